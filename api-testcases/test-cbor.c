@@ -0,0 +1,77 @@
+/*===
+*** test_1 (duk_safe_call)
+cbor encode: a3616101616282f5636162636178626161
+top after: 2
+decoded: {"a":1,"b":[true,"abc"],"x":"aa"}
+top after: 2
+buffer decoded: true
+==> rc=0, result='undefined'
+*** test_2 (duk_safe_call)
+text string decoded: 123
+==> rc=0, result='undefined'
+*** test_3 (duk_safe_call)
+==> rc=1, result='TypeError: cbor decode failed'
+*** test_4 (duk_safe_call)
+==> rc=1, result='TypeError: cbor decode failed'
+===*/
+
+int test_1(duk_context *ctx) {
+	duk_set_top(ctx, 0);
+	duk_eval_string(ctx, "({ a: 1, b: [ true, 'abc' ], x: 'aa' })");
+	duk_push_int(ctx, 123);  /* dummy */
+	duk_cbor_encode(ctx, -2);
+	printf("cbor encode: %s\n", duk_hex_encode(ctx, -2));
+	printf("top after: %d\n", duk_get_top(ctx));  /* value + dummy */
+
+	duk_hex_decode(ctx, -2);
+	duk_cbor_decode(ctx, -2);
+	printf("decoded: %s\n", duk_json_encode(ctx, -2));
+	printf("top after: %d\n", duk_get_top(ctx));  /* value + dummy */
+
+	duk_push_fixed_buffer(ctx, 1);
+	((unsigned char *) duk_get_buffer(ctx, -1, NULL))[0] = 0xf5;
+	duk_cbor_decode(ctx, -1);
+	printf("buffer decoded: %s\n", duk_to_string(ctx, -1));
+
+	duk_set_top(ctx, 0);
+	return 0;
+}
+
+int test_2(duk_context *ctx) {
+	/* non-buffer input is coerced to a string and its bytes are decoded */
+	duk_set_top(ctx, 0);
+	duk_push_string(ctx, "\x18\x7b");
+	duk_cbor_decode(ctx, 0);
+	printf("text string decoded: %s\n", duk_to_string(ctx, 0));
+	duk_set_top(ctx, 0);
+	return 0;
+}
+
+int test_3(duk_context *ctx) {
+	/* trailing garbage */
+	duk_set_top(ctx, 0);
+	duk_push_string(ctx, "0102");
+	duk_hex_decode(ctx, 0);
+	duk_cbor_decode(ctx, 0);
+	printf("never here\n");
+	return 0;
+}
+
+int test_4(duk_context *ctx) {
+	/* truncated input */
+	duk_set_top(ctx, 0);
+	duk_push_string(ctx, "83010203");
+	duk_hex_decode(ctx, 0);
+	duk_push_lstring(ctx, (const char *) duk_get_buffer(ctx, 0, NULL), 3);
+	duk_to_buffer(ctx, -1, NULL);
+	duk_cbor_decode(ctx, -1);
+	printf("never here\n");
+	return 0;
+}
+
+void test(duk_context *ctx) {
+	TEST_SAFE_CALL(test_1);
+	TEST_SAFE_CALL(test_2);
+	TEST_SAFE_CALL(test_3);
+	TEST_SAFE_CALL(test_4);
+}
@@ -0,0 +1,209 @@
+/*===
+*** test_1 (duk_safe_call)
+chunk 1: [1,"foo",{"a":[true,null]},[],"x,]}\"y",-2500]
+chunk 3: [1,"foo",{"a":[true,null]},[],"x,]}\"y",-2500]
+chunk 1000: [1,"foo",{"a":[true,null]},[],"x,]}\"y",-2500]
+chunk 1: {"a":[1,2],"b":"[,]"}
+chunk 2: "top level string"
+chunk 1: 123
+chunk 1: []
+chunk 4: []
+chunk 1: [[[]]]
+final top: 0
+==> rc=0, result='undefined'
+*** test_2 (duk_safe_call)
+element 0: {"id":1,"tags":["a","b"]}
+element 1: {"id":2,"tags":[]}
+element 2: "s\n,t"
+element 3: 4
+result: []
+final top: 0
+==> rc=0, result='undefined'
+*** test_3 (duk_safe_call)
+[1,]: SyntaxError: invalid json
+[,1]: SyntaxError: invalid json
+[1 2]: SyntaxError: invalid json
+[1: SyntaxError: invalid json
+: SyntaxError: invalid json
+   : SyntaxError: invalid json
+[1] x: SyntaxError: invalid json
+[}]: SyntaxError: invalid json
+{"a":1: SyntaxError: invalid json
+["abc: SyntaxError: invalid json
+[1]]: SyntaxError: invalid json
+final top: 0
+==> rc=0, result='undefined'
+*** test_4 (duk_safe_call)
+callback error: Error: aborted at 1
+reuse after error: TypeError: json decoder not usable
+reuse after finish: TypeError: json decoder not usable
+not a decoder: TypeError: not a json decoder
+final top: 0
+==> rc=0, result='undefined'
+===*/
+
+/* [ text chunk_size ] -> [ result ] */
+int decode_chunked(duk_context *ctx) {
+	const char *text;
+	duk_size_t len;
+	duk_size_t off;
+	duk_size_t chunk_size;
+	duk_size_t n;
+
+	/* duk_safe_call() doesn't create a new frame, so use negative indices */
+	text = duk_require_lstring(ctx, -2, &len);
+	chunk_size = (duk_size_t) duk_require_int(ctx, -1);
+
+	duk_push_json_decoder(ctx, DUK_INVALID_INDEX);
+	for (off = 0; off < len; off += n) {
+		n = (len - off < chunk_size ? len - off : chunk_size);
+		duk_json_decoder_feed(ctx, -1, (const void *) (text + off), n);
+	}
+	duk_json_decoder_finish(ctx, -1);
+	return 1;
+}
+
+void print_decoded(duk_context *ctx, const char *text, int chunk_size) {
+	int rc;
+
+	duk_push_string(ctx, text);
+	duk_push_int(ctx, chunk_size);
+	rc = duk_safe_call(ctx, decode_chunked, 2 /*nargs*/, 1 /*nrets*/);
+	if (rc == DUK_EXEC_SUCCESS) {
+		printf("chunk %d: %s\n", chunk_size, duk_json_encode(ctx, -1));
+	} else {
+		printf("%s: %s\n", text, duk_safe_to_string(ctx, -1));
+	}
+	duk_pop(ctx);
+}
+
+/* Top level arrays and other values fed in various chunk sizes, so that
+ * chunk boundaries land inside strings, escapes and literals.
+ */
+int test_1(duk_context *ctx) {
+	const char *text = " [ 1, \"foo\" ,{\"a\":[true,null]},[],\"x,]}\\\"y\",-2.5e3 ]\n";
+
+	print_decoded(ctx, text, 1);
+	print_decoded(ctx, text, 3);
+	print_decoded(ctx, text, 1000);
+	print_decoded(ctx, "{\"a\":[1,2],\"b\":\"[,]\"}", 1);
+	print_decoded(ctx, "\"top level string\"", 2);
+	print_decoded(ctx, "123", 1);
+	print_decoded(ctx, "[]", 1);
+	print_decoded(ctx, "\t[ \r\n ] ", 4);
+	print_decoded(ctx, "[[[]]]", 1);
+
+	printf("final top: %d\n", duk_get_top(ctx));
+	return 0;
+}
+
+int element_cb(duk_context *ctx) {
+	/* [ value index ] */
+	printf("element %d: %s\n", duk_get_int(ctx, 1), duk_json_encode(ctx, 0));
+	return 0;
+}
+
+int abort_cb(duk_context *ctx) {
+	if (duk_get_int(ctx, 1) >= 1) {
+		duk_error(ctx, DUK_ERR_ERROR, "aborted at %d", duk_get_int(ctx, 1));
+	}
+	return 0;
+}
+
+/* Elements passed to a callback one at a time. */
+int test_2(duk_context *ctx) {
+	const char *text = "[{\"id\":1,\"tags\":[\"a\",\"b\"]},{\"id\":2,\"tags\":[]},\"s\\n,t\",4]";
+	size_t i;
+
+	duk_push_c_function(ctx, element_cb, 2);
+	duk_push_json_decoder(ctx, -1);
+	for (i = 0; text[i] != (char) 0; i++) {
+		duk_json_decoder_feed(ctx, -1, (const void *) (text + i), 1);
+	}
+	duk_json_decoder_finish(ctx, -1);
+	printf("result: %s\n", duk_json_encode(ctx, -1));
+	duk_pop_2(ctx);
+
+	printf("final top: %d\n", duk_get_top(ctx));
+	return 0;
+}
+
+/* Invalid input. */
+int test_3(duk_context *ctx) {
+	print_decoded(ctx, "[1,]", 1);
+	print_decoded(ctx, "[,1]", 2);
+	print_decoded(ctx, "[1 2]", 3);
+	print_decoded(ctx, "[1", 1);
+	print_decoded(ctx, "", 1);
+	print_decoded(ctx, "   ", 1);
+	print_decoded(ctx, "[1] x", 1);
+	print_decoded(ctx, "[}]", 1);
+	print_decoded(ctx, "{\"a\":1", 2);
+	print_decoded(ctx, "[\"abc", 2);
+	print_decoded(ctx, "[1]]", 1);
+
+	printf("final top: %d\n", duk_get_top(ctx));
+	return 0;
+}
+
+int feed_string(duk_context *ctx) {
+	/* [ ... decoder text ] */
+	duk_size_t len;
+	const char *text = duk_get_lstring(ctx, -1, &len);
+	duk_json_decoder_feed(ctx, -2, (const void *) text, len);
+	return 0;
+}
+
+int finish_decoder(duk_context *ctx) {
+	/* [ ... decoder ] */
+	duk_json_decoder_finish(ctx, -1);
+	return 0;
+}
+
+/* Errors leave the decoder unusable. */
+int test_4(duk_context *ctx) {
+	int rc;
+
+	duk_push_c_function(ctx, abort_cb, 2);
+	duk_push_json_decoder(ctx, -1);
+	duk_dup(ctx, -1);
+	duk_push_string(ctx, "[1,2,3]");
+	rc = duk_safe_call(ctx, feed_string, 2, 1);
+	printf("callback error: %s\n", rc == DUK_EXEC_SUCCESS ? "none" : duk_safe_to_string(ctx, -1));
+	duk_pop(ctx);
+	duk_dup(ctx, -1);
+	duk_push_string(ctx, "]");
+	rc = duk_safe_call(ctx, feed_string, 2, 1);
+	printf("reuse after error: %s\n", rc == DUK_EXEC_SUCCESS ? "none" : duk_safe_to_string(ctx, -1));
+	duk_pop_3(ctx);
+
+	duk_push_json_decoder(ctx, DUK_INVALID_INDEX);
+	duk_dup(ctx, -1);
+	duk_push_string(ctx, "[1]");
+	(void) duk_safe_call(ctx, feed_string, 2, 1);
+	duk_pop(ctx);
+	duk_dup(ctx, -1);
+	(void) duk_safe_call(ctx, finish_decoder, 1, 1);
+	duk_pop(ctx);
+	duk_dup(ctx, -1);
+	duk_push_string(ctx, " ");
+	rc = duk_safe_call(ctx, feed_string, 2, 1);
+	printf("reuse after finish: %s\n", rc == DUK_EXEC_SUCCESS ? "none" : duk_safe_to_string(ctx, -1));
+	duk_pop_2(ctx);
+
+	duk_push_object(ctx);
+	duk_push_string(ctx, "[1]");
+	rc = duk_safe_call(ctx, feed_string, 2, 1);
+	printf("not a decoder: %s\n", rc == DUK_EXEC_SUCCESS ? "none" : duk_safe_to_string(ctx, -1));
+	duk_pop(ctx);
+
+	printf("final top: %d\n", duk_get_top(ctx));
+	return 0;
+}
+
+void test(duk_context *ctx) {
+	TEST_SAFE_CALL(test_1);
+	TEST_SAFE_CALL(test_2);
+	TEST_SAFE_CALL(test_3);
+	TEST_SAFE_CALL(test_4);
+}
@@ -0,0 +1,64 @@
+/*
+ *  Repeated compilation of the same pattern and flags is served from the
+ *  per-heap regexp cache.  Cache behavior must not affect match results.
+ */
+
+/*===
+first: misses=1 hits=0
+repeat: misses=0 hits=9
+other flags: misses=1 hits=0
+results: 3 aab,ab,b
+entries after gc: ok
+final top: 0
+===*/
+
+static duk_regexp_cache_stats prev;
+
+static void print_delta(duk_context *ctx, const char *name) {
+	duk_regexp_cache_stats st;
+
+	duk_get_regexp_cache_stats(ctx, &st);
+	printf("%s: misses=%d hits=%d\n", name,
+	       (int) (st.misses - prev.misses), (int) (st.hits - prev.hits));
+	prev = st;
+}
+
+void test(duk_context *ctx) {
+	duk_regexp_cache_stats st;
+	int i;
+
+	duk_get_regexp_cache_stats(ctx, &prev);
+
+	duk_eval_string(ctx, "new RegExp('a+b', 'g')");
+	duk_pop(ctx);
+	print_delta(ctx, "first");
+
+	for (i = 0; i < 9; i++) {
+		duk_eval_string(ctx, "new RegExp('a+b', 'g')");
+		duk_pop(ctx);
+	}
+	print_delta(ctx, "repeat");
+
+	duk_eval_string(ctx, "new RegExp('a+b', 'gi')");
+	duk_pop(ctx);
+	print_delta(ctx, "other flags");
+
+	duk_eval_string(ctx,
+		"(function () {\n"
+		"    var res = [];\n"
+		"    for (var i = 0; i < 3; i++) {\n"
+		"        var m = new RegExp('a*b', 'g').exec(['aab', 'ab', 'b'][i]);\n"
+		"        res.push(m[0]);\n"
+		"    }\n"
+		"    return res.length + ' ' + res.join(',');\n"
+		"})()");
+	printf("results: %s\n", duk_get_string(ctx, -1));
+	duk_pop(ctx);
+
+	/* Cached entries are strongly held but the cache is bounded. */
+	duk_gc(ctx, 0);
+	duk_get_regexp_cache_stats(ctx, &st);
+	printf("entries after gc: %s\n", (st.entries >= 1 && st.entries <= 16) ? "ok" : "fail");
+
+	printf("final top: %d\n", duk_get_top(ctx));
+}
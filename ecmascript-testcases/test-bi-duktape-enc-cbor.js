@@ -0,0 +1,237 @@
+/*
+ *  CBOR encoding and decoding with Duktape.enc() and Duktape.dec()
+ *  (DUK_USE_CBOR).  Vectors are from RFC 7049 Appendix A.
+ */
+
+/*---
+{
+    "custom": true
+}
+---*/
+
+function enc(v) {
+    return Duktape.enc('hex', Duktape.enc('cbor', v));
+}
+
+function dec(h) {
+    return Duktape.dec('cbor', Duktape.dec('hex', h));
+}
+
+function safeDec(h) {
+    try {
+        return Duktape.enc('jsonx', dec(h));
+    } catch (e) {
+        return e.name;
+    }
+}
+
+/*===
+encode
+0 00
+1 01
+10 0a
+23 17
+24 1818
+25 1819
+100 1864
+1000 1903e8
+1000000 1a000f4240
+1000000000000 1b000000e8d4a51000
+9007199254740992 1b0020000000000000
+18446744073709550000 1bfffffffffffff800
+-1 20
+-10 29
+-100 3863
+-1000 3903e7
+-9007199254740992 3b001fffffffffffff
+-18446744073709552000 fadf800000
+-0 f98000
+0.5 f93800
+1.5 f93e00
+0.00006103515625 f90400
+5.960464477539063e-8 f90001
+0.00006097555160522461 f903ff
+65504.5 fa477fe080
+100000.5 fa47c35040
+3.4028234663852886e+38 fa7f7fffff
+1e-7 fb3e7ad7f29abcaf48
+-4.1 fbc010666666666666
+1.1 fb3ff199999999999a
+1e+300 fb7e37e43c8800759c
+Infinity f97c00
+-Infinity f9fc00
+NaN f97e00
+false f4
+true f5
+null f6
+undefined f7
+"" 60
+"a" 6161
+"IETF" 6449455446
+"\"\\" 62225c
+"\xfc" 62c3bc
+"\u6c34" 63e6b0b4
+[] 80
+[1,2,3] 83010203
+[1,[2,3],[4,5]] 8301820203820405
+{} a0
+{a:1,b:[2,3]} a26161016162820203
+["a",{b:"c"}] 826161a161626163
+|01020304| 4401020304
+wrappers 03 6178 f5 4401020304
+functions f7 f7
+{"0":"a",x:1} a261306161617801
+{} a0
+[undefined,undefined,3] 83f7f703
+decode
+00 0
+17 23
+1818 24
+1b000000e8d4a51000 1000000000000
+1bffffffffffffffff 18446744073709552000
+20 -1
+3903e7 -1000
+3bffffffffffffffff -18446744073709552000
+f90000 0
+f98000 -0
+f93c00 1
+f93e00 1.5
+f97bff 65504
+f90001 5.960464477539063e-8
+f90400 0.00006103515625
+f9c400 -4
+f97c00 Infinity
+f9fc00 -Infinity
+f97e00 NaN
+fa47c35000 100000
+fa7f7fffff 3.4028234663852886e+38
+fb7e37e43c8800759c 1e+300
+f4 false
+f5 true
+f6 null
+f7 undefined
+40 ||
+4401020304 |01020304|
+60 ""
+6449455446 "IETF"
+80 []
+a0 {}
+a201020304 {"1":2,"3":4}
+a56161614161626142616361436164614461656145 {a:"A",b:"B",c:"C",d:"D",e:"E"}
+c074323031332d30332d32315432303a30343a30305a "2013-03-21T20:04:00Z"
+d74401020304 |01020304|
+c249010000000000000000 |010000000000000000|
+5f42010243030405ff |0102030405|
+7f657374726561646d696e67ff "streaming"
+9fff []
+9f018202039f0405ffff [1,[2,3],[4,5]]
+83018202039f0405ff [1,[2,3],[4,5]]
+bf61610161629f0203ffff {a:1,b:[2,3]}
+826161bf61626163ff ["a",{b:"c"}]
+a2616101616102 {a:2}
+errors
+ TypeError
+18 TypeError
+1a0000 TypeError
+ff TypeError
+f0 TypeError
+f8ff TypeError
+1c TypeError
+5a7fffffff TypeError
+9b7fffffffffffffff TypeError
+5f6161ff TypeError
+0000 TypeError
+9f01 TypeError
+bf01ff TypeError
+recursion
+RangeError
+RangeError
+round trip
+true
+true
+===*/
+
+print('encode');
+[ 0, 1, 10, 23, 24, 25, 100, 1000, 1000000, 1000000000000,
+  9007199254740992, 18446744073709549568,
+  -1, -10, -100, -1000, -9007199254740992, -18446744073709551616, -0,
+  0.5, 1.5, 0.00006103515625, 5.960464477539063e-8, 0.00006097555160522461,
+  65504.5, 100000.5, 3.4028234663852886e38, 1e-7, -4.1, 1.1, 1e300, 1 / 0, -1 / 0, 0 / 0,
+  false, true, null, undefined,
+  '', 'a', 'IETF', '"\\', 'ü', '水',
+  [], [ 1, 2, 3 ], [ 1, [ 2, 3 ], [ 4, 5 ] ], {}, { a: 1, b: [ 2, 3 ] },
+  [ 'a', { b: 'c' } ], Duktape.dec('hex', '01020304') ].forEach(function (v) {
+    var s = (v === 0 && 1 / v < 0) ? '-0' : Duktape.enc('jsonx', v);
+    print(s, enc(v));
+});
+
+print('wrappers', enc(new Number(3)), enc(new String('x')), enc(new Boolean(true)),
+      enc(new Duktape.Buffer(Duktape.dec('hex', '01020304'))));
+print('functions', enc(print), enc(function () {}));
+
+(function () {
+    var o = { 0: 'a', x: 1 };
+    var a = [];
+    Object.defineProperty(o, 'hidden', { value: 1, enumerable: false });
+    print(Duktape.enc('jsonx', o), enc(o));
+    print(Duktape.enc('jsonx', Object.create({ inherited: 1 })), enc(Object.create({ inherited: 1 })));
+    a[2] = 3;
+    print(Duktape.enc('jsonx', a), enc(a));
+})();
+
+print('decode');
+[ '00', '17', '1818', '1b000000e8d4a51000', '1bffffffffffffffff', '20', '3903e7',
+  '3bffffffffffffffff', 'f90000', 'f98000', 'f93c00', 'f93e00', 'f97bff', 'f90001',
+  'f90400', 'f9c400', 'f97c00', 'f9fc00', 'f97e00', 'fa47c35000', 'fa7f7fffff',
+  'fb7e37e43c8800759c', 'f4', 'f5', 'f6', 'f7', '40', '4401020304', '60',
+  '6449455446', '80', 'a0', 'a201020304',
+  'a56161614161626142616361436164614461656145',
+  'c074323031332d30332d32315432303a30343a30305a', 'd74401020304',
+  'c249010000000000000000', '5f42010243030405ff', '7f657374726561646d696e67ff',
+  '9fff', '9f018202039f0405ffff', '83018202039f0405ff', 'bf61610161629f0203ffff',
+  '826161bf61626163ff', 'a2616101616102' ].forEach(function (h) {
+    var v = dec(h);
+    var s = (v === 0 && 1 / v < 0) ? '-0' : Duktape.enc('jsonx', v);
+    print(h, s);
+});
+
+print('errors');
+[ '', '18', '1a0000', 'ff', 'f0', 'f8ff', '1c', '5a7fffffff', '9b7fffffffffffffff',
+  '5f6161ff', '0000', '9f01', 'bf01ff' ].forEach(function (h) {
+    print(h, safeDec(h));
+});
+
+print('recursion');
+(function () {
+    var a = [];
+    var i;
+    var h = '';
+    for (i = 0; i < 10000; i++) {
+        a = [ a ];
+    }
+    try {
+        enc(a);
+    } catch (e) {
+        print(e.name);
+    }
+    for (i = 0; i < 10000; i++) {
+        h += '81';
+    }
+    try {
+        dec(h + '80');
+    } catch (e) {
+        print(e.name);
+    }
+})();
+
+print('round trip');
+(function () {
+    var recs = [];
+    var i;
+    for (i = 0; i < 1000; i++) {
+        recs.push({ id: i, neg: -i * 1000003, name: 'rec' + i, ratio: i / 7,
+                    tags: [ 'x', 'y' ], ok: (i % 2) === 0, none: null });
+    }
+    print(JSON.stringify(dec(enc(recs))) === JSON.stringify(recs));
+    print(Duktape.enc('jsonx', dec(enc({ get g() { return 'getter'; } }))) === '{g:"getter"}');
+})();
@@ -0,0 +1,239 @@
+/*
+ *  break/continue compile to plain jumps unless a try/catch/finally or
+ *  'with' statement needs unwinding, and label sites only get a runtime
+ *  catcher when a slow break/continue targets them.
+ */
+
+/*===
+nested loops
+0 0
+1 0
+2 0
+2 1
+2 2
+30
+switch
+sw 0
+after 0
+after 2
+sw 3
+after 3
+labelled blocks
+1
+3
+fin
+4
+with
+200000
+glob
+obj-break
+try/catch/finally
+f 0 0
+f 1 0
+x 1
+f 2 0
+c 0 caught
+c 1 caught
+done 2
+fin-break 0
+fin-continue 0
+fin-continue 1
+fin-continue 2
+for-in
+a
+c
+many iterations
+100000
+===*/
+
+print('nested loops');
+(function () {
+    var i, j, t = 0;
+    outer:
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < 3; j++) {
+            if (i < 2 && j === 1) {
+                continue outer;
+            }
+            print(i, j);
+        }
+    }
+
+    search:
+    for (i = 0; i < 10; i++) {
+        for (j = 0; j < 10; j++) {
+            while (true) {
+                if (i === 3) {
+                    break search;
+                }
+                t += 10;
+                break;
+            }
+            if (j === 0) {
+                break;
+            }
+        }
+    }
+    print(t);
+})();
+
+print('switch');
+(function () {
+    var i;
+    for (i = 0; i < 4; i++) {
+        switch (i) {
+        case 1:
+            continue;
+        case 2:
+            break;
+        default:
+            print('sw', i);
+        }
+        print('after', i);
+    }
+})();
+
+print('labelled blocks');
+(function () {
+    foo: {
+        print(1);
+        break foo;
+        print(2);
+    }
+    print(3);
+
+    bar: if (true) {
+        try {
+            break bar;
+        } finally {
+            print('fin');
+        }
+        print('never here');
+    }
+    print(4);
+})();
+
+print('with');
+(function () {
+    var i, x = 0;
+    for (i = 0; i < 200000; i++) {
+        for (;;) {
+            with ({ a: 1 }) {
+                x += a;
+                break;
+            }
+        }
+    }
+    print(x);
+})();
+
+var a = 'glob';
+(function () {
+    var i, o = { a: 'obj' };
+    for (i = 0; i < 2; i++) {
+        with (o) {
+            if (i === 0) {
+                continue;
+            }
+        }
+    }
+    // 'a' must resolve to the global again, i.e. the 'with' binding
+    // is not left behind by the continue
+    print(a);
+
+    lbl: with (o) {
+        while (true) {
+            break lbl;
+        }
+    }
+    print(typeof a === 'string' && a === 'glob' ? 'obj-break' : 'leak');
+})();
+
+print('try/catch/finally');
+(function () {
+    var i, j;
+
+    // 'continue outer' is a fast jump emitted before the inner loop's
+    // slow 'break' is seen
+    outer:
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < 3; j++) {
+            if (j === 1) {
+                continue outer;
+            }
+            try {
+                if (i === 1) {
+                    break;
+                }
+            } finally {
+                print('f', i, j);
+            }
+        }
+        print('x', i);
+    }
+
+    // break/continue out of a catch clause (catch binding is unwound)
+    for (i = 0; i < 5; i++) {
+        try {
+            throw 'caught';
+        } catch (e) {
+            if (i === 2) {
+                break;
+            }
+            print('c', i, e);
+            continue;
+        }
+    }
+    print('done', i);
+
+    for (i = 0; i < 3; i++) {
+        try {
+            break;
+        } finally {
+            print('fin-break', i);
+        }
+    }
+    for (i = 0; i < 3; i++) {
+        try {
+            continue;
+        } finally {
+            print('fin-continue', i);
+        }
+    }
+})();
+
+print('for-in');
+(function () {
+    var k;
+    for (k in { a: 1, b: 2, c: 3, d: 4 }) {
+        if (k === 'b') {
+            continue;
+        }
+        if (k === 'd') {
+            break;
+        }
+        print(k);
+    }
+})();
+
+print('many iterations');
+(function () {
+    // no catchers may be left behind in long running loops
+    var i, j, n = 0;
+    for (i = 0; i < 100000; i++) {
+        lbl:
+        for (j = 0; j < 2; j++) {
+            switch (j) {
+            case 0:
+                continue lbl;
+            default:
+                try {
+                    n++;
+                } finally {
+                    break lbl;
+                }
+            }
+        }
+    }
+    print(n);
+})();
@@ -0,0 +1,233 @@
+/*
+ *  JSON.parse() fast paths: strings are scanned a word at a time and
+ *  escape-free strings are interned directly from the input, and
+ *  objects/arrays are presized and populated directly.  Results must be
+ *  identical to the slow paths.
+ */
+
+/*===
+strings
+0 1 7 8 9 15 16 17 31 32 33 63 64 65
+true
+1000 a\b"c	d
+"\u0000\u001f" true
+non-ascii
+6 true
+3 true
+control characters
+0 SyntaxError
+1 SyntaxError
+7 SyntaxError
+8 SyntaxError
+9 SyntaxError
+15 SyntaxError
+16 SyntaxError
+unterminated
+0 SyntaxError
+1 SyntaxError
+8 SyntaxError
+16 SyntaxError
+keys
+{"a":1,"b":2,"c":3}
+3 1 2 3
+{"k7":7,"k":0,"k07":7,"k70":70}
+dup keys
+{"a":3,"b":2}
+{"x":{"y":3}}
+{"a":[4,5],"b":{"c":6}}
+{"k":"new"}
+{"__proto__":1,"x":2}
+true true
+{"0":"a","1":"b","10":"c"}
+false
+array index keys
+a b c undefined
+escaped keys
+{"a\nb":1,"ab":2,"a\"b":3}
+arrays
+0 []
+1 [1]
+3 [[],[[]],[1,[2,[3]]]]
+10000 0 9999 49995000
+true true
+records
+1000 rec999 999 true
+[{"a":1},{"a":1,"b":2,"c":3,"d":4,"e":5,"f":6},{"a":1,"b":2},{}]
+nested
+[[[1,2],[3,4]],[[5,6],[7,8,9]],[[10]],[]]
+numbers
+0 -0 1 -1 123456789012345 -123456789012345 1234567890123456
+12345678901234568 9007199254740992 1.5 -2500 1e+21 0.001
+SyntaxError
+SyntaxError
+SyntaxError
+SyntaxError
+SyntaxError
+SyntaxError
+reviver
+{"a":2,"b":[2,4,{"c":6}]}
+===*/
+
+function rep(s, n) {
+    var res = '';
+    while (n-- > 0) {
+        res += s;
+    }
+    return res;
+}
+
+function tryParse(s) {
+    try {
+        return JSON.parse(s);
+    } catch (e) {
+        return e.name;
+    }
+}
+
+/* Strings around the word size so that the terminator lands in every
+ * byte position of a word, with varying input alignment.
+ */
+print('strings');
+(function () {
+    var lens = [ 0, 1, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65 ];
+    var out = [];
+    var ok = true;
+    lens.forEach(function (n) {
+        var s = rep('x', n);
+        var pad;
+        out.push(JSON.parse('"' + s + '"').length);
+        for (pad = 0; pad < 8; pad++) {
+            if (JSON.parse(rep(' ', pad) + '"' + s + '"') !== s) { ok = false; }
+            if (JSON.parse(rep(' ', pad) + '"' + s + '\\n' + s + '"') !== s + '\n' + s) { ok = false; }
+            if (JSON.parse(rep(' ', pad) + '["' + s + '",' + '"' + s + '\\"' + '"]')[1] !== s + '"') { ok = false; }
+        }
+    });
+    print(out.join(' '));
+    print(ok);
+})();
+
+(function () {
+    var s = rep('abcdefghij', 100);
+    var t = JSON.parse('"' + s + '"');
+    var u = JSON.parse('"a\\\\b\\"c\\td"');
+    print(t.length, u);
+    u = JSON.parse('"\\u0000\\u001f"');
+    print(JSON.stringify(u), u.length === 2);
+})();
+
+print('non-ascii');
+(function () {
+    var s = JSON.parse('"äሴö𐀀x"');
+    print(s.length, s === 'äሴö𐀀x');
+    s = JSON.parse('"ä\\n€"');
+    print(s.length, s === 'ä\n€');
+})();
+
+print('control characters');
+[ 0, 1, 7, 8, 9, 15, 16 ].forEach(function (n) {
+    print(n, tryParse('"' + rep('y', n) + '\u0001' + rep('y', 10) + '"'));
+});
+
+print('unterminated');
+[ 0, 1, 8, 16 ].forEach(function (n) {
+    print(n, tryParse('"' + rep('z', n)));
+});
+
+print('keys');
+(function () {
+    var o = JSON.parse('{"a":1,"b":2,"c":3}');
+    var arr;
+    print(JSON.stringify(o));
+    arr = JSON.parse('[{"a":1},{"a":2},{"a":3}]');
+    print(arr.length, arr[0].a, arr[1].a, arr[2].a);
+
+    // keys which may collide in the key cache
+    print(JSON.stringify(JSON.parse('{"k7":7,"k":0,"k07":7,"k70":70}')));
+})();
+
+print('dup keys');
+(function () {
+    var o;
+    print(JSON.stringify(JSON.parse('{"a":1,"b":2,"a":3}')));
+    print(JSON.stringify(JSON.parse('{"x":{"y":1},"x":{"y":2},"x":{"y":3}}')));
+
+    // the replaced values (and the keys they contain) become garbage
+    // while the keys may still be cached
+    print(JSON.stringify(JSON.parse('{"a":{"c":1,"d":2},"b":{"c":3},"a":[4,5],"b":{"c":6}}')));
+    print(JSON.stringify(JSON.parse('{"k":{"' + rep('q', 40) + '":1},"k":"new"}')));
+
+    // JSON.parse() defines own properties, Object.prototype.__proto__
+    // or inherited setters must not be invoked
+    o = JSON.parse('{"__proto__":1,"x":2}');
+    print(JSON.stringify(o));
+    print(Object.getPrototypeOf(o) === Object.prototype, o.hasOwnProperty('__proto__'));
+    print(JSON.stringify(JSON.parse('{"0":"a","1":"b","10":"c"}')));
+    print(Array.isArray(JSON.parse('{"0":"a"}')));
+})();
+
+print('array index keys');
+(function () {
+    var o = JSON.parse('{"0":"a","1":"b","2":"c"}');
+    print(o[0], o[1], o[2], typeof o[3]);
+})();
+
+print('escaped keys');
+print(JSON.stringify(JSON.parse('{"a\\nb":1,"\\u0061b":2,"a\\"b":3}')));
+
+print('arrays');
+(function () {
+    var a, i, sum;
+    [ '[]', '[1]', '[[],[[]],[1,[2,[3]]]]' ].forEach(function (s) {
+        var v = JSON.parse(s);
+        print(v.length, JSON.stringify(v));
+    });
+
+    a = [];
+    for (i = 0; i < 10000; i++) {
+        a.push(i);
+    }
+    a = JSON.parse(JSON.stringify(a));
+    sum = 0;
+    for (i = 0; i < a.length; i++) {
+        sum += a[i];
+    }
+    print(a.length, a[0], a[9999], sum);
+
+    // array is a normal array afterwards
+    a.push('x');
+    a.length = 3;
+    print(a.length === 3, a[3] === undefined);
+})();
+
+print('records');
+(function () {
+    var parts = [];
+    var i, a;
+    for (i = 0; i < 1000; i++) {
+        parts.push('{"id":' + i + ',"name":"rec' + i + '","tags":["a","b"],"pos":{"x":1,"y":2}}');
+    }
+    a = JSON.parse('[' + parts.join(',') + ']');
+    print(a.length, a[999].name, a[999].id, a[500].pos.y === 2 && a[7].tags[1] === 'b');
+
+    // size hints from previous objects must not limit later ones
+    print(JSON.stringify(JSON.parse('[{"a":1},{"a":1,"b":2,"c":3,"d":4,"e":5,"f":6},{"a":1,"b":2},{}]')));
+})();
+
+print('nested');
+print(JSON.stringify(JSON.parse('[[[1,2],[3,4]],[[5,6],[7,8,9]],[[10]],[]]')));
+
+print('numbers');
+(function () {
+    var v = JSON.parse('[0,-0,1,-1,123456789012345,-123456789012345,1234567890123456]');
+    print(v.map(function (x) { return (x === 0 && 1 / x < 0) ? '-0' : String(x); }).join(' '));
+    v = JSON.parse('[12345678901234567,9007199254740993,1.5,-2.5e3,1e21,0.001]');
+    print(v.join(' '));
+    [ '01', '-01', '-', '1.', '--1', '1-' ].forEach(function (s) {
+        print(tryParse(s));
+    });
+})();
+
+print('reviver');
+print(JSON.stringify(JSON.parse('{"a":1,"b":[1,2,{"c":3}]}', function (k, v) {
+    return typeof v === 'number' ? v * 2 : v;
+})));
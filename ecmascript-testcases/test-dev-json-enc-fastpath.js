@@ -0,0 +1,241 @@
+/*
+ *  JSON.stringify() fast path: plain objects and arrays are serialized
+ *  directly from their property tables when there is no replacer,
+ *  property list or indent.  Anything the fast path can't handle must
+ *  fall back to the slow path, and results must be identical.
+ */
+
+/*===
+basic
+{"a":1,"b":"x","c":true,"d":null,"e":[1,2,3],"f":{"g":{}}}
+[]
+{}
+[[],{},[{}]]
+"str"
+123
+null
+undefined
+undefined
+omitted values
+{"a":1,"c":3}
+{"c":3}
+{}
+[null,null,null,1]
+non-enumerable and inherited
+{"b":2}
+{"own":1}
+toJSON
+{"a":"own"}
+{"x":{"a":"proto"}}
+["arr"]
+{"a":"objproto"}
+["arrproto"]
+{"f":"func"}
+{"x":"hidden"}
+accessors
+{"a":1,"g":2}
+{"a":1}
+holes and sparse arrays
+[1,null,3]
+[1,null,"inherited"]
+[null,null,null,null,null]
+[1,2,null,null,null,null,null,null,null,null]
+{"0":"a","x":1}
+wrappers and special objects
+[1,"s",false]
+{"d":"2000-01-01T00:00:00.000Z"}
+{}
+[{}]
+loops and nesting
+TypeError
+TypeError
+[[1],[1]]
+RangeError
+true
+numbers
+[0,0,1,-1,4294967295,4294967296,-4294967296,1e+21,1.5,-0.001,null,null,null]
+[9007199254740992,123456789012,5e-324,1.7976931348623157e+308]
+strings
+"0123456789abcdef0123456789abcdef"
+"a\"b\\c\nd\te\bf\fg\rh"
+"\u0000\u0001\u001f x"
+"äሴö"
+0 1 7 8 9 15 16 17 31 32 33
+true
+keys
+{"a\"b":1,"c\nd":2,"ä":3}
+{"1":"y","0":"z"}
+after fallback
+{"a":[1,2],"b":{"c":"d"}}
+===*/
+
+function rep(s, n) {
+    var res = '';
+    while (n-- > 0) {
+        res += s;
+    }
+    return res;
+}
+
+function tryStringify(v) {
+    try {
+        return JSON.stringify(v);
+    } catch (e) {
+        return e.name;
+    }
+}
+
+print('basic');
+print(JSON.stringify({ a: 1, b: 'x', c: true, d: null, e: [ 1, 2, 3 ], f: { g: {} } }));
+print(JSON.stringify([]));
+print(JSON.stringify({}));
+print(JSON.stringify([ [], {}, [ {} ] ]));
+print(JSON.stringify('str'));
+print(JSON.stringify(123));
+print(JSON.stringify(null));
+print(String(JSON.stringify(undefined)));
+print(String(JSON.stringify(function () {})));
+
+print('omitted values');
+print(JSON.stringify({ a: 1, b: undefined, c: 3 }));
+print(JSON.stringify({ a: undefined, b: function () {}, c: 3 }));
+print(JSON.stringify({ a: undefined, b: function () {} }));
+print(JSON.stringify([ undefined, function () {}, null, 1 ]));
+
+print('non-enumerable and inherited');
+(function () {
+    var o = { b: 2 };
+    Object.defineProperty(o, 'a', { value: 1, enumerable: false });
+    print(JSON.stringify(o));
+    o = Object.create({ inherited: 1 });
+    o.own = 1;
+    print(JSON.stringify(o));
+})();
+
+print('toJSON');
+(function () {
+    var proto = { toJSON: function () { return { a: 'proto' }; } };
+    var o;
+
+    print(JSON.stringify({ b: 1, toJSON: function () { return { a: 'own' }; } }));
+    print(JSON.stringify({ x: Object.create(proto) }));
+
+    o = [ 1, 2 ];
+    o.toJSON = function () { return [ 'arr' ]; };
+    print(JSON.stringify(o));
+
+    // toJSON added to the built-in prototypes after an earlier fast path
+    // run must be noticed
+    JSON.stringify({ v: {}, w: [] });
+    Object.prototype.toJSON = function () { return Array.isArray(this) ? [ 'arrproto' ] : { a: 'objproto' }; };
+    Array.prototype.toJSON = function () { return [ 'arrproto' ]; };
+    print(JSON.stringify({ v: {}, w: [] }));
+    print(JSON.stringify([ {} ]));
+    delete Object.prototype.toJSON;
+    delete Array.prototype.toJSON;
+
+    Function.prototype.toJSON = function () { return 'func'; };
+    print(JSON.stringify({ f: function () {} }));
+    delete Function.prototype.toJSON;
+
+    o = {};
+    Object.defineProperty(o, 'toJSON', { value: function () { return { x: 'hidden' }; }, enumerable: false });
+    print(JSON.stringify(o));
+})();
+
+print('accessors');
+(function () {
+    var o = { a: 1 };
+    Object.defineProperty(o, 'g', { get: function () { return 2; }, enumerable: true });
+    print(JSON.stringify(o));
+    o = { a: 1 };
+    Object.defineProperty(o, 'g', { get: function () { return 2; }, enumerable: false });
+    print(JSON.stringify(o));
+})();
+
+print('holes and sparse arrays');
+(function () {
+    var a;
+    print(JSON.stringify([ 1, , 3 ]));
+    Array.prototype[2] = 'inherited';
+    print(JSON.stringify([ 1, , , ]));
+    delete Array.prototype[2];
+    print(JSON.stringify(new Array(5)));
+    a = [ 1, 2 ];
+    a.length = 10;
+    print(JSON.stringify(a));
+    print(JSON.stringify({ 0: 'a', x: 1 }));
+})();
+
+print('wrappers and special objects');
+print(JSON.stringify([ new Number(1), new String('s'), new Boolean(false) ]));
+print(JSON.stringify({ d: new Date(Date.UTC(2000, 0, 1)) }));
+print(JSON.stringify(/foo/));
+print(JSON.stringify([ Math ]));
+
+print('loops and nesting');
+(function () {
+    var o = {};
+    var a = [];
+    var shared = [ 1 ];
+    var deep, i;
+
+    o.self = o;
+    print(tryStringify(o));
+    a.push({ x: a });
+    print(tryStringify(a));
+
+    // the same object twice is not a loop
+    print(JSON.stringify([ shared, shared ]));
+
+    deep = [];
+    for (i = 0; i < 100000; i++) {
+        deep = [ deep ];
+    }
+    print(tryStringify(deep));
+
+    deep = {};
+    for (i = 0; i < 100; i++) {
+        deep = { x: deep };
+    }
+    print(JSON.stringify(deep) === rep('{"x":', 100) + '{}' + rep('}', 100));
+})();
+
+print('numbers');
+print(JSON.stringify([ 0, -0, 1, -1, 4294967295, 4294967296, -4294967296, 1e21, 1.5, -0.001, NaN, Infinity, -Infinity ]));
+print(JSON.stringify([ 9007199254740992, 123456789012, 5e-324, 1.7976931348623157e308 ]));
+
+print('strings');
+print(JSON.stringify('0123456789abcdef0123456789abcdef'));
+print(JSON.stringify('a"b\\c\nd\te\bf\fg\rh'));
+print(JSON.stringify('\u0000\u0001\u001f x'));
+print(JSON.stringify('äሴö'));
+
+// escapes at every byte position of a word, with varying alignment
+(function () {
+    var lens = [ 0, 1, 7, 8, 9, 15, 16, 17, 31, 32, 33 ];
+    var out = [];
+    var ok = true;
+    lens.forEach(function (n) {
+        var s = rep('x', n);
+        var pad, t;
+        for (pad = 0; pad < 8; pad++) {
+            t = rep('y', pad) + s;
+            if (JSON.stringify(t + '"' + s) !== '"' + t + '\\"' + s + '"') { ok = false; }
+            if (JSON.stringify(t + '\n') !== '"' + t + '\\n"') { ok = false; }
+            if (JSON.stringify(t + 'ä' + s) !== '"' + t + 'ä' + s + '"') { ok = false; }
+            if (JSON.parse(JSON.stringify([ t + '\u0001' + s ]))[0] !== t + '\u0001' + s) { ok = false; }
+        }
+        out.push(JSON.stringify(s).length - 2);
+    });
+    print(out.join(' '));
+    print(ok);
+})();
+
+print('keys');
+print(JSON.stringify({ 'a"b': 1, 'c\nd': 2, 'ä': 3 }));
+print(JSON.stringify({ 1: 'y', 0: 'z' }));  // insertion order in this implementation
+
+// a fallback must not leave partial output behind
+print('after fallback');
+print(JSON.stringify({ a: [ 1, 2 ], b: { c: 'd' } }));
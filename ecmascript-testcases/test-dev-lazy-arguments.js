@@ -0,0 +1,334 @@
+/*
+ *  Functions which only read 'arguments[x]' and 'arguments.length' don't
+ *  create an arguments object on entry; the reads are served directly from
+ *  the call arguments and the object is only created when something else
+ *  is needed.  Results must be identical to a real arguments object.
+ */
+
+/*===
+basic
+0 undefined undefined undefined
+1 1 undefined undefined
+3 1 2 3
+4 1 2 3
+15
+last: z
+key types
+a a b undefined undefined undefined
+a undefined
+mapped
+10 undefined 1
+10 2 2
+11 20
+3 1
+function
+strict
+1 undefined 1
+1 2 2
+TypeError
+created on demand
+function 5 1
+8
+P undefined
+[object Arguments]
+escaped through a getter
+1 9 9
+call paths
+x,y,z
+6
+[1,2,3]
+1:2:3
+42 2
+A B
+V x
+20
+resumed 1 a undefined
+caught 3
+100000
+tail calls
+3
+2 1
+2 z
+not lazy
+object 1
+10 10
+3 3
+inner 1 2
+caught-arg 1
+with-arg 1
+eval 2 2
+===*/
+
+print('basic');
+(function () {
+    function f() {
+        return arguments.length + ' ' + arguments[0] + ' ' + arguments[1] + ' ' + arguments[2];
+    }
+    print(f());
+    print(f(1));
+    print(f(1, 2, 3));
+    print(f(1, 2, 3, 4));
+
+    function sum() {
+        var t = 0;
+        for (var i = 0; i < arguments.length; i++) {
+            t += arguments[i];
+        }
+        return t;
+    }
+    print(sum(1, 2, 3, 4, 5));
+
+    function last() {
+        return 'last: ' + arguments[arguments.length - 1];
+    }
+    print(last('x', 'y', 'z'));
+})();
+
+print('key types');
+(function () {
+    function f() {
+        return [ arguments[0], arguments[-0], arguments[1], arguments[-1],
+                 arguments[0.5], arguments[1e9] ].map(String).join(' ');
+    }
+    print(f('a', 'b'));
+
+    function g() {
+        var k = '0';
+        return arguments[k] + ' ' + arguments['1'];
+    }
+    print(g('a'));
+})();
+
+print('mapped');
+(function () {
+    // non-strict: indices below the formal count follow the formals
+    function f(a, b) {
+        a = 10;
+        return arguments[0] + ' ' + arguments[1] + ' ' + arguments.length;
+    }
+    print(f(1));
+    print(f(1, 2));
+
+    // unmapped index (no actual argument) doesn't follow the formal
+    function g(a, b) {
+        a = 11; b = 20;
+        return arguments[0] + ' ' + b;
+    }
+    print(g(1));
+
+    // duplicate formals: only the last one is mapped
+    function dup(a, a) {
+        a = 3;
+        return arguments[1] + ' ' + arguments[0];
+    }
+    print(dup(1, 2));
+
+    // function declaration shadowing a formal updates the mapped value
+    function fd(a) {
+        function a() {}
+        return typeof arguments[0];
+    }
+    print(fd(1));
+})();
+
+print('strict');
+(function () {
+    function f(a, b) {
+        'use strict';
+        a = 10;
+        return arguments[0] + ' ' + arguments[1] + ' ' + arguments.length;
+    }
+    print(f(1));
+    print(f(1, 2));
+
+    function g() {
+        'use strict';
+        try {
+            return arguments.callee;
+        } catch (e) {
+            return e.name;
+        }
+    }
+    print(g());
+})();
+
+print('created on demand');
+(function () {
+    function f(a) {
+        return typeof arguments.callee + ' ' + arguments[0] + ' ' + arguments.length;
+    }
+    print(f(5));
+
+    // mapping is still live after the object has been created
+    function g(a) {
+        a = 7;
+        var c = arguments.callee;
+        a = 8;
+        return arguments[0];
+    }
+    print(g(1));
+
+    // out of range indices are looked up from the prototype
+    function h() {
+        return arguments[5] + ' ' + arguments[6];
+    }
+    Object.prototype[5] = 'P';
+    print(h(1));
+    delete Object.prototype[5];
+
+    function k() {
+        return arguments.toString();
+    }
+    print(k());
+})();
+
+print('escaped through a getter');
+(function () {
+    // once created, the object may have escaped and been modified
+    Object.defineProperty(Object.prototype, 'selfRef', {
+        get: function () { return this; },
+        configurable: true
+    });
+    function f(a) {
+        var before = arguments[0];
+        arguments.selfRef[0] = 9;
+        return before + ' ' + arguments[0] + ' ' + a;
+    }
+    print(f(1));
+    delete Object.prototype.selfRef;
+})();
+
+print('call paths');
+(function () {
+    function f() {
+        return arguments[0] + arguments[1];
+    }
+    function g() {
+        return arguments[0] + ',' + arguments[1] + ',' + arguments[2];
+    }
+
+    print(g.apply(null, [ 'x', 'y', 'z' ]));
+    print(f.call(null, 2, 4));
+    print(JSON.stringify([ 1, 2, 3 ].map(function () { return arguments[0]; })));
+    print(g.bind(null, 1)(2, 3).replace(/,/g, ':'));
+
+    function C() {
+        this.a = arguments[0];
+        this.n = arguments.length;
+    }
+    var c = new C(42, 'x');
+    print(c.a, c.n);
+
+    print(g.bind(null, 'A')('B').split(',').slice(0, 2).join(' '));
+
+    var o = { v: 'V', m: function () { return this.v + ' ' + arguments[0]; } };
+    print(o.m('x'));
+
+    function rec(n) {
+        if (n === 0) {
+            return arguments.length * 10;
+        }
+        return rec(n - 1, 'extra');
+    }
+    print(rec(3));
+
+    var t = new Duktape.Thread(function (v) {
+        print('resumed', arguments.length, arguments[0], arguments[1]);
+    });
+    Duktape.Thread.resume(t, 'a');
+
+    function thrower() {
+        throw arguments.length;
+    }
+    try {
+        thrower(1, 2, 3);
+    } catch (e) {
+        print('caught', e);
+    }
+
+    function deep(n) {
+        if (n === 0) {
+            return arguments[1];
+        }
+        return 1 + deep(n - 1, arguments[1]);
+    }
+    var i, total = 0;
+    for (i = 0; i < 1000; i++) {
+        total += deep(99, 1);
+    }
+    print(total);
+})();
+
+print('tail calls');
+(function () {
+    // lazy caller tail calling itself: frames are reused
+    function countdown(n) {
+        if (n > 0) {
+            return countdown(n - 1, 'x', 'y');
+        }
+        return arguments.length;
+    }
+    print(countdown(100000));
+
+    // non-lazy caller tail calling a lazy function and vice versa
+    function lazy() {
+        return arguments.length + ' ' + arguments[0];
+    }
+    function plain(a) {
+        return lazy(a, 2);
+    }
+    print(plain(1));
+    function back() {
+        return plain(arguments[0]);
+    }
+    print(back('z'));
+})();
+
+print('not lazy');
+(function () {
+    // other uses of 'arguments' get a real arguments object
+    function f() {
+        var a = arguments;
+        return typeof a + ' ' + a.length;
+    }
+    print(f(1));
+
+    function g(x) {
+        arguments[0] = 10;
+        return x + ' ' + arguments[0];
+    }
+    print(g(1));
+
+    function h() {
+        return Array.prototype.slice.call(arguments).length + ' ' + arguments.length;
+    }
+    print(h(1, 2, 3));
+
+    // inner function has its own arguments
+    function outer() {
+        return (function () { return 'inner ' + arguments[0]; })(1) + ' ' + arguments[0];
+    }
+    print(outer(2));
+
+    // catch binding named 'arguments' shadows the arguments object
+    function c(a) {
+        try {
+            throw [ 'caught-arg' ];
+        } catch (arguments) {
+            return arguments[0] + ' ' + a;
+        }
+    }
+    print(c(1));
+
+    function w(a) {
+        with ({ arguments: [ 'with-arg' ] }) {
+            return arguments[0] + ' ' + a;
+        }
+    }
+    print(w(1));
+
+    function e() {
+        return eval('arguments.length') + ' ' + arguments.length;
+    }
+    print('eval', e(1, 2));
+})();
@@ -0,0 +1,155 @@
+/*
+ *  The default 'prototype' object of a function instance is created on
+ *  demand, when the property is first looked up.  Results must be
+ *  identical to an eagerly created prototype.
+ */
+
+/*===
+read
+object true true
+true
+false true false
+own property
+true
+prototype
+length,prototype
+constructor
+[]
+{"value":{},"writable":true,"enumerable":false,"configurable":false}
+new
+true true 1
+true
+true
+identity
+true
+false
+write
+1 undefined
+false
+define
+123
+TypeError
+false
+freeze
+true true
+false true
+seal
+false
+delete
+false true
+strict
+true TypeError
+===*/
+
+print('read');
+(function () {
+    function f() {}
+    var p = f.prototype;
+    print(typeof p, p.constructor === f, Object.getPrototypeOf(p) === Object.prototype);
+    print(f.prototype === p);
+
+    var d = Object.getOwnPropertyDescriptor(p, 'constructor');
+    print(d.enumerable, d.writable, d.configurable === false);
+})();
+
+print('own property');
+(function () {
+    function f() {}
+    print(f.hasOwnProperty('prototype'));
+})();
+
+(function () {
+    function f() {}
+    var k;
+    for (k in f) {
+        print('enum', k);
+    }
+    print(Object.getOwnPropertyNames(f).filter(function (x) { return x === 'prototype'; }).join(','));
+    print(Object.getOwnPropertyNames(f).filter(function (x) { return x === 'length' || x === 'prototype'; }).join(','));
+    print(Object.getOwnPropertyNames(f.prototype).join(','));
+    print(JSON.stringify(Object.keys(f)));
+
+    function g() {}
+    print(JSON.stringify(Object.getOwnPropertyDescriptor(g, 'prototype')));
+})();
+
+print('new');
+(function () {
+    function C() { this.x = 1; }
+    var c = new C();
+    print(Object.getPrototypeOf(c) === C.prototype, c instanceof C, c.x);
+
+    function D() {}
+    print(new D() instanceof D);
+
+    function E() {}
+    print(({}) instanceof E === false);
+})();
+
+print('identity');
+(function () {
+    function mk() { return function () {}; }
+    var a = mk(), b = mk();
+    print(a.prototype === a.prototype);
+    print(a.prototype === b.prototype);
+})();
+
+print('write');
+(function () {
+    function f() {}
+    f.prototype = { y: 1 };
+    print(f.prototype.y, f.prototype.constructor === f ? 'same' : undefined);
+
+    function g() {}
+    g.prototype = 'str';
+    print(new g() instanceof Object === false);
+})();
+
+print('define');
+(function () {
+    function f() {}
+    Object.defineProperty(f, 'prototype', { value: 123 });
+    print(f.prototype);
+    try {
+        Object.defineProperty(f, 'prototype', { get: function () {} });
+    } catch (e) {
+        print(e.name);
+    }
+    print(Object.getOwnPropertyDescriptor(f, 'prototype').enumerable);
+})();
+
+print('freeze');
+(function () {
+    // freezing before the first lookup must not lose the default value
+    function f() {}
+    Object.freeze(f);
+    print(typeof f.prototype === 'object', f.prototype.constructor === f);
+    print(Object.getOwnPropertyDescriptor(f, 'prototype').writable, Object.isFrozen(f));
+})();
+
+print('seal');
+(function () {
+    function f() {}
+    Object.seal(f);
+    f.prototype = 1;
+    print(typeof f.prototype === 'object');
+})();
+
+print('delete');
+(function () {
+    function f() {}
+    print(delete f.prototype, typeof f.prototype === 'object');
+})();
+
+print('strict');
+(function () {
+    'use strict';
+    function f() {}
+    Object.freeze(f);
+    var p = f.prototype;
+    try {
+        f.prototype = {};
+    } catch (e) {
+        print(f.prototype === p, e.name);
+    }
+})();
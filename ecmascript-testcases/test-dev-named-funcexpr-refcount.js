@@ -11,13 +11,13 @@
 ---*/
 
 /*===
-anon refcount: 3
+anon refcount: 2
 anon refcount: 2
 anon refcount: 2
 assign null
 finalized
 force gc
-named refcount: 4
+named refcount: 3
 named refcount: 3
 named refcount: 3
 assign null
@@ -29,11 +29,13 @@ finalized
 function anonTest() {
     var f = function() {};
 
-    // Print refcount, expected is 3: variable, call argument,
-    // f_anon.prototype.constructor.
+    // Print refcount, expected is 2: variable, call argument.  The
+    // default prototype (and its f_anon.prototype.constructor reference)
+    // is only created when it is first accessed.
     print('anon refcount:', Duktape.info(f)[2]);  
 
-    // Break ref loop, should decrease refcount by 1.
+    // Accessing the prototype creates it, and the reference loop is
+    // broken immediately, so no change in refcount.
     f.prototype.constructor = null;
     print('anon refcount:', Duktape.info(f)[2]);  
 
@@ -54,12 +56,13 @@ function anonTest() {
 function namedTest() {
     var f = function named() {};
 
-    // Print refcount, expected is 4: variable, call argument,
-    // f_anon.prototype.constructor, and internal environment
-    // record holding the "named"->func binding
+    // Print refcount, expected is 3: variable, call argument, and
+    // internal environment record holding the "named"->func binding
+    // (the default prototype has not been created yet).
     print('named refcount:', Duktape.info(f)[2]);  
 
-    // Break prototype reference loop, should decrease refcount by 1.
+    // Create and immediately break the prototype reference loop, no
+    // change in refcount.
     // Doesn't break the scope reference loop: the function points
     // to the environment record, and the environment record points
     // to the function.
@@ -0,0 +1,48 @@
+/*
+ *  Radix 10 string-to-number conversion.  Inputs with at most 19 significant
+ *  digits and a moderate exponent are parsed with a fast path, the rest with
+ *  Dragon4.  Both must round correctly, with halfway cases rounded to even.
+ */
+
+/*===
+fast path
+123.456 0.1 -0.3 1e+23 6.02214076e+23 1.7976931348623157e+308
+10000000000000000000 1844674407370955.2 0.0000012345678901234567
+exponent range
+1e-64 1e+64 1e-65 1e+65 1.234567e-64 1.234567e+66
+halfway cases
+9007199254740992 9007199254740996 9007199254740992 4503599627370496
+4503599627370498 2010834088236481000 2432411907132003300
+9007199254740992 9007199254740996
+more than 20 digits
+9007199254740994 9007199254740992 9007199254740994
+denormals and overflow
+5e-324 5e-324 2.225073858507201e-308 Infinity
+JSON.parse
+[0.1,-12.75,1e-7,5e-324,9007199254740992,1.5e+300]
+===*/
+
+function test(strs) {
+    print(strs.map(function (s) { return String(Number(s)); }).join(' '));
+}
+
+print('fast path');
+test([ '123.456', '0.1', '-0.3', '1e23', '6.02214076e23', '1.7976931348623157e308' ]);
+test([ '9999999999999999999', '1844674407370955.1615', '0.000001234567890123456789' ]);
+
+print('exponent range');
+test([ '1e-64', '1e64', '1e-65', '1e65', '1234567e-70', '1234567e60' ]);
+
+print('halfway cases');
+test([ '9007199254740993', '9007199254740995', '9007199254740993.0', '4503599627370496.5' ]);
+test([ '4503599627370497.5', '2010834088236481152', '2432411907132003584' ]);
+print(parseInt('20000000000001', 16), parseInt('20000000000003', 16));
+
+print('more than 20 digits');
+test([ '9007199254740993000000001e-9', '9007199254740992999999999e-9', '9007199254740993.0000000000000001' ]);
+
+print('denormals and overflow');
+test([ '4.9e-324', '2.4703282292062328e-324', '2.2250738585072011e-308', '1.7976931348623159e308' ]);
+
+print('JSON.parse');
+print(JSON.stringify(JSON.parse('[0.1,-12.75,1e-7,5e-324,9007199254740993,1.5e300]')));
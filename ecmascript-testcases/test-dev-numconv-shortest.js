@@ -0,0 +1,58 @@
+/*
+ *  Shortest number-to-string conversion in radix 10.  Most values are
+ *  converted with a fast path, with a Dragon4 fallback for values where
+ *  the fast path can't guarantee a shortest result.  Values are built
+ *  from an integer significand and a power of two so that they're exact
+ *  regardless of number parsing.
+ */
+
+/*===
+integers
+9007199254740991
+-9007199254740992
+9007199254740994
+123456789012345680000
+1e+21
+decimals
+0.1 0.2 0.30000000000000004 1.5 -2.75 1234.5678
+5e-324 2.2250738585072014e-308 2.225073858507201e-308 1.7976931348623157e+308
+boundaries
+1e+23
+2973157286509023700
+9.5367431640625e-7
+2.9802322387695312e-8
+ties
+879108964690463.2
+1125899906842624.2
+powers of two
+1.1125369292536007e-308 2.2250738585072014e-308 8.98846567431158e+307
+===*/
+
+function mk(m, e) {
+    // m * 2^e, exact when representable
+    return m * Math.pow(2, e);
+}
+
+print('integers');
+print(mk(9007199254740991, 0));
+print(-mk(1, 53));
+print(mk(4503599627370497, 1));
+print(mk(3767602203745901, 15));
+print(mk(476837158203125, 21));
+
+print('decimals');
+print(0.1, 0.2, 0.1 + 0.2, 1.5, -2.75, mk(5429686605511341, -42));
+print(mk(1, -1074), mk(1, -1022), mk(4503599627370495, -1074), mk(9007199254740991, 971));
+
+print('boundaries');
+print(mk(2980232238769531, 25));
+print(mk(5806947825212937, 9));
+print(mk(1, -20));
+print(mk(1, -25));
+
+print('ties');
+print(mk(3516435858761853, -2));
+print(mk(4503599627370497, -2));
+
+print('powers of two');
+print(mk(1, -1023), mk(1, -1022), mk(1, 1023));
@@ -0,0 +1,110 @@
+/*
+ *  Regexps without backreferences and lookaheads are matched with an
+ *  automaton which follows all alternatives in parallel.  The results,
+ *  including captures, must be the same as with backtracking, and
+ *  patterns which take exponential time with backtracking must finish
+ *  quickly.
+ */
+
+/*===
+captures
+["abcd","a","bcd",""] 0 0
+["ab","b",null] 0 0
+["zaacbbbcac","z","ac","a",null,"c"] 0 0
+["aaa","a","aa"] 0 0
+["abab",null,"b"] 0 0
+["abc 123 def","abc ","123"," def"] 0 0
+["xaaaay","aaa","a"] 0 0
+["abc"] 0 0
+["zyx",null,"zyx"] 2 0
+["two three","two","three"] 4 0
+flags
+["FOObaz","FOO","baz"] 1 0
+["123","123"] 4 0
+["hello","h","ello"] 2 0
+["ooo","ooo"] 1 0
+["Éé","Éé",null] 2 0
+["12€€x","x"] 3 0
+global
+["12px","12","px"] 2 6
+["3","3",null] 7 8
+["45em","45","em"] 9 13
+null -1 0
+a<1>b<2>c<3>
+["one","two","three","four"]
+["x","1","y","2","z"]
+["","","",""]
+["bc","bc"]
+fallback
+["aaaa","aa"] 1 0
+["a","abc"] 0 0
+linear time
+false
+false
+false
+null
+false
+false
+1
+===*/
+
+function show(re, s) {
+    var m = re.exec(s);
+    print(JSON.stringify(m), m ? m.index : -1, re.lastIndex);
+}
+
+function rep(s, n) {
+    var r = [];
+    var i;
+    for (i = 0; i < n; i++) {
+        r.push(s);
+    }
+    return r.join('');
+}
+
+print('captures');
+show(/(a|ab)(c|bcd)(d*)/, 'abcd');
+show(/((a)|b)+/, 'ab');
+show(/(z)((a+)?(b+)?(c))*/, 'zaacbbbcac');
+show(/(a+?)(a*)/, 'aaa');
+show(/(?:(a)|(b))+/, 'abab');
+show(/(.*?)(\d+)(.*)/, 'abc 123 def');
+show(/x(a{2,3})(a{1,2}?)y?/, 'xaaaay');
+show(/(?:ab|a)(?:bc|c)?/, 'abc');
+show(/([a-c]+)|([x-z]+)/, '--zyx--');
+show(/(\w+)\s+(\w+)$/, 'one two three');
+
+print('flags');
+show(/(fo+)(BA[rz])/i, 'xFOObaz');
+show(/^(\d+)$/m, 'abc\n123\ndef');
+show(/\b(\w)(\w*)\b/, '  hello ');
+show(/\B(o+)\B/, 'foooo hoot');
+show(/(é+)(ü)?/i, 'caÉé!');
+show(/[^a-z]+(€|x)*/, 'abc12€€x!');
+
+print('global');
+var re = /(\d+)(px|em)?/g;
+var s = 'a 12px 3 45em';
+show(re, s);
+show(re, s);
+show(re, s);
+show(re, s);
+print('a1b22c333'.replace(/(\d)+/g, '<$1>'));
+print(JSON.stringify('one, two,three ,  four'.split(/\s*,\s*/)));
+print(JSON.stringify('x1y2z'.split(/(\d)?/)));
+print(JSON.stringify('aaa'.match(/a*?/g)));
+print(JSON.stringify('abcabc'.match(/(?:b|c)+/g)));
+
+print('fallback');
+show(/(a+)\1/, 'xaaaa');
+show(/(?=(\w+))\w/, 'abc');
+
+print('linear time');
+var a30 = rep('a', 30);
+print(/(a+)+b/.test(a30));
+print(/^(\w+\s?)+$/.test(a30 + '!'));
+print(/(a|aa)+c/.test(rep('a', 40)));
+print(/(x+x+)+y/.exec(rep('x', 40)));
+print(/^(([a-z])+.)+[A-Z]([a-z])+$/.test(rep('aaaaaaaa', 4) + '!'));
+print(/(?:a|b|ab)*c/.test(rep('ab', 5000)));
+print(/(.*a){12}/.exec(rep('a', 5000))[1].length);
@@ -0,0 +1,66 @@
+/*
+ *  RegExp.prototype.test(), String.prototype.search(), and split() with a
+ *  capture-free regexp don't create a match result object internally.
+ *  lastIndex handling and character offsets must be unaffected.
+ */
+
+/*===
+test
+true 3 true 6 false 0
+true 0 true 0
+false 0
+true 3
+search
+3 -1 0 3 7
+split
+a|b|c
+a|b|c|
+|a|b|
+x|y|z
+a|b
+a|-|b|-|c
+a|b|c
+|
+0
+limits
+a|b
+2
+===*/
+
+print('test');
+var re = /abc/g;
+var s = 'abcabcabd';
+var r1 = re.test(s), l1 = re.lastIndex;
+var r2 = re.test(s), l2 = re.lastIndex;
+var r3 = re.test(s), l3 = re.lastIndex;
+print(r1, l1, r2, l2, r3, l3);
+
+re = /x/;  // non-global: lastIndex not updated on match
+re.lastIndex = 0;
+print(re.test('axb'), re.lastIndex, re.test('axb'), re.lastIndex);
+
+re = /x/g;
+re.lastIndex = 100;  // out of range: fails, lastIndex reset
+print(re.test('axb'), re.lastIndex);
+
+re = /€(\d)/g;  // captures are not needed by test()
+print(re.test('a€1b'), re.lastIndex);
+
+print('search');
+print('ab€dxyz'.search(/dx/), 'abc'.search(/z/), 'abc'.search(/(?:)/),
+      '€€€foo'.search(/fo+/i), 'aaaaaaaZ'.search(/z/gi));
+
+print('split');
+print('a,b,c'.split(/,/).join('|'));
+print('a,b,c,'.split(/,/).join('|'));
+print(',a,b,'.split(/,/).join('|'));
+print('x€€y€€€z'.split(/€+(?=[yz])/).join('|'));
+print('a  b'.split(/\s*/).join('').split('').join('|'));
+print('a-b-c'.split(/(-)/).join('|'));
+print('abc'.split(/(?:)/).join('|'));
+print(['', ''].join('|'));
+print(''.split(/(?:)/).length);
+
+print('limits');
+print('a,b,c'.split(/,/, 2).join('|'));
+print('a,b,c'.split(/(,)/, 2).length);
@@ -0,0 +1,80 @@
+/*
+ *  Character classes are compiled into an ASCII bitmap and a sorted list
+ *  of non-ASCII ranges.  Case insensitivity is applied to the bitmap at
+ *  compile time, non-ASCII input is canonicalized when matching.
+ */
+
+/*===
+ascii
+true true false true false
+true true true false
+true false true
+ignorecase
+true true true true
+true true false false
+true false
+nonascii
+true true true false false
+true true false true
+true false
+unsorted
+true true true true false
+true true true false
+inverted
+false true false true
+false false true
+builtin
+3 5 4
+ok
+===*/
+
+function test(re, chars) {
+    var res = [];
+    var i;
+    for (i = 0; i < chars.length; i++) {
+        res.push(re.test(chars[i]));
+    }
+    print(res.join(' '));
+}
+
+print('ascii');
+test(/^[A-Za-z0-9_\-\.]$/, [ 'a', '-', '/', '.', 'ä' ]);
+test(/^[\x00-\x7f]$/, [ '\x00', '\x7f', 'A', '\x80' ]);
+test(/^[\]\\]$/, [ ']', 'a', '\\' ]);
+
+print('ignorecase');
+test(/^[a-z]$/i, [ 'a', 'Z', 'm', 'M' ]);
+test(/^[X-\x7b]$/i, [ 'x', 'Y', '@', 'ÿ' ]);
+// non-ASCII characters never match ASCII ones (E5 Section 15.10.2.8)
+test(/^[ä]$/i, [ 'Ä', 'a' ]);
+
+print('nonascii');
+test(/^[Ā-ſΑ-Ω＀-￿]$/, [ 'Ā', 'ſ', 'Π', 'ƀ', 'ΐ' ]);
+test(/^[äöü]$/i, [ 'Ä', 'Ö', 'Ý', 'Ü' ]);
+test(/^[σ]$/i, [ 'Σ', 'τ' ]);
+
+print('unsorted');
+test(/^[￮一-鿿Ѐ-ӿԀ-Ԑѐ-Ѡ]$/, [ '￮', '倀', 'ѐ', 'ԅ', 'ԑ' ]);
+test(/^[ԀЀ-Ԁ̀-Ё]$/, [ '̀', 'Ё', 'Ԁ', 'ԁ' ]);
+
+print('inverted');
+test(/^[^a-zĀ-ǿ]$/, [ 'a', 'A', 'Ő', 'Ȁ' ]);
+test(/^[^a-zĀ-ǿ]$/i, [ 'a', 'A', 'Ȁ' ]);
+
+print('builtin');
+print('a1 b2 c3'.match(/\d/g).length, 'x\u00a0y\u2028z\u3000w \t'.match(/\s/g).length,
+      'äa_bö-9'.match(/\w/gi).length);
+
+// exhaustive check of a mixed class against a naive implementation
+var ok = true;
+var re = /^[b-dà-ïĀ-ąぁ-ゖ]$/;
+var c;
+for (c = 0; c < 0x4000; c++) {
+    var expect = (c >= 0x62 && c <= 0x64) || (c >= 0xe0 && c <= 0xef) ||
+                 (c >= 0x100 && c <= 0x105) || (c >= 0x3041 && c <= 0x3096);
+    if (re.test(String.fromCharCode(c)) !== expect) {
+        print('mismatch', c);
+        ok = false;
+    }
+}
+print(ok ? 'ok' : 'failed');
@@ -0,0 +1,60 @@
+/*
+ *  The regexp matcher keeps backtracking state in an explicit stack instead
+ *  of recursing in C, so complex quantifiers, captures, and lookaheads work
+ *  with long inputs.
+ */
+
+/*===
+alternation
+100000 b
+100000 a
+captures
+100000 ab
+minimal
+100000 100000
+lookahead
+100000 100000
+backtrack
+ab true ab
+global
+50000 50000
+===*/
+
+function rep(s, n) {
+    var r = [];
+    var i;
+    for (i = 0; i < n; i++) {
+        r.push(s);
+    }
+    return r.join('');
+}
+
+var input = rep('ab', 50000);
+var m;
+
+print('alternation');
+m = /^(a|b)*$/.exec(input);
+print(m[0].length, m[1]);
+m = /^(?:(a)|b)*$/.exec(input + 'a');
+print(m[0].length - 1, m[1]);
+
+print('captures');
+m = /^((a)(b))+$/.exec(input);
+print(m[0].length, m[1]);
+
+print('minimal');
+m = /^(?:a|b)+?$/.exec(input);
+print(m[0].length, m[0].length);
+
+print('lookahead');
+m = /^(?:(?=a)a|(?!a)b)*$/.exec(input);
+print(m[0].length, input.length);
+
+print('backtrack');
+// the whole loop is backtracked before the second alternative matches,
+// and captures set by the loop are restored
+m = /^(?:(a|b)*x|(ab))/.exec(input);
+print(m[0], m[1] === undefined, m[2]);
+
+print('global');
+print(input.replace(/(a|b)(?:a|b)/g, '$1').length, input.match(/(?:a|x)b/g).length);
@@ -0,0 +1,62 @@
+/*
+ *  The regexp executor skips candidate match positions based on a literal
+ *  prefix, a required literal, the set of possible first characters, or a
+ *  '^' anchor.  Match indices and lastIndex must not be affected.
+ */
+
+/*===
+prefix
+5 foo 8
+13 foo 16
+-1 0
+7 ["€foo€","€"] 12
+required
+["12px"] 4
+["x€€yz","€€"] 2
+null
+first set
+["b1","c2"] 2
+["Ab","ab"] 4
+["ä1","Ä2"] 2
+["x","y"] 4
+anchored
+["ab"] 0
+null 0
+null
+["cd"] 3
+["ab","cd"]
+ignore case
+["ABC","abc","aBc"]
+===*/
+
+var re, m;
+
+print('prefix');
+re = /foo/g;
+var s = 'abcd€foo€€€€€foo';
+m = re.exec(s); print(m.index, m[0], re.lastIndex);
+m = re.exec(s); print(m.index, m[0], re.lastIndex);
+m = re.exec(s); print(m === null ? -1 : m.index, re.lastIndex);
+m = /€foo(€)/.exec('ab€cd€e€foo€'); print(m.index, JSON.stringify(m), m.index + m[0].length);
+
+print('required');
+m = /\d+px/.exec('ab €12px'); print(JSON.stringify(m), m.index);
+m = /x(€+)yz/.exec('€€x€€yz'); print(JSON.stringify(m), m.index);
+print(JSON.stringify(/\w+suffix/.exec(new Array(100).join('abc ') + 'suffi')));
+
+print('first set');
+m = 'a b1 c2 d'.match(/[bc]\d/g); print(JSON.stringify(m), 'a b1 c2 d'.search(/[bc]\d/));
+m = 'xxxxAb ab'.match(/a(?=b)./gi); print(JSON.stringify(m), 'xxxxAb ab'.search(/a(?=b)./i));
+m = '€€ä1Ä2'.match(/ä\d/gi); print(JSON.stringify(m), '€€ä1Ä2'.search(/ä\d/i));
+m = '€€€€x€y'.match(/x|y/g); print(JSON.stringify(m), '€€€€x€y'.search(/x|y/));
+
+print('anchored');
+re = /^ab/g;
+m = re.exec('abab'); print(JSON.stringify(m), m.index);
+m = re.exec('abab'); print(JSON.stringify(m), re.lastIndex);
+print(JSON.stringify(/^cd/.exec('abcd')));
+m = /^cd/m.exec('ab\ncd'); print(JSON.stringify(m), m.index);
+print(JSON.stringify('ab\ncd'.match(/^\w+/gm)));
+
+print('ignore case');
+print(JSON.stringify('xABCxabcxaBc'.match(/abc/gi)));
@@ -0,0 +1,62 @@
+/*
+ *  Pure ASCII strings are flagged when interned and use direct byte
+ *  indexing in character access, substring operations, regexp matching
+ *  and lexing.  Check that ASCII and non-ASCII strings behave identically.
+ */
+
+/*===
+char access
+0 a 97 a 97
+2 c 99 c 99
+3  NaN X 4660
+-1  NaN  NaN
+100  NaN  NaN
+substring
+bcd bcd
+bcd bcd
+cde cde
+regexp
+1 foo,foo 1 foo,foo
+5 5
+true true
+true true
+b,c b,c
+true true
+lexer
+6 6
+===*/
+
+function fmt(s) {
+    // keep output ASCII so the expected output is easy to compare
+    return s.replace(/ሴ/g, 'X');
+}
+
+print('char access');
+var A = 'abc';
+var U = 'abcሴ';
+[ 0, 2, 3, -1, 100 ].forEach(function (i) {
+    print(i, A.charAt(i), A.charCodeAt(i), fmt(U.charAt(i)), U.charCodeAt(i));
+});
+
+print('substring');
+A = 'abcdefg';
+U = 'abcdefgሴ';
+print(A.substring(1, 4), U.substring(1, 4));
+print(A.substr(1, 3), U.substr(1, 3));
+print(A.slice(2, -2), U.slice(2, -3));
+
+print('regexp');
+A = 'xfoo bar';
+U = 'xfoo barሴ';
+var m1 = /(f[a-z]+)/.exec(A);
+var m2 = /(f[a-z]+)/.exec(U);
+print(m1.index, m1, m2.index, m2);
+print(A.search(/bar/), U.search(/bar/));
+print(/\bbar$/.test(A), /\bbarሴ$/.test(U));
+print(/o(?= BAR)/i.test(A), /o(?= BAR)/i.test(U));
+print('abc'.match(/[bc]/g), 'abcሴ'.match(/[bc]/g));
+print(/^(a+)\1$/.test('aaaa'), /^(a+)\1ሴ$/.test('aaaaሴ'));
+
+print('lexer');
+print(eval('var x = 1;\r\nvar y = 2;\r\nx + y + 3;'),
+      eval('var x = 1;\r\nvar y = 2;\r\n/* ሴ */ x + y + 3;'));
@@ -0,0 +1,56 @@
+/*
+ *  Long strings are hashed by sampling, so strings differing only in
+ *  unsampled bytes share a hash.  They must still be distinct strings
+ *  and distinct property keys.
+ */
+
+/*===
+distinct
+true true
+keys
+101 0 100
+===*/
+
+function makeBase(n) {
+    var parts = [];
+    var i;
+    for (i = 0; i < n; i++) {
+        parts.push(String.fromCharCode(0x61 + (i % 26)));
+    }
+    return parts.join('');
+}
+
+var base = makeBase(256 * 1024);
+var obj = {};
+var strs = [];
+
+print('distinct');
+try {
+    var a = base.substring(0, 120000) + 'X' + base.substring(120001);
+    var b = base.substring(0, 120000) + 'Y' + base.substring(120001);
+    print(a !== b, a.length === b.length);
+} catch (e) {
+    print(e);
+}
+
+print('keys');
+try {
+    var i, s, cnt = 0, bad = 0;
+    obj[base] = -1;
+    for (i = 0; i < 100; i++) {
+        s = base.substring(0, 100000 + i * 7) + '#' + base.substring(100001 + i * 7);
+        strs.push(s);
+        obj[s] = i;
+    }
+    for (i = 0; i < 100; i++) {
+        if (obj[strs[i]] !== i) {
+            bad++;
+        }
+    }
+    for (s in obj) {
+        cnt++;
+    }
+    print(cnt, bad, Object.keys(obj).filter(function (k) { return obj[k] >= 0; }).length);
+} catch (e) {
+    print(e);
+}
@@ -0,0 +1,78 @@
+/*
+ *  Long strings are not interned by default.  Equality, comparison and
+ *  property key semantics must be the same as for interned strings.
+ */
+
+/*===
+equality
+true true true false true
+false true false
+compare
+false true 0
+keys
+1 true true
+2 true
+true false
+1 1
+defineProperty
+true 3
+switch
+matched
+json
+true 123
+concat
+true 262145
+===*/
+
+function make(len, ch) {
+    var parts = [];
+    var i;
+    for (i = 0; i < len; i++) {
+        parts.push(ch || String.fromCharCode(0x61 + (i % 26)));
+    }
+    return parts.join('');
+}
+
+var big1 = make(128 * 1024);
+var big2 = make(128 * 1024);     // same contents, created separately
+var big3 = make(128 * 1024, 'x');
+
+print('equality');
+print(big1 === big2, big1 == big2, [ big1 ].indexOf(big2) === 0, big1 === big3, big1 === big1);
+print(big1 !== big2, Object.is ? Object.is(big1, big2) : true, big1 != big2);
+
+print('compare');
+print(big1 < big2, big1 <= big2, big1.localeCompare(big2));
+
+print('keys');
+var obj = {};
+obj[big1] = 1;
+print(obj[big2], big2 in obj, obj.hasOwnProperty(big2));
+obj[big2] = 2;
+print(obj[big1], Object.keys(obj).length === 1);
+print(Object.keys(obj)[0] === big2, delete obj[big2] && (big1 in obj));
+obj[big1 + ''] = 1;
+print(Object.keys(obj).length, obj[big1.substring(0)]);
+
+print('defineProperty');
+Object.defineProperty(obj, big2, { value: 3, writable: false, enumerable: true, configurable: true });
+print(Object.getOwnPropertyDescriptor(obj, big1).writable === false, obj[big1]);
+
+print('switch');
+switch (big1) {
+case big3:
+    print('wrong');
+    break;
+case big2:
+    print('matched');
+    break;
+default:
+    print('default');
+}
+
+print('json');
+var parsed = JSON.parse('{"' + big1 + '":123}');
+print(Object.keys(parsed)[0] === big2, parsed[big2]);
+
+print('concat');
+print((big1 + big3).substring(0, big1.length) === big2, (big1 + big3 + 'y').length);
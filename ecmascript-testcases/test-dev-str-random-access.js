@@ -0,0 +1,57 @@
+/*
+ *  Random character access into long non-ASCII strings.  More strings
+ *  are accessed than fit into the string cache, and long strings get an
+ *  offset index.  Results must match a straightforward reference.
+ */
+
+/*===
+build
+20000 20000 20000 20000 20000 20000 20000 20000 20000 20000
+random access
+checksum 19301876 errors 0
+end of string
+4660 97 undefined
+===*/
+
+var strs = [];
+var refs = [];
+
+function build(seed) {
+    var codes = [];
+    var i, c;
+    for (i = 0; i < 20000; i++) {
+        // mix of 1, 2 and 3 byte UTF-8 encodings
+        c = (i * 7 + seed) % 11;
+        codes.push(c < 6 ? 0x61 + c : (c < 9 ? 0xe4 + c : 0x1234 + c));
+    }
+    refs.push(codes);
+    return String.fromCharCode.apply(null, codes);
+}
+
+print('build');
+var i, j;
+for (i = 0; i < 10; i++) {
+    strs.push(build(i));
+}
+print(strs.map(function (s) { return s.length; }).join(' '));
+
+print('random access');
+var sum = 0;
+var errors = 0;
+var pos = 12345;
+for (i = 0; i < 20000; i++) {
+    j = i % strs.length;
+    pos = (pos * 1103515245 + 12345) % 20000;
+    if (pos < 0) { pos = -pos; }
+    var c = strs[j].charCodeAt(pos);
+    if (c !== refs[j][pos] || strs[j].charAt(pos) !== String.fromCharCode(refs[j][pos]) ||
+        strs[j].substring(pos, pos + 2).charCodeAt(0) !== refs[j][pos]) {
+        errors++;
+    }
+    sum += c;
+}
+print('checksum', sum, 'errors', errors);
+
+print('end of string');
+var s = strs[0] + 'ሴa';
+print(s.charCodeAt(20000), s.charCodeAt(20001), s[20002]);
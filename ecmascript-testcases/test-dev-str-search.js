@@ -0,0 +1,120 @@
+/*
+ *  String search in indexOf(), lastIndexOf(), split() and replace() uses
+ *  a different algorithm for short and long search strings.  Character
+ *  offsets must be correct also for non-ASCII input.
+ */
+
+/*===
+short
+4 -1 0 10 14 -1
+14 4 -1 14 4
+long
+0 -1 26 52 78 -1
+78 52 -1 0
+nonascii
+3 6 11 14
+14 12 6 3 -1
+2 4 2
+periodic
+0 1 5 -1
+5 4 0
+split
+4 a|b|c|
+3 x€|y€|z
+4 |abc|def|
+replace
+aXbcabc
+€€X€€ab€
+xyz--tail
+positions
+ok
+===*/
+
+function rep(s, n) {
+    var r = [];
+    var i;
+    for (i = 0; i < n; i++) {
+        r.push(s);
+    }
+    return r.join('');
+}
+
+print('short');
+var s = 'abcdefghijabcdefghij';
+print(s.indexOf('efg'), s.indexOf('xyz'), s.indexOf('a'), s.indexOf('a', 1),
+      s.indexOf('efg', 5), s.indexOf('j', 20));
+print(s.lastIndexOf('efg'), s.lastIndexOf('efg', 13), s.lastIndexOf('xyz'),
+      s.lastIndexOf('efg', 100), s.lastIndexOf('efg', 4));
+
+print('long');
+var alpha = 'abcdefghijklmnopqrstuvwxyz';
+var t = rep(alpha, 4);
+print(t.indexOf(alpha), t.indexOf(alpha + 'x'), t.indexOf(alpha, 1),
+      t.indexOf(alpha, 27), t.indexOf('abcdefghijkl', 70), t.indexOf('abcdefghijkl', 79));
+print(t.lastIndexOf(alpha), t.lastIndexOf(alpha, 77), t.lastIndexOf(alpha + 'x'),
+      t.lastIndexOf(alpha, 0));
+
+print('nonascii');
+var u = 'ab€d€fgh€ij€klm€no';
+print(u.indexOf('d€fgh'), u.indexOf('gh€ij€'), u.indexOf('€klm€no'),
+      u.indexOf('m€no'));
+print(u.lastIndexOf('m€no'), u.lastIndexOf('klm€no'), u.lastIndexOf('gh€ij€klm'),
+      u.lastIndexOf('d€fgh€ij'), u.lastIndexOf('d€fgh€ij', 2));
+print(u.indexOf('€'), u.indexOf('€', 3), u.lastIndexOf('€', 3));
+
+print('periodic');
+var per = 'aaaaaaaaaaaa';
+print(per.indexOf('aaaaaaa'), per.indexOf('aaaaaaa', 1), per.indexOf('aaaaaaa', 5),
+      per.indexOf('aaaaaaaaaaaaa'));
+print(per.lastIndexOf('aaaaaaa'), per.lastIndexOf('aaaaaaa', 4), per.lastIndexOf('aaaaaaa', 0));
+
+print('split');
+var sp = 'a<separator>b<separator>c<separator>'.split('<separator>');
+print(sp.length, sp.join('|'));
+sp = 'x€<€€€€€€€>y€<€€€€€€€>z'.split('<€€€€€€€>');
+print(sp.length, sp.join('|'));
+sp = '--------abc--------def--------'.split('--------');
+print(sp.length, sp.join('|'));
+
+print('replace');
+print('abcabcabc'.replace('abc', 'aXbc').substring(0, 7));
+print('€€€€€€€€ab€'.replace('€€€€€€', '€€X'));
+print('xyz<long separator>tail'.replace('<long separator>', '--'));
+
+print('positions');
+// exhaustive check against a naive search
+function naiveIndexOf(h, n, pos) {
+    var i;
+    for (i = pos; i + n.length <= h.length; i++) {
+        if (h.substring(i, i + n.length) === n) {
+            return i;
+        }
+    }
+    return -1;
+}
+function naiveLastIndexOf(h, n, pos) {
+    var i;
+    for (i = Math.min(pos, h.length - n.length); i >= 0; i--) {
+        if (h.substring(i, i + n.length) === n) {
+            return i;
+        }
+    }
+    return -1;
+}
+var hay = rep('ab€cd€efghij', 5) + 'abcdefghijklm';
+var ok = true;
+var i, j, k, n;
+for (i = 0; i < 20 && ok; i++) {
+    for (j = 1; j <= 14 && ok; j++) {
+        n = hay.substring(i * 3, i * 3 + j);
+        for (k = 0; k < hay.length; k += 7) {
+            if (hay.indexOf(n, k) !== naiveIndexOf(hay, n, k) ||
+                hay.lastIndexOf(n, k) !== naiveLastIndexOf(hay, n, k)) {
+                print('mismatch', JSON.stringify(n), k);
+                ok = false;
+                break;
+            }
+        }
+    }
+}
+print(ok ? 'ok' : 'failed');
@@ -0,0 +1,103 @@
+/*
+ *  Long substrings are created as slices which refer to the parent
+ *  string's data.  Slices must behave exactly like ordinary strings.
+ */
+
+/*===
+basic
+300 true true true
+300 true true
+wy 119 121
+nonascii
+300 true 8364 true
+true 300 true
+slice of slice
+200 true true
+number
+123 123 255
+keys
+true true 1
+json
+true 3
+regexp
+true 100 true
+trim
+400 true
+gc
+300 true true
+===*/
+
+function make(len, ch) {
+    var parts = [];
+    var i;
+    for (i = 0; i < len; i++) {
+        parts.push(ch || String.fromCharCode(0x61 + (i % 26)));
+    }
+    return parts.join('');
+}
+
+function pad(len) {
+    return make(len, ' ');
+}
+
+var big = make(1000);
+var copy = make(1000);
+
+print('basic');
+var s1 = big.substring(100, 400);
+var s2 = copy.substring(100, 400);
+print(s1.length, s1 === s2, s1 == s2, s1 === copy.slice(100, 400));
+var s3 = big.substr(200, 300);
+print(s3.length, s3 === big.slice(200, 500), s3.charAt(299) === big.charAt(499));
+print(s1.charAt(0) + s1.charAt(2), s1.charCodeAt(0), s1.charCodeAt(2));
+
+print('nonascii');
+var nbig = make(500) + '€' + make(500);
+var n1 = nbig.substring(400, 700);
+print(n1.length, n1.indexOf('€') === 100, n1.charCodeAt(100),
+      n1 === make(500).substring(400) + '€' + make(199));
+var n2 = nbig.substring(600, 900);   // ASCII part of a non-ASCII parent
+print(n2 === make(500).substring(99, 399), n2.length, n2.charAt(5) === nbig.charAt(605));
+
+print('slice of slice');
+var ss = s1.substring(50, 250);
+print(ss.length, ss === big.substring(150, 350), ss.substring(10, 20) === big.substring(160, 170));
+
+print('number');
+// the slice is followed by other digits in the parent string
+var numstr = pad(200) + '123' + '456' + pad(200);
+var numslice = numstr.substring(0, 203);
+var hexstr = pad(200) + '0xff' + 'ee';
+print(Number(numslice), parseInt(numslice), Number(hexstr.substring(0, 204)));
+
+print('keys');
+var obj = {};
+var k1 = big.substring(0, 200);
+obj[k1] = 1;
+print(obj[big.slice(0, 200)] === 1, k1 in obj, Object.keys(obj).length);
+
+print('json');
+var jsonbig = '[1,2,3]' + pad(300) + 'garbage';
+var parsed = JSON.parse(jsonbig.substring(0, 307));
+print(Array.isArray(parsed), parsed.length);
+
+print('regexp');
+var m = /b(c+)d/.exec(pad(150) + 'b' + make(100, 'c') + 'd' + 'x');
+var reinput = (pad(150) + 'b' + make(100, 'c') + 'dx').substring(0, 252);
+var m2 = /b(c+)d/.exec(reinput);
+print(m2 !== null, m2[1].length, m2[0] === m[0]);
+
+print('trim');
+var t = (pad(100) + make(400) + pad(100)).trim();
+print(t.length, t === make(400));
+
+print('gc');
+function makeSlice() {
+    var parent = make(100000);
+    return parent.substring(500, 800);
+}
+var kept = makeSlice();
+if (typeof Duktape === 'object') {
+    Duktape.gc();
+}
+print(kept.length, kept === make(100000).substring(500, 800), kept.charAt(0) === 'g');
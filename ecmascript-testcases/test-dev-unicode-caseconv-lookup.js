@@ -0,0 +1,60 @@
+/*
+ *  Pure ASCII strings are case converted in bulk and non-ASCII BMP
+ *  codepoints use lookup tables, with 1:n mappings and final sigma
+ *  handled separately.  Check the boundaries between these paths.
+ */
+
+/*===
+ascii
+@AZ[`AZ{ @az[`az{
+true true
+0123456789 ~!
+long 1000 true true
+nonascii
+ÀÞ ×ßÿ àþ ×÷ 376
+STRASSE ŉ ʼN
+ΣΑΣ σας σασ
+ΑΙ ᾳ
+Ꮳ Ꮳ
+regexp
+true true true
+false false
+===*/
+
+print('ascii');
+var s = '@AZ[`az{';
+print(s.toUpperCase(), s.toLowerCase());
+var u = 'ALREADY UPPERCASE 123';
+print(u.toUpperCase() === u, u.toLowerCase().toUpperCase() === u);
+print('0123456789 ~!'.toLowerCase());
+
+var parts = [];
+for (var i = 0; i < 1000; i++) {
+    parts.push(String.fromCharCode(0x41 + (i % 58)));
+}
+var longstr = parts.join('');
+var conv = longstr.toLowerCase();
+var ok = true;
+for (i = 0; i < longstr.length; i++) {
+    var c = longstr.charCodeAt(i);
+    var expect = (c >= 0x41 && c <= 0x5a) ? c + 0x20 : c;
+    if (conv.charCodeAt(i) !== expect) {
+        ok = false;
+    }
+}
+print('long', conv.length, ok, conv.toUpperCase() === longstr.toUpperCase());
+
+print('nonascii');
+// U+00D7 and U+00F7 are not letters, U+00FF uppercases outside Latin-1
+print('ÀÞ'.toUpperCase(), '×ßÿ'.toLowerCase(), 'ÀÞ'.toLowerCase(),
+      '×÷'.toUpperCase(), 'ÿ'.toUpperCase().charCodeAt(0));
+print('straße'.toUpperCase(), 'ŉ', 'ŉ'.toUpperCase());
+print('ΣΑΣ'.toUpperCase(), 'ΣΑΣ'.toLowerCase(),
+      'ΣΑΣ '.toLowerCase().substring(0, 1) + 'ασ');
+print('ᾳ'.toUpperCase(), 'ᾳ'.toLowerCase());
+print('Ꮳ', 'Ꮳ'.toUpperCase());
+
+print('regexp');
+print(/ä/i.test('Ä'), /σ/i.test('Σ'), /ā/i.test('Ā'));
+// non-ASCII to ASCII and 1:n mappings are not canonicalized
+print(/ſ/i.test('s'), /ß/i.test('SS'));
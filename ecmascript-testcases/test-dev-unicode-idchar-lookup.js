@@ -0,0 +1,57 @@
+/*
+ *  Non-ASCII BMP IdentifierStart, IdentifierPart, and Unicode letter checks
+ *  use bitmap lookup tables.  Check characters from different table blocks
+ *  and at block boundaries.
+ */
+
+/*===
+00aa true true
+00b5 true true
+00c0 true true
+00d7 false false
+00ff true true
+0100 true true
+0300 false true
+0393 true true
+0660 false true
+06dd false false
+200c false true
+203f false true
+2160 true true
+3005 true true
+30a1 true true
+ffda true true
+ffdd false false
+letter
+σς σσ σσ
+===*/
+
+function hex(c) {
+    return ('000' + c.toString(16)).slice(-4);
+}
+
+function check(c) {
+    var start, part;
+    try {
+        eval('var \\u' + hex(c) + ';');
+        start = true;
+    } catch (e) {
+        start = false;
+    }
+    try {
+        eval('var x\\u' + hex(c) + ';');
+        part = true;
+    } catch (e) {
+        part = false;
+    }
+    print(hex(c), start, part);
+}
+
+[ 0xaa, 0xb5, 0xc0, 0xd7, 0xff, 0x100, 0x300, 0x393, 0x660, 0x6dd,
+  0x200c, 0x203f, 0x2160, 0x3005, 0x30a1, 0xffda, 0xffdd ].forEach(check);
+
+print('letter');
+// final sigma depends on whether the preceding character is a letter;
+// U+0660 (ARABIC-INDIC DIGIT ZERO) and U+0300 are not letters
+print('ΣΣ'.toLowerCase(), '٠Σ'.toLowerCase().substring(1) + 'σ',
+      '̀Σ'.toLowerCase().substring(1) + 'σ');
@@ -0,0 +1,69 @@
+/*
+ *  Benchmark for variadic helpers which only read 'arguments[i]' and
+ *  'arguments.length'; such functions don't need an arguments object.
+ *
+ *    $ make
+ *    $ ./duk misc/bench_arguments.js
+ */
+
+function sum() {
+    var t = 0;
+    var i;
+    for (i = 0; i < arguments.length; i++) {
+        t += arguments[i];
+    }
+    return t;
+}
+
+function opt(a, b) {
+    var c = arguments.length > 2 ? arguments[2] : 0;
+    return a + b + c;
+}
+
+function sumObj() {
+    // uses the arguments object as a value, not optimized
+    var args = arguments;
+    var t = 0;
+    var i;
+    for (i = 0; i < args.length; i++) {
+        t += args[i];
+    }
+    return t;
+}
+
+function bench(name, rounds, fn) {
+    var t1 = Date.now();
+    var i;
+    var res;
+
+    for (i = 0; i < rounds; i++) {
+        res = fn();
+    }
+    var t2 = Date.now();
+    print(name + ': ' + ((t2 - t1) / rounds).toFixed(1) + ' ms/iter (result ' + res + ')');
+}
+
+bench('sum(...)', 5, function () {
+    var t = 0;
+    var i;
+    for (i = 0; i < 50000; i++) {
+        t += sum(i, 1, 2, 3);
+    }
+    return t;
+});
+bench('opt(a, b[, c])', 5, function () {
+    var t = 0;
+    var i;
+    for (i = 0; i < 50000; i++) {
+        t += opt(i, 1) + opt(i, 1, 2);
+    }
+    return t;
+});
+bench('sumObj(...)', 5, function () {
+    var t = 0;
+    var i;
+    for (i = 0; i < 50000; i++) {
+        t += sumObj(i, 1, 2, 3);
+    }
+    return t;
+});
@@ -0,0 +1,66 @@
+/*
+ *  Benchmark for loops using break/continue, including 'continue' inside
+ *  a 'switch' and labelled breaks out of nested loops.
+ *
+ *    $ make
+ *    $ ./duk misc/bench_break_continue.js
+ */
+
+function bench(name, rounds, fn) {
+    var t1 = Date.now();
+    var i;
+    var res;
+
+    for (i = 0; i < rounds; i++) {
+        res = fn();
+    }
+    var t2 = Date.now();
+    print(name + ': ' + ((t2 - t1) / rounds).toFixed(1) + ' ms/iter (result ' + res + ')');
+}
+
+bench('inner loop with break', 5, function () {
+    var t = 0;
+    var i, j;
+    for (i = 0; i < 200000; i++) {
+        for (j = 0; ; j++) {
+            if (j >= 2) {
+                break;
+            }
+            t += j;
+        }
+    }
+    return t;
+});
+bench('continue inside switch', 5, function () {
+    var t = 0;
+    var i;
+    for (i = 0; i < 300000; i++) {
+        switch (i & 3) {
+        case 0:
+            continue;
+        case 1:
+            t += 1;
+            break;
+        default:
+            t += 2;
+        }
+    }
+    return t;
+});
+bench('labelled break from nested loop', 5, function () {
+    var t = 0;
+    var i, j;
+    for (i = 0; i < 100000; i++) {
+        search:
+        for (j = 0; j < 10; j++) {
+            while (true) {
+                if (j === 3) {
+                    break search;
+                }
+                t++;
+                break;
+            }
+        }
+    }
+    return t;
+});
@@ -0,0 +1,49 @@
+/*
+ *  Benchmark for String.prototype.toUpperCase() and toLowerCase() with
+ *  ASCII and non-ASCII inputs, and for case insensitive RegExp matching
+ *  which canonicalizes every input character.
+ *
+ *    $ make
+ *    $ ./duk misc/bench_caseconv.js
+ */
+
+function makeText(kbytes, words) {
+    var parts = [];
+    var len = 0;
+    var i = 0;
+    var w;
+
+    while (len < kbytes * 1024) {
+        w = words[(i * 7 + (i >> 3)) % words.length] + ' ';
+        parts.push(w);
+        len += w.length;
+        i++;
+    }
+    return parts.join('');
+}
+
+function bench(name, count, fn) {
+    var t1 = Date.now();
+    var i;
+    var res;
+
+    for (i = 0; i < count; i++) {
+        res = fn();
+    }
+    var t2 = Date.now();
+    print(name + ': ' + ((t2 - t1) / count).toFixed(2) + ' ms/iter (result ' + res + ')');
+}
+
+var ascii = makeText(1024, [ 'Lorem', 'ipsum', 'DOLOR', 'sit', 'amet' ]);
+var latin = makeText(256, [ 'Größe', 'ÅNGSTRÖM', 'café', 'naïve', 'Ærø' ]);
+var greek = makeText(256, [ 'Αλφα', 'ΒΗΤΑ', 'γάμμα', 'Δέλτα', 'ΣΙΓΜΑ' ]);
+
+bench('ascii toUpperCase', 10, function () { return ascii.toUpperCase().length; });
+bench('ascii toLowerCase', 10, function () { return ascii.toLowerCase().length; });
+bench('ascii toUpperCase unchanged', 10, function () { return ascii.toUpperCase().toUpperCase().length; });
+bench('latin toUpperCase', 10, function () { return latin.toUpperCase().length; });
+bench('latin toLowerCase', 10, function () { return latin.toLowerCase().length; });
+bench('greek toUpperCase', 10, function () { return greek.toUpperCase().length; });
+bench('greek toLowerCase', 10, function () { return greek.toLowerCase().length; });
+bench('regexp /i latin', 10, function () { return /ångströmx/i.test(latin); });
+bench('regexp /i greek', 10, function () { return /σιγμαx/i.test(greek); });
@@ -0,0 +1,55 @@
+/*
+ *  Benchmark for CBOR vs. JSON encoding and decoding of numeric heavy
+ *  records, e.g. telemetry exchanged with native code.
+ *
+ *    $ make
+ *    $ ./duk misc/bench_cbor.js
+ */
+
+function makeDocument(count) {
+    var recs = [];
+    var i;
+
+    for (i = 0; i < count; i++) {
+        recs.push({
+            id: i,
+            ts: 1400000000000 + i * 1000,
+            value: i * 0.37,
+            ok: (i % 3) === 0,
+            name: 'sensor' + (i % 100),
+            samples: [ i, -i, i / 4, i * 1.1 ]
+        });
+    }
+    return recs;
+}
+
+function bench(name, rounds, fn) {
+    var t1 = Date.now();
+    var i;
+    var res;
+
+    for (i = 0; i < rounds; i++) {
+        res = fn();
+    }
+    var t2 = Date.now();
+    print(name + ': ' + ((t2 - t1) / rounds).toFixed(1) + ' ms/iter (result ' + res + ')');
+}
+
+var doc = makeDocument(20000);
+var json = JSON.stringify(doc);
+var cbor = Duktape.enc('cbor', doc);
+
+print('json: ' + json.length + ' bytes, cbor: ' + cbor.length + ' bytes');
+
+bench('JSON.stringify', 5, function () {
+    return JSON.stringify(doc).length;
+});
+bench('Duktape.enc cbor', 5, function () {
+    return Duktape.enc('cbor', doc).length;
+});
+bench('JSON.parse', 5, function () {
+    return JSON.parse(json).length;
+});
+bench('Duktape.dec cbor', 5, function () {
+    return Duktape.dec('cbor', cbor).length;
+});
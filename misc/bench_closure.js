@@ -0,0 +1,50 @@
+/*
+ *  Benchmark for closure creation; callbacks are typically never used as
+ *  constructors so their default 'prototype' object is not needed.
+ *
+ *    $ make
+ *    $ ./duk misc/bench_closure.js
+ */
+
+function bench(name, rounds, fn) {
+    var t1 = Date.now();
+    var i;
+    var res;
+
+    for (i = 0; i < rounds; i++) {
+        res = fn();
+    }
+    var t2 = Date.now();
+    print(name + ': ' + ((t2 - t1) / rounds).toFixed(1) + ' ms/iter (result ' + res + ')');
+}
+
+bench('create callback', 5, function () {
+    var t = 0;
+    var i;
+    var f;
+    for (i = 0; i < 100000; i++) {
+        f = function (x) { return x + 1; };
+        t += f(i);
+    }
+    return t;
+});
+bench('forEach with callback', 5, function () {
+    var arr = [ 1, 2, 3 ];
+    var t = 0;
+    var i;
+    for (i = 0; i < 50000; i++) {
+        arr.forEach(function (v) { t += v; });
+    }
+    return t;
+});
+bench('create constructor', 5, function () {
+    var t = 0;
+    var i;
+    var C;
+    for (i = 0; i < 50000; i++) {
+        // prototype is needed here, created on 'new'
+        C = function () { this.x = 1; };
+        t += new C().x;
+    }
+    return t;
+});
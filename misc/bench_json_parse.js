@@ -0,0 +1,69 @@
+/*
+ *  Benchmark for JSON.parse(): an array of records with repeated keys,
+ *  short and long strings (some with escapes), small integers and nested
+ *  arrays, i.e. a typical API response or log dump.
+ *
+ *    $ make
+ *    $ ./duk misc/bench_json_parse.js
+ */
+
+var seed = 12345;
+
+function rnd() {
+    // deterministic LCG so that runs are comparable
+    seed = (seed * 1103515245 + 12345) % 2147483648;
+    return seed / 2147483648;
+}
+
+function rndWord(n) {
+    var res = '';
+    var i;
+
+    for (i = 0; i < n; i++) {
+        res += String.fromCharCode(0x61 + Math.floor(rnd() * 26));
+    }
+    return res;
+}
+
+function makeRecord(i) {
+    return {
+        id: i,
+        name: rndWord(8),
+        email: rndWord(6) + '@' + rndWord(5) + '.com',
+        active: rnd() < 0.5,
+        score: Math.floor(rnd() * 10000),
+        tags: [ rndWord(4), rndWord(5), rndWord(3) ],
+        address: { street: rndWord(12), city: rndWord(7), zip: String(Math.floor(rnd() * 90000) + 10000) },
+        text: rndWord(40) + (rnd() < 0.2 ? '\n"quoted"\t' : ' ') + rndWord(60)
+    };
+}
+
+function makeDocument(count) {
+    var recs = [];
+    var i;
+
+    for (i = 0; i < count; i++) {
+        recs.push(makeRecord(i));
+    }
+    return JSON.stringify(recs);
+}
+
+function bench(name, rounds, fn) {
+    var t1 = Date.now();
+    var i;
+    var res;
+
+    for (i = 0; i < rounds; i++) {
+        res = fn();
+    }
+    var t2 = Date.now();
+    print(name + ': ' + ((t2 - t1) / rounds).toFixed(1) + ' ms/iter (result ' + res + ')');
+}
+
+var doc = makeDocument(20000);
+
+print('document: ' + doc.length + ' chars');
+
+bench('JSON.parse', 5, function () {
+    return JSON.parse(doc).length;
+});
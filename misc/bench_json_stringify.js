@@ -0,0 +1,63 @@
+/*
+ *  Benchmark for JSON.stringify(): an array of plain records with short
+ *  and long strings (some with escapes), integers, floats, booleans and
+ *  nested arrays and objects, i.e. a typical API response or log dump.
+ *
+ *    $ make
+ *    $ ./duk misc/bench_json_stringify.js
+ */
+
+var seed = 12345;
+
+function rnd() {
+    // deterministic LCG so that runs are comparable
+    seed = (seed * 1103515245 + 12345) % 2147483648;
+    return seed / 2147483648;
+}
+
+function rndWord(n) {
+    var res = '';
+    var i;
+
+    for (i = 0; i < n; i++) {
+        res += String.fromCharCode(0x61 + Math.floor(rnd() * 26));
+    }
+    return res;
+}
+
+function makeRecord(i) {
+    return {
+        id: i,
+        name: rndWord(8),
+        email: rndWord(6) + '@' + rndWord(5) + '.com',
+        active: rnd() < 0.5,
+        score: Math.floor(rnd() * 10000),
+        ratio: Math.floor(rnd() * 1000) / 8,
+        tags: [ rndWord(4), rndWord(5), rndWord(3) ],
+        address: { street: rndWord(12), city: rndWord(7), zip: String(Math.floor(rnd() * 90000) + 10000) },
+        text: rndWord(40) + (rnd() < 0.2 ? '\n"quoted"\t' : ' ') + rndWord(60)
+    };
+}
+
+function bench(name, rounds, fn) {
+    var t1 = Date.now();
+    var i;
+    var res;
+
+    for (i = 0; i < rounds; i++) {
+        res = fn();
+    }
+    var t2 = Date.now();
+    print(name + ': ' + ((t2 - t1) / rounds).toFixed(1) + ' ms/iter (result ' + res + ')');
+}
+
+var recs = [];
+var i;
+
+for (i = 0; i < 20000; i++) {
+    recs.push(makeRecord(i));
+}
+
+bench('JSON.stringify', 5, function () {
+    return JSON.stringify(recs).length;
+});
@@ -0,0 +1,77 @@
+/*
+ *  Benchmark for number-to-string conversion with radix 10: integers of
+ *  various sizes, short decimals, full precision doubles, and very large
+ *  and small exponents.  Also covers number formatting via string
+ *  concatenation and JSON.stringify().
+ *
+ *    $ make
+ *    $ ./duk misc/bench_numconv.js
+ */
+
+function makeValues(count, fn) {
+    var res = [];
+    var seed = 12345;
+    var i;
+
+    function rnd() {
+        // deterministic LCG so that runs are comparable
+        seed = (seed * 1103515245 + 12345) % 2147483648;
+        return seed / 2147483648;
+    }
+
+    for (i = 0; i < count; i++) {
+        res.push(fn(rnd));
+    }
+    return res;
+}
+
+function bench(name, values, rounds) {
+    var t1 = Date.now();
+    var i, j, n = 0;
+    var len = values.length;
+
+    for (i = 0; i < rounds; i++) {
+        for (j = 0; j < len; j++) {
+            n += String(values[j]).length;
+        }
+    }
+    var t2 = Date.now();
+    print(name + ': ' + ((t2 - t1) * 1e6 / (rounds * len)).toFixed(0) + ' ns/conversion (chars ' + n + ')');
+}
+
+var small_int = makeValues(10000, function (rnd) { return Math.floor(rnd() * 100000); });
+var large_int = makeValues(10000, function (rnd) { return Math.floor(rnd() * 4294967296) * 1048576 + Math.floor(rnd() * 1048576); });
+var short_dec = makeValues(10000, function (rnd) { return Math.round(rnd() * 1e6) / 100; });
+var full_prec = makeValues(10000, function (rnd) { return rnd() * rnd(); });
+var big_exp = makeValues(10000, function (rnd) { return (rnd() + 0.5) * Math.pow(10, Math.floor(rnd() * 600) - 300); });
+var denormal = makeValues(1000, function (rnd) { return (rnd() + 0.5) * Math.pow(2, -1060); });
+
+bench('small integers', small_int, 20);
+bench('integers up to 2^53', large_int, 20);
+bench('short decimals', short_dec, 10);
+bench('full precision doubles', full_prec, 5);
+bench('large and small exponents', big_exp, 5);
+bench('denormals', denormal, 5);
+
+(function () {
+    var t1 = Date.now();
+    var i, s;
+    for (i = 0; i < 5; i++) {
+        s = JSON.stringify(full_prec);
+    }
+    var t2 = Date.now();
+    print('JSON.stringify doubles: ' + ((t2 - t1) / 5).toFixed(2) + ' ms/iter (length ' + s.length + ')');
+})();
+
+(function () {
+    var t1 = Date.now();
+    var i, j, s;
+    for (i = 0; i < 5; i++) {
+        s = '';
+        for (j = 0; j < short_dec.length; j++) {
+            s = 'x=' + short_dec[j];
+        }
+    }
+    var t2 = Date.now();
+    print('concat short decimals: ' + ((t2 - t1) / 5).toFixed(2) + ' ms/iter (' + s + ')');
+})();
@@ -0,0 +1,71 @@
+/*
+ *  Benchmark for radix 10 string-to-number conversion: JSON.parse() of a
+ *  numeric heavy document (coordinates, prices, counters, measurements
+ *  with exponents, full precision doubles), and Number() / parseFloat()
+ *  applied to the same strings.
+ *
+ *    $ make
+ *    $ ./duk misc/bench_numparse.js
+ */
+
+var seed = 12345;
+
+function rnd() {
+    // deterministic LCG so that runs are comparable
+    seed = (seed * 1103515245 + 12345) % 2147483648;
+    return seed / 2147483648;
+}
+
+function makeRecord() {
+    return '{"id":' + Math.floor(rnd() * 1000000) +
+           ',"lat":' + (rnd() * 180 - 90).toFixed(6) +
+           ',"lon":' + (rnd() * 360 - 180).toFixed(6) +
+           ',"price":' + (rnd() * 1000).toFixed(2) +
+           ',"mass":' + (rnd() * 9 + 1).toFixed(4) + 'e' + (Math.floor(rnd() * 60) - 30) +
+           ',"value":' + String(rnd() * rnd()) + '}';
+}
+
+function makeDocument(count) {
+    var parts = [];
+    var i;
+
+    for (i = 0; i < count; i++) {
+        parts.push(makeRecord());
+    }
+    return '[' + parts.join(',') + ']';
+}
+
+function bench(name, rounds, fn) {
+    var t1 = Date.now();
+    var i;
+    var res;
+
+    for (i = 0; i < rounds; i++) {
+        res = fn();
+    }
+    var t2 = Date.now();
+    print(name + ': ' + ((t2 - t1) / rounds).toFixed(1) + ' ms/iter (result ' + res + ')');
+}
+
+var doc = makeDocument(20000);
+var strings = doc.match(/-?[0-9][0-9.e+-]*/g);
+
+print('document: ' + doc.length + ' chars, ' + strings.length + ' numbers');
+
+bench('JSON.parse', 5, function () {
+    return JSON.parse(doc).length;
+});
+bench('Number()', 5, function () {
+    var i, n = 0;
+    for (i = 0; i < strings.length; i++) {
+        n += Number(strings[i]);
+    }
+    return n;
+});
+bench('parseFloat()', 5, function () {
+    var i, n = 0;
+    for (i = 0; i < strings.length; i++) {
+        n += parseFloat(strings[i]);
+    }
+    return n;
+});
@@ -0,0 +1,63 @@
+/*
+ *  Benchmark for regexp patterns which take exponential or polynomial
+ *  time with a backtracking matcher, and for typical patterns over a
+ *  large input.
+ *
+ *    $ make
+ *    $ ./duk misc/bench_regexp_automaton.js
+ */
+
+function rep(s, n) {
+    var r = [];
+    var i;
+    for (i = 0; i < n; i++) {
+        r.push(s);
+    }
+    return r.join('');
+}
+
+function makeText(kbytes) {
+    var words = [ 'lorem', 'ipsum', 'dolor', 'sit', 'amet', 'consectetur',
+                  'adipiscing', 'elit', 'sed', 'do', 'eiusmod', 'tempor',
+                  'foo@example.com', 'x=12', 'running', '12px' ];
+    var parts = [];
+    var len = 0;
+    var i = 0;
+    var w;
+
+    while (len < kbytes * 1024) {
+        w = words[(i * 7 + (i >> 3)) % words.length];
+        w += ((i % 12) === 11) ? '\n' : ' ';
+        parts.push(w);
+        len += w.length;
+        i++;
+    }
+    return parts.join('');
+}
+
+function bench(name, count, fn) {
+    var t1 = Date.now();
+    var i;
+    var res;
+
+    for (i = 0; i < count; i++) {
+        res = fn();
+    }
+    var t2 = Date.now();
+    print(name + ': ' + ((t2 - t1) / count).toFixed(2) + ' ms/iter (result ' + res + ')');
+}
+
+var n;
+for (n = 16; n <= 24; n += 4) {
+    bench('nested quantifier, ' + n + ' chars', 1, function () { return /(a+)+b/.test(rep('a', n)); });
+    bench('word sequence, ' + n + ' chars', 1, function () { return /^(\w+\s?)+$/.test(rep('a', n) + '!'); });
+}
+bench('alternation loop, 100k chars', 1, function () { return /(?:a|b|ab)*c/.test(rep('ab', 50000)); });
+
+var text = makeText(512);
+print('text, ' + text.length + ' chars');
+
+bench('global replace', 5, function () { return text.replace(/\d+/g, '#').length; });
+bench('split on whitespace', 2, function () { return text.split(/\s+/).length; });
+bench('captures, global match', 2, function () { return text.match(/(\w+)@(\w+)\.com/g).length; });
+bench('word alternatives, global match', 2, function () { return text.match(/\b(?:lorem|dolor|amet)\b/g).length; });
@@ -0,0 +1,52 @@
+/*
+ *  Benchmark for regexp matching over large inputs with patterns that
+ *  have a literal prefix, a required literal, a known first character,
+ *  or a '^' anchor.
+ *
+ *    $ make
+ *    $ ./duk misc/bench_regexp_prefilter.js
+ */
+
+function makeText(kbytes) {
+    var words = [ 'lorem', 'ipsum', 'dolor', 'sit', 'amet', 'consectetur',
+                  'adipiscing', 'elit', 'sed', 'do', 'eiusmod', 'tempor',
+                  'incididunt', 'ut', 'labore', 'et', 'dolore', 'magna',
+                  'aliqua', '12px' ];
+    var parts = [];
+    var len = 0;
+    var i = 0;
+    var w;
+
+    while (len < kbytes * 1024) {
+        w = words[(i * 7 + (i >> 3)) % words.length];
+        w += ((i % 12) === 11) ? '\n' : ' ';
+        parts.push(w);
+        len += w.length;
+        i++;
+    }
+    return parts.join('');
+}
+
+function bench(name, count, fn) {
+    var t1 = Date.now();
+    var i;
+    var res;
+
+    for (i = 0; i < count; i++) {
+        res = fn();
+    }
+    var t2 = Date.now();
+    print(name + ': ' + ((t2 - t1) / count).toFixed(2) + ' ms/iter (result ' + res + ')');
+}
+
+var text = makeText(512);
+print('text, ' + text.length + ' chars');
+
+bench('literal prefix, global match', 5, function () { return text.match(/tempor\s/g).length; });
+bench('literal prefix, no match', 5, function () { return text.search(/temporary/); });
+bench('required literal, global replace', 5, function () { return text.replace(/\d+px/g, 'N').length; });
+bench('required literal, no match', 5, function () { return /[a-z]+ingx/.test(text); });
+bench('first char set, global match', 5, function () { return text.match(/[xq]\w/g).length; });
+bench('alternation first char set', 5, function () { return text.match(/magna|aliqua/g).length; });
+bench('anchored, no match', 20, function () { return /^ipsum/.test(text); });
+bench('no prefilter, global match', 2, function () { return text.match(/.m\b/g).length; });
@@ -0,0 +1,103 @@
+/*
+ *  Microbenchmark for string interning: pushes unique strings of various
+ *  typical sizes (short identifier-like keys, medium text, large file-like
+ *  data) as ASCII and as mixed UTF-8, and reports throughput.
+ *
+ *  Each string is made unique by rewriting a few leading bytes so that
+ *  every push is an intern miss (hash, length/ASCII scan, copy).
+ *
+ *    $ make dist
+ *    $ gcc -O2 -std=c99 -Idist/src -o /tmp/bench_string_intern \
+ *          misc/bench_string_intern.c dist/src/duktape.c -lm
+ *    $ /tmp/bench_string_intern
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "duktape.h"
+
+static double now(void) {
+	return (double) clock() / (double) CLOCKS_PER_SEC;
+}
+
+static void fill(char *buf, size_t len, int nonascii) {
+	size_t i = 0;
+
+	while (i < len) {
+		if (nonascii && (i % 16) == 8 && i + 3 <= len) {
+			/* U+20AC (euro sign) as UTF-8 */
+			buf[i++] = (char) 0xe2;
+			buf[i++] = (char) 0x82;
+			buf[i++] = (char) 0xac;
+		} else {
+			buf[i] = (char) ('a' + (i % 26));
+			i++;
+		}
+	}
+}
+
+static void bench(duk_context *ctx, size_t len, int nonascii, size_t total) {
+	char *buf;
+	size_t count;
+	size_t i;
+	double t1, t2;
+
+	buf = (char *) malloc(len + 1);
+	if (!buf) {
+		return;
+	}
+	fill(buf, len, nonascii);
+
+	count = total / len;
+	if (count < 16) {
+		count = 16;
+	} else if (count > 400000) {
+		count = 400000;
+	}
+
+	t1 = now();
+	for (i = 0; i < count; i++) {
+		/* unique prefix -> always an intern miss */
+		buf[0] = (char) ('A' + (i % 26));
+		if (len >= 4) {
+			buf[1] = (char) ('A' + ((i / 26) % 26));
+			buf[2] = (char) ('A' + ((i / 676) % 26));
+			buf[3] = (char) ('A' + ((i / 17576) % 26));
+		}
+		duk_push_lstring(ctx, buf, len);
+		duk_pop(ctx);
+	}
+	t2 = now();
+
+	printf("%-8s len=%-9ld count=%-9ld time=%.3fs  %.1f MB/s\n",
+	       nonascii ? "utf8" : "ascii", (long) len, (long) count, t2 - t1,
+	       ((double) len * (double) count) / (t2 - t1 > 0.0 ? t2 - t1 : 1e-9) / 1e6);
+
+	free(buf);
+}
+
+int main(int argc, char *argv[]) {
+	static const size_t sizes[] = { 8, 32, 128, 1024, 65536, 1048576, 16777216 };
+	duk_context *ctx;
+	size_t total = 256 * 1024 * 1024;
+	size_t i;
+
+	if (argc > 1) {
+		total = (size_t) atol(argv[1]) * 1024 * 1024;
+	}
+
+	ctx = duk_create_heap_default();
+	if (!ctx) {
+		return 1;
+	}
+
+	for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+		bench(ctx, sizes[i], 0, total);
+		bench(ctx, sizes[i], 1, total);
+	}
+
+	duk_destroy_heap(ctx);
+	return 0;
+}
@@ -0,0 +1,74 @@
+/*
+ *  Benchmark for string searching in indexOf(), lastIndexOf(), split()
+ *  and replace() with multi-megabyte inputs, ASCII and non-ASCII, with
+ *  short and long search strings.
+ *
+ *    $ make
+ *    $ ./duk misc/bench_string_search.js
+ */
+
+function makeText(mbytes, nonascii) {
+    var words = [ 'lorem', 'ipsum', 'dolor', 'sit', 'amet', 'consectetur',
+                  'adipiscing', 'elit', 'sed', 'do', 'eiusmod', 'tempor',
+                  'incididunt', 'ut', 'labore', 'et', 'dolore', 'magna',
+                  'aliqua', nonascii ? 'café' : 'cafe' ];
+    var parts = [];
+    var len = 0;
+    var i = 0;
+    var w;
+
+    while (len < mbytes * 1024 * 1024) {
+        w = words[(i * 7 + (i >> 3)) % words.length];
+        if ((i % 12) === 11) {
+            w += '\n';
+        } else {
+            w += ' ';
+        }
+        parts.push(w);
+        len += w.length;
+        i++;
+    }
+    return parts.join('');
+}
+
+function bench(name, count, fn) {
+    var t1 = Date.now();
+    var i;
+    var res;
+
+    for (i = 0; i < count; i++) {
+        res = fn();
+    }
+    var t2 = Date.now();
+    print(name + ': ' + ((t2 - t1) / count).toFixed(2) + ' ms/iter (result ' + res + ')');
+}
+
+function run(nonascii) {
+    var text = makeText(4, nonascii);
+    var tail = 'the needle string at the very end';
+    text = text + tail;
+
+    print((nonascii ? 'non-ASCII' : 'ASCII') + ' text, ' + text.length + ' chars');
+
+    bench('indexOf short miss', 10, function () { return text.indexOf('xyz'); });
+    bench('indexOf short hit at end', 10, function () { return text.indexOf('the n'); });
+    bench('indexOf long hit at end', 10, function () { return text.indexOf(tail); });
+    bench('indexOf long miss', 10, function () { return text.indexOf('consectetur adipiscing elitx'); });
+    bench('lastIndexOf short from end', 10, function () { return text.lastIndexOf('xyz'); });
+    bench('lastIndexOf long from end', 10, function () { return text.lastIndexOf('magna aliquax'); });
+    bench('indexOf loop over all matches', 3, function () {
+        var n = 0;
+        var pos = text.indexOf('tempor');
+        while (pos >= 0) {
+            n++;
+            pos = text.indexOf('tempor', pos + 1);
+        }
+        return n;
+    });
+    bench('split on newline', 3, function () { return text.split('\n').length; });
+    bench('split on long separator', 3, function () { return text.split('incididunt ut labore').length; });
+    bench('replace long', 10, function () { return text.replace(tail, 'x').length; });
+}
+
+run(false);
+run(true);
@@ -0,0 +1,41 @@
+/*
+ *  Benchmark for lexing source code with non-ASCII identifiers, which
+ *  exercises the non-ASCII IdentifierStart and IdentifierPart checks.
+ *
+ *    $ make
+ *    $ ./duk misc/bench_unicode_ident.js
+ */
+
+function makeSource(count, names) {
+    var parts = [];
+    var i, n;
+
+    // long identifiers keep the compiler share of the time small
+    for (i = 0; i < count; i++) {
+        n = names[i % names.length];
+        parts.push('typeof ' + n + n + n + n + n + n + n + n + ';');
+    }
+    return parts.join('\n');
+}
+
+function bench(name, count, fn) {
+    var t1 = Date.now();
+    var i;
+    var res;
+
+    for (i = 0; i < count; i++) {
+        res = fn();
+    }
+    var t2 = Date.now();
+    print(name + ': ' + ((t2 - t1) / count).toFixed(2) + ' ms/iter (result ' + res + ')');
+}
+
+var asciiSrc = makeSource(20000, [ 'alpha', 'beta', 'gamma', 'delta' ]);
+var latinSrc = makeSource(20000, [ 'größe', 'können', 'façade', 'niño' ]);
+var greekSrc = makeSource(20000, [ 'αλφα', 'βήτα', 'γάμμα', 'δέλτα' ]);
+var kanaSrc = makeSource(20000, [ 'ひらがな', 'カタカナ', 'ァィゥェ', 'ـــع' ]);
+
+bench('ascii identifiers', 3, function () { return new Function(asciiSrc).length; });
+bench('latin identifiers', 3, function () { return new Function(latinSrc).length; });
+bench('greek identifiers', 3, function () { return new Function(greekSrc).length; });
+bench('kana identifiers', 3, function () { return new Function(kanaSrc).length; });
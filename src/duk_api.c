@@ -889,10 +889,12 @@ int duk_require_int(duk_context *ctx, int index) {
 }
 
 const char *duk_get_lstring(duk_context *ctx, int index, size_t *out_len) {
+	duk_hthread *thr = (duk_hthread *) ctx;
 	const char *ret;
 	duk_tval *tv;
 
 	DUK_ASSERT(ctx != NULL);
+	DUK_UNREF(thr);
 
 	/* default: NULL, length 0 */
 	ret = NULL;
@@ -903,10 +905,12 @@ const char *duk_get_lstring(duk_context *ctx, int index, size_t *out_len) {
 	tv = duk_get_tval(ctx, index);
 	if (tv && DUK_TVAL_IS_STRING(tv)) {
 		/* Here we rely on duk_hstring instances always being zero
-		 * terminated even if the actual string is not.
+		 * terminated even if the actual string is not.  String slices
+		 * are flattened to ensure this (which may throw an alloc error).
 		 */
 		duk_hstring *h = DUK_TVAL_GET_STRING(tv);
 		DUK_ASSERT(h != NULL);
+		DUK_HSTRING_FLATTEN(thr, h);
 		ret = (const char *) DUK_HSTRING_GET_DATA(h);
 		if (out_len) {
 			*out_len = DUK_HSTRING_GET_BYTELEN(h);
@@ -1794,6 +1798,31 @@ duk_hstring *duk_to_hstring(duk_context *ctx, int index) {
 	return ret;
 }
 
+/* Coerce to string for use as a property key: a non-interned string is
+ * replaced by its interned counterpart so that keys can be compared by
+ * pointer.
+ */
+duk_hstring *duk_to_property_key_hstring(duk_context *ctx, int index) {
+	duk_hstring *ret;
+	DUK_ASSERT(ctx != NULL);
+	index = duk_require_normalize_index(ctx, index);
+	ret = duk_to_hstring(ctx, index);
+#if defined(DUK_USE_NONINTERNED_STRINGS)
+	if (DUK_HSTRING_HAS_NONINTERNED(ret)) {
+		duk_hthread *thr = (duk_hthread *) ctx;
+
+		/* source string remains reachable through the value stack */
+		ret = duk_heap_string_intern_key_checked(thr,
+		                                         DUK_HSTRING_GET_DATA(ret),
+		                                         DUK_HSTRING_GET_BYTELEN(ret));
+		duk_push_hstring(ctx, ret);
+		duk_replace(ctx, index);
+	}
+	DUK_ASSERT(!DUK_HSTRING_HAS_NONINTERNED(ret));
+#endif
+	return ret;
+}
+
 void *duk_to_buffer(duk_context *ctx, int index, size_t *out_size) {
 	duk_hbuffer *h_buf;
 
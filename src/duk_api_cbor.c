@@ -0,0 +1,888 @@
+/*
+ *  CBOR (RFC 7049) encoding and decoding.
+ *
+ *  Values are encoded directly from their tagged values into a dynamic
+ *  buffer and decoded directly from the input bytes, so numbers never go
+ *  through a textual representation.  Mapping:
+ *
+ *    undefined               simple value 23
+ *    null, true, false       simple values 22, 21, 20
+ *    number                  integer (major type 0/1) if the value is an
+ *                            integer other than -0 with magnitude below
+ *                            2^64, otherwise the shortest of float16,
+ *                            float32 and float64 which is exact
+ *    string                  text string (internal string bytes as is)
+ *    buffer                  byte string
+ *    Array                   array, elements 0...length-1
+ *    other objects           map of own enumerable properties; Number,
+ *                            String, Boolean and Buffer objects encode
+ *                            their internal value
+ *    function, pointer       simple value 23 (undefined)
+ *
+ *  Decoding accepts definite and indefinite length items, all float sizes
+ *  and ignores tags (the tagged item is decoded as is).  Map keys are
+ *  coerced to property keys.  Arrays and objects are presized based on the
+ *  item count, which is capped by the remaining input length so that a
+ *  bogus count can't cause a huge allocation.
+ *
+ *  Internal strings are extended UTF-8/CESU-8, so non-BMP characters
+ *  encode as surrogate pairs, not as strict UTF-8.
+ */
+
+#include "duk_internal.h"
+
+#ifdef DUK_USE_CBOR
+
+/* Recursion limits (to protect C stack) */
+#if defined(DUK_USE_DEEP_C_STACK)
+#define DUK__CBOR_RECURSION_LIMIT  1000
+#else
+#define DUK__CBOR_RECURSION_LIMIT  100
+#endif
+
+/* How much stack to require on entry to array/map encode and decode */
+#define DUK__CBOR_REQSTACK         8
+
+/* Major types */
+#define DUK__CBOR_MT_UINT          0
+#define DUK__CBOR_MT_NINT          1
+#define DUK__CBOR_MT_BYTES         2
+#define DUK__CBOR_MT_TEXT          3
+#define DUK__CBOR_MT_ARRAY         4
+#define DUK__CBOR_MT_MAP           5
+#define DUK__CBOR_MT_TAG           6
+#define DUK__CBOR_MT_SIMPLE        7
+
+#define DUK__CBOR_AI_INDEFINITE    31
+#define DUK__CBOR_BREAK            0xff
+
+typedef struct {
+	duk_hthread *thr;
+	duk_hbuffer_dynamic *h_buf;
+	int recursion_depth;
+	int recursion_limit;
+} duk__cbor_enc_ctx;
+
+typedef struct {
+	duk_hthread *thr;
+	const duk_uint8_t *p;
+	const duk_uint8_t *p_end;
+	int recursion_depth;
+	int recursion_limit;
+} duk__cbor_dec_ctx;
+
+static void duk__cbor_encode_value(duk__cbor_enc_ctx *enc_ctx);
+static void duk__cbor_decode_value(duk__cbor_dec_ctx *dec_ctx);
+
+/*
+ *  Encoding
+ */
+
+/* Ensure space for 'len' more bytes and return the write pointer. */
+static duk_uint8_t *duk__cbor_reserve(duk__cbor_enc_ctx *enc_ctx, duk_size_t len) {
+	duk_hbuffer_dynamic *h_buf = enc_ctx->h_buf;
+	duk_size_t size;
+
+	size = DUK_HBUFFER_GET_SIZE(h_buf);
+	if (DUK_HBUFFER_DYNAMIC_GET_SPARE_SIZE(h_buf) < len) {
+		if (len > DUK_HBUFFER_MAX_BYTELEN - size) {
+			DUK_ERROR(enc_ctx->thr, DUK_ERR_RANGE_ERROR, "buffer too long");
+		}
+		duk_hbuffer_resize(enc_ctx->thr, h_buf, size, size + len + size / 2 + 64);
+	}
+	return (duk_uint8_t *) DUK_HBUFFER_DYNAMIC_GET_CURR_DATA_PTR(h_buf) + size;
+}
+
+/* Update buffer size after writing up to (but not including) 'p'. */
+static void duk__cbor_commit(duk__cbor_enc_ctx *enc_ctx, duk_uint8_t *p) {
+	duk_hbuffer_dynamic *h_buf = enc_ctx->h_buf;
+
+	DUK_ASSERT(p >= (duk_uint8_t *) DUK_HBUFFER_DYNAMIC_GET_CURR_DATA_PTR(h_buf));
+	DUK_HBUFFER_SET_SIZE(h_buf, (duk_size_t) (p - (duk_uint8_t *) DUK_HBUFFER_DYNAMIC_GET_CURR_DATA_PTR(h_buf)));
+}
+
+static duk_uint8_t *duk__cbor_write_u16(duk_uint8_t *p, duk_uint32_t val) {
+	*p++ = (duk_uint8_t) (val >> 8);
+	*p++ = (duk_uint8_t) val;
+	return p;
+}
+
+static duk_uint8_t *duk__cbor_write_u32(duk_uint8_t *p, duk_uint32_t val) {
+	*p++ = (duk_uint8_t) (val >> 24);
+	*p++ = (duk_uint8_t) (val >> 16);
+	*p++ = (duk_uint8_t) (val >> 8);
+	*p++ = (duk_uint8_t) val;
+	return p;
+}
+
+/* Initial byte and shortest argument encoding for a 64-bit argument. */
+static void duk__cbor_emit_head64(duk__cbor_enc_ctx *enc_ctx, int major, duk_uint32_t hi, duk_uint32_t lo) {
+	duk_uint8_t *p;
+	duk_uint8_t mt = (duk_uint8_t) (major << 5);
+
+	p = duk__cbor_reserve(enc_ctx, 9);
+	if (hi != 0) {
+		*p++ = mt + 27;
+		p = duk__cbor_write_u32(p, hi);
+		p = duk__cbor_write_u32(p, lo);
+	} else if (lo < 24) {
+		*p++ = mt + (duk_uint8_t) lo;
+	} else if (lo <= 0xffUL) {
+		*p++ = mt + 24;
+		*p++ = (duk_uint8_t) lo;
+	} else if (lo <= 0xffffUL) {
+		*p++ = mt + 25;
+		p = duk__cbor_write_u16(p, lo);
+	} else {
+		*p++ = mt + 26;
+		p = duk__cbor_write_u32(p, lo);
+	}
+	duk__cbor_commit(enc_ctx, p);
+}
+
+static void duk__cbor_emit_head(duk__cbor_enc_ctx *enc_ctx, int major, duk_size_t len) {
+#if defined(DUK_USE_64BIT_OPS)
+	duk__cbor_emit_head64(enc_ctx, major, (duk_uint32_t) (((duk_uint64_t) len) >> 32), (duk_uint32_t) len);
+#else
+	duk__cbor_emit_head64(enc_ctx, major, 0, (duk_uint32_t) len);
+#endif
+}
+
+static void duk__cbor_emit_byte(duk__cbor_enc_ctx *enc_ctx, duk_uint8_t val) {
+	duk_uint8_t *p;
+
+	p = duk__cbor_reserve(enc_ctx, 1);
+	*p++ = val;
+	duk__cbor_commit(enc_ctx, p);
+}
+
+static void duk__cbor_emit_data(duk__cbor_enc_ctx *enc_ctx, int major, const duk_uint8_t *data, duk_size_t len) {
+	duk_uint8_t *p;
+
+	duk__cbor_emit_head(enc_ctx, major, len);
+	p = duk__cbor_reserve(enc_ctx, len);
+	DUK_MEMCPY((void *) p, (const void *) data, len);
+	duk__cbor_commit(enc_ctx, p + len);
+}
+
+/* Convert finite float32 bits to float16 bits if the conversion is exact,
+ * otherwise return -1.
+ */
+static duk_int32_t duk__cbor_float_to_half(duk_uint32_t u) {
+	duk_uint32_t sign = (u >> 16) & 0x8000UL;
+	duk_int32_t expt = (duk_int32_t) ((u >> 23) & 0xff) - 127;
+	duk_uint32_t mant = u & 0x7fffffUL;
+	int shift;
+
+	if (expt == -127 && mant == 0) {
+		return (duk_int32_t) sign;  /* +/- zero */
+	} else if (expt >= -14 && expt <= 15) {
+		if (mant & 0x1fffUL) {
+			return -1;
+		}
+		return (duk_int32_t) (sign | ((duk_uint32_t) (expt + 15) << 10) | (mant >> 13));
+	} else if (expt >= -24 && expt < -14) {
+		/* subnormal: implicit bit becomes explicit */
+		mant |= 0x800000UL;
+		shift = 13 + (-14 - expt);
+		if (mant & ((1UL << shift) - 1)) {
+			return -1;
+		}
+		return (duk_int32_t) (sign | (mant >> shift));
+	}
+	return -1;
+}
+
+static void duk__cbor_encode_double(duk__cbor_enc_ctx *enc_ctx, duk_double_t d) {
+	duk_double_union du;
+	duk_uint8_t *p;
+	duk_double_t t;
+	duk_uint32_t hi, lo;
+	int major;
+	duk_int32_t half;
+	union {
+		float f;
+		duk_uint32_t u;
+	} fu;
+
+	if (DUK_ISNAN(d)) {
+		/* canonical NaN as float16 */
+		p = duk__cbor_reserve(enc_ctx, 3);
+		*p++ = 0xf9;
+		*p++ = 0x7e;
+		*p++ = 0x00;
+		duk__cbor_commit(enc_ctx, p);
+		return;
+	} else if (DUK_ISINF(d)) {
+		p = duk__cbor_reserve(enc_ctx, 3);
+		*p++ = 0xf9;
+		*p++ = (d > 0 ? 0x7c : 0xfc);
+		*p++ = 0x00;
+		duk__cbor_commit(enc_ctx, p);
+		return;
+	}
+
+	if (d == floor(d) && !(d == 0 && DUK_SIGNBIT(d)) &&
+	    d < 18446744073709551616.0 && d > -18446744073709551616.0) {
+		/* Integer: split the magnitude into 32-bit halves exactly,
+		 * and for negative values encode -1 - d, i.e. |d| - 1.
+		 */
+		if (d >= 0) {
+			major = DUK__CBOR_MT_UINT;
+			t = d;
+		} else {
+			major = DUK__CBOR_MT_NINT;
+			t = -d;
+		}
+		hi = (duk_uint32_t) (t / 4294967296.0);
+		lo = (duk_uint32_t) (t - (duk_double_t) hi * 4294967296.0);
+		if (major == DUK__CBOR_MT_NINT) {
+			if (lo == 0) {
+				hi--;
+			}
+			lo--;
+		}
+		duk__cbor_emit_head64(enc_ctx, major, hi, lo);
+		return;
+	}
+
+	if (d >= -3.4028234663852886e38 && d <= 3.4028234663852886e38 &&
+	    (duk_double_t) ((float) d) == d) {
+		fu.f = (float) d;
+		half = duk__cbor_float_to_half(fu.u);
+		if (half >= 0) {
+			p = duk__cbor_reserve(enc_ctx, 3);
+			*p++ = 0xf9;
+			p = duk__cbor_write_u16(p, (duk_uint32_t) half);
+			duk__cbor_commit(enc_ctx, p);
+			return;
+		}
+		p = duk__cbor_reserve(enc_ctx, 5);
+		*p++ = 0xfa;
+		p = duk__cbor_write_u32(p, fu.u);
+		duk__cbor_commit(enc_ctx, p);
+		return;
+	}
+
+	DUK_DBLUNION_SET_DOUBLE(&du, d);
+	p = duk__cbor_reserve(enc_ctx, 9);
+	*p++ = 0xfb;
+	p = duk__cbor_write_u32(p, DUK_DBLUNION_GET_HIGH32(&du));
+	p = duk__cbor_write_u32(p, DUK_DBLUNION_GET_LOW32(&du));
+	duk__cbor_commit(enc_ctx, p);
+}
+
+static void duk__cbor_objarr_entry(duk__cbor_enc_ctx *enc_ctx) {
+	duk_require_stack((duk_context *) enc_ctx->thr, DUK__CBOR_REQSTACK);
+
+	if (enc_ctx->recursion_depth >= enc_ctx->recursion_limit) {
+		DUK_ERROR(enc_ctx->thr, DUK_ERR_RANGE_ERROR, "cbor encode recursion limit");
+	}
+	enc_ctx->recursion_depth++;
+}
+
+/* [ ... arr ] -> [ ... arr ] */
+static void duk__cbor_encode_array(duk__cbor_enc_ctx *enc_ctx, duk_hobject *h) {
+	duk_context *ctx = (duk_context *) enc_ctx->thr;
+	duk_tval *tv;
+	duk_uint32_t len;
+	duk_uint32_t i;
+	int idx_arr;
+
+	idx_arr = duk_get_top(ctx) - 1;
+	len = (duk_uint32_t) duk_get_length(ctx, idx_arr);
+	duk__cbor_emit_head(enc_ctx, DUK__CBOR_MT_ARRAY, (duk_size_t) len);
+
+	for (i = 0; i < len; i++) {
+		/* Elements are read from the array part when possible.  The
+		 * array may change during the loop (getters, inherited index
+		 * properties), so check the array part on every round; the
+		 * number of items emitted is fixed to 'len' anyway.
+		 */
+		if (DUK_HOBJECT_HAS_ARRAY_PART(h) && i < h->a_size) {
+			tv = DUK_HOBJECT_A_GET_VALUE_PTR(h, i);
+			if (!DUK_TVAL_IS_UNDEFINED_UNUSED(tv)) {
+				duk_push_tval(ctx, tv);
+				duk__cbor_encode_value(enc_ctx);
+				continue;
+			}
+		}
+		duk_get_prop_index(ctx, idx_arr, i);
+		duk__cbor_encode_value(enc_ctx);
+	}
+}
+
+/* [ ... obj ] -> [ ... obj ] */
+static void duk__cbor_encode_map(duk__cbor_enc_ctx *enc_ctx, duk_hobject *h) {
+	duk_context *ctx = (duk_context *) enc_ctx->thr;
+	duk_hstring *k;
+	duk_tval *tv;
+	duk_uint32_t count;
+	duk_uint32_t emitted;
+	duk_uint32_t i, t;
+	duk_uint8_t buf[10];
+	duk_uint8_t *q;
+	int idx_obj;
+
+	idx_obj = duk_get_top(ctx) - 1;
+
+	/* Own enumerable properties in enumeration order: array part first,
+	 * then the entry part.  Count them first for the map header.
+	 */
+	count = 0;
+	if (DUK_HOBJECT_HAS_ARRAY_PART(h)) {
+		for (i = 0; i < h->a_size; i++) {
+			if (!DUK_TVAL_IS_UNDEFINED_UNUSED(DUK_HOBJECT_A_GET_VALUE_PTR(h, i))) {
+				count++;
+			}
+		}
+	}
+	for (i = 0; i < h->e_used; i++) {
+		k = DUK_HOBJECT_E_GET_KEY(h, i);
+		if (k != NULL && DUK_HOBJECT_E_SLOT_IS_ENUMERABLE(h, i) && !DUK_HSTRING_HAS_INTERNAL(k)) {
+			count++;
+		}
+	}
+
+	duk__cbor_emit_head(enc_ctx, DUK__CBOR_MT_MAP, (duk_size_t) count);
+
+	/* Getters and nested values may run user code which may modify the
+	 * object, so the property tables are re-read on every round and the
+	 * final count is checked to ensure the output is well-formed.
+	 */
+	emitted = 0;
+	for (i = 0; DUK_HOBJECT_HAS_ARRAY_PART(h) && i < h->a_size; i++) {
+		tv = DUK_HOBJECT_A_GET_VALUE_PTR(h, i);
+		if (DUK_TVAL_IS_UNDEFINED_UNUSED(tv)) {
+			continue;
+		}
+
+		/* array index keys are formatted without interning */
+		q = buf + sizeof(buf);
+		t = i;
+		do {
+			*(--q) = (duk_uint8_t) ('0' + (t % 10));
+			t /= 10;
+		} while (t > 0);
+		duk__cbor_emit_data(enc_ctx, DUK__CBOR_MT_TEXT, q, (duk_size_t) (buf + sizeof(buf) - q));
+
+		tv = DUK_HOBJECT_A_GET_VALUE_PTR(h, i);  /* re-lookup, emit may have triggered GC */
+		duk_push_tval(ctx, tv);
+		duk__cbor_encode_value(enc_ctx);
+		emitted++;
+	}
+	for (i = 0; i < h->e_used; i++) {
+		k = DUK_HOBJECT_E_GET_KEY(h, i);
+		if (k == NULL || !DUK_HOBJECT_E_SLOT_IS_ENUMERABLE(h, i) || DUK_HSTRING_HAS_INTERNAL(k)) {
+			continue;
+		}
+
+		duk_push_hstring(ctx, k);  /* keep key reachable */
+		duk__cbor_emit_data(enc_ctx, DUK__CBOR_MT_TEXT,
+		                    (const duk_uint8_t *) DUK_HSTRING_GET_DATA(k),
+		                    (duk_size_t) DUK_HSTRING_GET_BYTELEN(k));
+
+		if (DUK_HOBJECT_E_SLOT_IS_ACCESSOR(h, i)) {
+			duk_get_prop(ctx, idx_obj);  /* [ ... obj key ] -> [ ... obj val ] */
+		} else {
+			duk_pop(ctx);
+			duk_push_tval(ctx, DUK_HOBJECT_E_GET_VALUE_TVAL_PTR(h, i));
+		}
+		duk__cbor_encode_value(enc_ctx);
+		emitted++;
+	}
+
+	if (emitted != count) {
+		DUK_ERROR(enc_ctx->thr, DUK_ERR_TYPE_ERROR, "object modified during cbor encode");
+	}
+}
+
+/* [ ... val ] -> [ ... ] */
+static void duk__cbor_encode_value(duk__cbor_enc_ctx *enc_ctx) {
+	duk_context *ctx = (duk_context *) enc_ctx->thr;
+	duk_tval *tv;
+
+	tv = duk_get_tval(ctx, -1);
+	DUK_ASSERT(tv != NULL);
+
+	switch (DUK_TVAL_GET_TAG(tv)) {
+	case DUK_TAG_UNDEFINED:
+	case DUK_TAG_POINTER: {
+		duk__cbor_emit_byte(enc_ctx, 0xf7);
+		break;
+	}
+	case DUK_TAG_NULL: {
+		duk__cbor_emit_byte(enc_ctx, 0xf6);
+		break;
+	}
+	case DUK_TAG_BOOLEAN: {
+		duk__cbor_emit_byte(enc_ctx, DUK_TVAL_GET_BOOLEAN(tv) ? 0xf5 : 0xf4);
+		break;
+	}
+	case DUK_TAG_STRING: {
+		duk_hstring *h = DUK_TVAL_GET_STRING(tv);
+		DUK_ASSERT(h != NULL);
+		duk__cbor_emit_data(enc_ctx, DUK__CBOR_MT_TEXT,
+		                    (const duk_uint8_t *) DUK_HSTRING_GET_DATA(h),
+		                    (duk_size_t) DUK_HSTRING_GET_BYTELEN(h));
+		break;
+	}
+	case DUK_TAG_BUFFER: {
+		duk_hbuffer *h = DUK_TVAL_GET_BUFFER(tv);
+		DUK_ASSERT(h != NULL);
+		duk__cbor_emit_data(enc_ctx, DUK__CBOR_MT_BYTES,
+		                    (const duk_uint8_t *) DUK_HBUFFER_GET_DATA_PTR(h),
+		                    (duk_size_t) DUK_HBUFFER_GET_SIZE(h));
+		break;
+	}
+	case DUK_TAG_OBJECT: {
+		duk_hobject *h = DUK_TVAL_GET_OBJECT(tv);
+		DUK_ASSERT(h != NULL);
+
+		if (DUK_HOBJECT_IS_CALLABLE(h)) {
+			duk__cbor_emit_byte(enc_ctx, 0xf7);
+			break;
+		}
+
+		switch (DUK_HOBJECT_GET_CLASS_NUMBER(h)) {
+		case DUK_HOBJECT_CLASS_NUMBER:
+		case DUK_HOBJECT_CLASS_STRING:
+		case DUK_HOBJECT_CLASS_BOOLEAN:
+		case DUK_HOBJECT_CLASS_BUFFER: {
+			duk_get_prop_stridx(ctx, -1, DUK_STRIDX_INT_VALUE);
+			duk__cbor_encode_value(enc_ctx);
+			break;
+		}
+		case DUK_HOBJECT_CLASS_ARRAY: {
+			duk__cbor_objarr_entry(enc_ctx);
+			duk__cbor_encode_array(enc_ctx, h);
+			enc_ctx->recursion_depth--;
+			break;
+		}
+		default: {
+			duk__cbor_objarr_entry(enc_ctx);
+			duk__cbor_encode_map(enc_ctx, h);
+			enc_ctx->recursion_depth--;
+			break;
+		}
+		}
+		break;
+	}
+	default: {
+		DUK_ASSERT(DUK_TVAL_IS_NUMBER(tv));
+		duk__cbor_encode_double(enc_ctx, DUK_TVAL_GET_NUMBER(tv));
+		break;
+	}
+	}
+
+	duk_pop(ctx);
+}
+
+/*
+ *  Decoding
+ */
+
+static void duk__cbor_decode_error(duk__cbor_dec_ctx *dec_ctx) {
+	DUK_ERROR(dec_ctx->thr, DUK_ERR_TYPE_ERROR, "cbor decode failed");
+}
+
+static duk_uint8_t duk__cbor_read_u8(duk__cbor_dec_ctx *dec_ctx) {
+	if (dec_ctx->p >= dec_ctx->p_end) {
+		duk__cbor_decode_error(dec_ctx);
+	}
+	return *dec_ctx->p++;
+}
+
+static duk_uint32_t duk__cbor_read_u32(duk__cbor_dec_ctx *dec_ctx, int nbytes) {
+	duk_uint32_t res = 0;
+
+	if ((duk_size_t) (dec_ctx->p_end - dec_ctx->p) < (duk_size_t) nbytes) {
+		duk__cbor_decode_error(dec_ctx);
+	}
+	while (nbytes-- > 0) {
+		res = (res << 8) + (duk_uint32_t) (*dec_ctx->p++);
+	}
+	return res;
+}
+
+/* Read the argument for additional info 'ai' as a 64-bit value. */
+static void duk__cbor_read_arg(duk__cbor_dec_ctx *dec_ctx, int ai, duk_uint32_t *out_hi, duk_uint32_t *out_lo) {
+	*out_hi = 0;
+	if (ai < 24) {
+		*out_lo = (duk_uint32_t) ai;
+	} else if (ai == 24) {
+		*out_lo = duk__cbor_read_u32(dec_ctx, 1);
+	} else if (ai == 25) {
+		*out_lo = duk__cbor_read_u32(dec_ctx, 2);
+	} else if (ai == 26) {
+		*out_lo = duk__cbor_read_u32(dec_ctx, 4);
+	} else if (ai == 27) {
+		*out_hi = duk__cbor_read_u32(dec_ctx, 4);
+		*out_lo = duk__cbor_read_u32(dec_ctx, 4);
+	} else {
+		/* reserved, or indefinite length where not allowed */
+		duk__cbor_decode_error(dec_ctx);
+	}
+}
+
+/* Read a length which must fit into the remaining input when each item
+ * takes at least 'min_item_size' bytes.
+ */
+static duk_size_t duk__cbor_read_length(duk__cbor_dec_ctx *dec_ctx, int ai, duk_size_t min_item_size) {
+	duk_uint32_t hi, lo;
+
+	duk__cbor_read_arg(dec_ctx, ai, &hi, &lo);
+	if (hi != 0 || (duk_size_t) lo > (duk_size_t) (dec_ctx->p_end - dec_ctx->p) / min_item_size) {
+		duk__cbor_decode_error(dec_ctx);
+	}
+	return (duk_size_t) lo;
+}
+
+static int duk__cbor_peek_break(duk__cbor_dec_ctx *dec_ctx) {
+	if (dec_ctx->p >= dec_ctx->p_end) {
+		duk__cbor_decode_error(dec_ctx);
+	}
+	if (*dec_ctx->p == DUK__CBOR_BREAK) {
+		dec_ctx->p++;
+		return 1;
+	}
+	return 0;
+}
+
+/* [ ... ] -> [ ... str/buf ] */
+static void duk__cbor_decode_data(duk__cbor_dec_ctx *dec_ctx, int major, int ai) {
+	duk_hthread *thr = dec_ctx->thr;
+	duk_context *ctx = (duk_context *) thr;
+	duk_hbuffer_dynamic *h_buf;
+	duk_size_t len;
+	duk_uint8_t ib;
+	void *buf;
+
+	if (ai != DUK__CBOR_AI_INDEFINITE) {
+		len = duk__cbor_read_length(dec_ctx, ai, 1);
+		if (major == DUK__CBOR_MT_TEXT) {
+			duk_push_lstring(ctx, (const char *) dec_ctx->p, len);
+		} else {
+			buf = duk_push_fixed_buffer(ctx, len);
+			DUK_MEMCPY(buf, (const void *) dec_ctx->p, len);
+		}
+		dec_ctx->p += len;
+		return;
+	}
+
+	/* Indefinite length: concatenation of definite length chunks of the
+	 * same major type.
+	 */
+	duk_push_dynamic_buffer(ctx, 0);
+	h_buf = (duk_hbuffer_dynamic *) duk_get_hbuffer(ctx, -1);
+	DUK_ASSERT(h_buf != NULL);
+
+	while (!duk__cbor_peek_break(dec_ctx)) {
+		ib = duk__cbor_read_u8(dec_ctx);
+		if ((int) (ib >> 5) != major || (ib & 0x1f) == DUK__CBOR_AI_INDEFINITE) {
+			duk__cbor_decode_error(dec_ctx);
+		}
+		len = duk__cbor_read_length(dec_ctx, ib & 0x1f, 1);
+		duk_hbuffer_append_bytes(thr, h_buf, (duk_uint8_t *) dec_ctx->p, len);
+		dec_ctx->p += len;
+	}
+
+	if (major == DUK__CBOR_MT_TEXT) {
+		duk_to_string(ctx, -1);
+	} else {
+		duk_to_fixed_buffer(ctx, -1);
+	}
+}
+
+static void duk__cbor_objarr_entry_dec(duk__cbor_dec_ctx *dec_ctx) {
+	duk_require_stack((duk_context *) dec_ctx->thr, DUK__CBOR_REQSTACK);
+
+	if (dec_ctx->recursion_depth >= dec_ctx->recursion_limit) {
+		DUK_ERROR(dec_ctx->thr, DUK_ERR_RANGE_ERROR, "cbor decode recursion limit");
+	}
+	dec_ctx->recursion_depth++;
+}
+
+/* [ ... ] -> [ ... arr ] */
+static void duk__cbor_decode_array(duk__cbor_dec_ctx *dec_ctx, int ai) {
+	duk_hthread *thr = dec_ctx->thr;
+	duk_context *ctx = (duk_context *) thr;
+	duk_hobject *h_arr;
+	duk_size_t len = 0;
+	duk_uint32_t arr_idx;
+	int indefinite;
+
+	duk__cbor_objarr_entry_dec(dec_ctx);
+
+	duk_push_array(ctx);
+	h_arr = duk_get_hobject(ctx, -1);
+	DUK_ASSERT(h_arr != NULL);
+
+	indefinite = (ai == DUK__CBOR_AI_INDEFINITE);
+	if (!indefinite) {
+		len = duk__cbor_read_length(dec_ctx, ai, 1);
+		if (len > 0) {
+			duk_hobject_presize_props(thr, h_arr, 0, (duk_uint32_t) len);
+		}
+	}
+
+	for (arr_idx = 0; ; arr_idx++) {
+		if (indefinite) {
+			if (duk__cbor_peek_break(dec_ctx)) {
+				break;
+			}
+			if (arr_idx >= h_arr->a_size) {
+				duk_hobject_presize_props(thr, h_arr, 0, arr_idx * 2 + 8);
+			}
+		} else if ((duk_size_t) arr_idx >= len) {
+			break;
+		}
+
+		duk__cbor_decode_value(dec_ctx);
+		duk_hobject_define_property_internal_arridx(thr, h_arr, arr_idx, DUK_PROPDESC_FLAGS_WEC);
+	}
+
+	duk_hobject_set_length(thr, h_arr, arr_idx);
+	if (indefinite && h_arr->a_size - arr_idx > arr_idx / 4 + 8) {
+		duk_hobject_compact_props(thr, h_arr);
+	}
+
+	dec_ctx->recursion_depth--;
+}
+
+/* [ ... ] -> [ ... obj ] */
+static void duk__cbor_decode_map(duk__cbor_dec_ctx *dec_ctx, int ai) {
+	duk_hthread *thr = dec_ctx->thr;
+	duk_context *ctx = (duk_context *) thr;
+	duk_hobject *h_obj;
+	duk_hstring *h_key;
+	duk_size_t len = 0;
+	duk_size_t i;
+	int indefinite;
+
+	duk__cbor_objarr_entry_dec(dec_ctx);
+
+	duk_push_object(ctx);
+	h_obj = duk_get_hobject(ctx, -1);
+	DUK_ASSERT(h_obj != NULL);
+
+	indefinite = (ai == DUK__CBOR_AI_INDEFINITE);
+	if (!indefinite) {
+		len = duk__cbor_read_length(dec_ctx, ai, 2);
+		if (len > 0) {
+			duk_hobject_presize_props(thr, h_obj, (duk_uint32_t) len, 0);
+		}
+	}
+
+	for (i = 0; ; i++) {
+		if (indefinite) {
+			if (duk__cbor_peek_break(dec_ctx)) {
+				break;
+			}
+		} else if (i >= len) {
+			break;
+		}
+
+		duk__cbor_decode_value(dec_ctx);  /* key */
+		duk__cbor_decode_value(dec_ctx);  /* value */
+
+		/* [ ... obj key val ] */
+
+		h_key = duk_to_property_key_hstring(ctx, -2);
+		DUK_ASSERT(h_key != NULL);
+		duk_hobject_define_property_internal(thr, h_obj, h_key, DUK_PROPDESC_FLAGS_WEC);
+		duk_pop(ctx);
+	}
+
+	if (!indefinite && h_obj->e_used * 2 < h_obj->e_size) {
+		/* duplicate keys */
+		duk_hobject_compact_props(thr, h_obj);
+	}
+
+	dec_ctx->recursion_depth--;
+}
+
+static duk_double_t duk__cbor_decode_half(duk_uint32_t half) {
+	duk_double_union du;
+	duk_uint32_t expt = (half >> 10) & 0x1f;
+	duk_uint32_t mant = half & 0x3ff;
+	duk_double_t d;
+
+	if (expt == 0) {
+		/* zero or subnormal: mant * 2^-24 */
+		d = (duk_double_t) mant / 16777216.0;
+		return (half & 0x8000 ? -d : d);
+	}
+
+	/* Normal numbers, infinities and NaNs map directly to double bits. */
+	expt = (expt == 0x1f ? 0x7ff : expt - 15 + 1023);
+	DUK_DBLUNION_SET_HIGH32(&du, ((half & 0x8000UL) << 16) | (expt << 20) | (mant << 10));
+	DUK_DBLUNION_SET_LOW32(&du, 0);
+	return DUK_DBLUNION_GET_DOUBLE(&du);
+}
+
+/* [ ... ] -> [ ... val ] */
+static void duk__cbor_decode_value(duk__cbor_dec_ctx *dec_ctx) {
+	duk_context *ctx = (duk_context *) dec_ctx->thr;
+	duk_double_union du;
+	duk_uint32_t hi, lo;
+	duk_uint8_t ib;
+	int major;
+	int ai;
+	union {
+		float f;
+		duk_uint32_t u;
+	} fu;
+
+	for (;;) {
+		ib = duk__cbor_read_u8(dec_ctx);
+		major = ib >> 5;
+		ai = ib & 0x1f;
+		if (major != DUK__CBOR_MT_TAG) {
+			break;
+		}
+		/* Tags are ignored, the tagged item is decoded as is. */
+		duk__cbor_read_arg(dec_ctx, ai, &hi, &lo);
+	}
+
+	switch (major) {
+	case DUK__CBOR_MT_UINT: {
+		duk__cbor_read_arg(dec_ctx, ai, &hi, &lo);
+		duk_push_number(ctx, (duk_double_t) hi * 4294967296.0 + (duk_double_t) lo);
+		break;
+	}
+	case DUK__CBOR_MT_NINT: {
+		/* -1 - n, computed as -(n + 1) to round only once */
+		duk__cbor_read_arg(dec_ctx, ai, &hi, &lo);
+		lo++;
+		duk_push_number(ctx, -((duk_double_t) hi * 4294967296.0 +
+		                       (lo == 0 ? 4294967296.0 : (duk_double_t) lo)));
+		break;
+	}
+	case DUK__CBOR_MT_BYTES:
+	case DUK__CBOR_MT_TEXT: {
+		duk__cbor_decode_data(dec_ctx, major, ai);
+		break;
+	}
+	case DUK__CBOR_MT_ARRAY: {
+		duk__cbor_decode_array(dec_ctx, ai);
+		break;
+	}
+	case DUK__CBOR_MT_MAP: {
+		duk__cbor_decode_map(dec_ctx, ai);
+		break;
+	}
+	default: {
+		DUK_ASSERT(major == DUK__CBOR_MT_SIMPLE);
+		switch (ai) {
+		case 20:
+			duk_push_false(ctx);
+			break;
+		case 21:
+			duk_push_true(ctx);
+			break;
+		case 22:
+			duk_push_null(ctx);
+			break;
+		case 23:
+			duk_push_undefined(ctx);
+			break;
+		case 25:
+			duk_push_number(ctx, duk__cbor_decode_half(duk__cbor_read_u32(dec_ctx, 2)));
+			break;
+		case 26:
+			fu.u = duk__cbor_read_u32(dec_ctx, 4);
+			duk_push_number(ctx, (duk_double_t) fu.f);
+			break;
+		case 27:
+			hi = duk__cbor_read_u32(dec_ctx, 4);
+			lo = duk__cbor_read_u32(dec_ctx, 4);
+			DUK_DBLUNION_SET_HIGH32(&du, hi);
+			DUK_DBLUNION_SET_LOW32(&du, lo);
+			duk_push_number(ctx, DUK_DBLUNION_GET_DOUBLE(&du));
+			break;
+		default:
+			/* other simple values, unexpected break */
+			duk__cbor_decode_error(dec_ctx);
+		}
+		break;
+	}
+	}
+}
+
+#endif  /* DUK_USE_CBOR */
+
+/*
+ *  API calls
+ */
+
+void duk_cbor_encode(duk_context *ctx, int index) {
+#ifdef DUK_USE_CBOR
+	duk_hthread *thr = (duk_hthread *) ctx;
+	duk__cbor_enc_ctx enc_ctx;
+#ifdef DUK_USE_ASSERTIONS
+	int top_at_entry = duk_get_top(ctx);
+#endif
+
+	index = duk_require_normalize_index(ctx, index);
+
+	DUK_MEMZERO(&enc_ctx, sizeof(enc_ctx));
+	enc_ctx.thr = thr;
+	enc_ctx.recursion_limit = DUK__CBOR_RECURSION_LIMIT;
+
+	duk_push_dynamic_buffer(ctx, 0);
+	enc_ctx.h_buf = (duk_hbuffer_dynamic *) duk_get_hbuffer(ctx, -1);
+	DUK_ASSERT(enc_ctx.h_buf != NULL);
+
+	duk_dup(ctx, index);
+	duk__cbor_encode_value(&enc_ctx);  /* [ ... buf val ] -> [ ... buf ] */
+
+	duk_hbuffer_compact(thr, enc_ctx.h_buf);
+	duk_replace(ctx, index);
+
+	DUK_ASSERT(duk_get_top(ctx) == top_at_entry);
+#else
+	DUK_UNREF(index);
+	DUK_ERROR((duk_hthread *) ctx, DUK_ERR_UNSUPPORTED_ERROR, "cbor support disabled");
+#endif
+}
+
+void duk_cbor_decode(duk_context *ctx, int index) {
+#ifdef DUK_USE_CBOR
+	duk_hthread *thr = (duk_hthread *) ctx;
+	duk__cbor_dec_ctx dec_ctx;
+	duk_size_t len;
+#ifdef DUK_USE_ASSERTIONS
+	int top_at_entry = duk_get_top(ctx);
+#endif
+
+	index = duk_require_normalize_index(ctx, index);
+
+	DUK_MEMZERO(&dec_ctx, sizeof(dec_ctx));
+	dec_ctx.thr = thr;
+	dec_ctx.recursion_limit = DUK__CBOR_RECURSION_LIMIT;
+
+	/* Buffer data is used as is, other values are coerced to strings
+	 * whose bytes are then decoded.  The input value stays on the value
+	 * stack until decoding is complete.
+	 */
+	if (duk_is_buffer(ctx, index)) {
+		dec_ctx.p = (const duk_uint8_t *) duk_get_buffer(ctx, index, &len);
+	} else {
+		dec_ctx.p = (const duk_uint8_t *) duk_to_lstring(ctx, index, &len);
+	}
+	dec_ctx.p_end = dec_ctx.p + len;
+
+	duk__cbor_decode_value(&dec_ctx);
+	if (dec_ctx.p != dec_ctx.p_end) {
+		duk__cbor_decode_error(&dec_ctx);
+	}
+
+	duk_replace(ctx, index);
+
+	DUK_ASSERT(duk_get_top(ctx) == top_at_entry);
+#else
+	DUK_UNREF(index);
+	DUK_ERROR((duk_hthread *) ctx, DUK_ERR_UNSUPPORTED_ERROR, "cbor support disabled");
+#endif
+}
@@ -360,3 +360,35 @@ void duk_json_decode(duk_context *ctx, int index) {
 	DUK_ASSERT(duk_get_top(ctx) == top_at_entry);
 }
 
+void duk_push_json_decoder(duk_context *ctx, int callback_index) {
+#ifdef DUK_USE_ASSERTIONS
+	int top_at_entry = duk_get_top(ctx);
+#endif
+
+	duk_bi_json_stream_push(ctx, callback_index);
+
+	DUK_ASSERT(duk_get_top(ctx) == top_at_entry + 1);
+}
+
+void duk_json_decoder_feed(duk_context *ctx, int index, const void *data, duk_size_t len) {
+#ifdef DUK_USE_ASSERTIONS
+	int top_at_entry = duk_get_top(ctx);
+#endif
+
+	index = duk_require_normalize_index(ctx, index);
+	duk_bi_json_stream_feed(ctx, index, (const duk_uint8_t *) data, len);
+
+	DUK_ASSERT(duk_get_top(ctx) == top_at_entry);
+}
+
+void duk_json_decoder_finish(duk_context *ctx, int index) {
+#ifdef DUK_USE_ASSERTIONS
+	int top_at_entry = duk_get_top(ctx);
+#endif
+
+	index = duk_require_normalize_index(ctx, index);
+	duk_bi_json_stream_finish(ctx, index);
+
+	DUK_ASSERT(duk_get_top(ctx) == top_at_entry);
+}
+
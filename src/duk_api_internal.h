@@ -49,6 +49,7 @@ duk_hnativefunction *duk_get_hnativefunction(duk_context *ctx, int index);
  */
 
 duk_hstring *duk_to_hstring(duk_context *ctx, int index);
+duk_hstring *duk_to_property_key_hstring(duk_context *ctx, int index);  /* duk_to_hstring() + intern non-interned strings */
 int duk_to_int_clamped_raw(duk_context *ctx, int index, int minval, int maxval, int *out_clamped);  /* out_clamped=NULL, RangeError if outside range */
 int duk_to_int_clamped(duk_context *ctx, int index, int minval, int maxval);
 int duk_to_int_check_range(duk_context *ctx, int index, int minval, int maxval);
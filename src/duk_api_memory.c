@@ -100,3 +100,29 @@ void duk_gc(duk_context *ctx, int flags) {
 #endif
 }
 
+void duk_get_regexp_cache_stats(duk_context *ctx, duk_regexp_cache_stats *out_stats) {
+	duk_hthread *thr = (duk_hthread *) ctx;
+#if defined(DUK_USE_REGEXP_CACHE)
+	duk_heap *heap;
+	int i;
+#endif
+
+	DUK_ASSERT(ctx != NULL);
+	DUK_ASSERT(out_stats != NULL);
+	DUK_ASSERT(thr != NULL);
+	DUK_ASSERT(thr->heap != NULL);
+
+	DUK_MEMZERO(out_stats, sizeof(*out_stats));
+#if defined(DUK_USE_REGEXP_CACHE)
+	heap = thr->heap;
+	out_stats->hits = (duk_size_t) heap->recache_hits;
+	out_stats->misses = (duk_size_t) heap->recache_misses;
+	for (i = 0; i < DUK_HEAP_RECACHE_SIZE; i++) {
+		if (heap->recache[i].pattern) {
+			out_stats->entries++;
+		}
+	}
+#else
+	DUK_UNREF(thr);
+#endif
+}
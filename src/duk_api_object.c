@@ -253,7 +253,7 @@ void duk_def_prop(duk_context *ctx, int obj_index, int desc_flags) {
 
 	obj = duk_require_hobject(ctx, obj_index);
 	DUK_ASSERT(obj != NULL);
-	key = duk_to_hstring(ctx, -2);
+	key = duk_to_property_key_hstring(ctx, -2);
 	DUK_ASSERT(key != NULL);
 	DUK_ASSERT(duk_require_tval(ctx, -1) != NULL);
 
@@ -192,15 +192,22 @@ void duk_substring(duk_context *ctx, int index, size_t start_offset, size_t end_
 	DUK_ASSERT_DISABLE(end_offset >= 0);
 	DUK_ASSERT(end_offset >= start_offset && end_offset <= DUK_HSTRING_GET_CHARLEN(h));
 
-	start_byte_offset = (size_t) duk_heap_strcache_offset_char2byte(thr, h, start_offset);
-	end_byte_offset = (size_t) duk_heap_strcache_offset_char2byte(thr, h, end_offset);
+	if (DUK_HSTRING_HAS_ASCII(h)) {
+		/* char offsets are byte offsets, no need for a string cache lookup */
+		start_byte_offset = start_offset;
+		end_byte_offset = end_offset;
+	} else {
+		start_byte_offset = (size_t) duk_heap_strcache_offset_char2byte(thr, h, start_offset);
+		end_byte_offset = (size_t) duk_heap_strcache_offset_char2byte(thr, h, end_offset);
+	}
 
 	DUK_ASSERT(end_byte_offset >= start_byte_offset);
 
-	/* no size check is necessary */
-	res = duk_heap_string_intern_checked(thr,
-	                                     DUK_HSTRING_GET_DATA(h) + start_byte_offset,
-	                                     end_byte_offset - start_byte_offset);
+	/* no size check is necessary; long substrings become slices of 'h' */
+	res = duk_heap_string_substring_checked(thr,
+	                                        h,
+	                                        (duk_uint32_t) start_byte_offset,
+	                                        (duk_uint32_t) (end_byte_offset - start_byte_offset));
 
 	duk_push_hstring(ctx, res);
 	duk_replace(ctx, index);
@@ -278,7 +285,10 @@ void duk_trim(duk_context *ctx, int index) {
 		return;
 	}
 
-	duk_push_lstring(ctx, (const char *) q_start, (size_t) (q_end - q_start));
+	duk_push_hstring(ctx, duk_heap_string_substring_checked(thr,
+	                                                        h,
+	                                                        (duk_uint32_t) (q_start - p_start),
+	                                                        (duk_uint32_t) (q_end - q_start)));
 	duk_replace(ctx, index);
 }
 
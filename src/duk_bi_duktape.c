@@ -203,6 +203,12 @@ duk_ret_t duk_bi_duktape_object_enc(duk_context *ctx) {
 		duk_set_top(ctx, 2);
 		duk_base64_encode(ctx, 1);
 		DUK_ASSERT_TOP(ctx, 2);
+#ifdef DUK_USE_CBOR
+	} else if (h_str == DUK_HTHREAD_STRING_CBOR(thr)) {
+		duk_set_top(ctx, 2);
+		duk_cbor_encode(ctx, 1);
+		DUK_ASSERT_TOP(ctx, 2);
+#endif
 #ifdef DUK_USE_JSONX
 	} else if (h_str == DUK_HTHREAD_STRING_JSONX(thr)) {
 		duk_bi_json_stringify_helper(ctx,
@@ -248,6 +254,12 @@ duk_ret_t duk_bi_duktape_object_dec(duk_context *ctx) {
 		duk_set_top(ctx, 2);
 		duk_base64_decode(ctx, 1);
 		DUK_ASSERT_TOP(ctx, 2);
+#ifdef DUK_USE_CBOR
+	} else if (h_str == DUK_HTHREAD_STRING_CBOR(thr)) {
+		duk_set_top(ctx, 2);
+		duk_cbor_decode(ctx, 1);
+		DUK_ASSERT_TOP(ctx, 2);
+#endif
 #ifdef DUK_USE_JSONX
 	} else if (h_str == DUK_HTHREAD_STRING_JSONX(thr)) {
 		duk_bi_json_parse_helper(ctx,
@@ -195,7 +195,7 @@ static int duk__traceback_getter_helper(duk_context *ctx, int output_type) {
 
 				h_name = duk_get_hstring(ctx, -2);  /* may be NULL */
 				funcname = (h_name == NULL || h_name == DUK_HTHREAD_STRING_EMPTY_STRING(thr)) ?
-				           "anon" : (const char *) DUK_HSTRING_GET_DATA(h_name);
+				           "anon" : duk_get_string(ctx, -2);
 				if (DUK_HOBJECT_HAS_NATIVEFUNCTION(h_func)) {
 					duk_push_sprintf(ctx, "%s %s native%s%s%s%s%s",
 					                 funcname,
@@ -17,6 +17,7 @@ static int duk__dec_get(duk_json_dec_ctx *js_ctx);
 static int duk__dec_get_nonwhite(duk_json_dec_ctx *js_ctx);
 static duk_uint32_t duk__dec_decode_hex_escape(duk_json_dec_ctx *js_ctx, int n);
 static void duk__dec_req_stridx(duk_json_dec_ctx *js_ctx, int stridx);
+static duk_uint8_t *duk__dec_scan_plain(duk_uint8_t *p, duk_uint8_t *p_end);
 static void duk__dec_string(duk_json_dec_ctx *js_ctx);
 #ifdef DUK_USE_JSONX
 static void duk__dec_plain_string(duk_json_dec_ctx *js_ctx);
@@ -30,7 +31,13 @@ static void duk__dec_object(duk_json_dec_ctx *js_ctx);
 static void duk__dec_array(duk_json_dec_ctx *js_ctx);
 static void duk__dec_value(duk_json_dec_ctx *js_ctx);
 static void duk__dec_reviver_walk(duk_json_dec_ctx *js_ctx);
+static duk_json_dec_stream *duk__dec_stream_get(duk_context *ctx, int idx_decoder);
+static void duk__dec_stream_decode(duk_json_dec_stream *st, duk_uint8_t *p, duk_uint8_t *p_end);
+static void duk__dec_stream_element(duk_context *ctx, duk_json_dec_stream *st, duk_uint8_t *p, duk_uint8_t *p_end);
+static void duk__dec_stream_scan(duk_context *ctx, duk_json_dec_stream *st, duk_hbuffer_dynamic *h_input);
 
+static void duk__emit_grow(duk_json_enc_ctx *js_ctx, size_t len);
+static void duk__emit_bytes(duk_json_enc_ctx *js_ctx, const duk_uint8_t *data, size_t len);
 static void duk__emit_1(duk_json_enc_ctx *js_ctx, char ch);
 static void duk__emit_2(duk_json_enc_ctx *js_ctx, int chars);
 static void duk__emit_esc_auto(duk_json_enc_ctx *js_ctx, duk_uint32_t cp);
@@ -40,7 +47,9 @@ static void duk__emit_hstring(duk_json_enc_ctx *js_ctx, duk_hstring *h);
 static void duk__emit_cstring(duk_json_enc_ctx *js_ctx, const char *p);
 #endif
 static int duk__enc_key_quotes_needed(duk_hstring *h_key);
+static duk_uint8_t *duk__enc_scan_plain(duk_uint8_t *p, duk_uint8_t *p_end);
 static void duk__enc_quote_string(duk_json_enc_ctx *js_ctx, duk_hstring *h_str);
+static void duk__enc_double(duk_json_enc_ctx *js_ctx, duk_double_t d);
 static void duk__enc_objarr_entry(duk_json_enc_ctx *js_ctx, duk_hstring **h_stepback, duk_hstring **h_indent, int *entry_top);
 static void duk__enc_objarr_exit(duk_json_enc_ctx *js_ctx, duk_hstring **h_stepback, duk_hstring **h_indent, int *entry_top);
 static void duk__enc_object(duk_json_enc_ctx *js_ctx);
@@ -48,6 +57,13 @@ static void duk__enc_array(duk_json_enc_ctx *js_ctx);
 static int duk__enc_value1(duk_json_enc_ctx *js_ctx, int idx_holder);
 static void duk__enc_value2(duk_json_enc_ctx *js_ctx);
 static int duk__enc_allow_into_proplist(duk_tval *tv);
+#if defined(DUK_USE_JSON_STRINGIFY_FASTPATH)
+static duk_small_int_t duk__enc_fast_check_proto(duk_json_enc_ctx *js_ctx, duk_hobject *h);
+static duk_small_int_t duk__enc_fast_object(duk_json_enc_ctx *js_ctx, duk_hobject *h);
+static duk_small_int_t duk__enc_fast_array(duk_json_enc_ctx *js_ctx, duk_hobject *h);
+static duk_small_int_t duk__enc_fast_value(duk_json_enc_ctx *js_ctx, duk_tval *tv);
+static int duk__enc_fast_safe(duk_context *ctx);
+#endif
 
 /*
  *  Parsing implementation.
@@ -179,10 +195,69 @@ static void duk__dec_req_stridx(duk_json_dec_ctx *js_ctx, int stridx) {
 	DUK_UNREACHABLE();
 }
 
+/* Scan a run of plain string bytes, i.e. bytes other than '"', '\\' and
+ * control characters (0x00...0x1f), and return a pointer to the first
+ * byte ending the run (or p_end).  Non-ASCII bytes are plain.
+ *
+ * The bulk of the input is checked a word at a time: for each byte lane,
+ * bit 7 of (w - n) & ~w is set if the byte is below n (exact for n <= 0x80
+ * as far as "some lane matches" is concerned), and a byte equal to c is
+ * found as a byte below 1 in w ^ c.  A word with a match is rescanned
+ * bytewise to locate the terminator.
+ */
+#if defined(DUK_USE_64BIT_OPS)
+typedef duk_uint64_t duk__json_word_t;
+#define DUK__JSON_WORD_HIBITS  ((((duk__json_word_t) 0x80808080UL) << 32) | ((duk__json_word_t) 0x80808080UL))
+#define DUK__JSON_WORD_LOBITS  ((((duk__json_word_t) 0x01010101UL) << 32) | ((duk__json_word_t) 0x01010101UL))
+#else
+typedef duk_uint32_t duk__json_word_t;
+#define DUK__JSON_WORD_HIBITS  ((duk__json_word_t) 0x80808080UL)
+#define DUK__JSON_WORD_LOBITS  ((duk__json_word_t) 0x01010101UL)
+#endif
+#define DUK__JSON_WORD_HASLESS(w,n)  (((w) - DUK__JSON_WORD_LOBITS * (n)) & ~(w) & DUK__JSON_WORD_HIBITS)
+#define DUK__JSON_WORD_HASBYTE(w,c)  DUK__JSON_WORD_HASLESS((w) ^ (DUK__JSON_WORD_LOBITS * (c)), 1)
+
+static duk_uint8_t *duk__dec_scan_plain(duk_uint8_t *p, duk_uint8_t *p_end) {
+	duk_small_int_t x;
+
+	/* Leading bytes until word aligned. */
+	while (p < p_end && (((duk_uintptr_t) p) & (sizeof(duk__json_word_t) - 1)) != 0) {
+		x = (duk_small_int_t) *p;
+		if (x == '"' || x == '\\' || x < 0x20) {
+			return p;
+		}
+		p++;
+	}
+
+	/* Aligned words, stopping at the first word containing a terminator. */
+	while ((duk_size_t) (p_end - p) >= sizeof(duk__json_word_t)) {
+		duk__json_word_t w = *((duk__json_word_t *) p);
+
+		if (DUK__JSON_WORD_HASLESS(w, 0x20) |
+		    DUK__JSON_WORD_HASBYTE(w, 0x22) |
+		    DUK__JSON_WORD_HASBYTE(w, 0x5c)) {
+			break;
+		}
+		p += sizeof(duk__json_word_t);
+	}
+
+	/* Trailing bytes (or the word containing the terminator). */
+	while (p < p_end) {
+		x = (duk_small_int_t) *p;
+		if (x == '"' || x == '\\' || x < 0x20) {
+			break;
+		}
+		p++;
+	}
+
+	return p;
+}
+
 static void duk__dec_string(duk_json_dec_ctx *js_ctx) {
 	duk_hthread *thr = js_ctx->thr;
 	duk_context *ctx = (duk_context *) thr;
 	duk_hbuffer_dynamic *h_buf;
+	duk_uint8_t *p;
 	int x;
 
 	/* '"' was eaten by caller */
@@ -192,12 +267,28 @@ static void duk__dec_string(duk_json_dec_ctx *js_ctx) {
 	 * so they'll simply pass through (valid UTF-8 or not).
 	 */
 
+	/* Fast path: a string without escapes is interned directly from
+	 * the input, without going through a temporary buffer.
+	 */
+	p = duk__dec_scan_plain(js_ctx->p, js_ctx->p_end);
+	if (p < js_ctx->p_end && *p == (duk_uint8_t) '"') {
+		duk_push_lstring(ctx, (const char *) js_ctx->p, (size_t) (p - js_ctx->p));
+		js_ctx->p = p + 1;
+		return;
+	}
+
 	duk_push_dynamic_buffer(ctx, 0);
 	h_buf = (duk_hbuffer_dynamic *) duk_get_hbuffer(ctx, -1);
 	DUK_ASSERT(h_buf != NULL);
 	DUK_ASSERT(DUK_HBUFFER_HAS_DYNAMIC(h_buf));
 
 	for (;;) {
+		/* Runs of plain bytes between escapes are copied in one go. */
+		if (p > js_ctx->p) {
+			duk_hbuffer_append_bytes(thr, h_buf, js_ctx->p, (duk_size_t) (p - js_ctx->p));
+			js_ctx->p = p;
+		}
+
 		x = duk__dec_get(js_ctx);
 		if (x == (int) '"') {
 			break;
@@ -238,12 +329,13 @@ static void duk__dec_string(duk_json_dec_ctx *js_ctx) {
 				goto syntax_error;
 			}
 			duk_hbuffer_append_xutf8(thr, h_buf, (duk_uint32_t) x);
-		} else if (x < 0x20) {
-			/* catches EOF (-1) */
-			goto syntax_error;
 		} else {
-			duk_hbuffer_append_byte(thr, h_buf, (duk_uint8_t) x);
+			/* control character; catches EOF (-1) */
+			DUK_ASSERT(x < 0x20);
+			goto syntax_error;
 		}
+
+		p = duk__dec_scan_plain(js_ctx->p, js_ctx->p_end);
 	}
 
 	duk_to_string(ctx, -1);
@@ -436,6 +528,38 @@ static void duk__dec_number(duk_json_dec_ctx *js_ctx) {
 	}
 
 	DUK_ASSERT(js_ctx->p > p_start);
+
+	/* Fast path for plain integers (optional minus sign, at most 15
+	 * digits, no leading zeroes) which are exact as doubles and need
+	 * no interned temporary string.
+	 */
+	{
+		duk_uint8_t *p = p_start;
+		duk_double_t val = 0.0;
+		duk_small_int_t neg = 0;
+
+		if (*p == (duk_uint8_t) '-') {
+			neg = 1;
+			p++;
+		}
+		if (js_ctx->p - p <= 15 && js_ctx->p > p &&
+		    (*p != (duk_uint8_t) '0' || js_ctx->p - p == 1)) {
+			while (p < js_ctx->p) {
+				x = (int) *p;
+				if (!(x >= (int) '0' && x <= (int) '9')) {
+					break;
+				}
+				val = val * 10.0 + (duk_double_t) (x - (int) '0');
+				p++;
+			}
+			if (p == js_ctx->p) {
+				duk_push_number(ctx, neg ? -val : val);
+				DUK_DDDPRINT("parse_number: integer fast path: %!T", duk_get_tval(ctx, -1));
+				return;
+			}
+		}
+	}
+
 	duk_push_lstring(ctx, (const char *) p_start, (size_t) (js_ctx->p - p_start));
 
 	s2n_flags = DUK_S2N_FLAG_ALLOW_EXP |
@@ -476,7 +600,12 @@ static void duk__dec_objarr_exit(duk_json_dec_ctx *js_ctx) {
 }
 
 static void duk__dec_object(duk_json_dec_ctx *js_ctx) {
-	duk_context *ctx = (duk_context *) js_ctx->thr;
+	duk_hthread *thr = js_ctx->thr;
+	duk_context *ctx = (duk_context *) thr;
+	duk_hobject *h_obj;
+	duk_hstring *h_key;
+	duk_uint32_t size_hint;
+	int depth;
 	int key_count;
 	int x;
 
@@ -485,6 +614,21 @@ static void duk__dec_object(duk_json_dec_ctx *js_ctx) {
 	duk__dec_objarr_entry(js_ctx);
 
 	duk_push_object(ctx);
+	h_obj = duk_get_hobject(ctx, -1);
+	DUK_ASSERT(h_obj != NULL);
+
+	/* Objects at the same depth are often of the same shape (e.g. records
+	 * in an array), so presize the entry part based on the key count of
+	 * the previous object at this depth.
+	 */
+	depth = js_ctx->recursion_depth - 1;
+	size_hint = 0;
+	if (depth < DUK_JSON_DEC_SIZE_HINT_DEPTH) {
+		size_hint = js_ctx->obj_size_hint[depth];
+		if (size_hint > 0) {
+			duk_hobject_presize_props(thr, h_obj, size_hint, 0);
+		}
+	}
 
 	/* Initial '{' has been checked and eaten by caller. */
 
@@ -537,7 +681,13 @@ static void duk__dec_object(duk_json_dec_ctx *js_ctx) {
 
 		/* [ ... obj key val ] */
 
-		duk_put_prop(ctx, -3);
+		/* Properties are defined directly (E5.1 Section 15.12.2 uses
+		 * [[DefineOwnProperty]]); a duplicate key updates the value.
+		 */
+		h_key = duk_to_property_key_hstring(ctx, -2);
+		DUK_ASSERT(h_key != NULL);
+		duk_hobject_define_property_internal(thr, h_obj, h_key, DUK_PROPDESC_FLAGS_WEC);
+		duk_pop(ctx);
 
 		/* [ ... obj ] */
 
@@ -546,6 +696,14 @@ static void duk__dec_object(duk_json_dec_ctx *js_ctx) {
 
 	/* [ ... obj ] */
 
+	if (depth < DUK_JSON_DEC_SIZE_HINT_DEPTH) {
+		js_ctx->obj_size_hint[depth] = (duk_uint32_t) key_count;
+	}
+	if (size_hint > 0 && h_obj->e_used * 2 < h_obj->e_size) {
+		/* hint was badly off, don't waste the space */
+		duk_hobject_compact_props(thr, h_obj);
+	}
+
 	DUK_DDDPRINT("parse_object: final object is %!T", duk_get_tval(ctx, -1));
 
 	duk__dec_objarr_exit(js_ctx);
@@ -557,8 +715,11 @@ static void duk__dec_object(duk_json_dec_ctx *js_ctx) {
 }
 
 static void duk__dec_array(duk_json_dec_ctx *js_ctx) {
-	duk_context *ctx = (duk_context *) js_ctx->thr;
-	int arr_idx;
+	duk_hthread *thr = js_ctx->thr;
+	duk_context *ctx = (duk_context *) thr;
+	duk_hobject *h_arr;
+	duk_uint32_t arr_idx;
+	int depth;
 	int x;
 
 	DUK_DDDPRINT("parse_array");
@@ -566,6 +727,15 @@ static void duk__dec_array(duk_json_dec_ctx *js_ctx) {
 	duk__dec_objarr_entry(js_ctx);
 
 	duk_push_array(ctx);
+	h_arr = duk_get_hobject(ctx, -1);
+	DUK_ASSERT(h_arr != NULL);
+	DUK_ASSERT(DUK_HOBJECT_HAS_ARRAY_PART(h_arr));
+
+	/* Presize the array part like for objects, see duk__dec_object(). */
+	depth = js_ctx->recursion_depth - 1;
+	if (depth < DUK_JSON_DEC_SIZE_HINT_DEPTH && js_ctx->arr_size_hint[depth] > 0) {
+		duk_hobject_presize_props(thr, h_arr, 0, js_ctx->arr_size_hint[depth]);
+	}
 
 	/* Initial '[' has been checked and eaten by caller. */
 
@@ -574,7 +744,7 @@ static void duk__dec_array(duk_json_dec_ctx *js_ctx) {
 		x = duk__dec_get_nonwhite(js_ctx);
 
 		DUK_DDDPRINT("parse_array: arr=%!T, x=%d, arr_idx=%d",
-		             duk_get_tval(ctx, -1), x, arr_idx);
+		             duk_get_tval(ctx, -1), x, (int) arr_idx);
 
 		/* handle comma and closing bracket */
 
@@ -600,12 +770,27 @@ static void duk__dec_array(duk_json_dec_ctx *js_ctx) {
 
 		/* [ ... arr val ] */
 
-		duk_put_prop_index(ctx, -2, arr_idx);
+		/* Elements are written directly into the array part and 'length'
+		 * is updated once at the end.  The array part is grown by doubling
+		 * which avoids repeated resizes for large arrays.
+		 */
+		if (arr_idx >= h_arr->a_size) {
+			duk_hobject_presize_props(thr, h_arr, 0, arr_idx * 2 + 8);
+		}
+		duk_hobject_define_property_internal_arridx(thr, h_arr, arr_idx, DUK_PROPDESC_FLAGS_WEC);
 		arr_idx++;
 	}
 
 	/* [ ... arr ] */
 
+	duk_hobject_set_length(thr, h_arr, arr_idx);
+	if (depth < DUK_JSON_DEC_SIZE_HINT_DEPTH) {
+		js_ctx->arr_size_hint[depth] = arr_idx;
+	}
+	if (h_arr->a_size - arr_idx > arr_idx / 4 + 8) {
+		duk_hobject_compact_props(thr, h_arr);
+	}
+
 	DUK_DDDPRINT("parse_array: final array is %!T", duk_get_tval(ctx, -1));
 
 	duk__dec_objarr_exit(js_ctx);
@@ -774,15 +959,46 @@ static void duk__dec_reviver_walk(duk_json_dec_ctx *js_ctx) {
 #endif
 #define DUK__EMIT_STRIDX(js_ctx,i)      duk__emit_stridx((js_ctx),(i))
 
+/* Emit helpers write directly into the spare part of the output buffer
+ * when it is large enough, i.e. with a single bounds check, and only call
+ * into duk_hbuffer_ops.c to grow the buffer.  The buffer is grown by 50%
+ * so that large outputs don't need a realloc every few kilobytes.
+ */
+static void duk__emit_grow(duk_json_enc_ctx *js_ctx, size_t len) {
+	duk_hbuffer_dynamic *h_buf = js_ctx->h_buf;
+	size_t size = DUK_HBUFFER_GET_SIZE(h_buf);
+
+	duk_hbuffer_resize(js_ctx->thr, h_buf, size, size + len + (size >> 1) + 64);
+	DUK_ASSERT(DUK_HBUFFER_DYNAMIC_GET_SPARE_SIZE(h_buf) >= len);
+}
+
+static void duk__emit_bytes(duk_json_enc_ctx *js_ctx, const duk_uint8_t *data, size_t len) {
+	duk_hbuffer_dynamic *h_buf = js_ctx->h_buf;
+
+	if (DUK_UNLIKELY(DUK_HBUFFER_DYNAMIC_GET_SPARE_SIZE(h_buf) < len)) {
+		duk__emit_grow(js_ctx, len);
+	}
+	DUK_MEMCPY((void *) ((duk_uint8_t *) DUK_HBUFFER_DYNAMIC_GET_CURR_DATA_PTR(h_buf) + DUK_HBUFFER_GET_SIZE(h_buf)),
+	           (const void *) data,
+	           len);
+	DUK_HBUFFER_SET_SIZE(h_buf, DUK_HBUFFER_GET_SIZE(h_buf) + len);
+}
+
 static void duk__emit_1(duk_json_enc_ctx *js_ctx, char ch) {
-	duk_hbuffer_append_byte(js_ctx->thr, js_ctx->h_buf, (duk_uint8_t) ch);
+	duk_hbuffer_dynamic *h_buf = js_ctx->h_buf;
+
+	if (DUK_UNLIKELY(DUK_HBUFFER_DYNAMIC_GET_SPARE_SIZE(h_buf) < 1)) {
+		duk__emit_grow(js_ctx, 1);
+	}
+	((duk_uint8_t *) DUK_HBUFFER_DYNAMIC_GET_CURR_DATA_PTR(h_buf))[DUK_HBUFFER_GET_SIZE(h_buf)] = (duk_uint8_t) ch;
+	DUK_HBUFFER_SET_SIZE(h_buf, DUK_HBUFFER_GET_SIZE(h_buf) + 1);
 }
 
 static void duk__emit_2(duk_json_enc_ctx *js_ctx, int chars) {
 	duk_uint8_t buf[2];
-	buf[0] = (chars >> 8);
-	buf[1] = chars & 0xff;
-	duk_hbuffer_append_bytes(js_ctx->thr, js_ctx->h_buf, (duk_uint8_t *) buf, 2);
+	buf[0] = (duk_uint8_t) (chars >> 8);
+	buf[1] = (duk_uint8_t) (chars & 0xff);
+	duk__emit_bytes(js_ctx, buf, 2);
 }
 
 #define DUK__MKESC(nybbles,esc1,esc2)  \
@@ -830,13 +1046,13 @@ static void duk__emit_esc_auto(duk_json_enc_ctx *js_ctx, duk_uint32_t cp) {
 
 	buf[0] = (duk_uint8_t) ((tmp >> 8) & 0xff);
 	buf[1] = (duk_uint8_t) (tmp & 0xff);
-	duk_hbuffer_append_bytes(js_ctx->thr, js_ctx->h_buf, buf, 2);
+	duk__emit_bytes(js_ctx, buf, 2);
 
 	tmp = tmp >> 16;
 	while (tmp > 0) {
 		tmp--;
 		dig = (cp >> (4 * tmp)) & 0x0f;
-		duk_hbuffer_append_byte(js_ctx->thr, js_ctx->h_buf, duk_lc_digits[dig]);
+		duk__emit_1(js_ctx, (char) duk_lc_digits[dig]);
 	}
 }
 
@@ -846,10 +1062,9 @@ static void duk__emit_xutf8(duk_json_enc_ctx *js_ctx, duk_uint32_t cp) {
 
 static void duk__emit_hstring(duk_json_enc_ctx *js_ctx, duk_hstring *h) {
 	DUK_ASSERT(h != NULL);
-	duk_hbuffer_append_bytes(js_ctx->thr,
-	                         js_ctx->h_buf,
-	                         (duk_uint8_t *) DUK_HSTRING_GET_DATA(h),
-	                         (size_t) DUK_HSTRING_GET_BYTELEN(h));
+	duk__emit_bytes(js_ctx,
+	                (const duk_uint8_t *) DUK_HSTRING_GET_DATA(h),
+	                (size_t) DUK_HSTRING_GET_BYTELEN(h));
 }
 
 #if defined(DUK_USE_JSONX) || defined(DUK_USE_JSONC)
@@ -906,6 +1121,48 @@ static int duk__enc_key_quotes_needed(duk_hstring *h_key) {
 	return 0;
 }
 
+/* Find the end of a run of printable ASCII (0x20...0x7e) other than '"'
+ * and '\\', which is emitted as is in all modes.  Like duk__dec_scan_plain()
+ * but bytes 0x7f and above also end the run (checked as "byte + 1 has its
+ * high bit set").
+ */
+static duk_uint8_t *duk__enc_scan_plain(duk_uint8_t *p, duk_uint8_t *p_end) {
+	duk_small_int_t x;
+
+	/* Leading bytes until word aligned. */
+	while (p < p_end && (((duk_uintptr_t) p) & (sizeof(duk__json_word_t) - 1)) != 0) {
+		x = (duk_small_int_t) *p;
+		if (x < 0x20 || x >= 0x7f || x == '"' || x == '\\') {
+			return p;
+		}
+		p++;
+	}
+
+	/* Aligned words, stopping at the first word containing a terminator. */
+	while ((duk_size_t) (p_end - p) >= sizeof(duk__json_word_t)) {
+		duk__json_word_t w = *((duk__json_word_t *) p);
+
+		if (DUK__JSON_WORD_HASLESS(w, 0x20) |
+		    (((w + DUK__JSON_WORD_LOBITS) | w) & DUK__JSON_WORD_HIBITS) |
+		    DUK__JSON_WORD_HASBYTE(w, 0x22) |
+		    DUK__JSON_WORD_HASBYTE(w, 0x5c)) {
+			break;
+		}
+		p += sizeof(duk__json_word_t);
+	}
+
+	/* Trailing bytes (or the word containing the terminator). */
+	while (p < p_end) {
+		x = (duk_small_int_t) *p;
+		if (x < 0x20 || x >= 0x7f || x == '"' || x == '\\') {
+			break;
+		}
+		p++;
+	}
+
+	return p;
+}
+
 /* The Quote(value) operation: quote a string.
  *
  * Stack policy: [ ] -> [ ].
@@ -931,6 +1188,16 @@ static void duk__enc_quote_string(duk_json_enc_ctx *js_ctx, duk_hstring *h_str)
 	DUK__EMIT_1(js_ctx, '"');
 
 	while (p < p_end) {
+		/* Runs of printable ASCII are copied in one go. */
+		p_tmp = duk__enc_scan_plain(p, p_end);
+		if (p_tmp > p) {
+			duk__emit_bytes(js_ctx, p, (size_t) (p_tmp - p));
+			p = p_tmp;
+			if (p >= p_end) {
+				break;
+			}
+		}
+
 		cp = *p;
 
 		if (cp <= 0x7f) {
@@ -992,6 +1259,45 @@ static void duk__enc_quote_string(duk_json_enc_ctx *js_ctx, duk_hstring *h_str)
 	DUK__EMIT_1(js_ctx, '"');
 }
 
+/* Emit a finite number.  Integers below 2^32 in magnitude (the common
+ * case) are formatted directly into the output; other values go through
+ * duk_numconv_stringify().  Negative zero is serialized as "0".
+ */
+static void duk__enc_double(duk_json_enc_ctx *js_ctx, duk_double_t d) {
+	duk_context *ctx = (duk_context *) js_ctx->thr;
+	duk_uint8_t buf[16];
+	duk_uint8_t *q;
+	duk_double_t d_abs;
+	duk_uint32_t v;
+	duk_hstring *h_str;
+
+	DUK_ASSERT(DUK_ISFINITE(d));
+
+	d_abs = (d < 0.0 ? -d : d);
+	if (d_abs < 4294967296.0) {
+		v = (duk_uint32_t) d_abs;
+		if ((duk_double_t) v == d_abs) {
+			q = buf + sizeof(buf);
+			do {
+				*(--q) = (duk_uint8_t) ('0' + (v % 10));
+				v = v / 10;
+			} while (v > 0);
+			if (d < 0.0) {
+				*(--q) = (duk_uint8_t) '-';
+			}
+			duk__emit_bytes(js_ctx, q, (size_t) (buf + sizeof(buf) - q));
+			return;
+		}
+	}
+
+	duk_push_number(ctx, d);
+	duk_numconv_stringify(ctx, 10 /*radix*/, 0 /*digits*/, 0 /*flags*/);
+	h_str = duk_get_hstring(ctx, -1);
+	DUK_ASSERT(h_str != NULL);
+	DUK__EMIT_HSTR(js_ctx, h_str);
+	duk_pop(ctx);
+}
+
 /* Shared entry handling for object/array serialization: indent/stepback,
  * loop detection.
  */
@@ -1540,8 +1846,6 @@ static void duk__enc_value2(duk_json_enc_ctx *js_ctx) {
 		int c;
 		int s;
 		int stridx;
-		int n2s_flags;
-		duk_hstring *h_str;
 		DUK_ASSERT(DUK_TVAL_IS_NUMBER(tv));
 
 		d = DUK_TVAL_GET_NUMBER(tv);
@@ -1551,12 +1855,7 @@ static void duk__enc_value2(duk_json_enc_ctx *js_ctx) {
 
 		if (!(c == DUK_FP_INFINITE || c == DUK_FP_NAN)) {
 			DUK_ASSERT(DUK_ISFINITE(d));
-			n2s_flags = 0;
-			/* [ ... number ] -> [ ... string ] */
-			duk_numconv_stringify(ctx, 10 /*radix*/, 0 /*digits*/, n2s_flags);
-			h_str = duk_to_hstring(ctx, -1);
-			DUK_ASSERT(h_str != NULL);
-			DUK__EMIT_HSTR(js_ctx, h_str);
+			duk__enc_double(js_ctx, d);
 			break;
 		}
 
@@ -1604,6 +1903,262 @@ static int duk__enc_allow_into_proplist(duk_tval *tv) {
 	return 0;
 }
 
+#if defined(DUK_USE_JSON_STRINGIFY_FASTPATH)
+/*
+ *  Fast path for plain objects and arrays.
+ *
+ *  Used when there is no replacer, property list or indent, and standard
+ *  JSON is requested.  Values are serialized by walking the entry and array
+ *  parts directly: there is no key enumeration object, no property lookups
+ *  and no loop detection object.  Anything the fast path can't serialize
+ *  exactly like the slow path (a 'toJSON' property anywhere, accessors,
+ *  arrays with holes, wrapper objects such as Number or Date instances,
+ *  etc) aborts the fast path with a -1 return value; the caller then
+ *  discards the partial output and uses the slow path.  Return values are
+ *  used instead of throwing so that no error objects (and user error
+ *  handlers) are involved in an abort.
+ *
+ *  No user code runs in the fast path, so the object graph doesn't change
+ *  while it is walked.  However, mark-and-sweep triggered by a buffer or
+ *  string allocation could compact objects or run finalizers; the caller
+ *  prevents that using the mark-and-sweep base flags and a protected call
+ *  which ensures the flags are restored.  Reference loops are not detected
+ *  as such: a loop runs into the recursion limit which aborts the fast path,
+ *  and the slow path then throws the appropriate error.
+ *
+ *  Return value: 1 = value emitted, 0 = value serializes to 'undefined'
+ *  (nothing emitted), -1 = abort.
+ */
+
+/* Check that the prototype chain of 'h' has no 'toJSON' property.  The most
+ * recently checked object and array prototypes are remembered, because the
+ * answer can't change during the fast path.
+ */
+static duk_small_int_t duk__enc_fast_check_proto(duk_json_enc_ctx *js_ctx, duk_hobject *h) {
+	duk_hthread *thr = js_ctx->thr;
+	duk_hobject *proto;
+
+	proto = h->prototype;
+	if (proto == NULL ||
+	    proto == js_ctx->h_fast_proto[0] ||
+	    proto == js_ctx->h_fast_proto[1]) {
+		return 1;
+	}
+	if (duk_hobject_hasprop_raw(thr, proto, DUK_HTHREAD_STRING_TO_JSON(thr))) {
+		return 0;
+	}
+	js_ctx->h_fast_proto[DUK_HOBJECT_GET_CLASS_NUMBER(h) == DUK_HOBJECT_CLASS_ARRAY ? 1 : 0] = proto;
+	return 1;
+}
+
+static duk_small_int_t duk__enc_fast_object(duk_json_enc_ctx *js_ctx, duk_hobject *h) {
+	duk_hthread *thr = js_ctx->thr;
+	duk_hstring *h_tojson = DUK_HTHREAD_STRING_TO_JSON(thr);
+	duk_hstring *k;
+	duk_uint32_t i;
+	size_t prev_size;
+	duk_small_int_t rc;
+	duk_small_int_t first;
+
+	if (DUK_HOBJECT_HAS_ARRAY_PART(h) || !duk__enc_fast_check_proto(js_ctx, h)) {
+		return -1;
+	}
+	if (js_ctx->recursion_depth >= js_ctx->recursion_limit) {
+		return -1;
+	}
+	js_ctx->recursion_depth++;
+
+	DUK__EMIT_1(js_ctx, '{');
+
+	/* Entry part order is the enumeration order. */
+	first = 1;
+	for (i = 0; i < h->e_used; i++) {
+		k = DUK_HOBJECT_E_GET_KEY(h, i);
+		if (k == NULL) {
+			continue;
+		}
+		if (k == h_tojson) {
+			return -1;
+		}
+		if (!DUK_HOBJECT_E_SLOT_IS_ENUMERABLE(h, i) || DUK_HSTRING_HAS_INTERNAL(k)) {
+			continue;
+		}
+		if (DUK_HOBJECT_E_SLOT_IS_ACCESSOR(h, i)) {
+			return -1;
+		}
+
+		prev_size = DUK_HBUFFER_GET_SIZE(js_ctx->h_buf);
+		if (!first) {
+			DUK__EMIT_1(js_ctx, ',');
+		}
+		duk__enc_quote_string(js_ctx, k);
+		DUK__EMIT_1(js_ctx, ':');
+
+		rc = duk__enc_fast_value(js_ctx, DUK_HOBJECT_E_GET_VALUE_TVAL_PTR(h, i));
+		if (rc < 0) {
+			return rc;
+		} else if (rc == 0) {
+			/* value serializes to 'undefined', omit the key too */
+			DUK_HBUFFER_SET_SIZE(js_ctx->h_buf, prev_size);
+		} else {
+			first = 0;
+		}
+	}
+
+	DUK__EMIT_1(js_ctx, '}');
+
+	js_ctx->recursion_depth--;
+	return 1;
+}
+
+static duk_small_int_t duk__enc_fast_array(duk_json_enc_ctx *js_ctx, duk_hobject *h) {
+	duk_hthread *thr = js_ctx->thr;
+	duk_hstring *h_tojson = DUK_HTHREAD_STRING_TO_JSON(thr);
+	duk_hstring *h_length = DUK_HTHREAD_STRING_LENGTH(thr);
+	duk_hstring *k;
+	duk_tval *tv;
+	duk_uint32_t i;
+	duk_uint32_t len;
+	duk_small_int_t rc;
+
+	if (!DUK_HOBJECT_HAS_ARRAY_PART(h) || !duk__enc_fast_check_proto(js_ctx, h)) {
+		return -1;
+	}
+
+	/* 'length' and any other non-index properties are in the entry part. */
+	len = 0;
+	for (i = 0; i < h->e_used; i++) {
+		k = DUK_HOBJECT_E_GET_KEY(h, i);
+		if (k == h_tojson) {
+			return -1;
+		} else if (k == h_length) {
+			tv = DUK_HOBJECT_E_GET_VALUE_TVAL_PTR(h, i);
+			DUK_ASSERT(DUK_TVAL_IS_NUMBER(tv));
+			len = (duk_uint32_t) DUK_TVAL_GET_NUMBER(tv);
+		}
+	}
+
+	/* Elements above the array part would be holes. */
+	if (len > h->a_size) {
+		return -1;
+	}
+	if (js_ctx->recursion_depth >= js_ctx->recursion_limit) {
+		return -1;
+	}
+	js_ctx->recursion_depth++;
+
+	DUK__EMIT_1(js_ctx, '[');
+
+	for (i = 0; i < len; i++) {
+		if (i > 0) {
+			DUK__EMIT_1(js_ctx, ',');
+		}
+
+		tv = DUK_HOBJECT_A_GET_VALUE_PTR(h, i);
+		if (DUK_TVAL_IS_UNDEFINED_UNUSED(tv)) {
+			/* hole, value would be looked up from the prototype chain */
+			return -1;
+		}
+
+		rc = duk__enc_fast_value(js_ctx, tv);
+		if (rc < 0) {
+			return rc;
+		} else if (rc == 0) {
+			DUK__EMIT_STRIDX(js_ctx, DUK_STRIDX_NULL);
+		}
+	}
+
+	DUK__EMIT_1(js_ctx, ']');
+
+	js_ctx->recursion_depth--;
+	return 1;
+}
+
+static duk_small_int_t duk__enc_fast_value(duk_json_enc_ctx *js_ctx, duk_tval *tv) {
+	duk_hthread *thr = js_ctx->thr;
+
+	DUK_ASSERT(tv != NULL);
+
+	switch (DUK_TVAL_GET_TAG(tv)) {
+	case DUK_TAG_UNDEFINED:
+	case DUK_TAG_POINTER:
+	case DUK_TAG_BUFFER: {
+		/* see 'mask_for_undefined' */
+		return 0;
+	}
+	case DUK_TAG_NULL: {
+		DUK__EMIT_STRIDX(js_ctx, DUK_STRIDX_NULL);
+		break;
+	}
+	case DUK_TAG_BOOLEAN: {
+		DUK__EMIT_STRIDX(js_ctx, DUK_TVAL_GET_BOOLEAN(tv) ?
+		                 DUK_STRIDX_TRUE : DUK_STRIDX_FALSE);
+		break;
+	}
+	case DUK_TAG_STRING: {
+		duk__enc_quote_string(js_ctx, DUK_TVAL_GET_STRING(tv));
+		break;
+	}
+	case DUK_TAG_OBJECT: {
+		duk_hobject *h = DUK_TVAL_GET_OBJECT(tv);
+		DUK_ASSERT(h != NULL);
+
+		if (DUK_HOBJECT_IS_CALLABLE(h)) {
+			/* functions serialize to 'undefined' unless they have a toJSON() */
+			if (duk_hobject_hasprop_raw(thr, h, DUK_HTHREAD_STRING_TO_JSON(thr))) {
+				return -1;
+			}
+			return 0;
+		}
+
+		switch (DUK_HOBJECT_GET_CLASS_NUMBER(h)) {
+		case DUK_HOBJECT_CLASS_OBJECT:
+			return duk__enc_fast_object(js_ctx, h);
+		case DUK_HOBJECT_CLASS_ARRAY:
+			return duk__enc_fast_array(js_ctx, h);
+		default:
+			return -1;
+		}
+	}
+	default: {
+		duk_double_t d;
+
+		DUK_ASSERT(DUK_TVAL_IS_NUMBER(tv));
+		d = DUK_TVAL_GET_NUMBER(tv);
+		if (DUK_ISFINITE(d)) {
+			duk__enc_double(js_ctx, d);
+		} else {
+			DUK__EMIT_STRIDX(js_ctx, DUK_STRIDX_NULL);
+		}
+		break;
+	}
+	}
+
+	return 1;
+}
+
+/* Protected call wrapper: [ ... js_ctx_ptr value ] -> [ ... rc ]. */
+static int duk__enc_fast_safe(duk_context *ctx) {
+	duk_json_enc_ctx *js_ctx;
+	duk_tval *tv;
+	duk_small_int_t rc;
+
+	js_ctx = (duk_json_enc_ctx *) duk_get_pointer(ctx, -2);
+	DUK_ASSERT(js_ctx != NULL);
+
+	/* Reserve value stack space before looking up the value so that
+	 * the value stack is not resized while the fast path runs.
+	 */
+	duk_require_stack(ctx, DUK_JSON_ENC_REQSTACK);
+	tv = duk_get_tval(ctx, -1);
+	DUK_ASSERT(tv != NULL);
+
+	rc = duk__enc_fast_value(js_ctx, tv);
+	duk_push_int(ctx, (int) rc);
+	return 1;
+}
+#endif  /* DUK_USE_JSON_STRINGIFY_FASTPATH */
+
 /*
  *  Top level wrappers
  */
@@ -1718,6 +2273,10 @@ void duk_bi_json_stringify_helper(duk_context *ctx,
 	js_ctx->h_replacer = NULL;
 	js_ctx->h_gap = NULL;
 	js_ctx->h_indent = NULL;
+#if defined(DUK_USE_JSON_STRINGIFY_FASTPATH)
+	js_ctx->h_fast_proto[0] = NULL;
+	js_ctx->h_fast_proto[1] = NULL;
+#endif
 #endif
 	js_ctx->idx_proplist = -1;
 	js_ctx->recursion_limit = DUK_JSON_ENC_RECURSION_LIMIT;
@@ -1894,6 +2453,52 @@ void duk_bi_json_stringify_helper(duk_context *ctx,
 
 	/* [ ... buf loop (proplist) (gap) ] */
 
+	/*
+	 *  Fast path, falls back to the slow path if aborted
+	 */
+
+#if defined(DUK_USE_JSON_STRINGIFY_FASTPATH)
+	if (js_ctx->flags == 0 &&
+	    js_ctx->h_replacer == NULL &&
+	    js_ctx->idx_proplist < 0 &&
+	    js_ctx->h_gap == NULL) {
+		int pcall_rc;
+		int fast_rc;
+		int prev_ms_base_flags;
+
+		prev_ms_base_flags = thr->heap->mark_and_sweep_base_flags;
+		thr->heap->mark_and_sweep_base_flags |=
+		        DUK_MS_FLAG_NO_FINALIZERS |         /* avoid attempts to add/remove object keys */
+		        DUK_MS_FLAG_NO_OBJECT_COMPACTION;   /* avoid attempts to compact any objects */
+
+		duk_push_pointer(ctx, (void *) js_ctx);
+		duk_dup(ctx, idx_value);
+		pcall_rc = duk_safe_call(ctx, duk__enc_fast_safe, 2 /*nargs*/, 1 /*nrets*/);
+
+		thr->heap->mark_and_sweep_base_flags = prev_ms_base_flags;
+
+		fast_rc = (pcall_rc == DUK_EXEC_SUCCESS ? duk_get_int(ctx, -1) : -1);
+		duk_pop(ctx);
+
+		DUK_DDDPRINT("stringify fast path: pcall_rc=%d, fast_rc=%d", pcall_rc, fast_rc);
+
+		if (fast_rc > 0) {
+			duk_push_hbuffer(ctx, (duk_hbuffer *) js_ctx->h_buf);
+			duk_to_string(ctx, -1);
+			goto replace_result;
+		} else if (fast_rc == 0) {
+			duk_push_undefined(ctx);
+			goto replace_result;
+		}
+
+		/* Aborted, or an error which the slow path will throw again:
+		 * discard partial output.
+		 */
+		DUK_HBUFFER_SET_SIZE(js_ctx->h_buf, 0);
+		js_ctx->recursion_depth = 0;
+	}
+#endif  /* DUK_USE_JSON_STRINGIFY_FASTPATH */
+
 	/*
 	 *  Create wrapper object and serialize
 	 */
@@ -1951,6 +2556,9 @@ void duk_bi_json_stringify_helper(duk_context *ctx,
 	 * desired one explicitly.
 	 */
 
+#if defined(DUK_USE_JSON_STRINGIFY_FASTPATH)
+ replace_result:
+#endif
 	duk_replace(ctx, top_at_entry);
 	duk_set_top(ctx, top_at_entry + 1);
 
@@ -1961,6 +2569,329 @@ void duk_bi_json_stringify_helper(duk_context *ctx,
 	DUK_ASSERT(duk_get_top(ctx) == top_at_entry + 1);
 }
 
+/*
+ *  Streaming decoder
+ *
+ *  Input is fed in arbitrary chunks and collected into a pending input
+ *  buffer instead of a single interned string.  When the top level value
+ *  is an array, a minimal scanner tracks string and nesting state to find
+ *  the end of each top level element; a complete element is decoded with
+ *  the ordinary parser and its text is then discarded.  Peak memory for
+ *  input is thus bounded by the largest element plus the chunk size.
+ *  Decoded elements are either appended to a result array or passed to a
+ *  callback which can process and discard them.  Any other top level value
+ *  is collected as is and decoded when the input is finished.
+ *
+ *  The scanner does not validate anything.  It is only exact for valid
+ *  input, but every piece it splits off must be a complete JSON value for
+ *  the parser, so invalid input can't be accepted because of a wrong split.
+ *
+ *  The decoder object is a plain object with internal properties:
+ *
+ *    _state     fixed buffer holding a duk_json_dec_stream
+ *    _input     dynamic buffer holding pending input
+ *    _callback  element callback (optional)
+ *    _value     result array
+ *
+ *  While a feed or finish is in progress the pending input buffer is not
+ *  resized, so pointers to it remain valid across element decodes and
+ *  callback calls.  A decoder which has thrown an error (or has finished)
+ *  can't be used further.
+ */
+
+#define DUK__JSON_IS_WHITE(x)  ((x) == 0x20 || (x) == 0x0a || (x) == 0x0d || (x) == 0x09)
+
+/* [ ... ] -> [ ... state input target ], where target is the callback or
+ * the result array.
+ */
+static duk_json_dec_stream *duk__dec_stream_get(duk_context *ctx, int idx_decoder) {
+	duk_hthread *thr = (duk_hthread *) ctx;
+	duk_json_dec_stream *st;
+	duk_hbuffer *h_input;
+	duk_size_t sz;
+
+	duk_get_prop_stridx(ctx, idx_decoder, DUK_STRIDX_INT_STATE);
+	duk_get_prop_stridx(ctx, idx_decoder, DUK_STRIDX_INT_INPUT);
+	if (!duk_get_prop_stridx(ctx, idx_decoder, DUK_STRIDX_INT_CALLBACK)) {
+		duk_pop(ctx);
+		duk_get_prop_stridx(ctx, idx_decoder, DUK_STRIDX_INT_VALUE);
+	}
+
+	st = (duk_json_dec_stream *) duk_get_buffer(ctx, -3, &sz);
+	h_input = duk_get_hbuffer(ctx, -2);
+	if (st == NULL || sz != sizeof(duk_json_dec_stream) ||
+	    h_input == NULL || !DUK_HBUFFER_HAS_DYNAMIC(h_input)) {
+		DUK_ERROR(thr, DUK_ERR_TYPE_ERROR, "not a json decoder");
+	}
+	if (st->busy) {
+		DUK_ERROR(thr, DUK_ERR_TYPE_ERROR, "json decoder not usable");
+	}
+
+	st->js_ctx.thr = thr;
+	return st;
+}
+
+/* Decode [p,p_end) as a single JSON value: [ ... ] -> [ ... value ]. */
+static void duk__dec_stream_decode(duk_json_dec_stream *st, duk_uint8_t *p, duk_uint8_t *p_end) {
+	duk_json_dec_ctx *js_ctx = &st->js_ctx;
+
+	js_ctx->p = p;
+	js_ctx->p_end = p_end;
+	js_ctx->recursion_depth = 0;
+
+	duk__dec_value(js_ctx);
+	if (js_ctx->p != js_ctx->p_end) {
+		duk__dec_syntax_error(js_ctx);
+	}
+}
+
+/* Decode a top level array element and pass it on:
+ * [ ... state input target ] -> [ ... state input target ]
+ */
+static void duk__dec_stream_element(duk_context *ctx, duk_json_dec_stream *st, duk_uint8_t *p, duk_uint8_t *p_end) {
+	duk__dec_stream_decode(st, p, p_end);  /* -> [ ... state input target value ] */
+
+	if (duk_is_callable(ctx, -2)) {
+		duk_dup(ctx, -2);
+		duk_insert(ctx, -2);
+		duk_push_number(ctx, (double) st->count);  /* -> [ ... state input target callback value index ] */
+		duk_call(ctx, 2);
+		duk_pop(ctx);
+	} else {
+		duk_put_prop_index(ctx, -2, st->count);
+	}
+
+	st->count++;
+}
+
+/* Scan pending input, decoding complete top level array elements and
+ * discarding their text: [ ... state input target ] -> no change.
+ */
+static void duk__dec_stream_scan(duk_context *ctx, duk_json_dec_stream *st, duk_hbuffer_dynamic *h_input) {
+	duk_hthread *thr = (duk_hthread *) ctx;
+	duk_uint8_t *p_base;
+	duk_uint8_t *p;
+	duk_uint8_t *p_end;
+	duk_uint8_t *p_elem;
+	int x;
+
+	DUK_ASSERT(st->mode == DUK_JSON_STREAM_MODE_ARRAY);
+
+	p_base = (duk_uint8_t *) DUK_HBUFFER_DYNAMIC_GET_CURR_DATA_PTR(h_input);
+	p_end = p_base + DUK_HBUFFER_GET_SIZE(h_input);
+	p = p_base + st->scan_off;
+	p_elem = p_base;  /* start of current element */
+
+	while (p < p_end) {
+		if (st->in_string) {
+			if (st->escape) {
+				st->escape = 0;
+				p++;
+				continue;
+			}
+			p = duk__dec_scan_plain(p, p_end);
+			if (p >= p_end) {
+				break;
+			}
+			x = (int) (*p++);
+			if (x == (int) '\\') {
+				st->escape = 1;
+			} else if (x == (int) '"') {
+				st->in_string = 0;
+			}
+			continue;
+		}
+
+		x = (int) (*p++);
+		if (DUK__JSON_IS_WHITE(x)) {
+			continue;
+		}
+
+		switch (x) {
+		case '"':
+			st->in_string = 1;
+			break;
+		case '[':
+		case '{':
+			st->depth++;
+			break;
+		case ']':
+		case '}':
+			if (st->depth > 0) {
+				st->depth--;
+				break;
+			}
+			if (x == (int) '}') {
+				goto syntax_error;
+			}
+
+			/* End of top level array; "[]" has no elements but
+			 * "[1,]" has an empty (invalid) last element.
+			 */
+			if (st->seen_value || st->count > 0) {
+				duk__dec_stream_element(ctx, st, p_elem, p - 1);
+			}
+			st->mode = DUK_JSON_STREAM_MODE_DONE;
+			while (p < p_end) {
+				x = (int) (*p++);
+				if (!DUK__JSON_IS_WHITE(x)) {
+					goto syntax_error;
+				}
+			}
+			p_elem = p_end;
+			goto done;
+		case ',':
+			if (st->depth == 0) {
+				duk__dec_stream_element(ctx, st, p_elem, p - 1);
+				p_elem = p;
+				st->seen_value = 0;
+				continue;
+			}
+			break;
+		default:
+			break;
+		}
+		st->seen_value = 1;
+	}
+
+ done:
+	/* Discard text of decoded elements. */
+	duk_hbuffer_remove_slice(thr, h_input, 0, (size_t) (p_elem - p_base));
+	st->scan_off = (duk_size_t) (p - p_elem);
+	return;
+
+ syntax_error:
+	duk__dec_syntax_error(&st->js_ctx);
+	DUK_UNREACHABLE();
+}
+
+/* [ ... ] -> [ ... decoder ] */
+void duk_bi_json_stream_push(duk_context *ctx, int idx_callback) {
+	duk_hthread *thr = (duk_hthread *) ctx;
+	duk_json_dec_stream *st;
+
+	if (idx_callback != DUK_INVALID_INDEX) {
+		idx_callback = duk_require_normalize_index(ctx, idx_callback);
+		if (!duk_is_callable(ctx, idx_callback)) {
+			DUK_ERROR(thr, DUK_ERR_TYPE_ERROR, "not callable");
+		}
+	}
+
+	duk_push_object(ctx);
+
+	st = (duk_json_dec_stream *) duk_push_fixed_buffer(ctx, sizeof(duk_json_dec_stream));
+	DUK_ASSERT(st != NULL);
+	DUK_MEMZERO(st, sizeof(duk_json_dec_stream));
+#ifdef DUK_USE_EXPLICIT_NULL_INIT
+	st->js_ctx.thr = NULL;
+	st->js_ctx.p = NULL;
+	st->js_ctx.p_end = NULL;
+#endif
+	st->js_ctx.recursion_limit = DUK_JSON_DEC_RECURSION_LIMIT;
+	st->mode = DUK_JSON_STREAM_MODE_INITIAL;
+	duk_put_prop_stridx(ctx, -2, DUK_STRIDX_INT_STATE);
+
+	duk_push_dynamic_buffer(ctx, 0);
+	duk_put_prop_stridx(ctx, -2, DUK_STRIDX_INT_INPUT);
+
+	if (idx_callback != DUK_INVALID_INDEX) {
+		duk_dup(ctx, idx_callback);
+		duk_put_prop_stridx(ctx, -2, DUK_STRIDX_INT_CALLBACK);
+	}
+
+	duk_push_array(ctx);
+	duk_put_prop_stridx(ctx, -2, DUK_STRIDX_INT_VALUE);
+}
+
+void duk_bi_json_stream_feed(duk_context *ctx, int idx_decoder, const duk_uint8_t *data, duk_size_t len) {
+	duk_hthread *thr = (duk_hthread *) ctx;
+	duk_json_dec_stream *st;
+	duk_hbuffer_dynamic *h_input;
+	int x;
+
+	DUK_ASSERT(data != NULL || len == 0);
+
+	st = duk__dec_stream_get(ctx, idx_decoder);  /* -> [ ... state input target ] */
+	h_input = (duk_hbuffer_dynamic *) duk_get_hbuffer(ctx, -2);
+	DUK_ASSERT(h_input != NULL);
+
+	st->busy = 1;
+
+	if (st->mode == DUK_JSON_STREAM_MODE_INITIAL) {
+		/* Leading whitespace is not buffered. */
+		while (len > 0 && DUK__JSON_IS_WHITE((int) (*data))) {
+			data++;
+			len--;
+		}
+		if (len > 0) {
+			if (*data == (duk_uint8_t) '[') {
+				st->mode = DUK_JSON_STREAM_MODE_ARRAY;
+				data++;
+				len--;
+			} else {
+				st->mode = DUK_JSON_STREAM_MODE_VALUE;
+			}
+		}
+	}
+
+	if (st->mode == DUK_JSON_STREAM_MODE_DONE) {
+		/* Only trailing whitespace is allowed after the top level array. */
+		while (len > 0) {
+			x = (int) (*data++);
+			len--;
+			if (!DUK__JSON_IS_WHITE(x)) {
+				duk__dec_syntax_error(&st->js_ctx);
+			}
+		}
+	} else if (len > 0) {
+		duk_hbuffer_append_bytes(thr, h_input, (duk_uint8_t *) data, (size_t) len);
+		if (st->mode == DUK_JSON_STREAM_MODE_ARRAY) {
+			duk__dec_stream_scan(ctx, st, h_input);
+		}
+	}
+
+	st->busy = 0;
+	duk_pop_n(ctx, 3);
+}
+
+/* [ ... decoder ... ] -> [ ... value ... ] */
+void duk_bi_json_stream_finish(duk_context *ctx, int idx_decoder) {
+	duk_json_dec_stream *st;
+	duk_hbuffer_dynamic *h_input;
+	duk_uint8_t *p;
+
+	st = duk__dec_stream_get(ctx, idx_decoder);  /* -> [ ... state input target ] */
+	h_input = (duk_hbuffer_dynamic *) duk_get_hbuffer(ctx, -2);
+	DUK_ASSERT(h_input != NULL);
+
+	st->busy = 1;  /* never cleared */
+
+	switch (st->mode) {
+	case DUK_JSON_STREAM_MODE_VALUE: {
+		p = (duk_uint8_t *) DUK_HBUFFER_DYNAMIC_GET_CURR_DATA_PTR(h_input);
+		duk__dec_stream_decode(st, p, p + DUK_HBUFFER_GET_SIZE(h_input));
+		break;
+	}
+	case DUK_JSON_STREAM_MODE_DONE: {
+		/* Result array, or an empty array if elements were passed to
+		 * a callback.
+		 */
+		duk_get_prop_stridx(ctx, idx_decoder, DUK_STRIDX_INT_VALUE);
+		break;
+	}
+	default: {
+		/* No value or unterminated top level array. */
+		duk__dec_syntax_error(&st->js_ctx);
+		DUK_UNREACHABLE();
+	}
+	}
+
+	duk_replace(ctx, idx_decoder);
+	duk_pop_n(ctx, 3);
+}
+
+#undef DUK__JSON_IS_WHITE
+
 /*
  *  Entry points
  */
@@ -108,6 +108,9 @@ void duk_bi_json_stringify_helper(duk_context *ctx,
                                   int idx_replacer,
                                   int idx_space,
                                   int flags);
+void duk_bi_json_stream_push(duk_context *ctx, int idx_callback);
+void duk_bi_json_stream_feed(duk_context *ctx, int idx_decoder, const duk_uint8_t *data, duk_size_t len);
+void duk_bi_json_stream_finish(duk_context *ctx, int idx_decoder);
 duk_ret_t duk_bi_json_object_parse(duk_context *ctx);
 duk_ret_t duk_bi_json_object_stringify(duk_context *ctx);
 
@@ -103,16 +103,19 @@ duk_ret_t duk_bi_regexp_prototype_exec(duk_context *ctx) {
 }
 
 duk_ret_t duk_bi_regexp_prototype_test(duk_context *ctx) {
+	duk_re_match_bounds bounds;
+	duk_small_int_t match;
+
 	duk__get_this_regexp(ctx);
 
 	/* [ regexp input ] */
 
-	/* result object is created and discarded; wasteful but saves code space */
-	duk_regexp_match((duk_hthread *) ctx);
+	/* no result object is needed, only lastIndex is updated */
+	match = duk_regexp_match_bounds((duk_hthread *) ctx, 0 /*force_global*/, &bounds);
 
-	/* [ result ] */
+	/* [ ] */
 
-	duk_push_boolean(ctx, (duk_is_null(ctx, -1) ? 0 : 1));
+	duk_push_boolean(ctx, match);
 
 	return 1;
 }
@@ -8,6 +8,18 @@
 
 #include "duk_internal.h"
 
+/* Number of characters in a byte range of 'h' which starts and ends at
+ * character boundaries.
+ */
+static duk_size_t duk__char_count(duk_hstring *h, duk_uint8_t *p, duk_size_t blen) {
+	duk_small_int_t dummy;
+
+	if (DUK_HSTRING_HAS_ASCII(h)) {
+		return blen;
+	}
+	return duk_unicode_unvalidated_utf8_length(p, blen, &dummy);
+}
+
 /*
  *  Constructor
  */
@@ -110,15 +122,24 @@ duk_ret_t duk_bi_string_prototype_to_string(duk_context *ctx) {
 /* FIXME: charAt() and charCodeAt() could probably use a shared helper. */
 
 duk_ret_t duk_bi_string_prototype_char_at(duk_context *ctx) {
+	duk_hstring *h;
 	duk_int_t pos;  /* FIXME: type, duk_to_int() needs to be fixed */
 
-	/* FIXME: faster implementation */
 	/* FIXME: handling int values outside C int range, currently
 	 * duk_to_int() coerces to min/max int, so this works passably.
 	 */
 
-	(void) duk_push_this_coercible_to_string(ctx);
+	h = duk_push_this_coercible_to_string(ctx);
+	DUK_ASSERT(h != NULL);
 	pos = duk_to_int(ctx, 0);
+
+	if (DUK_HSTRING_HAS_ASCII(h) &&
+	    pos >= 0 && (duk_uint32_t) pos < DUK_HSTRING_GET_BYTELEN(h)) {
+		/* pure ASCII: index string data directly */
+		duk_push_lstring(ctx, (const char *) (DUK_HSTRING_GET_DATA(h) + pos), 1);
+		return 1;
+	}
+
 	duk_substring(ctx, -1, pos, pos + 1);
 	return 1;
 }
@@ -132,8 +153,6 @@ duk_ret_t duk_bi_string_prototype_char_code_at(duk_context *ctx) {
 	duk_ucodepoint_t cp;
 	int clamped;  /* FIXME: type */
 
-	/* FIXME: faster implementation */
-
 	DUK_DDDPRINT("arg=%!T", duk_get_tval(ctx, 0));
 
 	h = duk_push_this_coercible_to_string(ctx);
@@ -149,6 +168,12 @@ duk_ret_t duk_bi_string_prototype_char_code_at(duk_context *ctx) {
 		return 1;
 	}
 
+	if (DUK_HSTRING_HAS_ASCII(h)) {
+		/* pure ASCII: char offset is byte offset, no decoding needed */
+		duk_push_int(ctx, (duk_int_t) DUK_HSTRING_GET_DATA(h)[pos]);
+		return 1;
+	}
+
 	boff = duk_heap_strcache_offset_char2byte(thr, h, (duk_uint32_t) pos);
 	DUK_DDDPRINT("charCodeAt: pos=%d -> boff=%d, str=%!O", pos, boff, h);
 	DUK_ASSERT_DISABLE(boff >= 0);
@@ -316,8 +341,6 @@ duk_ret_t duk_bi_string_prototype_indexof_shared(duk_context *ctx) {
 	duk_uint8_t *p_start, *p_end, *p;
 	duk_uint8_t *q_start;
 	duk_size_t q_blen;  /* FIXME: type inconsistency (clen_this is duk_int_t) */
-	duk_uint8_t firstbyte;
-	duk_uint8_t t;
 	duk_small_int_t is_lastindexof = duk_get_magic(ctx);  /* 0=indexOf, 1=lastIndexOf */
 
 	h_this = duk_push_this_coercible_to_string(ctx);
@@ -350,53 +373,32 @@ duk_ret_t duk_bi_string_prototype_indexof_shared(duk_context *ctx) {
 
 	p_start = DUK_HSTRING_GET_DATA(h_this);
 	p_end = p_start + DUK_HSTRING_GET_BYTELEN(h_this);
-	p = p_start + bpos;
 
-	/* This loop is optimized for size.  For speed, there should be
-	 * two separate loops, and we should ensure that memcmp() can be
-	 * used without an extra "will searchstring fit" check.  Doing
-	 * the preconditioning for 'p' and 'p_end' is easy but cpos
-	 * must be updated if 'p' is wound back (backward scanning).
+	/* Search bytes and convert the match byte offset into a char offset
+	 * relative to 'cpos'.  For Ecmascript strings a match can only start
+	 * at an initial UTF-8 byte (not a continuation byte).  For other
+	 * strings all bets are off.
 	 */
 
-	firstbyte = q_start[0];  /* leading byte of match string */
-	while (p <= p_end && p >= p_start) {
-		t = *p;
-
-		/* For Ecmascript strings, this check can only match for
-		 * initial UTF-8 bytes (not continuation bytes).  For other
-		 * strings all bets are off.
-		 */
-
-		if ((t == firstbyte) && ((duk_size_t) (p_end - p) >= q_blen)) {
-			DUK_ASSERT(q_blen > 0);  /* no issues with memcmp() zero size, even if broken */
-			if (DUK_MEMCMP(p, q_start, q_blen) == 0) {
-				duk_push_int(ctx, cpos);
-				return 1;
-			}
+	if (is_lastindexof) {
+		/* match must start at or before 'bpos' */
+		duk_size_t search_blen = (duk_size_t) bpos + q_blen;
+		if (search_blen > (duk_size_t) (p_end - p_start)) {
+			search_blen = (duk_size_t) (p_end - p_start);
 		}
-
-		/* track cpos while scanning */
-		if (is_lastindexof) {
-			/* when going backwards, we decrement cpos 'early';
-			 * 'p' may point to a continuation byte of the char
-			 * at offset 'cpos', but that's OK because we'll
-			 * backtrack all the way to the initial byte.
-			 */
-			if ((t & 0xc0) != 0x80) {
-				cpos--;
-			}
-			p--;
-		} else {
-			if ((t & 0xc0) != 0x80) {
-				cpos++;
-			}
-			p++;
+		p = duk_util_memsearch_last(p_start, search_blen, q_start, q_blen);
+		if (p != NULL) {
+			cpos -= (duk_int_t) duk__char_count(h_this, p, (duk_size_t) (p_start + bpos - p));
+		}
+	} else {
+		p = duk_util_memsearch(p_start + bpos, (duk_size_t) (p_end - p_start - bpos), q_start, q_blen);
+		if (p != NULL) {
+			cpos += (duk_int_t) duk__char_count(h_this, p_start + bpos, (duk_size_t) (p - (p_start + bpos)));
 		}
 	}
 
-	/* Not found.  Empty string case is handled specially above. */
-	duk_push_int(ctx, -1);
+	/* Empty string case is handled specially above. */
+	duk_push_int(ctx, p != NULL ? cpos : -1);
 	return 1;
 }
 
@@ -563,40 +565,26 @@ duk_ret_t duk_bi_string_prototype_replace(duk_context *ctx) {
 
 			p_start = DUK_HSTRING_GET_DATA(h_input);
 			p_end = p_start + DUK_HSTRING_GET_BYTELEN(h_input);
-			p = p_start;
 
 			h_search = duk_get_hstring(ctx, 0);
 			DUK_ASSERT(h_search != NULL);
 			q_start = DUK_HSTRING_GET_DATA(h_search);
 			q_blen = (duk_size_t) DUK_HSTRING_GET_BYTELEN(h_search);
 
-			p_end -= q_blen;  /* ensure full memcmp() fits in while */
-
-			match_start_coff = 0;
+			p = duk_util_memsearch(p_start, (duk_size_t) (p_end - p_start), q_start, q_blen);
+			if (p == NULL) {
+				/* not found */
+				break;
+			}
+			match_start_coff = (duk_uint32_t) duk__char_count(h_input, p_start, (duk_size_t) (p - p_start));
 
-			while (p <= p_end) {
-				DUK_ASSERT(p + q_blen <= DUK_HSTRING_GET_DATA(h_input) + DUK_HSTRING_GET_BYTELEN(h_input));
-				if (DUK_MEMCMP((void *) p, (void *) q_start, (size_t) q_blen) == 0) {
-					duk_dup(ctx, 0);
-					h_match = duk_get_hstring(ctx, -1);
-					DUK_ASSERT(h_match != NULL);
+			duk_dup(ctx, 0);
+			h_match = duk_get_hstring(ctx, -1);
+			DUK_ASSERT(h_match != NULL);
 #ifdef DUK_USE_REGEXP_SUPPORT
-					match_caps = 0;
+			match_caps = 0;
 #endif
-					goto found;
-				}
-
-				/* track utf-8 non-continuation bytes */
-				if ((p[0] & 0xc0) != 0x80) {
-					match_start_coff++;
-				}
-				p++;
-			}
-
-			/* not found */
-			break;
 		}
-	 found:
 
 		/* stack[0] = search value
 		 * stack[1] = replace value
@@ -801,6 +789,8 @@ int duk_bi_string_prototype_split(duk_context *ctx) {
 	duk_uint32_t arr_idx;
 #ifdef DUK_USE_REGEXP_SUPPORT
 	duk_small_int_t is_regexp;
+	duk_small_int_t has_captures;
+	duk_re_match_bounds bounds;
 #endif
 	duk_small_int_t matched;  /* set to 1 if any match exists (needed for empty input special case) */
 	duk_uint32_t prev_match_end_coff, prev_match_end_boff;
@@ -846,6 +836,7 @@ int duk_bi_string_prototype_split(duk_context *ctx) {
 		duk_replace(ctx, 0);
 		/* lastIndex is initialized to zero by new RegExp() */
 		is_regexp = 1;
+		has_captures = (duk_regexp_get_num_captures(thr, 0) > 0);
 #else
 		return DUK_RET_UNSUPPORTED_ERROR;
 #endif
@@ -853,6 +844,7 @@ int duk_bi_string_prototype_split(duk_context *ctx) {
 		duk_to_string(ctx, 0);
 #ifdef DUK_USE_REGEXP_SUPPORT
 		is_regexp = 0;
+		has_captures = 0;
 #endif
 	}
 
@@ -881,31 +873,53 @@ int duk_bi_string_prototype_split(duk_context *ctx) {
 		if (is_regexp) {
 			duk_dup(ctx, 0);
 			duk_dup(ctx, 2);
-			duk_regexp_match_force_global(thr);  /* [ ... regexp input ] -> [ res_obj ] */
-			if (!duk_is_object(ctx, -1)) {
+			if (!has_captures) {
+				/* Only the match bounds are needed; a placeholder
+				 * keeps the stack layout the same as with captures.
+				 */
+				if (!duk_regexp_match_bounds(thr, 1 /*force_global*/, &bounds)) {  /* [ ... regexp input ] -> [ ... ] */
+					break;
+				}
+				duk_push_undefined(ctx);
+				matched = 1;
+
+				match_start_coff = bounds.start_coff;
+				match_start_boff = (duk_uint32_t) bounds.start_boff;
+				match_end_coff = bounds.end_coff;
+				match_end_boff = (duk_uint32_t) bounds.end_boff;
+
+				if (match_start_coff == DUK_HSTRING_GET_CHARLEN(h_input)) {
+					/* don't allow an empty match at the end of the string */
+					duk_pop(ctx);
+					break;
+				}
+			} else {
+				duk_regexp_match_force_global(thr);  /* [ ... regexp input ] -> [ res_obj ] */
+				if (!duk_is_object(ctx, -1)) {
+					duk_pop(ctx);
+					break;
+				}
+				matched = 1;
+
+				duk_get_prop_stridx(ctx, -1, DUK_STRIDX_INDEX);
+				DUK_ASSERT(duk_is_number(ctx, -1));
+				match_start_coff = duk_get_int(ctx, -1);
+				match_start_boff = duk_heap_strcache_offset_char2byte(thr, h_input, match_start_coff);
 				duk_pop(ctx);
-				break;
-			}
-			matched = 1;
 
-			duk_get_prop_stridx(ctx, -1, DUK_STRIDX_INDEX);
-			DUK_ASSERT(duk_is_number(ctx, -1));
-			match_start_coff = duk_get_int(ctx, -1);
-			match_start_boff = duk_heap_strcache_offset_char2byte(thr, h_input, match_start_coff);
-			duk_pop(ctx);
+				if (match_start_coff == DUK_HSTRING_GET_CHARLEN(h_input)) {
+					/* don't allow an empty match at the end of the string */
+					duk_pop(ctx);
+					break;
+				}
 
-			if (match_start_coff == DUK_HSTRING_GET_CHARLEN(h_input)) {
-				/* don't allow an empty match at the end of the string */
+				duk_get_prop_stridx(ctx, 0, DUK_STRIDX_LAST_INDEX);
+				DUK_ASSERT(duk_is_number(ctx, -1));
+				match_end_coff = duk_get_int(ctx, -1);
+				match_end_boff = duk_heap_strcache_offset_char2byte(thr, h_input, match_end_coff);
 				duk_pop(ctx);
-				break;
 			}
 
-			duk_get_prop_stridx(ctx, 0, DUK_STRIDX_LAST_INDEX);
-			DUK_ASSERT(duk_is_number(ctx, -1));
-			match_end_coff = duk_get_int(ctx, -1);
-			match_end_boff = duk_heap_strcache_offset_char2byte(thr, h_input, match_end_coff);
-			duk_pop(ctx);
-
 			/* empty match -> bump and continue */
 			if (prev_match_end_boff == match_end_boff) {
 				duk_push_int(ctx, match_end_coff + 1);
@@ -931,8 +945,6 @@ int duk_bi_string_prototype_split(duk_context *ctx) {
 			q_blen = (duk_size_t) DUK_HSTRING_GET_BYTELEN(h_sep);
 			q_clen = (duk_size_t) DUK_HSTRING_GET_CHARLEN(h_sep);
 
-			p_end -= q_blen;  /* ensure full memcmp() fits in while */
-
 			match_start_coff = prev_match_end_coff;
 
 			if (q_blen == 0) {
@@ -958,19 +970,13 @@ int duk_bi_string_prototype_split(duk_context *ctx) {
 			}
 
 			DUK_ASSERT(q_blen > 0 && q_clen > 0);
-			while (p <= p_end) {
-				DUK_ASSERT(p + q_blen <= DUK_HSTRING_GET_DATA(h_input) + DUK_HSTRING_GET_BYTELEN(h_input));
-				DUK_ASSERT(q_blen > 0);  /* no issues with empty memcmp() */
-				if (DUK_MEMCMP((void *) p, (void *) q_start, (size_t) q_blen) == 0) {
-					/* never an empty match, so step 13.c.iii can't be triggered */
-					goto found;
-				}
-
-				/* track utf-8 non-continuation bytes */
-				if ((p[0] & 0xc0) != 0x80) {
-					match_start_coff++;
-				}
-				p++;
+			p = duk_util_memsearch(p, (duk_size_t) (p_end - p), q_start, q_blen);
+			if (p != NULL) {
+				/* never an empty match, so step 13.c.iii can't be triggered */
+				match_start_coff += (duk_uint32_t) duk__char_count(h_input,
+				                                                   p_start + prev_match_end_boff,
+				                                                   (duk_size_t) (p - (p_start + prev_match_end_boff)));
+				goto found;
 			}
 
 		 not_found:
@@ -995,7 +1001,7 @@ int duk_bi_string_prototype_split(duk_context *ctx) {
 		 * stack[1] = limit
 		 * stack[2] = input string
 		 * stack[3] = result array
-		 * stack[4] = regexp res_obj (if is_regexp)
+		 * stack[4] = regexp res_obj (if is_regexp; undefined if !has_captures)
 		 */
 
 		DUK_DDDPRINT("split; match_start b=%d,c=%d, match_end b=%d,c=%d, prev_end b=%d,c=%d",
@@ -1016,7 +1022,7 @@ int duk_bi_string_prototype_split(duk_context *ctx) {
 		if (is_regexp) {
 			duk_size_t i, len;
 
-			len = duk_get_length(ctx, 4);
+			len = (has_captures ? duk_get_length(ctx, 4) : 0);
 			for (i = 1; i < len; i++) {
 				duk_get_prop_index(ctx, 4, i);
 				duk_put_prop_index(ctx, 3, arr_idx);
@@ -1104,6 +1110,7 @@ static void duk__to_regexp_helper(duk_context *ctx, duk_idx_t index, int force_n
 #ifdef DUK_USE_REGEXP_SUPPORT
 duk_ret_t duk_bi_string_prototype_search(duk_context *ctx) {
 	duk_hthread *thr = (duk_hthread *) ctx;
+	duk_re_match_bounds bounds;
 
 	/* Easiest way to implement the search required by the specification
 	 * is to do a RegExp test() with lastIndex forced to zero.  To avoid
@@ -1127,17 +1134,16 @@ duk_ret_t duk_bi_string_prototype_search(duk_context *ctx) {
 	 * configurable and may have been changed.
 	 */
 
+	/* Only the match index is needed, so skip the result object. */
+
 	duk_dup(ctx, 0);
 	duk_dup(ctx, 1);  /* [ ... re_obj input ] */
-	duk_regexp_match(thr);  /* -> [ ... res_obj ] */
-
-	if (!duk_is_object(ctx, -1)) {
+	if (!duk_regexp_match_bounds(thr, 0 /*force_global*/, &bounds)) {  /* -> [ ... ] */
 		duk_push_int(ctx, -1);
 		return 1;
 	}
 
-	duk_get_prop_stridx(ctx, -1, DUK_STRIDX_INDEX);
-	DUK_ASSERT(duk_is_number(ctx, -1));
+	duk_push_number(ctx, (double) bounds.start_coff);
 	return 1;
 }
 #else  /* DUK_USE_REGEXP_SUPPORT */
@@ -86,11 +86,21 @@ static void duk__dump_stringtable(duk_heap *heap) {
 	duk_uint32_t i;
 	char buf[64+1];
 
-	DUK_DPRINT("stringtable %p, used %d, size %d, load %d%%",
+	DUK_DPRINT("stringtable %p, used %d, size %d, load %d%%, live strings %d",
 	           (void *) heap->st,
 	           (int) heap->st_used,
 	           (int) heap->st_size,
-	           (int) (((double) heap->st_used) / ((double) heap->st_size) * 100.0));
+	           (int) (((double) heap->st_used) / ((double) heap->st_size) * 100.0),
+	           (int) heap->st_count);
+	DUK_DPRINT("old stringtable %p (being migrated), size %d, next slot %d, step %d",
+	           (void *) heap->st_old,
+	           (int) heap->st_old_size,
+	           (int) heap->st_old_pos,
+	           (int) heap->st_old_step);
+	DUK_DPRINT("probes since last resize: %d ops, %d total, max %d",
+	           (int) heap->st_probe_ops,
+	           (int) heap->st_probe_total,
+	           (int) heap->st_probe_max);
 
 	for (i = 0; i < heap->st_size; i++) {
 		duk_hstring *e = heap->st[i];
@@ -148,7 +158,21 @@ static void duk__dump_strcache(duk_heap *heap) {
 			DUK_DPRINT("  [%d]: bidx=%d cidx=%d str=%s",
 			           i, c->bidx, c->cidx, buf);
 		}
-	} 
+	}
+
+#if defined(DUK_USE_STRCACHE_INDEX)
+	DUK_DPRINT("string offset indices");
+
+	for (i = 0; i < DUK_HEAP_STRINDEX_SIZE; i++) {
+		duk_strindex *e = &heap->strindex[i];
+		if (!e->h) {
+			DUK_DPRINT("  [%d]: n=%d, str=NULL", i, e->n);
+		} else {
+			duk__sanitize_snippet(buf, sizeof(buf), e->h);
+			DUK_DPRINT("  [%d]: n=%d str=%s", i, e->n, buf);
+		}
+	}
+#endif
 }
 
 void duk_debug_dump_heap(duk_heap *heap) {
@@ -149,6 +149,8 @@ void duk_debug_dump_hobject(duk_hobject *obj) {
 	DUK_DPRINT("  %snewenv", DUK_HOBJECT_HAS_NEWENV(obj) ? str_empty : str_excl);
 	DUK_DPRINT("  %snamebinding", DUK_HOBJECT_HAS_NAMEBINDING(obj) ? str_empty : str_excl);
 	DUK_DPRINT("  %screateargs", DUK_HOBJECT_HAS_CREATEARGS(obj) ? str_empty : str_excl);
+	DUK_DPRINT("  %slazyargs", DUK_HOBJECT_HAS_LAZYARGS(obj) ? str_empty : str_excl);
+	DUK_DPRINT("  %slazyproto", DUK_HOBJECT_HAS_LAZYPROTO(obj) ? str_empty : str_excl);
 	DUK_DPRINT("  %senvrecclosed", DUK_HOBJECT_HAS_ENVRECCLOSED(obj) ? str_empty : str_excl);
 	DUK_DPRINT("  %sspecial_array", DUK_HOBJECT_HAS_SPECIAL_ARRAY(obj) ? str_empty : str_excl);
 	DUK_DPRINT("  %sspecial_stringobj", DUK_HOBJECT_HAS_SPECIAL_STRINGOBJ(obj) ? str_empty : str_excl);
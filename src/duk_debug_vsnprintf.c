@@ -79,7 +79,7 @@ static const char *duk__bc_optab[] = {
 	"CLOSURE",  "GETPROP", 	"PUTPROP",  "DELPROP",  "CSPROP",   "CSPROPI",  "ADD",      "SUB",      "MUL",      "DIV",
 	"MOD",      "BAND",     "BOR",      "BXOR",     "BASL",     "BLSR", 	"BASR",     "BNOT", 	"LNOT",     "EQ",
 	"NEQ",      "SEQ",      "SNEQ",     "GT",       "GE",       "LT",       "LE",       "IF", 	"INSTOF",   "IN",
-	"JUMP",     "RETURN",   "CALL",     "CALLI",    "LABEL",    "ENDLABEL", "BREAK",    "CONTINUE", "TRYCATCH", "UNUSED59",
+	"JUMP",     "RETURN",   "CALL",     "CALLI",    "LABEL",    "ENDLABEL", "BREAK",    "CONTINUE", "TRYCATCH", "GETARG",
 	"UNUSED60", "EXTRA",    "DEBUG",    "INVALID",
 };
 
@@ -482,6 +482,16 @@ static void duk__print_hobject(duk__dprint_state *st, duk_hobject *h) {
 		} else {
 			;
 		}
+		if (DUK_HOBJECT_HAS_LAZYARGS(h)) {
+			DUK__COMMA(); duk_fb_sprintf(fb, "__lazyargs:true");
+		} else {
+			;
+		}
+		if (DUK_HOBJECT_HAS_LAZYPROTO(h)) {
+			DUK__COMMA(); duk_fb_sprintf(fb, "__lazyproto:true");
+		} else {
+			;
+		}
 		if (DUK_HOBJECT_HAS_ENVRECCLOSED(h)) {
 			DUK__COMMA(); duk_fb_sprintf(fb, "__envrecclosed:true");
 		} else {
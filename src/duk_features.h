@@ -1275,6 +1275,7 @@ typedef FILE duk_file;
 
 #define DUK_MEMMOVE      memmove
 #define DUK_MEMCMP       memcmp
+#define DUK_MEMCHR       memchr
 #define DUK_MEMSET       memset
 #define DUK_STRLEN       strlen
 #define DUK_STRCMP       strcmp
@@ -1609,6 +1610,54 @@ typedef FILE duk_file;
 #undef DUK_USE_REGEXP_SUPPORT
 #endif
 
+/* Match regexps without backreferences and lookaheads with an automaton
+ * matcher which runs in linear time, instead of the backtracking matcher.
+ */
+#define DUK_USE_REGEXP_AUTOMATON
+#if defined(DUK_OPT_NO_REGEXP_AUTOMATON)
+#undef DUK_USE_REGEXP_AUTOMATON
+#endif
+
+/* Cache compiled regexps per heap so that compiling the same pattern and
+ * flags again (e.g. new RegExp() in a loop) reuses the bytecode.
+ */
+#define DUK_USE_REGEXP_CACHE
+#if defined(DUK_OPT_NO_REGEXP_CACHE) || !defined(DUK_USE_REGEXP_SUPPORT)
+#undef DUK_USE_REGEXP_CACHE
+#endif
+
+/* Grisu3 fast path for shortest number-to-string conversion, and a fast
+ * path for integers up to 2^53.  Needs 64-bit integer arithmetic.
+ */
+#define DUK_USE_NUMCONV_GRISU3
+#if defined(DUK_OPT_NO_NUMCONV_GRISU3) || !defined(DUK_USE_64BIT_OPS)
+#undef DUK_USE_NUMCONV_GRISU3
+#endif
+
+/* Eisel-Lemire fast path for decimal string-to-number conversion.  Needs
+ * 64-bit integer arithmetic.
+ */
+#define DUK_USE_NUMCONV_FAST_PARSE
+#if defined(DUK_OPT_NO_NUMCONV_FAST_PARSE) || !defined(DUK_USE_64BIT_OPS)
+#undef DUK_USE_NUMCONV_FAST_PARSE
+#endif
+
+/* Fast path for JSON.stringify() of plain objects and arrays without a
+ * replacer, property list or indent.
+ */
+#define DUK_USE_JSON_STRINGIFY_FASTPATH
+#if defined(DUK_OPT_NO_JSON_STRINGIFY_FASTPATH)
+#undef DUK_USE_JSON_STRINGIFY_FASTPATH
+#endif
+
+/* CBOR encoding and decoding (duk_cbor_encode(), duk_cbor_decode() and
+ * Duktape.enc/dec('cbor', ...)).
+ */
+#define DUK_USE_CBOR
+#if defined(DUK_OPT_NO_CBOR)
+#undef DUK_USE_CBOR
+#endif
+
 #undef DUK_USE_STRICT_UTF8_SOURCE
 #if defined(DUK_OPT_STRICT_UTF8_SOURCE)
 #define DUK_USE_STRICT_UTF8_SOURCE
@@ -1624,6 +1673,23 @@ typedef FILE duk_file;
 #undef DUK_USE_SOURCE_NONBMP
 #endif
 
+/* Use multi-level lookup tables (about 11kB) for non-ASCII BMP case
+ * conversion instead of decoding the compact bitstream for each
+ * codepoint.
+ */
+#define DUK_USE_CASECONV_LOOKUP
+#if defined(DUK_OPT_NO_CASECONV_LOOKUP)
+#undef DUK_USE_CASECONV_LOOKUP
+#endif
+
+/* Use two-level bitmap tables (about 4kB) for non-ASCII BMP identifier
+ * and letter checks instead of a linear scan of packed range tables.
+ */
+#define DUK_USE_IDCHAR_LOOKUP
+#if defined(DUK_OPT_NO_IDCHAR_LOOKUP)
+#undef DUK_USE_IDCHAR_LOOKUP
+#endif
+
 #define DUK_USE_BROWSER_LIKE
 #if defined(DUK_OPT_NO_BROWSER_LIKE)
 #undef DUK_USE_BROWSER_LIKE
@@ -1723,6 +1789,59 @@ typedef FILE duk_file;
 #define DUK_USE_SELF_TESTS
 #endif
 
+/*
+ *  String handling
+ */
+
+/* Sparse char-to-byte offset index for long non-ASCII strings, used by
+ * the string cache to provide O(1) amortized random access.
+ */
+#define DUK_USE_STRCACHE_INDEX
+#if defined(DUK_OPT_NO_STRCACHE_INDEX)
+#undef DUK_USE_STRCACHE_INDEX
+#endif
+
+/* Randomize the per-heap string hash seed (time, heap and stack addresses)
+ * to make string table hash flooding impractical.  When disabled, the seed
+ * depends only on the heap address.
+ */
+#define DUK_USE_STRHASH_RANDOM_SEED
+#if defined(DUK_OPT_NO_STRHASH_RANDOM_SEED)
+#undef DUK_USE_STRHASH_RANDOM_SEED
+#endif
+
+/* Strings of at least DUK_USE_NONINTERNED_STRING_LIMIT bytes are not
+ * interned: they are not hashed or inserted into the string table, and
+ * an interned copy is made on demand if such a string is used as a
+ * property key.
+ */
+#define DUK_USE_NONINTERNED_STRINGS
+#if defined(DUK_OPT_NO_NONINTERNED_STRINGS)
+#undef DUK_USE_NONINTERNED_STRINGS
+#endif
+
+#if defined(DUK_OPT_NONINTERNED_STRING_LIMIT)
+#define DUK_USE_NONINTERNED_STRING_LIMIT  DUK_OPT_NONINTERNED_STRING_LIMIT
+#else
+#define DUK_USE_NONINTERNED_STRING_LIMIT  65536L
+#endif
+
+/* Substrings of at least DUK_USE_STRING_SLICE_LIMIT bytes are created as
+ * slices which refer to the parent string's data instead of copying it.
+ * Slices are non-interned strings, so this requires non-interned string
+ * support.
+ */
+#define DUK_USE_STRING_SLICES
+#if defined(DUK_OPT_NO_STRING_SLICES) || !defined(DUK_USE_NONINTERNED_STRINGS)
+#undef DUK_USE_STRING_SLICES
+#endif
+
+#if defined(DUK_OPT_STRING_SLICE_LIMIT)
+#define DUK_USE_STRING_SLICE_LIMIT  DUK_OPT_STRING_SLICE_LIMIT
+#else
+#define DUK_USE_STRING_SLICE_LIMIT  128L
+#endif
+
 /*
  *  Codecs
  */
@@ -15,6 +15,7 @@ struct duk_jmpbuf;
 struct duk_heaphdr;
 struct duk_heaphdr_string;
 struct duk_hstring;
+struct duk_hstring_slice;
 struct duk_hobject;
 struct duk_hcompiledfunction;
 struct duk_hnativefunction;
@@ -32,6 +33,8 @@ struct duk_heap;
 struct duk_activation;
 struct duk_catcher;
 struct duk_strcache;
+struct duk_strindex;
+struct duk_recache_entry;
 struct duk_ljstate;
 
 #ifdef DUK_USE_DEBUG
@@ -50,8 +53,10 @@ struct duk_compiler_instr;
 struct duk_compiler_func;
 struct duk_compiler_ctx;
 
+union duk_re_btslot;
 struct duk_re_matcher_ctx;
 struct duk_re_compiler_ctx;
+struct duk_re_match_bounds;
 
 typedef struct duk_jmpbuf duk_jmpbuf;
 
@@ -59,6 +64,7 @@ typedef struct duk_jmpbuf duk_jmpbuf;
 typedef struct duk_heaphdr duk_heaphdr;
 typedef struct duk_heaphdr_string duk_heaphdr_string;
 typedef struct duk_hstring duk_hstring;
+typedef struct duk_hstring_slice duk_hstring_slice;
 typedef struct duk_hobject duk_hobject;
 typedef struct duk_hcompiledfunction duk_hcompiledfunction;
 typedef struct duk_hnativefunction duk_hnativefunction;
@@ -76,6 +82,8 @@ typedef struct duk_heap duk_heap;
 typedef struct duk_activation duk_activation;
 typedef struct duk_catcher duk_catcher;
 typedef struct duk_strcache duk_strcache;
+typedef struct duk_strindex duk_strindex;
+typedef struct duk_recache_entry duk_recache_entry;
 typedef struct duk_ljstate duk_ljstate;
 
 #ifdef DUK_USE_DEBUG
@@ -94,8 +102,10 @@ typedef struct duk_compiler_instr duk_compiler_instr;
 typedef struct duk_compiler_func duk_compiler_func;
 typedef struct duk_compiler_ctx duk_compiler_ctx;
 
+typedef union duk_re_btslot duk_re_btslot;
 typedef struct duk_re_matcher_ctx duk_re_matcher_ctx;
 typedef struct duk_re_compiler_ctx duk_re_compiler_ctx;
+typedef struct duk_re_match_bounds duk_re_match_bounds;
 	
 #endif  /* DUK_FORWDECL_H_INCLUDED */
 
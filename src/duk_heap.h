@@ -141,9 +141,32 @@
 /* Stringcache is used for speeding up char-offset-to-byte-offset
  * translations for non-ASCII strings.
  */
-#define DUK_HEAP_STRCACHE_SIZE                            4
+#define DUK_HEAP_STRCACHE_SIZE                            8
 #define DUK_HEAP_STRINGCACHE_NOCACHE_LIMIT                16  /* strings up to the this length are not cached */
 
+/* Offset index ("breadcrumbs") for long non-ASCII strings: records the
+ * byte offset of every 2^SHIFT'th character so that any char offset can
+ * be resolved with a bounded scan.  An index is built lazily when a string
+ * needs a long scan for the second time while still being remembered as a
+ * candidate, and is freed with the string (or when evicted).  Only a few
+ * strings are indexed at a time; the candidate step avoids rebuilding
+ * indices over and over when more strings are being accessed.
+ */
+#if defined(DUK_USE_STRCACHE_INDEX)
+#define DUK_HEAP_STRINDEX_SIZE                            16
+#define DUK_HEAP_STRINDEX_SHIFT                           7     /* one offset per 128 chars */
+#define DUK_HEAP_STRINDEX_MIN_CHARLEN                     4096  /* shorter strings are never indexed */
+#define DUK_HEAP_STRINDEX_SCAN_LIMIT                      512   /* index when a longer scan would be needed */
+#endif
+
+/* Compiled regexp cache, see duk_regexp_compiler.c.  Entries hold strong
+ * references, so the total size of cached regexps is limited.
+ */
+#if defined(DUK_USE_REGEXP_CACHE)
+#define DUK_HEAP_RECACHE_SIZE                             16
+#define DUK_HEAP_RECACHE_MAX_BYTECODE                     4096  /* larger regexps are not cached */
+#endif
+
 /* helper to insert a (non-string) heap object into heap allocated list */
 #define DUK_HEAP_INSERT_INTO_HEAP_ALLOCATED(heap,hdr)     duk_heap_insert_into_heap_allocated((heap),(hdr))
 
@@ -159,8 +182,8 @@
  *  Stringtable
  */
 
-/* initial stringtable size, must be prime and higher than DUK_UTIL_MIN_HASH_PRIME */
-#define DUK_STRTAB_INITIAL_SIZE            17
+/* initial stringtable size, must be a power of two */
+#define DUK_STRTAB_INITIAL_SIZE            32
 
 /* indicates a deleted string; any fixed non-NULL, non-hstring pointer works */
 #define DUK_STRTAB_DELETED_MARKER(heap)    ((duk_hstring *) heap)
@@ -169,13 +192,22 @@
 #define DUK_STRTAB_MIN_FREE_DIVISOR        4                /* load factor max 75% */
 #define DUK_STRTAB_MIN_USED_DIVISOR        4                /* load factor min 25% */
 #define DUK_STRTAB_GROW_ST_SIZE(n)         ((n) + (n))      /* used entries + approx 100% -> reset load to 50% */
+#define DUK_STRTAB_MAX_SIZE                0x80000000UL     /* highest 32-bit power of two */
+
+/* incremental resizing: minimum number of old table slots migrated per
+ * string table operation; the actual step is scaled so that migration
+ * always finishes before the new table needs another resize.
+ */
+#define DUK_STRTAB_MIGRATE_STEP            16
 
 #define DUK_STRTAB_U32_MAX_STRLEN          10               /* 4'294'967'295 */
-#define DUK_STRTAB_HIGHEST_32BIT_PRIME     0xfffffffbUL
 
-/* probe sequence */
-#define DUK_STRTAB_HASH_INITIAL(hash,h_size)    ((hash) % (h_size))
-#define DUK_STRTAB_HASH_PROBE_STEP(hash)        DUK_UTIL_GET_HASH_PROBE_STEP((hash))
+/* probe sequence: table size is a power of two so the probe step must
+ * be odd; step is taken from high hash bits to decorrelate it from the
+ * initial slot
+ */
+#define DUK_STRTAB_HASH_INITIAL(hash,h_size)    ((hash) & ((h_size) - 1))
+#define DUK_STRTAB_HASH_PROBE_STEP(hash)        (DUK_UTIL_GET_HASH_PROBE_STEP((hash) >> 16) | 1)
 
 /*
  *  Built-in strings
@@ -284,6 +316,24 @@ struct duk_strcache {
 	duk_uint32_t cidx;
 };
 
+#if defined(DUK_USE_STRCACHE_INDEX)
+struct duk_strindex {
+	duk_hstring *h;           /* weak reference, NULL if entry unused */
+	duk_uint32_t *offsets;    /* offsets[i] = byte offset of char (i << DUK_HEAP_STRINDEX_SHIFT) */
+	duk_uint32_t n;           /* number of entries in 'offsets' */
+};
+#endif
+
+#if defined(DUK_USE_REGEXP_CACHE)
+struct duk_recache_entry {
+	duk_hstring *pattern;     /* key; NULL if entry unused */
+	duk_hstring *flags;       /* key */
+	duk_hstring *source;      /* escaped source */
+	duk_hstring *bytecode;
+	duk_uint32_t lru;         /* heap->recache_clock at last use */
+};
+#endif
+
 /*
  *  Longjmp state, contains the information needed to perform a longjmp.
  *  Longjmp related values are written to value1, value2, and iserror.
@@ -379,14 +429,59 @@ struct duk_heap {
 
 	/* string intern table (weak refs) */
 	duk_hstring **st;
-	duk_uint32_t st_size;     /* alloc size in elements */
+	duk_uint32_t st_size;     /* alloc size in elements, power of two */
 	duk_uint32_t st_used;     /* used elements (includes DELETED) */
+	duk_uint32_t st_count;    /* live strings in st and st_old */
+
+	/* previous string intern table during an incremental resize; entries
+	 * are migrated to 'st' a few slots at a time starting from st_old_pos
+	 */
+	duk_hstring **st_old;
+	duk_uint32_t st_old_size;
+	duk_uint32_t st_old_pos;
+	duk_uint32_t st_old_step;
+
+#if defined(DUK_USE_NONINTERNED_STRINGS)
+	/* non-interned (long) strings; each string's 'hash' field holds its
+	 * index in this array
+	 */
+	duk_hstring **nonint_strs;
+	duk_uint32_t nonint_size;     /* alloc size in elements */
+	duk_uint32_t nonint_used;     /* used elements */
+#endif
+
+#ifdef DUK_USE_DEBUG
+	/* string table probe statistics since last resize */
+	duk_uint32_t st_probe_ops;
+	duk_uint32_t st_probe_total;
+	duk_uint32_t st_probe_max;
+#endif
 
 	/* string access cache (codepoint offset -> byte offset) for fast string
 	 * character looping; 'weak' reference which needs special handling in GC.
 	 */
 	duk_strcache strcache[DUK_HEAP_STRCACHE_SIZE];
 
+	/* offset indices for long non-ASCII strings; 'weak' references like
+	 * the string access cache, index memory is owned by the heap.
+	 */
+#if defined(DUK_USE_STRCACHE_INDEX)
+	duk_strindex strindex[DUK_HEAP_STRINDEX_SIZE];
+	duk_hstring *strindex_cand[DUK_HEAP_STRINDEX_SIZE];  /* candidates for indexing (ring) */
+	duk_small_int_t strindex_cand_next;
+#endif
+
+	/* compiled regexp cache, keyed by interned pattern and flags strings;
+	 * 'strong' references which are marked by mark-and-sweep, entries are
+	 * dropped by an emergency mark-and-sweep.
+	 */
+#if defined(DUK_USE_REGEXP_CACHE)
+	duk_recache_entry recache[DUK_HEAP_RECACHE_SIZE];
+	duk_uint32_t recache_clock;
+	duk_uint32_t recache_hits;
+	duk_uint32_t recache_misses;
+#endif
+
 	/* built-in strings */
 	duk_hstring *strs[DUK_HEAP_NUM_STRINGS];
 };
@@ -414,15 +509,37 @@ void duk_heap_switch_thread(duk_heap *heap, duk_hthread *new_thr);
 duk_hstring *duk_heap_string_lookup(duk_heap *heap, duk_uint8_t *str, duk_uint32_t blen);
 duk_hstring *duk_heap_string_intern(duk_heap *heap, duk_uint8_t *str, duk_uint32_t blen);
 duk_hstring *duk_heap_string_intern_checked(duk_hthread *thr, duk_uint8_t *str, duk_uint32_t len);
+duk_hstring *duk_heap_string_intern_key(duk_heap *heap, duk_uint8_t *str, duk_uint32_t blen);
+duk_hstring *duk_heap_string_intern_key_checked(duk_hthread *thr, duk_uint8_t *str, duk_uint32_t blen);
 duk_hstring *duk_heap_string_lookup_u32(duk_heap *heap, duk_uint32_t val);
 duk_hstring *duk_heap_string_intern_u32(duk_heap *heap, duk_uint32_t val);
 duk_hstring *duk_heap_string_intern_u32_checked(duk_hthread *thr, duk_uint32_t val);
+duk_hstring *duk_heap_string_substring_checked(duk_hthread *thr, duk_hstring *h, duk_uint32_t start_boff, duk_uint32_t blen);
 void duk_heap_string_remove(duk_heap *heap, duk_hstring *h);
+#if defined(DUK_USE_STRING_SLICES)
+void duk_heap_string_flatten_checked(duk_hthread *thr, duk_hstring *h);
+#endif
+
+/* Ensure string data is NUL terminated, needed when string data is handed
+ * out as a C string.  Only (unflattened) slices need any work.
+ */
+#if defined(DUK_USE_STRING_SLICES)
+#define DUK_HSTRING_FLATTEN(thr,h)  do { \
+		if (DUK_HSTRING_HAS_SLICE((h))) { \
+			duk_heap_string_flatten_checked((thr), (h)); \
+		} \
+	} while (0)
+#else
+#define DUK_HSTRING_FLATTEN(thr,h)  /* nop */
+#endif
 #if defined(DUK_USE_MARK_AND_SWEEP) && defined(DUK_USE_MS_STRINGTABLE_RESIZE)
 void duk_heap_force_stringtable_resize(duk_heap *heap);
 #endif
 
 void duk_heap_strcache_string_remove(duk_heap *heap, duk_hstring *h);
+#if defined(DUK_USE_STRCACHE_INDEX)
+void duk_heap_strcache_free_indices(duk_heap *heap);
+#endif
 duk_uint32_t duk_heap_strcache_offset_char2byte(duk_hthread *thr, duk_hstring *h, duk_uint32_t char_offset);
 
 #ifdef DUK_USE_PROVIDE_DEFAULT_ALLOC_FUNCTIONS
@@ -71,7 +71,13 @@ void duk_heap_free_heaphdr_raw(duk_heap *heap, duk_heaphdr *hdr) {
 
 	switch (DUK_HEAPHDR_GET_TYPE(hdr)) {
 	case DUK_HTYPE_STRING:
-		/* no inner refs to free */
+		/* no inner refs to free, except for the data of a flattened slice */
+#if defined(DUK_USE_STRING_SLICES)
+		if (DUK_HSTRING_HAS_SLICE((duk_hstring *) hdr) &&
+		    DUK_HSTRING_GET_SLICE_PARENT((duk_hstring *) hdr) == NULL) {
+			DUK_FREE(heap, ((duk_hstring_slice *) hdr)->data);
+		}
+#endif
 		break;
 	case DUK_HTYPE_OBJECT:
 		duk__free_hobject_inner(heap, (duk_hobject *) hdr);
@@ -146,29 +152,51 @@ static void duk__free_markandsweep_finalize_list(duk_heap *heap) {
 }
 #endif
 
-static void duk__free_stringtable(duk_heap *heap) {
+static void duk__free_stringtable_entries(duk_heap *heap, duk_hstring **entries, duk_uint32_t size) {
 	duk_uint_fast32_t i;
 
-	/* strings are only tracked by stringtable */
-	if (heap->st) {
-		for (i = 0; i < heap->st_size; i++) {
-			duk_hstring *e = heap->st[i];
-			if (e == DUK_STRTAB_DELETED_MARKER(heap)) {
-				continue;
-			}
+	for (i = 0; i < size; i++) {
+		duk_hstring *e = entries[i];
+		if (e == DUK_STRTAB_DELETED_MARKER(heap)) {
+			continue;
+		}
 
-			/* strings have no inner allocations so free directly */
-			DUK_DDDPRINT("FINALFREE (string): %!iO", e);
-			DUK_FREE(heap, e);
+		/* strings have no inner allocations so free directly */
+		DUK_DDDPRINT("FINALFREE (string): %!iO", e);
+		DUK_FREE(heap, e);
 #if 0  /* not strictly necessary */
-			heap->st[i] = NULL;
+		entries[i] = NULL;
 #endif
-		}
-		DUK_FREE(heap, heap->st);
+	}
+	DUK_FREE(heap, entries);
+}
+
+static void duk__free_stringtable(duk_heap *heap) {
+	/* strings are only tracked by stringtable (and the old table
+	 * during an incremental resize)
+	 */
+	if (heap->st) {
+		duk__free_stringtable_entries(heap, heap->st, heap->st_size);
 #if 0  /* not strictly necessary */
 		heap->st = NULL;
 #endif
 	}
+	if (heap->st_old) {
+		duk__free_stringtable_entries(heap, heap->st_old, heap->st_old_size);
+#if 0  /* not strictly necessary */
+		heap->st_old = NULL;
+#endif
+	}
+#if defined(DUK_USE_NONINTERNED_STRINGS)
+	if (heap->nonint_strs) {
+		duk_uint_fast32_t i;
+		for (i = 0; i < heap->nonint_used; i++) {
+			DUK_DDDPRINT("FINALFREE (non-interned string): %!iO", heap->nonint_strs[i]);
+			duk_heap_free_heaphdr_raw(heap, (duk_heaphdr *) heap->nonint_strs[i]);
+		}
+		DUK_FREE(heap, heap->nonint_strs);
+	}
+#endif
 }
 
 static void duk__free_run_finalizers(duk_heap *heap) {
@@ -248,6 +276,11 @@ void duk_heap_free(duk_heap *heap) {
 	duk__free_markandsweep_finalize_list(heap);
 #endif
 
+#if defined(DUK_USE_STRCACHE_INDEX)
+	DUK_DPRINT("freeing string offset indices of heap: %p", heap);
+	duk_heap_strcache_free_indices(heap);
+#endif
+
 	DUK_DPRINT("freeing string table of heap: %p", heap);
 	duk__free_stringtable(heap);
 
@@ -307,7 +340,7 @@ static int duk__init_heap_strings(duk_heap *heap) {
 		}
 
 		DUK_DDDPRINT("intern built-in string %d", i);
-		h = duk_heap_string_intern(heap, tmp, len);
+		h = duk_heap_string_intern_key(heap, tmp, len);
 		if (!h) {
 			goto error;
 		}
@@ -376,6 +409,54 @@ static int duk__init_heap_thread(duk_heap *heap) {
 	return 1;
 }
 
+/*
+ *  String hash seed.
+ *
+ *  A fixed seed would allow an attacker to precompute strings which all
+ *  collide in the string table (hash flooding).  The seed is derived from
+ *  the heap and stack addresses (which vary with ASLR) and the current
+ *  time at the best available resolution.  This is not cryptographically
+ *  strong but makes collisions impractical to precompute.
+ */
+
+static duk_uint32_t duk__heap_hash_seed(duk_heap *heap) {
+	duk_uint32_t tmp[4];
+
+	/* cast through C99 intptr_t to avoid GCC warning:
+	 *
+	 *   warning: cast from pointer to integer of different size [-Wpointer-to-int-cast]
+	 */
+	tmp[0] = (duk_uint32_t) (duk_intptr_t) heap;
+	tmp[1] = (duk_uint32_t) (duk_intptr_t) &tmp;
+	tmp[2] = 0;
+	tmp[3] = 0;
+
+#if defined(DUK_USE_STRHASH_RANDOM_SEED)
+#if defined(DUK_USE_DATE_NOW_GETTIMEOFDAY)
+	{
+		struct timeval tv;
+		if (gettimeofday(&tv, NULL) == 0) {
+			tmp[2] = (duk_uint32_t) tv.tv_sec;
+			tmp[3] = (duk_uint32_t) tv.tv_usec;
+		}
+	}
+#elif defined(DUK_USE_DATE_NOW_TIME)
+	tmp[2] = (duk_uint32_t) time(NULL);
+	tmp[3] = (duk_uint32_t) clock();
+#elif defined(DUK_USE_DATE_NOW_WINDOWS)
+	{
+		FILETIME ft;
+		GetSystemTimeAsFileTime(&ft);
+		tmp[2] = (duk_uint32_t) ft.dwHighDateTime;
+		tmp[3] = (duk_uint32_t) ft.dwLowDateTime;
+	}
+#endif
+	return duk_util_hashbytes((duk_uint8_t *) tmp, sizeof(tmp), tmp[0]);
+#else  /* DUK_USE_STRHASH_RANDOM_SEED */
+	return tmp[0];
+#endif  /* DUK_USE_STRHASH_RANDOM_SEED */
+}
+
 #ifdef DUK_USE_DEBUG
 #define DUK__DUMPSZ(t)  do { \
 		DUK_DPRINT("" #t "=%d", (int) sizeof(t)); \
@@ -451,6 +532,12 @@ static void duk__dump_type_sizes(void) {
 	DUK__DUMPSZ(duk_activation);
 	DUK__DUMPSZ(duk_catcher);
 	DUK__DUMPSZ(duk_strcache);
+#if defined(DUK_USE_STRCACHE_INDEX)
+	DUK__DUMPSZ(duk_strindex);
+#endif
+#if defined(DUK_USE_REGEXP_CACHE)
+	DUK__DUMPSZ(duk_recache_entry);
+#endif
 	DUK__DUMPSZ(duk_ljstate);
 	DUK__DUMPSZ(duk_fixedbuffer);
 	DUK__DUMPSZ(duk_bitdecoder_ctx);
@@ -539,6 +626,10 @@ duk_heap *duk_heap_alloc(duk_alloc_function alloc_func,
 	res->heap_object = NULL;
 	res->log_buffer = NULL;
 	res->st = NULL;
+	res->st_old = NULL;
+#if defined(DUK_USE_NONINTERNED_STRINGS)
+	res->nonint_strs = NULL;
+#endif
 	{
 		int i;
 	        for (i = 0; i < DUK_HEAP_NUM_STRINGS; i++) {
@@ -559,13 +650,12 @@ duk_heap *duk_heap_alloc(duk_alloc_function alloc_func,
 	res->call_recursion_depth = 0;
 	res->call_recursion_limit = DUK_HEAP_DEFAULT_CALL_RECURSION_LIMIT;
 
-	/* FIXME: use the pointer as a seed for now: mix in time at least */
+	res->hash_seed = duk__heap_hash_seed(res);
 
 	/* cast through C99 intptr_t to avoid GCC warning:
 	 *
 	 *   warning: cast from pointer to integer of different size [-Wpointer-to-int-cast]
 	 */
-	res->hash_seed = (duk_uint32_t) (duk_intptr_t) res;
 	res->rnd_state = (duk_uint32_t) (duk_intptr_t) res;
 
 #ifdef DUK_USE_INTERRUPT_COUNTER
@@ -582,7 +672,7 @@ duk_heap *duk_heap_alloc(duk_alloc_function alloc_func,
 	DUK_TVAL_SET_UNDEFINED_UNUSED(&res->lj.value1);
 	DUK_TVAL_SET_UNDEFINED_UNUSED(&res->lj.value2);
 
-#if (DUK_STRTAB_INITIAL_SIZE < DUK_UTIL_MIN_HASH_PRIME)
+#if ((DUK_STRTAB_INITIAL_SIZE & (DUK_STRTAB_INITIAL_SIZE - 1)) != 0)
 #error initial heap stringtable size is defined incorrectly
 #endif
 
@@ -609,6 +699,21 @@ duk_heap *duk_heap_alloc(duk_alloc_function alloc_func,
 		for (i = 0; i < DUK_HEAP_STRCACHE_SIZE; i++) {
 			res->strcache[i].h = NULL;
 		}
+#if defined(DUK_USE_STRCACHE_INDEX)
+		for (i = 0; i < DUK_HEAP_STRINDEX_SIZE; i++) {
+			res->strindex[i].h = NULL;
+			res->strindex[i].offsets = NULL;
+			res->strindex_cand[i] = NULL;
+		}
+#endif
+#if defined(DUK_USE_REGEXP_CACHE)
+		for (i = 0; i < DUK_HEAP_RECACHE_SIZE; i++) {
+			res->recache[i].pattern = NULL;
+			res->recache[i].flags = NULL;
+			res->recache[i].source = NULL;
+			res->recache[i].bytecode = NULL;
+		}
+#endif
 	}
 #endif
 
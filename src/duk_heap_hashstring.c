@@ -6,59 +6,65 @@
 
 /* constants for duk_hashstring() */
 #define DUK__STRHASH_SHORTSTRING   4096
-#define DUK__STRHASH_MEDIUMSTRING  (256 * 1024)
 #define DUK__STRHASH_BLOCKSIZE     256
+#define DUK__STRHASH_MAXBLOCKS     64
 
 duk_uint32_t duk_heap_hashstring(duk_heap *heap, duk_uint8_t *str, duk_size_t len) {
 	/*
 	 *  Sampling long strings by byte skipping (like Lua does) is potentially
 	 *  a cache problem.  Here we do 'block skipping' instead for long strings:
-	 *  hash an initial part, and then sample the rest of the string with
-	 *  reasonably sized chunks.
+	 *  hash an initial part, the final block, and then sample the rest of the
+	 *  string with reasonably sized chunks.
 	 *
-	 *  Skip should depend on length and bound the total time to roughly
-	 *  logarithmic.
+	 *  The number of sampled blocks is capped so that hashing cost is
+	 *  bounded regardless of string length, roughly:
 	 *
-	 *  With current values:
+	 *    4096 + 256 + 65 * 256 = 20992 bytes of hashing
 	 *
-	 *    1M string => 256 * 241 = 61696 bytes (0.06M) of hashing
-	 *    1G string => 256 * 16321 = 4178176 bytes (3.98M) of hashing
+	 *  Strings up to about 20kB are hashed fully.
 	 *
-	 *  After an initial part has been hashed, an offset is applied before
-	 *  starting the sampling.  The initial offset is computed from the
-	 *  hash of the initial part of the string.  The idea is to avoid the
-	 *  case that all long strings have certain offset ranges that are never
-	 *  sampled.
+	 *  Strings which differ only in unsampled bytes get the same hash and
+	 *  are told apart by a full comparison in the string table.  The
+	 *  sample positions depend on the hash of the initial part, and thus
+	 *  on the per-heap random seed, so that an attacker cannot easily
+	 *  predict which bytes are left out.
 	 */
-	
+
 	/* note: mixing len into seed improves hashing when skipping */
-	duk_uint32_t str_seed = heap->hash_seed ^ len;
+	duk_uint32_t str_seed = heap->hash_seed ^ (duk_uint32_t) len;
 
-	if (len <= DUK__STRHASH_SHORTSTRING) {
+	if (len <= DUK__STRHASH_SHORTSTRING + DUK__STRHASH_BLOCKSIZE) {
 		return duk_util_hashbytes(str, len, str_seed);
 	} else {
 		duk_uint32_t hash;
 		duk_size_t off;
+		duk_size_t end;
 		duk_size_t skip;
 
-		if (len <= DUK__STRHASH_MEDIUMSTRING) {
-			skip = (duk_size_t) (16 * DUK__STRHASH_BLOCKSIZE + DUK__STRHASH_BLOCKSIZE);
-		} else {
-			skip = (duk_size_t) (256 * DUK__STRHASH_BLOCKSIZE + DUK__STRHASH_BLOCKSIZE);
-		}
-
 		hash = duk_util_hashbytes(str, (duk_size_t) DUK__STRHASH_SHORTSTRING, str_seed);
-		off = DUK__STRHASH_SHORTSTRING + (skip * (hash % 256)) / 256;
 
-		/* FIXME: inefficient loop */
-		while (off < len) {
-			duk_size_t left = len - off;
+		/* The last block is always hashed: a common case is strings
+		 * built by appending to a shared prefix.
+		 */
+		end = len - DUK__STRHASH_BLOCKSIZE;
+		hash ^= duk_util_hashbytes(str + end, (duk_size_t) DUK__STRHASH_BLOCKSIZE, str_seed + 1);
+
+		/* Middle part is sampled with at most DUK__STRHASH_MAXBLOCKS blocks,
+		 * starting at a hash dependent offset within the first skip.
+		 */
+		skip = (end - DUK__STRHASH_SHORTSTRING) / DUK__STRHASH_MAXBLOCKS;
+		if (skip < DUK__STRHASH_BLOCKSIZE) {
+			skip = DUK__STRHASH_BLOCKSIZE;
+		}
+		off = DUK__STRHASH_SHORTSTRING + (duk_size_t) ((skip - DUK__STRHASH_BLOCKSIZE) * (hash % 256)) / 256;
+
+		while (off < end) {
+			duk_size_t left = end - off;
 			duk_size_t now = (duk_size_t) (left > DUK__STRHASH_BLOCKSIZE ? DUK__STRHASH_BLOCKSIZE : left);
-			hash ^= duk_util_hashbytes(str + off, now, str_seed);
+			hash ^= duk_util_hashbytes(str + off, now, str_seed ^ (duk_uint32_t) off);
 			off += skip;
 		}
 
 		return hash;
 	}
 }
-
@@ -34,7 +34,9 @@ static void duk__mark_hstring(duk_heap *heap, duk_hstring *h) {
 	DUK_DDDPRINT("duk__mark_hstring: %p", (void *) h);
 	DUK_ASSERT(h);
 
-	/* nothing to process */
+	/* nothing to process; slice parents are intentionally not marked,
+	 * see duk__process_string_slices()
+	 */
 }
 
 static void duk__mark_hobject(duk_heap *heap, duk_hobject *h) {
@@ -203,8 +205,53 @@ static void duk__mark_roots_heap(duk_heap *heap) {
 
 	duk__mark_tval(heap, &heap->lj.value1);
 	duk__mark_tval(heap, &heap->lj.value2);
+
+#if defined(DUK_USE_REGEXP_CACHE)
+	for (i = 0; i < DUK_HEAP_RECACHE_SIZE; i++) {
+		duk_recache_entry *e = heap->recache + i;
+		if (e->pattern) {
+			duk__mark_heaphdr(heap, (duk_heaphdr *) e->pattern);
+			duk__mark_heaphdr(heap, (duk_heaphdr *) e->flags);
+			duk__mark_heaphdr(heap, (duk_heaphdr *) e->source);
+			duk__mark_heaphdr(heap, (duk_heaphdr *) e->bytecode);
+		}
+	}
+#endif
 }
 
+/*
+ *  Drop all compiled regexp cache entries (emergency only).
+ *
+ *  The cache holds strong references; once dropped, strings which are
+ *  not otherwise reachable are freed by this mark-and-sweep round.  Since
+ *  mark-and-sweep is running, decref'ing doesn't cause refzero processing.
+ */
+
+#if defined(DUK_USE_REGEXP_CACHE)
+static void duk__clear_regexp_cache(duk_heap *heap) {
+	duk_hthread *thr;
+	int i;
+
+	thr = duk__get_temp_hthread(heap);
+	DUK_ASSERT(thr != NULL);
+	DUK_UNREF(thr);
+
+	for (i = 0; i < DUK_HEAP_RECACHE_SIZE; i++) {
+		duk_recache_entry *e = heap->recache + i;
+		if (e->pattern) {
+			DUK_HSTRING_DECREF(thr, e->pattern);
+			DUK_HSTRING_DECREF(thr, e->flags);
+			DUK_HSTRING_DECREF(thr, e->source);
+			DUK_HSTRING_DECREF(thr, e->bytecode);
+			e->pattern = NULL;
+			e->flags = NULL;
+			e->source = NULL;
+			e->bytecode = NULL;
+		}
+	}
+}
+#endif
+
 /*
  *  Mark refzero_list objects.
  *
@@ -436,33 +483,88 @@ static void duk__clear_refzero_list_flags(duk_heap *heap) {
 }
 #endif  /* DUK_USE_REFERENCE_COUNTING */
 
+/*
+ *  Process string slices after marking.
+ *
+ *  Marking doesn't follow slice parent references, so a parent is marked
+ *  only if it is reachable by other means.  A reachable slice whose parent
+ *  is not otherwise reachable is flattened so that the (potentially much
+ *  larger) parent can be freed; if flattening fails, the parent is marked
+ *  reachable instead.  Parents never have parents of their own, so marking
+ *  a parent here needs no recursion.
+ *
+ *  With reference counting, the parent references of unreachable slices
+ *  are finalized here like duk__finalize_refcounts() does for objects.
+ */
+
+#if defined(DUK_USE_STRING_SLICES)
+static void duk__process_string_slices(duk_heap *heap) {
+#ifdef DUK_USE_REFERENCE_COUNTING
+	duk_hthread *thr = duk__get_temp_hthread(heap);
+#endif
+	duk_uint32_t i;
+
+	for (i = 0; i < heap->nonint_used; i++) {
+		duk_hstring_slice *h = (duk_hstring_slice *) heap->nonint_strs[i];
+		duk_hstring *parent;
+		duk_uint8_t *buf;
+
+		if (!DUK_HSTRING_HAS_SLICE(&h->str) || h->parent == NULL) {
+			continue;
+		}
+		parent = h->parent;
+		DUK_ASSERT(!DUK_HSTRING_HAS_SLICE(parent) || DUK_HSTRING_GET_SLICE_PARENT(parent) == NULL);
+
+		if (!DUK_HEAPHDR_HAS_REACHABLE((duk_heaphdr *) h)) {
+#ifdef DUK_USE_REFERENCE_COUNTING
+			DUK_HSTRING_DECREF(thr, parent);  /* refzero suppressed */
+#endif
+			continue;
+		}
+		if (DUK_HEAPHDR_HAS_REACHABLE((duk_heaphdr *) parent)) {
+			continue;
+		}
+
+		/* Raw allocation: must not recurse into mark-and-sweep. */
+		buf = (duk_uint8_t *) DUK_ALLOC_RAW(heap, DUK_HSTRING_GET_BYTELEN(&h->str) + 1);
+		if (!buf) {
+			DUK_DDPRINT("failed to flatten string slice %p, keep parent %p", (void *) h, (void *) parent);
+			DUK_HEAPHDR_SET_REACHABLE((duk_heaphdr *) parent);
+			continue;
+		}
+		DUK_MEMCPY((void *) buf, (void *) h->data, (size_t) DUK_HSTRING_GET_BYTELEN(&h->str));
+		buf[DUK_HSTRING_GET_BYTELEN(&h->str)] = (duk_uint8_t) 0;
+		h->data = buf;
+		h->parent = NULL;
+
+		DUK_DDDPRINT("flattened string slice %p, parent %p no longer reachable", (void *) h, (void *) parent);
+
+#ifdef DUK_USE_REFERENCE_COUNTING
+		DUK_HSTRING_DECREF(thr, parent);  /* refzero suppressed */
+#endif
+	}
+}
+#endif  /* DUK_USE_STRING_SLICES */
+
 /*
  *  Sweep stringtable
  */
 
-static void duk__sweep_stringtable(duk_heap *heap, duk_size_t *out_count_keep) {
+static void duk__sweep_stringtable_entries(duk_heap *heap, duk_hstring **entries, duk_uint32_t size, duk_size_t *p_count_keep, duk_size_t *p_count_free) {
 	duk_hstring *h;
 	duk_uint_fast32_t i;
-#ifdef DUK_USE_DEBUG
-	duk_size_t count_free = 0;
-#endif
-	duk_size_t count_keep = 0;
-
-	DUK_DDPRINT("duk__sweep_stringtable: %p", (void *) heap);
 
-	for (i = 0; i < heap->st_size; i++) {
-		h = heap->st[i];
+	for (i = 0; i < size; i++) {
+		h = entries[i];
 		if (h == NULL || h == DUK_STRTAB_DELETED_MARKER(heap)) {
 			continue;
 		} else if (DUK_HEAPHDR_HAS_REACHABLE((duk_heaphdr *) h)) {
 			DUK_HEAPHDR_CLEAR_REACHABLE((duk_heaphdr *) h);
-			count_keep++;
+			(*p_count_keep)++;
 			continue;
 		}
 
-#ifdef DUK_USE_DEBUG
-		count_free++;
-#endif
+		(*p_count_free)++;
 
 #if defined(DUK_USE_DEBUG) && defined(DUK_USE_REFERENCE_COUNTING)
 		/* Non-zero refcounts should not happen for unreachable strings,
@@ -482,7 +584,7 @@ static void duk__sweep_stringtable(duk_heap *heap, duk_size_t *out_count_keep) {
 		 * duk_heap_string_remove() but that would be slow and
 		 * pointless because we already know the slot.
 		 */
-		heap->st[i] = DUK_STRTAB_DELETED_MARKER(heap);
+		entries[i] = DUK_STRTAB_DELETED_MARKER(heap);
 
 		/* then free */
 #if 1
@@ -491,6 +593,65 @@ static void duk__sweep_stringtable(duk_heap *heap, duk_size_t *out_count_keep) {
 		duk_heap_free_heaphdr_raw(heap, (duk_heaphdr *) h);  /* this would be OK but unnecessary */
 #endif
 	}
+}
+
+#if defined(DUK_USE_NONINTERNED_STRINGS)
+static void duk__sweep_noninterned_strings(duk_heap *heap, duk_size_t *p_count_keep, duk_size_t *p_count_free) {
+	duk_hstring *h;
+	duk_uint32_t i;
+
+	i = 0;
+	while (i < heap->nonint_used) {
+		h = heap->nonint_strs[i];
+		DUK_ASSERT(h != NULL);
+		DUK_ASSERT(DUK_HSTRING_HAS_NONINTERNED(h));
+		DUK_ASSERT(h->hash == i);
+
+		if (DUK_HEAPHDR_HAS_REACHABLE((duk_heaphdr *) h)) {
+			DUK_HEAPHDR_CLEAR_REACHABLE((duk_heaphdr *) h);
+			(*p_count_keep)++;
+			i++;
+			continue;
+		}
+
+		(*p_count_free)++;
+
+#if defined(DUK_USE_DEBUG) && defined(DUK_USE_REFERENCE_COUNTING)
+		DUK_ASSERT(DUK_HEAPHDR_GET_REFCOUNT((duk_heaphdr *) h) == 0);
+#endif
+
+		DUK_DDDPRINT("sweep non-interned string, not reachable: %p", (void *) h);
+
+		duk_heap_strcache_string_remove(heap, h);
+
+		/* move last entry to this slot and revisit the slot */
+		heap->nonint_used--;
+		heap->nonint_strs[i] = heap->nonint_strs[heap->nonint_used];
+		heap->nonint_strs[i]->hash = i;
+
+		duk_heap_free_heaphdr_raw(heap, (duk_heaphdr *) h);
+	}
+}
+#endif  /* DUK_USE_NONINTERNED_STRINGS */
+
+static void duk__sweep_stringtable(duk_heap *heap, duk_size_t *out_count_keep) {
+	duk_size_t count_free = 0;
+	duk_size_t count_keep = 0;
+
+	DUK_DDPRINT("duk__sweep_stringtable: %p", (void *) heap);
+
+	/* During an incremental resize strings may be in either table. */
+	duk__sweep_stringtable_entries(heap, heap->st, heap->st_size, &count_keep, &count_free);
+	if (heap->st_old != NULL) {
+		duk__sweep_stringtable_entries(heap, heap->st_old, heap->st_old_size, &count_keep, &count_free);
+	}
+
+	DUK_ASSERT((duk_size_t) heap->st_count == count_keep + count_free);
+	heap->st_count = (duk_uint32_t) count_keep;
+
+#if defined(DUK_USE_NONINTERNED_STRINGS)
+	duk__sweep_noninterned_strings(heap, &count_keep, &count_free);
+#endif
 
 #ifdef DUK_USE_DEBUG
 	DUK_DPRINT("mark-and-sweep sweep stringtable: %d freed, %d kept",
@@ -918,6 +1079,12 @@ int duk_heap_mark_and_sweep(duk_heap *heap, int flags) {
 
 	DUK_HEAP_SET_MARKANDSWEEP_RUNNING(heap);
 
+#if defined(DUK_USE_REGEXP_CACHE)
+	if (flags & DUK_MS_FLAG_EMERGENCY) {
+		duk__clear_regexp_cache(heap);
+	}
+#endif
+
 	/*
 	 *  Mark roots, hoping that recursion limit is not normally hit.
 	 *  If recursion limit is hit, run additional reachability rounds
@@ -950,11 +1117,15 @@ int duk_heap_mark_and_sweep(duk_heap *heap, int flags) {
 	 *  even without bugs, e.g. with reference loops)
 	 *
 	 *  Because strings don't point to other heap objects, similar
-	 *  finalization is not necessary for strings.
+	 *  finalization is not necessary for strings, except for string
+	 *  slices which are handled separately.
 	 */
 
 	/* FIXME: more emergency behavior, e.g. find smaller hash sizes etc */
 
+#if defined(DUK_USE_STRING_SLICES)
+	duk__process_string_slices(heap);
+#endif
 #ifdef DUK_USE_REFERENCE_COUNTING
 	duk__finalize_refcounts(heap);
 #endif
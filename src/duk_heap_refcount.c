@@ -271,9 +271,7 @@ static void duk__refzero_free_pending(duk_hthread *thr) {
 		if (rescued) {
 			/* yes -> move back to heap allocated */
 			DUK_DDPRINT("object rescued during refcount finalization: %p", (void *) h1);
-			DUK_HEAPHDR_SET_PREV(h1, NULL);
-			DUK_HEAPHDR_SET_NEXT(h1, heap->heap_allocated);
-			heap->heap_allocated = h1;
+			duk_heap_insert_into_heap_allocated(heap, h1);  /* also updates 'prev' of the old head */
 		} else {
 			/* no -> decref members, then free */
 			duk__refcount_finalize_hobject(thr, obj);
@@ -419,18 +417,33 @@ void duk_heap_heaphdr_decref(duk_hthread *thr, duk_heaphdr *h) {
 #endif
 
 	switch (DUK_HEAPHDR_GET_TYPE(h)) {
-	case DUK_HTYPE_STRING:
+	case DUK_HTYPE_STRING: {
 		/*
 		 *  Strings have no internal references but do have "weak"
 		 *  references in the string cache.  Also note that strings
 		 *  are not on the heap_allocated list like other heap
-		 *  elements.
+		 *  elements.  A string slice references its parent, which
+		 *  is never a slice with a parent so there is no recursion.
 		 */
+#if defined(DUK_USE_STRING_SLICES)
+		duk_hstring *parent = NULL;
+
+		if (DUK_HSTRING_HAS_SLICE((duk_hstring *) h)) {
+			parent = DUK_HSTRING_GET_SLICE_PARENT((duk_hstring *) h);
+		}
+#endif
 
 		duk_heap_strcache_string_remove(heap, (duk_hstring *) h);
 		duk_heap_string_remove(heap, (duk_hstring *) h);
 		duk_heap_free_heaphdr_raw(heap, h);
+
+#if defined(DUK_USE_STRING_SLICES)
+		if (parent != NULL) {
+			DUK_HSTRING_DECREF(thr, parent);
+		}
+#endif
 		break;
+	}
 
 	case DUK_HTYPE_OBJECT:
 		/*
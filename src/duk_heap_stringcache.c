@@ -5,6 +5,10 @@
  *  track of (byte offset, char offset) states for a fixed number of strings.
  *  Otherwise we'd need to scan from either end of the string, as we store
  *  strings in (extended) UTF-8.
+ *
+ *  Long non-ASCII strings which are accessed far from any cached position
+ *  also get a sparse offset index so that random access doesn't degrade
+ *  into long scans when the cache thrashes.
  */
 
 #include "duk_internal.h"
@@ -32,7 +36,37 @@ void duk_heap_strcache_string_remove(duk_heap *heap, duk_hstring *h) {
 			 */
 		}
 	}
+
+#if defined(DUK_USE_STRCACHE_INDEX)
+	for (i = 0; i < DUK_HEAP_STRINDEX_SIZE; i++) {
+		duk_strindex *e = &heap->strindex[i];
+		if (e->h == h) {
+			DUK_DDPRINT("deleting weak strindex reference to hstring %p from heap %p",
+			            (void *) h, (void *) heap);
+			DUK_FREE(heap, e->offsets);
+			e->h = NULL;
+			e->offsets = NULL;
+			e->n = 0;
+		}
+		if (heap->strindex_cand[i] == h) {
+			heap->strindex_cand[i] = NULL;
+		}
+	}
+#endif
+}
+
+#if defined(DUK_USE_STRCACHE_INDEX)
+void duk_heap_strcache_free_indices(duk_heap *heap) {
+	int i;
+	for (i = 0; i < DUK_HEAP_STRINDEX_SIZE; i++) {
+		duk_strindex *e = &heap->strindex[i];
+		DUK_FREE(heap, e->offsets);
+		e->h = NULL;
+		e->offsets = NULL;
+		e->n = 0;
+	}
 }
+#endif
 
 /*
  *  String scanning helpers
@@ -70,6 +104,117 @@ static duk_uint8_t *duk__scan_backwards(duk_uint8_t *p, duk_uint8_t *q, duk_uint
 	return p;
 }
 
+/*
+ *  Offset index for long strings
+ *
+ *  The index is a plain array of byte offsets, one per 2^SHIFT characters,
+ *  built with a single scan over the string.  Index entries are kept in
+ *  "LRU" order like the string cache: a lookup moves the entry first, and
+ *  a new index replaces the last entry.
+ *
+ *  Building an index costs a full scan, so a string is first only recorded
+ *  as a candidate; the index is built if the string needs another long scan
+ *  while it is still a candidate.  When many strings are accessed in turn
+ *  the candidates are overwritten before that happens and we degrade to
+ *  plain scanning instead of building indices over and over again.
+ */
+
+#if defined(DUK_USE_STRCACHE_INDEX)
+static duk_strindex *duk__strindex_lookup(duk_heap *heap, duk_hstring *h) {
+	duk_strindex *e;
+	duk_strindex tmp;
+	int i;
+
+	for (i = 0; i < DUK_HEAP_STRINDEX_SIZE; i++) {
+		e = &heap->strindex[i];
+		if (e->h == h) {
+			if (i > 0) {
+				tmp = *e;
+				DUK_MEMMOVE((void *) (&heap->strindex[1]),
+				            (void *) (&heap->strindex[0]),
+				            (size_t) (sizeof(duk_strindex) * i));
+				heap->strindex[0] = tmp;
+			}
+			return &heap->strindex[0];
+		}
+	}
+	return NULL;
+}
+
+static duk_strindex *duk__strindex_build(duk_heap *heap, duk_hstring *h) {
+	duk_strindex *e;
+	duk_uint32_t *offsets;
+	duk_uint32_t n;
+	duk_uint32_t k;
+	duk_uint32_t cidx;
+	duk_uint8_t *p_start;
+	duk_uint8_t *p_end;
+	duk_uint8_t *p;
+	int i;
+
+	for (i = 0; i < DUK_HEAP_STRINDEX_SIZE; i++) {
+		if (heap->strindex_cand[i] == h) {
+			break;
+		}
+	}
+	if (i >= DUK_HEAP_STRINDEX_SIZE) {
+		DUK_DDDPRINT("string %p not yet an index candidate, record it", (void *) h);
+		heap->strindex_cand[heap->strindex_cand_next] = h;
+		heap->strindex_cand_next = (heap->strindex_cand_next + 1) % DUK_HEAP_STRINDEX_SIZE;
+		return NULL;
+	}
+	heap->strindex_cand[i] = NULL;
+
+	n = (DUK_HSTRING_GET_CHARLEN(h) >> DUK_HEAP_STRINDEX_SHIFT) + 1;
+
+	/* The allocation may trigger a GC which may remove other index
+	 * entries (but not 'h', which is reachable from the caller), so
+	 * the entry is only claimed after the allocation.  Allocation
+	 * failure is not an error: we just scan without an index.
+	 */
+	offsets = (duk_uint32_t *) DUK_ALLOC(heap, sizeof(duk_uint32_t) * n);
+	if (!offsets) {
+		DUK_DPRINT("failed to allocate string offset index, scan without one");
+		return NULL;
+	}
+
+	p_start = DUK_HSTRING_GET_DATA(h);
+	p_end = p_start + DUK_HSTRING_GET_BYTELEN(h);
+	k = 0;
+	cidx = 0;
+	for (p = p_start; p < p_end; p++) {
+		if ((*p & 0xc0) != 0x80) {
+			/* same counting rule as duk_unicode_unvalidated_utf8_length() */
+			if ((cidx & ((1UL << DUK_HEAP_STRINDEX_SHIFT) - 1)) == 0) {
+				DUK_ASSERT(k < n);
+				offsets[k++] = (duk_uint32_t) (p - p_start);
+			}
+			cidx++;
+		}
+	}
+	DUK_ASSERT(cidx == DUK_HSTRING_GET_CHARLEN(h));
+	while (k < n) {
+		/* char offset == clen maps to the end of the string */
+		offsets[k++] = DUK_HSTRING_GET_BYTELEN(h);
+	}
+
+	e = &heap->strindex[DUK_HEAP_STRINDEX_SIZE - 1];  /* take last entry */
+	DUK_FREE(heap, e->offsets);
+	DUK_MEMMOVE((void *) (&heap->strindex[1]),
+	            (void *) (&heap->strindex[0]),
+	            (size_t) (sizeof(duk_strindex) * (DUK_HEAP_STRINDEX_SIZE - 1)));
+	e = &heap->strindex[0];
+	e->h = h;
+	e->offsets = offsets;
+	e->n = n;
+
+	DUK_DDPRINT("built string offset index for %p: clen=%d, blen=%d, %d entries",
+	            (void *) h, (int) DUK_HSTRING_GET_CHARLEN(h),
+	            (int) DUK_HSTRING_GET_BYTELEN(h), (int) n);
+	return e;
+}
+#endif  /* DUK_USE_STRCACHE_INDEX */
+
 /*
  *  Convert char offset to byte offset
  *
@@ -91,6 +236,10 @@ duk_uint32_t duk_heap_strcache_offset_char2byte(duk_hthread *thr, duk_hstring *h
 	duk_uint8_t *p_start;
 	duk_uint8_t *p_end;
 	duk_uint8_t *p_found;
+#if defined(DUK_USE_STRCACHE_INDEX)
+	duk_uint32_t dist_best;
+	duk_strindex *sie;
+#endif
 
 	if (char_offset > DUK_HSTRING_GET_CHARLEN(h)) {
 		goto error;
@@ -100,8 +249,8 @@ duk_uint32_t duk_heap_strcache_offset_char2byte(duk_hthread *thr, duk_hstring *h
 	 *  For ASCII strings, the answer is simple.
 	 */
 
-	if (DUK_HSTRING_IS_ASCII(h)) {
-		/* clen == blen -> pure ascii */
+	if (DUK_HSTRING_HAS_ASCII(h)) {
+		/* pure ascii, flagged at intern time -> clen == blen */
 		return char_offset;
 	}
 
@@ -159,6 +308,38 @@ duk_uint32_t duk_heap_strcache_offset_char2byte(duk_hthread *thr, duk_hstring *h
 	p_end = (duk_uint8_t *) (p_start + DUK_HSTRING_GET_BYTELEN(h));
 	p_found = NULL;
 
+#if defined(DUK_USE_STRCACHE_INDEX)
+	/* If the shortest scan would be long, resolve using the offset
+	 * index instead, building it on first need.
+	 */
+	dist_best = (dist_start <= dist_end ? dist_start : dist_end);
+	if (sce) {
+		dist_sce = (char_offset >= sce->cidx ? char_offset - sce->cidx : sce->cidx - char_offset);
+		if (dist_sce < dist_best) {
+			dist_best = dist_sce;
+		}
+	}
+	if (dist_best > DUK_HEAP_STRINDEX_SCAN_LIMIT &&
+	    DUK_HSTRING_GET_CHARLEN(h) >= DUK_HEAP_STRINDEX_MIN_CHARLEN) {
+		sie = duk__strindex_lookup(heap, h);
+		if (!sie) {
+			sie = duk__strindex_build(heap, h);
+		}
+		if (sie) {
+			duk_uint32_t k = char_offset >> DUK_HEAP_STRINDEX_SHIFT;
+
+			DUK_ASSERT(sie->h == h);
+			DUK_ASSERT(k < sie->n);
+			DUK_DDDPRINT("non-ascii string, dist_best=%d => scan forwards from offset index entry %d",
+			             (int) dist_best, (int) k);
+			p_found = duk__scan_forwards(p_start + sie->offsets[k],
+			                             p_end,
+			                             char_offset & ((1UL << DUK_HEAP_STRINDEX_SHIFT) - 1));
+			goto scan_done;
+		}
+	}
+#endif
+
 	if (sce) {
 		if (char_offset >= sce->cidx) {
 			dist_sce = char_offset - sce->cidx;
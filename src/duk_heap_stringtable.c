@@ -25,6 +25,7 @@ static duk_hstring *duk__alloc_init_hstring(duk_heap *heap,
 	duk_uint8_t *data;
 	duk_uint32_t alloc_size;
 	duk_uint32_t dummy;
+	duk_small_int_t is_ascii;
 
 	/* NUL terminate for convenient C access */
 
@@ -46,17 +47,26 @@ static duk_hstring *duk__alloc_init_hstring(duk_heap *heap,
 
 	res->hash = strhash;
 	res->blen = blen;
-	res->clen = (duk_uint32_t) duk_unicode_unvalidated_utf8_length(str, (duk_size_t) blen);  /* clen <= blen */
+
+	/* Pure ASCII strings are flagged so that char offsets can be used
+	 * directly as byte offsets.  Both are determined in one pass.
+	 */
+	res->clen = (duk_uint32_t) duk_unicode_unvalidated_utf8_length(str, (duk_size_t) blen, &is_ascii);  /* clen <= blen */
+	if (is_ascii) {
+		DUK_ASSERT(res->clen == blen);
+		DUK_HSTRING_SET_ASCII(res);
+	}
 
 	data = (duk_uint8_t *) (res + 1);
 	DUK_MEMCPY(data, str, blen);
 	data[blen] = (duk_uint8_t) 0;
 
-	DUK_DDDPRINT("interned string, hash=0x%08x, blen=%d, clen=%d, arridx=%d",
+	DUK_DDDPRINT("interned string, hash=0x%08x, blen=%d, clen=%d, arridx=%d, ascii=%d",
 	             DUK_HSTRING_GET_HASH(res),
 	             DUK_HSTRING_GET_BYTELEN(res),
 	             DUK_HSTRING_GET_CHARLEN(res),
-	             DUK_HSTRING_HAS_ARRIDX(res) ? 1 : 0);
+	             DUK_HSTRING_HAS_ARRIDX(res) ? 1 : 0,
+	             DUK_HSTRING_HAS_ASCII(res) ? 1 : 0);
 
 	return res;
 
@@ -66,34 +76,41 @@ static duk_hstring *duk__alloc_init_hstring(duk_heap *heap,
 }
 
 /*
- *  Count actually used (non-NULL, non-DELETED) entries
+ *  Probe length statistics (debug builds only)
  */
 
-static duk_int_t duk__count_used(duk_heap *heap) {
-	duk_int_t res = 0;
-	duk_uint_fast32_t i, n;
-
-	n = (duk_uint_fast32_t) heap->st_size;
-	for (i = 0; i < n; i++) {
-		if (heap->st[i] != NULL && heap->st[i] != DUK__DELETED_MARKER(heap)) {
-			res++;
-		}
+#ifdef DUK_USE_DEBUG
+static void duk__record_probes(duk_heap *heap, duk_uint32_t probes) {
+	heap->st_probe_ops++;
+	heap->st_probe_total += probes;
+	if (probes > heap->st_probe_max) {
+		heap->st_probe_max = probes;
 	}
-	return res;
 }
+#define DUK__RECORD_PROBES(heap,probes)  duk__record_probes((heap), (probes))
+#else
+#define DUK__RECORD_PROBES(heap,probes)  do {} while (0)
+#endif
 
 /*
  *  Hashtable lookup and insert helpers
+ *
+ *  Table sizes are powers of two, so the initial slot is taken by masking
+ *  and the (odd) probe step visits every slot before looping.
  */
 
 static void duk__insert_hstring(duk_heap *heap, duk_hstring **entries, duk_uint32_t size, duk_uint32_t *p_used, duk_hstring *h) {
 	duk_uint32_t i;
 	duk_uint32_t step;
+	duk_uint32_t mask;
+	duk_uint32_t probes = 0;
 
 	DUK_ASSERT(size > 0);
+	DUK_ASSERT((size & (size - 1)) == 0);
 
+	mask = size - 1;
 	i = DUK__HASH_INITIAL(DUK_HSTRING_GET_HASH(h), size);
-	step = DUK__HASH_PROBE_STEP(DUK_HSTRING_GET_HASH(h)); 
+	step = DUK__HASH_PROBE_STEP(DUK_HSTRING_GET_HASH(h));
 	for (;;) {
 		duk_hstring *e;
 		
@@ -110,19 +127,27 @@ static void duk__insert_hstring(duk_heap *heap, duk_hstring **entries, duk_uint3
 			break;
 		}
 		DUK_DDDPRINT("insert miss: %d", i);
-		i = (i + step) % size;
+		i = (i + step) & mask;
+		probes++;
 
 		/* looping should never happen */
 		DUK_ASSERT(i != DUK__HASH_INITIAL(DUK_HSTRING_GET_HASH(h), size));
 	}
+
+	DUK__RECORD_PROBES(heap, probes);
+	DUK_UNREF(probes);
 }
 
 static duk_hstring *duk__find_matching_string(duk_heap *heap, duk_hstring **entries, duk_uint32_t size, duk_uint8_t *str, duk_uint32_t blen, duk_uint32_t strhash) {
 	duk_uint32_t i;
 	duk_uint32_t step;
+	duk_uint32_t mask;
+	duk_uint32_t probes = 0;
 
 	DUK_ASSERT(size > 0);
+	DUK_ASSERT((size & (size - 1)) == 0);
 
+	mask = size - 1;
 	i = DUK__HASH_INITIAL(strhash, size);
 	step = DUK__HASH_PROBE_STEP(strhash);
 	for (;;) {
@@ -130,16 +155,24 @@ static duk_hstring *duk__find_matching_string(duk_heap *heap, duk_hstring **entr
 
 		e = entries[i];
 		if (!e) {
+			DUK__RECORD_PROBES(heap, probes);
 			return NULL;
 		}
-		if (e != DUK__DELETED_MARKER(heap) && DUK_HSTRING_GET_BYTELEN(e) == blen) {
+		if (e != DUK__DELETED_MARKER(heap) &&
+		    DUK_HSTRING_GET_HASH(e) == strhash &&
+		    DUK_HSTRING_GET_BYTELEN(e) == blen) {
+			/* Long strings are hashed by sampling, so a matching
+			 * hash and length still needs a full comparison.
+			 */
 			if (DUK_MEMCMP(str, DUK_HSTRING_GET_DATA(e), blen) == 0) {
 				DUK_DDDPRINT("find matching hit: %d (step %d, size %d)", i, step, size);
+				DUK__RECORD_PROBES(heap, probes);
 				return e;
 			}
 		}
 		DUK_DDDPRINT("find matching miss: %d (step %d, size %d)", i, step, size);
-		i = (i + step) % size;
+		i = (i + step) & mask;
+		probes++;
 
 		/* looping should never happen */
 		DUK_ASSERT(i != DUK__HASH_INITIAL(strhash, size));
@@ -147,12 +180,16 @@ static duk_hstring *duk__find_matching_string(duk_heap *heap, duk_hstring **entr
 	DUK_UNREACHABLE();
 }
 
-static void duk__remove_matching_hstring(duk_heap *heap, duk_hstring **entries, duk_uint32_t size, duk_hstring *h) {
+/* Returns 1 if found and removed, 0 if the string is not in 'entries'. */
+static int duk__remove_matching_hstring(duk_heap *heap, duk_hstring **entries, duk_uint32_t size, duk_hstring *h) {
 	duk_uint32_t i;
 	duk_uint32_t step;
+	duk_uint32_t mask;
 
 	DUK_ASSERT(size > 0);
+	DUK_ASSERT((size & (size - 1)) == 0);
 
+	mask = size - 1;
 	i = DUK__HASH_INITIAL(h->hash, size);
 	step = DUK__HASH_PROBE_STEP(h->hash);
 	for (;;) {
@@ -160,55 +197,103 @@ static void duk__remove_matching_hstring(duk_heap *heap, duk_hstring **entries,
 
 		e = entries[i];
 		if (!e) {
-			DUK_UNREACHABLE();
-			break;
+			return 0;
 		}
 		if (e == h) {
 			/* st_used remains the same, DELETED is counted as used */
 			DUK_DDDPRINT("free matching hit: %d", i);
 			entries[i] = DUK__DELETED_MARKER(heap);
-			break;
+			return 1;
 		}
 
 		DUK_DDDPRINT("free matching miss: %d", i);
-		i = (i + step) % size;
+		i = (i + step) & mask;
 
 		/* looping should never happen */
 		DUK_ASSERT(i != DUK__HASH_INITIAL(h->hash, size));
 	}
+	DUK_UNREACHABLE();
 }
 
 /*
- *  Hash resizing and resizing policy
+ *  Incremental resizing
+ *
+ *  A resize allocates a new table and makes it current; the previous table
+ *  is kept in heap->st_old and its entries are moved to the new table a few
+ *  slots at a time on every intern and lookup.  While migration is in
+ *  progress, new strings go into the new table and lookups consult both.
+ *
+ *  The migration step is chosen so that all old slots have been visited
+ *  within size/8 operations.  A new table starts at most 50% loaded (live
+ *  strings of both tables), so it can't reach the 75% grow limit before
+ *  migration is done and at most two tables ever exist.
  */
 
+static void duk__migrate_strtab(duk_heap *heap, duk_uint32_t count) {
+	duk_hstring **old_entries = heap->st_old;
+	duk_uint32_t old_size = heap->st_old_size;
+	duk_uint32_t pos = heap->st_old_pos;
+
+	DUK_ASSERT(old_entries != NULL);
+
+	while (count > 0 && pos < old_size) {
+		duk_hstring *e = old_entries[pos];
+		if (e != NULL && e != DUK__DELETED_MARKER(heap)) {
+			/* Leave a DELETED marker so that probe sequences of
+			 * strings still in the old table remain intact.
+			 */
+			old_entries[pos] = DUK__DELETED_MARKER(heap);
+			duk__insert_hstring(heap, heap->st, heap->st_size, &heap->st_used, e);
+		}
+		pos++;
+		count--;
+	}
+	heap->st_old_pos = pos;
+
+	if (pos >= old_size) {
+		DUK_DDPRINT("stringtable migration done: %d old entries, new table %d entries, %d used",
+		            (int) old_size, (int) heap->st_size, (int) heap->st_used);
+		DUK_FREE(heap, old_entries);
+		heap->st_old = NULL;
+		heap->st_old_size = 0;
+		heap->st_old_pos = 0;
+		heap->st_old_step = 0;
+	}
+}
+
+#define DUK__MIGRATE_STEP(heap)  do { \
+		if ((heap)->st_old != NULL) { \
+			duk__migrate_strtab((heap), (heap)->st_old_step); \
+		} \
+	} while (0)
+
 static int duk__resize_strtab_raw(duk_heap *heap, duk_uint32_t new_size) {
 #ifdef DUK_USE_MARK_AND_SWEEP
 	int prev_mark_and_sweep_base_flags;
 #endif
-#ifdef DUK_USE_DDEBUG
-	duk_uint32_t old_used = heap->st_used;
-#endif
-	duk_uint32_t old_size = heap->st_size;
-	duk_hstring **old_entries = heap->st;
 	duk_hstring **new_entries = NULL;
-	duk_uint32_t new_used = 0;
+	duk_uint32_t step;
+#ifdef DUK_USE_EXPLICIT_NULL_INIT
 	duk_uint32_t i;
-
-#ifdef DUK_USE_DEBUG
-	DUK_DDDPRINT("attempt to resize stringtable: %d entries, %d bytes, %d used, %d%% load -> %d entries, %d bytes, %d used, %d%% load",
-	             (int) old_size, (int) (sizeof(duk_hstring *) * old_size), (int) old_used,
-	             (int) (((double) old_used) / ((double) old_size) * 100.0),
-	             (int) new_size, (int) (sizeof(duk_hstring *) * new_size), (int) duk__count_used(heap),
-	             (int) (((double) duk__count_used(heap)) / ((double) new_size) * 100.0));
 #endif
 
-	DUK_ASSERT(new_size > (duk_uint32_t) duk__count_used(heap));  /* required for rehash to succeed, equality not that useful */
-	DUK_ASSERT(old_entries);
+	DUK_ASSERT(new_size >= DUK_STRTAB_INITIAL_SIZE);
+	DUK_ASSERT((new_size & (new_size - 1)) == 0);
+	DUK_ASSERT(new_size > heap->st_count);  /* required for rehash to succeed, equality not that useful */
+	DUK_ASSERT(heap->st != NULL);
 #ifdef DUK_USE_MARK_AND_SWEEP
 	DUK_ASSERT((heap->mark_and_sweep_base_flags & DUK_MS_FLAG_NO_STRINGTABLE_RESIZE) == 0);
 #endif
 
+	/* A previous migration should have finished by now (see above), but
+	 * finish it synchronously if not: at most two tables may exist.
+	 */
+	if (heap->st_old != NULL) {
+		DUK_DPRINT("stringtable resize while migration in progress, finish migration first");
+		duk__migrate_strtab(heap, heap->st_old_size);
+	}
+	DUK_ASSERT(heap->st_old == NULL);
+
 	/*
 	 *  The attempt to allocate may cause a GC.  Such a GC must not attempt to resize
 	 *  the stringtable (though it can be swept); finalizer execution and object
@@ -231,7 +316,7 @@ static int duk__resize_strtab_raw(duk_heap *heap, duk_uint32_t new_size) {
 #endif
 
 	if (!new_entries) {
-		goto error;
+		return 1;  /* FAIL */
 	}
 
 #ifdef DUK_USE_EXPLICIT_NULL_INIT
@@ -242,48 +327,50 @@ static int duk__resize_strtab_raw(duk_heap *heap, duk_uint32_t new_size) {
 	DUK_MEMZERO(new_entries, sizeof(duk_hstring *) * new_size);
 #endif
 
-	/* Because new_size > duk__count_used(heap), guaranteed to work */
-	for (i = 0; i < old_size; i++) {
-		duk_hstring *e;
+#ifdef DUK_USE_DEBUG
+	DUK_DPRINT("start stringtable resize: %d entries, %d used, %d live -> %d entries; "
+	           "probes since last resize: %d ops, avg %d.%02d, max %d",
+	           (int) heap->st_size, (int) heap->st_used, (int) heap->st_count, (int) new_size,
+	           (int) heap->st_probe_ops,
+	           (int) (heap->st_probe_ops > 0 ? heap->st_probe_total / heap->st_probe_ops : 0),
+	           (int) (heap->st_probe_ops > 0 ? (heap->st_probe_total % heap->st_probe_ops) * 100 / heap->st_probe_ops : 0),
+	           (int) heap->st_probe_max);
+	heap->st_probe_ops = 0;
+	heap->st_probe_total = 0;
+	heap->st_probe_max = 0;
+#endif
 
-		e = old_entries[i];
-		if (e == NULL || e == DUK__DELETED_MARKER(heap)) {
-			continue;
-		}
-		/* checking for DUK__DELETED_MARKER is not necessary here, but helper does it now */
-		duk__insert_hstring(heap, new_entries, new_size, &new_used, e);
+	/* Visit all old slots within new_size / 8 operations. */
+	step = heap->st_size / (new_size / 8) + 1;
+	if (step < DUK_STRTAB_MIGRATE_STEP) {
+		step = DUK_STRTAB_MIGRATE_STEP;
 	}
 
-#ifdef DUK_USE_DEBUG
-	DUK_DDPRINT("resized stringtable: %d entries, %d bytes, %d used, %d%% load -> %d entries, %d bytes, %d used, %d%% load",
-	            (int) old_size, (int) (sizeof(duk_hstring *) * old_size), (int) old_used,
-	            (int) (((double) old_used) / ((double) old_size) * 100.0),
-	            (int) new_size, (int) (sizeof(duk_hstring *) * new_size), (int) new_used,
-	            (int) (((double) new_used) / ((double) new_size) * 100.0));
-#endif
+	heap->st_old = heap->st;
+	heap->st_old_size = heap->st_size;
+	heap->st_old_pos = 0;
+	heap->st_old_step = step;
 
-	DUK_FREE(heap, heap->st);
 	heap->st = new_entries;
 	heap->st_size = new_size;
-	heap->st_used = new_used;  /* may be less, since DELETED entries are NULLed by rehash */
+	heap->st_used = 0;  /* DELETED entries are dropped by migration */
 
 	return 0;  /* OK */
-
- error:
-	DUK_FREE(heap, new_entries);
-	return 1;  /* FAIL */
 }
 
 static int duk__resize_strtab(duk_heap *heap) {
+	duk_uint32_t count;
 	duk_uint32_t new_size;
-	int ret;
 
-	new_size = (duk_uint32_t) duk__count_used(heap);
-	if (new_size >= 0x80000000U) {
-		new_size = DUK_STRTAB_HIGHEST_32BIT_PRIME;
+	count = heap->st_count;
+	if (count >= DUK_STRTAB_MAX_SIZE / 2) {
+		new_size = (duk_uint32_t) DUK_STRTAB_MAX_SIZE;
 	} else {
-		new_size = duk_util_get_hash_prime(DUK_STRTAB_GROW_ST_SIZE(new_size));
-		new_size = duk_util_get_hash_prime(new_size);
+		count = DUK_STRTAB_GROW_ST_SIZE(count);
+		new_size = DUK_STRTAB_INITIAL_SIZE;
+		while (new_size < count) {
+			new_size <<= 1;
+		}
 	}
 	DUK_ASSERT(new_size > 0);
 
@@ -291,9 +378,7 @@ static int duk__resize_strtab(duk_heap *heap) {
 	 * DELETED entries.
 	*/ 
 
-	ret = duk__resize_strtab_raw(heap, new_size);
-
-	return ret;
+	return duk__resize_strtab_raw(heap, new_size);
 }
 
 static int duk__recheck_strtab_size(duk_heap *heap, duk_uint32_t new_used) {
@@ -305,13 +390,20 @@ static int duk__recheck_strtab_size(duk_heap *heap, duk_uint32_t new_used) {
 	new_free = heap->st_size - new_used;    /* unsigned intentionally */
 
 	/* new_free / size <= 1 / DIV  <=>  new_free <= size / DIV */
-	/* new_used / size <= 1 / DIV  <=>  new_used <= size / DIV */
+	/* count / size <= 1 / DIV  <=>  count <= size / DIV */
 
 	tmp1 = heap->st_size / DUK_STRTAB_MIN_FREE_DIVISOR;
 	tmp2 = heap->st_size / DUK_STRTAB_MIN_USED_DIVISOR;
 
-	if (new_free <= tmp1 || new_used <= tmp2) {
-		/* load factor too low or high, count actually used entries and resize */
+	if (new_free <= tmp1) {
+		/* load factor (including DELETED entries) too high */
+		return duk__resize_strtab(heap);
+	} else if (heap->st_count <= tmp2 &&
+	           heap->st_size > DUK_STRTAB_INITIAL_SIZE &&
+	           heap->st_old == NULL) {
+		/* load factor too low; no point in shrinking while a previous
+		 * resize is still being migrated
+		 */
 		return duk__resize_strtab(heap);
 	} else {
 		return 0;  /* OK */
@@ -335,6 +427,7 @@ static duk_hstring *duk__do_intern(duk_heap *heap, duk_uint8_t *str, duk_uint32_
 	}
 
 	duk__insert_hstring(heap, heap->st, heap->st_size, &heap->st_used, res);  /* guaranteed to succeed */
+	heap->st_count++;
 
 	/* Note: hstring is in heap but has refcount zero and is not strongly reachable.
 	 * Caller should increase refcount and make the hstring reachable before any
@@ -349,11 +442,171 @@ static duk_hstring *duk__do_lookup(duk_heap *heap, duk_uint8_t *str, duk_uint32_
 
 	DUK_ASSERT(out_strhash);
 
+	DUK__MIGRATE_STEP(heap);
+
 	*out_strhash = duk_heap_hashstring(heap, str, (duk_size_t) blen);  /* FIXME: change blen to duk_size_t */
 	res = duk__find_matching_string(heap, heap->st, heap->st_size, str, blen, *out_strhash);
+	if (!res && heap->st_old != NULL) {
+		res = duk__find_matching_string(heap, heap->st_old, heap->st_old_size, str, blen, *out_strhash);
+	}
 	return res;
 }
 
+/*
+ *  Non-interned strings
+ *
+ *  Long strings are not looked up or inserted into the string table;
+ *  they're tracked in a plain array (for mark-and-sweep and heap
+ *  destruction) where each string knows its own index so that removal
+ *  is O(1).
+ */
+
+#if defined(DUK_USE_NONINTERNED_STRINGS)
+/* Ensure there is space for one more entry in heap->nonint_strs. */
+static duk_small_int_t duk__reserve_noninterned(duk_heap *heap) {
+	duk_hstring **new_strs;
+	duk_uint32_t new_size;
+
+	if (heap->nonint_used < heap->nonint_size) {
+		return 1;
+	}
+
+	/* A GC triggered by the allocation may sweep (and compact)
+	 * the current array, so copy only after allocation.
+	 */
+	new_size = heap->nonint_size + heap->nonint_size / 2 + 8;
+	new_strs = (duk_hstring **) DUK_ALLOC(heap, sizeof(duk_hstring *) * new_size);
+	if (!new_strs) {
+		return 0;
+	}
+	DUK_ASSERT(heap->nonint_used <= heap->nonint_size);
+	if (heap->nonint_used > 0) {
+		DUK_MEMCPY((void *) new_strs, (void *) heap->nonint_strs, sizeof(duk_hstring *) * heap->nonint_used);
+	}
+	DUK_FREE(heap, heap->nonint_strs);
+	heap->nonint_strs = new_strs;
+	heap->nonint_size = new_size;
+	return 1;
+}
+
+static void duk__append_noninterned(duk_heap *heap, duk_hstring *h) {
+	DUK_ASSERT(heap->nonint_used < heap->nonint_size);
+
+	DUK_HSTRING_SET_NONINTERNED(h);
+	h->hash = heap->nonint_used;
+	heap->nonint_strs[heap->nonint_used++] = h;
+}
+
+static duk_hstring *duk__do_create_noninterned(duk_heap *heap, duk_uint8_t *str, duk_uint32_t blen) {
+	duk_hstring *res;
+
+	if (!duk__reserve_noninterned(heap)) {
+		return NULL;
+	}
+
+	res = duk__alloc_init_hstring(heap, str, blen, 0 /*strhash*/);
+	if (!res) {
+		return NULL;
+	}
+	duk__append_noninterned(heap, res);
+
+	DUK_DDDPRINT("created non-interned string %p, blen=%d, index=%d",
+	             (void *) res, (int) blen, (int) res->hash);
+
+	/* Same reachability caveat as for duk__do_intern(). */
+
+	return res;
+}
+
+static void duk__remove_noninterned(duk_heap *heap, duk_hstring *h) {
+	duk_uint32_t idx = h->hash;
+	duk_hstring *last;
+
+	DUK_ASSERT(DUK_HSTRING_HAS_NONINTERNED(h));
+	DUK_ASSERT(heap->nonint_used > 0);
+	DUK_ASSERT(idx < heap->nonint_used);
+	DUK_ASSERT(heap->nonint_strs[idx] == h);
+
+	last = heap->nonint_strs[--heap->nonint_used];
+	heap->nonint_strs[idx] = last;
+	last->hash = idx;
+}
+#endif  /* DUK_USE_NONINTERNED_STRINGS */
+
+/*
+ *  String slices
+ *
+ *  A slice refers to the data of a parent string instead of copying it,
+ *  and holds a reference to the parent.  Slices are non-interned strings
+ *  and share their bookkeeping.  A slice of a slice refers directly to
+ *  the original parent so that parent chains are never longer than one.
+ */
+
+#if defined(DUK_USE_STRING_SLICES)
+static duk_hstring *duk__do_create_slice(duk_hthread *thr, duk_hstring *h, duk_uint32_t start_boff, duk_uint32_t blen) {
+	duk_heap *heap = thr->heap;
+	duk_hstring_slice *res;
+	duk_hstring *parent;
+	duk_uint8_t *data;
+	duk_uint32_t dummy;
+	duk_small_int_t is_ascii;
+
+	/* Caller must keep 'h' reachable; allocations below may trigger a
+	 * GC which may also flatten 'h' if it is a slice.
+	 */
+
+	if (!duk__reserve_noninterned(heap)) {
+		return NULL;
+	}
+	res = (duk_hstring_slice *) DUK_ALLOC(heap, sizeof(duk_hstring_slice));
+	if (!res) {
+		return NULL;
+	}
+
+	parent = h;
+	if (DUK_HSTRING_HAS_SLICE(h) && DUK_HSTRING_GET_SLICE_PARENT(h) != NULL) {
+		parent = DUK_HSTRING_GET_SLICE_PARENT(h);
+		DUK_ASSERT(!DUK_HSTRING_HAS_SLICE(parent) || DUK_HSTRING_GET_SLICE_PARENT(parent) == NULL);
+	}
+	data = DUK_HSTRING_GET_DATA(h) + start_boff;
+	DUK_ASSERT(data >= DUK_HSTRING_GET_DATA(parent));
+	DUK_ASSERT(data + blen <= DUK_HSTRING_GET_DATA_END(parent));
+
+	DUK_MEMZERO(res, sizeof(duk_hstring_slice));
+#ifdef DUK_USE_EXPLICIT_NULL_INIT
+	DUK_HEAPHDR_STRING_INIT_NULLS(&res->str.hdr);
+#endif
+	DUK_HEAPHDR_SET_TYPE_AND_FLAGS(&res->str.hdr, DUK_HTYPE_STRING, DUK_HSTRING_FLAG_SLICE);
+
+	if (duk_js_to_arrayindex_raw_string(data, blen, &dummy)) {
+		DUK_HSTRING_SET_ARRIDX(&res->str);
+	}
+	res->str.blen = blen;
+	if (DUK_HSTRING_HAS_ASCII(h)) {
+		res->str.clen = blen;
+		DUK_HSTRING_SET_ASCII(&res->str);
+	} else {
+		res->str.clen = (duk_uint32_t) duk_unicode_unvalidated_utf8_length(data, (duk_size_t) blen, &is_ascii);
+		if (is_ascii) {
+			DUK_HSTRING_SET_ASCII(&res->str);
+		}
+	}
+
+	res->data = data;
+	res->parent = parent;
+	DUK_HSTRING_INCREF(thr, parent);
+	duk__append_noninterned(heap, &res->str);
+
+	DUK_DDDPRINT("created string slice %p, parent=%p, offset=%d, blen=%d, index=%d",
+	             (void *) res, (void *) parent, (int) (data - DUK_HSTRING_GET_DATA(parent)),
+	             (int) blen, (int) res->str.hash);
+
+	/* Same reachability caveat as for duk__do_intern(). */
+
+	return &res->str;
+}
+#endif  /* DUK_USE_STRING_SLICES */
+
 /*
  *  Exposed calls
  */
@@ -363,7 +616,10 @@ duk_hstring *duk_heap_string_lookup(duk_heap *heap, duk_uint8_t *str, duk_uint32
 	return duk__do_lookup(heap, str, blen, &strhash);
 }
 
-duk_hstring *duk_heap_string_intern(duk_heap *heap, duk_uint8_t *str, duk_uint32_t blen) {
+/* Intern a string for use as a property key: the result is always in the
+ * string table so that pointer comparison is a valid equality check.
+ */
+duk_hstring *duk_heap_string_intern_key(duk_heap *heap, duk_uint8_t *str, duk_uint32_t blen) {
 	duk_hstring *res;
 	duk_uint32_t strhash;
 
@@ -379,6 +635,26 @@ duk_hstring *duk_heap_string_intern(duk_heap *heap, duk_uint8_t *str, duk_uint32
 	return res;  /* may be NULL */
 }
 
+duk_hstring *duk_heap_string_intern_key_checked(duk_hthread *thr, duk_uint8_t *str, duk_uint32_t blen) {
+	duk_hstring *res = duk_heap_string_intern_key(thr->heap, str, blen);
+	if (!res) {
+		DUK_ERROR(thr, DUK_ERR_ALLOC_ERROR, "failed to intern string");
+	}
+	return res;
+}
+
+/* Intern a string value; long strings are created without interning if
+ * DUK_USE_NONINTERNED_STRINGS is enabled.
+ */
+duk_hstring *duk_heap_string_intern(duk_heap *heap, duk_uint8_t *str, duk_uint32_t blen) {
+#if defined(DUK_USE_NONINTERNED_STRINGS)
+	if (blen >= (duk_uint32_t) DUK_USE_NONINTERNED_STRING_LIMIT) {
+		return duk__do_create_noninterned(heap, str, blen);  /* may be NULL */
+	}
+#endif
+	return duk_heap_string_intern_key(heap, str, blen);
+}
+
 duk_hstring *duk_heap_string_intern_checked(duk_hthread *thr, duk_uint8_t *str, duk_uint32_t blen) {
 	duk_hstring *res = duk_heap_string_intern(thr->heap, str, blen);
 	if (!res) {
@@ -409,20 +685,99 @@ duk_hstring *duk_heap_string_intern_u32_checked(duk_hthread *thr, duk_uint32_t v
 	return res;
 }
 
+/* Create a string from a byte range of an existing string which the caller
+ * keeps reachable.  Long enough ranges become slices of 'h', others are
+ * interned (or created as non-interned strings) normally.
+ */
+duk_hstring *duk_heap_string_substring_checked(duk_hthread *thr, duk_hstring *h, duk_uint32_t start_boff, duk_uint32_t blen) {
+	DUK_ASSERT(h != NULL);
+	DUK_ASSERT(start_boff + blen <= DUK_HSTRING_GET_BYTELEN(h));
+
+	if (blen == DUK_HSTRING_GET_BYTELEN(h)) {
+		return h;
+	}
+#if defined(DUK_USE_STRING_SLICES)
+	if (blen >= (duk_uint32_t) DUK_USE_STRING_SLICE_LIMIT) {
+		duk_hstring *res = duk__do_create_slice(thr, h, start_boff, blen);
+		if (!res) {
+			DUK_ERROR(thr, DUK_ERR_ALLOC_ERROR, "failed to create string slice");
+		}
+		return res;
+	}
+#endif
+	return duk_heap_string_intern_checked(thr, DUK_HSTRING_GET_DATA(h) + start_boff, blen);
+}
+
+#if defined(DUK_USE_STRING_SLICES)
+/* Copy slice data into a NUL terminated allocation owned by the slice and
+ * drop the parent reference.  No-op for a slice which is already flat.
+ * The caller must keep 'h' reachable.
+ */
+void duk_heap_string_flatten_checked(duk_hthread *thr, duk_hstring *h) {
+	duk_hstring_slice *sl = (duk_hstring_slice *) h;
+	duk_hstring *parent;
+	duk_uint8_t *buf;
+
+	DUK_ASSERT(h != NULL);
+	DUK_ASSERT(DUK_HSTRING_HAS_SLICE(h));
+
+	if (sl->parent == NULL) {
+		return;
+	}
+
+	buf = (duk_uint8_t *) DUK_ALLOC(thr->heap, DUK_HSTRING_GET_BYTELEN(h) + 1);
+	if (!buf) {
+		DUK_ERROR(thr, DUK_ERR_ALLOC_ERROR, "failed to flatten string slice");
+	}
+
+	/* A GC triggered by the allocation may have flattened the slice
+	 * already (if the parent was not otherwise reachable).
+	 */
+	parent = sl->parent;
+	if (parent == NULL) {
+		DUK_FREE(thr->heap, buf);
+		return;
+	}
+
+	DUK_MEMCPY((void *) buf, (void *) sl->data, (size_t) DUK_HSTRING_GET_BYTELEN(h));
+	buf[DUK_HSTRING_GET_BYTELEN(h)] = (duk_uint8_t) 0;
+	sl->data = buf;
+	sl->parent = NULL;
+
+	DUK_DDDPRINT("flattened string slice %p, blen=%d", (void *) h, (int) DUK_HSTRING_GET_BYTELEN(h));
+
+	DUK_HSTRING_DECREF(thr, parent);  /* may free parent */
+}
+#endif  /* DUK_USE_STRING_SLICES */
+
 /* find and remove string from stringtable; caller must free the string itself */
 void duk_heap_string_remove(duk_heap *heap, duk_hstring *h) {
 	DUK_DDDPRINT("remove string from stringtable: %!O", h);
-	duk__remove_matching_hstring(heap, heap->st, heap->st_size, h);
+#if defined(DUK_USE_NONINTERNED_STRINGS)
+	if (DUK_HSTRING_HAS_NONINTERNED(h)) {
+		duk__remove_noninterned(heap, h);
+		return;
+	}
+#endif
+	if (heap->st_old != NULL &&
+	    duk__remove_matching_hstring(heap, heap->st_old, heap->st_old_size, h)) {
+		;
+	} else {
+		int found = duk__remove_matching_hstring(heap, heap->st, heap->st_size, h);
+		DUK_ASSERT(found);
+		DUK_UNREF(found);
+	}
+	DUK_ASSERT(heap->st_count > 0);
+	heap->st_count--;
 }
 
 #if defined(DUK_USE_MARK_AND_SWEEP) && defined(DUK_USE_MS_STRINGTABLE_RESIZE)
 void duk_heap_force_stringtable_resize(duk_heap *heap) {
-	/* Force a resize so that DELETED entries are eliminated.
-	 * Another option would be duk__recheck_strtab_size(); but since
-	 * that happens on every intern anyway, this whole check
-	 * can now be disabled.
+	/* Resizing is incremental and DELETED entries are counted towards
+	 * the load factor, so a resize is only started if the load factor
+	 * is out of bounds after the sweep (same check as on every intern).
 	 */
-	duk__resize_strtab(heap);
+	(void) duk__recheck_strtab_size(heap, heap->st_used);
 }
 #endif
 
@@ -430,4 +785,6 @@ void duk_heap_force_stringtable_resize(duk_heap *heap) {
 #undef DUK__HASH_INITIAL
 #undef DUK__HASH_PROBE_STEP
 #undef DUK__DELETED_MARKER
+#undef DUK__RECORD_PROBES
+#undef DUK__MIGRATE_STEP
 
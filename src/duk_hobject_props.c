@@ -108,8 +108,7 @@ static duk_uint32_t duk__push_tval_to_hstring_arr_idx(duk_context *ctx, duk_tval
 	DUK_ASSERT(out_h != NULL);
 
 	duk_push_tval(ctx, tv);
-	duk_to_string(ctx, -1);
-	h = duk_get_hstring(ctx, -1);
+	h = duk_to_property_key_hstring(ctx, -1);
 	DUK_ASSERT(h != NULL);
 	*out_h = h;
 
@@ -808,6 +807,46 @@ static void duk__abandon_array_checked(duk_hthread *thr, duk_hobject *obj) {
 	duk__realloc_props(thr, obj, new_e_size, new_a_size, new_h_size, 1);
 }
 
+/*
+ *  Presize the property allocation of an object so that at least 'e_size'
+ *  entry part and 'a_size' array part items fit without a resize.  Useful
+ *  when the number of properties of a fresh object can be estimated, e.g.
+ *  in JSON.parse().  The allocation is never shrunk here.
+ *
+ *  The call may fail due to allocation error.
+ */
+
+void duk_hobject_presize_props(duk_hthread *thr, duk_hobject *obj, duk_uint32_t e_size, duk_uint32_t a_size) {
+	duk_uint32_t new_e_size;
+	duk_uint32_t new_a_size;
+	duk_uint32_t new_h_size;
+
+	DUK_ASSERT(thr != NULL);
+	DUK_ASSERT(obj != NULL);
+
+	if (e_size <= obj->e_size && a_size <= obj->a_size) {
+		return;
+	}
+	if (!DUK_HOBJECT_HAS_ARRAY_PART(obj)) {
+		a_size = 0;
+	}
+	if (e_size > DUK_HOBJECT_MAX_PROPERTIES || a_size > DUK_HOBJECT_MAX_PROPERTIES) {
+		/* let normal growth fail if the object really gets this large */
+		return;
+	}
+
+	new_e_size = (e_size > obj->e_size ? e_size : obj->e_size);
+	new_a_size = (a_size > obj->a_size ? a_size : obj->a_size);
+	new_h_size = (new_e_size > obj->e_size ? duk__get_default_h_size(new_e_size) : obj->h_size);
+
+	DUK_DDDPRINT("presize hobject %p: e_size %d -> %d, a_size %d -> %d, h_size %d -> %d",
+	             (void *) obj, (int) obj->e_size, (int) new_e_size,
+	             (int) obj->a_size, (int) new_a_size,
+	             (int) obj->h_size, (int) new_h_size);
+
+	duk__realloc_props(thr, obj, new_e_size, new_a_size, new_h_size, 0);
+}
+
 /*
  *  Compact an object.  Minimizes allocation size for objects which are
  *  not likely to be extended.  This is useful for internal and non-
@@ -1010,6 +1049,9 @@ static int duk__alloc_entry_checked(duk_hthread *thr, duk_hobject *obj, duk_hstr
 	DUK_ASSERT(obj != NULL);
 	DUK_ASSERT(key != NULL);
 	DUK_ASSERT(obj->e_used <= obj->e_size);
+#if defined(DUK_USE_NONINTERNED_STRINGS)
+	DUK_ASSERT(!DUK_HSTRING_HAS_NONINTERNED(key));  /* keys are always interned */
+#endif
 
 #ifdef DUK_USE_ASSERTIONS
 	/* key must not already exist in entry part */
@@ -1304,6 +1346,51 @@ static void duk__check_arguments_map_for_delete(duk_hthread *thr, duk_hobject *o
 	DUK_DDDPRINT("map after deletion: %!O", map);
 }
 
+/*
+ *  On-demand creation of the default 'prototype' object of a function
+ *  instance (E5 Section 13.2, steps 16-18).
+ *
+ *  duk_js_push_closure() allocates the 'prototype' property slot with an
+ *  undefined value and sets DUK_HOBJECT_FLAG_LAZYPROTO.  All own property
+ *  lookups go through duk__get_own_property_desc_raw(), which calls this
+ *  helper before looking at the slot, so the placeholder value is never
+ *  observed.  The slot attributes are not touched: they may have been
+ *  changed by e.g. Object.freeze() before the value was created, which
+ *  only inspects keys and attributes.
+ */
+
+static void duk__create_lazy_prototype(duk_hthread *thr, duk_hobject *obj) {
+	duk_context *ctx = (duk_context *) thr;
+	duk_tval *tv;
+	int e_idx;
+	int h_idx;
+
+	DUK_ASSERT(DUK_HOBJECT_HAS_LAZYPROTO(obj));
+	DUK_ASSERT(DUK_HOBJECT_IS_COMPILEDFUNCTION(obj));
+
+	DUK_DDDPRINT("create lazy 'prototype' for function %p", (void *) obj);
+
+	duk_push_object(ctx);
+	duk_push_hobject(ctx, obj);
+	duk_def_prop_stridx(ctx, -2, DUK_STRIDX_CONSTRUCTOR, DUK_PROPDESC_FLAGS_WC);  /* -> [ ... newobj ] */
+
+	/* The allocations above may have caused a GC and a props realloc
+	 * for 'obj', so look up the slot only now.
+	 */
+	duk_hobject_find_existing_entry(obj, DUK_HTHREAD_STRING_PROTOTYPE(thr), &e_idx, &h_idx);
+	DUK_ASSERT(e_idx >= 0);
+	DUK_ASSERT(!DUK_HOBJECT_E_SLOT_IS_ACCESSOR(obj, e_idx));
+	tv = DUK_HOBJECT_E_GET_VALUE_TVAL_PTR(obj, e_idx);
+	DUK_ASSERT(DUK_TVAL_IS_UNDEFINED(tv));
+
+	/* prev value is undefined, no decref */
+	DUK_TVAL_SET_TVAL(tv, duk_get_tval(ctx, -1));
+	DUK_TVAL_INCREF(thr, tv);
+	DUK_HOBJECT_CLEAR_LAZYPROTO(obj);
+
+	duk_pop(ctx);
+}
+
 /*
  *  Ecmascript compliant [[GetOwnProperty]](P), for internal use only.
  *
@@ -1398,6 +1485,10 @@ static int duk__get_own_property_desc_raw(duk_hthread *thr, duk_hobject *obj, du
 	 *  Entries part
 	 */
 
+	if (DUK_HOBJECT_HAS_LAZYPROTO(obj) && key == DUK_HTHREAD_STRING_PROTOTYPE(thr)) {
+		duk__create_lazy_prototype(thr, obj);
+	}
+
 	duk_hobject_find_existing_entry(obj, key, &out_desc->e_idx, &out_desc->h_idx);
 	if (out_desc->e_idx >= 0) {
 		int e_idx = out_desc->e_idx;
@@ -2129,8 +2220,7 @@ int duk_hobject_hasprop(duk_hthread *thr, duk_tval *tv_obj, duk_tval *tv_key) {
 	DUK_ASSERT(obj != NULL);
 
 	duk_push_tval(ctx, tv_key);
-	duk_to_string(ctx, -1);
-	key = duk_get_hstring(ctx, -1);
+	key = duk_to_property_key_hstring(ctx, -1);
 	DUK_ASSERT(key != NULL);
 
 	/* XXX: inline into a prototype walking loop? */
@@ -3363,8 +3453,7 @@ int duk_hobject_delprop(duk_hthread *thr, duk_tval *tv_obj, duk_tval *tv_key, in
 	duk_push_tval(ctx, tv_obj);
 	duk_push_tval(ctx, tv_key);
 
-	duk_to_string(ctx, -1);
-	key = duk_get_hstring(ctx, -1);
+	key = duk_to_property_key_hstring(ctx, -1);
 	DUK_ASSERT(key != NULL);
 
 	tv_obj = duk_get_tval(ctx, -2);
@@ -3668,8 +3757,7 @@ int duk_hobject_object_get_own_property_descriptor(duk_context *ctx) {
 	DUK_ASSERT(thr->heap != NULL);
 
 	obj = duk_require_hobject(ctx, 0);
-	(void) duk_to_string(ctx, 1);
-	key = duk_require_hstring(ctx, 1);
+	key = duk_to_property_key_hstring(ctx, 1);
 
 	DUK_ASSERT(obj != NULL);
 	DUK_ASSERT(key != NULL);
@@ -3872,8 +3960,7 @@ int duk_hobject_object_define_property(duk_context *ctx) {
 	DUK_ASSERT_VALSTACK_SPACE(thr, DUK__VALSTACK_SPACE);
 
 	obj = duk_require_hobject(ctx, 0);
-	(void) duk_to_string(ctx, 1);
-	key = duk_require_hstring(ctx, 1);
+	key = duk_to_property_key_hstring(ctx, 1);
 	desc = duk_require_hobject(ctx, 2);
 	DUK_UNREF(desc);
 	idx_desc = 2;
@@ -4796,7 +4883,7 @@ int duk_hobject_object_ownprop_helper(duk_context *ctx, int required_desc_flags)
 	int ret;
 
 	/* coercion order matters */
-	h_v = duk_to_hstring(ctx, 0);
+	h_v = duk_to_property_key_hstring(ctx, 0);
 	DUK_ASSERT(h_v != NULL);
 
 	h_obj = duk_push_this_coercible_to_object(ctx);
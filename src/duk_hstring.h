@@ -31,6 +31,27 @@
  * "is valid UTF-8", "is valid extended UTF-8" (internal strings are not,
  * regexp bytecode is), and "contains non-BMP characters".  These are not
  * needed right now.
+ *
+ * The ASCII flag is set at intern time when all bytes are in the range
+ * 0x00...0x7f.  For such strings byte and char offsets are equal, so that
+ * callers can index string data directly without the string cache.  Note
+ * that 'blen == clen' alone does not imply this: internal strings with a
+ * 0xff prefix byte also satisfy it.
+ *
+ * Long strings may be created without interning (NONINTERNED flag), see
+ * DUK_USE_NONINTERNED_STRINGS.  Such strings are never used as property
+ * keys, and two different string pointers may have the same contents if
+ * either of them is non-interned.  The 'hash' field of a non-interned
+ * string holds its index in heap->nonint_strs instead of a hash.
+ *
+ * A slice (SLICE flag, see DUK_USE_STRING_SLICES) is a non-interned string
+ * whose data is not stored inline but points into the data of a 'parent'
+ * string which the slice keeps reachable.  Slice data is NOT NUL
+ * terminated; when a C string is needed, the slice is flattened: its data
+ * is copied into a separate allocation owned by the slice and the parent
+ * reference is dropped.  Mark-and-sweep also flattens slices whose parent
+ * is not otherwise reachable so that small slices don't keep large
+ * parents alive indefinitely.
  */
 
 #define DUK_HSTRING_FLAG_ARRIDX                     DUK_HEAPHDR_USER_FLAG(0)  /* string is a valid array index */
@@ -38,33 +59,51 @@
 #define DUK_HSTRING_FLAG_RESERVED_WORD              DUK_HEAPHDR_USER_FLAG(2)  /* string is a reserved word (non-strict) */
 #define DUK_HSTRING_FLAG_STRICT_RESERVED_WORD       DUK_HEAPHDR_USER_FLAG(3)  /* string is a reserved word (strict) */
 #define DUK_HSTRING_FLAG_EVAL_OR_ARGUMENTS          DUK_HEAPHDR_USER_FLAG(4)  /* string is 'eval' or 'arguments' */
+#define DUK_HSTRING_FLAG_ASCII                      DUK_HEAPHDR_USER_FLAG(5)  /* string is pure ASCII (byte offset == char offset) */
+#define DUK_HSTRING_FLAG_NONINTERNED                DUK_HEAPHDR_USER_FLAG(6)  /* string is not in the string table */
+#define DUK_HSTRING_FLAG_SLICE                      DUK_HEAPHDR_USER_FLAG(7)  /* string is a duk_hstring_slice */
 
 #define DUK_HSTRING_HAS_ARRIDX(x)                   DUK_HEAPHDR_CHECK_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_ARRIDX)
 #define DUK_HSTRING_HAS_INTERNAL(x)                 DUK_HEAPHDR_CHECK_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_INTERNAL)
 #define DUK_HSTRING_HAS_RESERVED_WORD(x)            DUK_HEAPHDR_CHECK_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_RESERVED_WORD)
 #define DUK_HSTRING_HAS_STRICT_RESERVED_WORD(x)     DUK_HEAPHDR_CHECK_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_STRICT_RESERVED_WORD)
 #define DUK_HSTRING_HAS_EVAL_OR_ARGUMENTS(x)        DUK_HEAPHDR_CHECK_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_EVAL_OR_ARGUMENTS)
+#define DUK_HSTRING_HAS_ASCII(x)                    DUK_HEAPHDR_CHECK_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_ASCII)
+#define DUK_HSTRING_HAS_NONINTERNED(x)              DUK_HEAPHDR_CHECK_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_NONINTERNED)
+#define DUK_HSTRING_HAS_SLICE(x)                    DUK_HEAPHDR_CHECK_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_SLICE)
 
 #define DUK_HSTRING_SET_ARRIDX(x)                   DUK_HEAPHDR_SET_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_ARRIDX)
 #define DUK_HSTRING_SET_INTERNAL(x)                 DUK_HEAPHDR_SET_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_INTERNAL)
 #define DUK_HSTRING_SET_RESERVED_WORD(x)            DUK_HEAPHDR_SET_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_RESERVED_WORD)
 #define DUK_HSTRING_SET_STRICT_RESERVED_WORD(x)     DUK_HEAPHDR_SET_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_STRICT_RESERVED_WORD)
 #define DUK_HSTRING_SET_EVAL_OR_ARGUMENTS(x)        DUK_HEAPHDR_SET_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_EVAL_OR_ARGUMENTS)
+#define DUK_HSTRING_SET_ASCII(x)                    DUK_HEAPHDR_SET_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_ASCII)
+#define DUK_HSTRING_SET_NONINTERNED(x)              DUK_HEAPHDR_SET_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_NONINTERNED)
+#define DUK_HSTRING_SET_SLICE(x)                    DUK_HEAPHDR_SET_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_SLICE)
 
 #define DUK_HSTRING_CLEAR_ARRIDX(x)                 DUK_HEAPHDR_CLEAR_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_ARRIDX)
 #define DUK_HSTRING_CLEAR_INTERNAL(x)               DUK_HEAPHDR_CLEAR_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_INTERNAL)
 #define DUK_HSTRING_CLEAR_RESERVED_WORD(x)          DUK_HEAPHDR_CLEAR_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_RESERVED_WORD)
 #define DUK_HSTRING_CLEAR_STRICT_RESERVED_WORD(x)   DUK_HEAPHDR_CLEAR_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_STRICT_RESERVED_WORD)
 #define DUK_HSTRING_CLEAR_EVAL_OR_ARGUMENTS(x)      DUK_HEAPHDR_CLEAR_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_EVAL_OR_ARGUMENTS)
+#define DUK_HSTRING_CLEAR_ASCII(x)                  DUK_HEAPHDR_CLEAR_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_ASCII)
+#define DUK_HSTRING_CLEAR_NONINTERNED(x)            DUK_HEAPHDR_CLEAR_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_NONINTERNED)
+#define DUK_HSTRING_CLEAR_SLICE(x)                  DUK_HEAPHDR_CLEAR_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_SLICE)
 
-#define DUK_HSTRING_IS_ASCII(x)                     ((x)->blen == (x)->clen)
+#define DUK_HSTRING_IS_ASCII(x)                     DUK_HSTRING_HAS_ASCII((x))
 #define DUK_HSTRING_IS_EMPTY(x)                     ((x)->blen == 0)
 
 #define DUK_HSTRING_GET_HASH(x)                     ((x)->hash)
 #define DUK_HSTRING_GET_BYTELEN(x)                  ((x)->blen)
 #define DUK_HSTRING_GET_CHARLEN(x)                  ((x)->clen)
+#if defined(DUK_USE_STRING_SLICES)
+#define DUK_HSTRING_GET_DATA(x) \
+	(DUK_HSTRING_HAS_SLICE((x)) ? ((duk_hstring_slice *) (x))->data : ((duk_uint8_t *) ((x) + 1)))
+#define DUK_HSTRING_GET_SLICE_PARENT(x)             (((duk_hstring_slice *) (x))->parent)
+#else
 #define DUK_HSTRING_GET_DATA(x)                     ((duk_uint8_t *) ((x) + 1))
-#define DUK_HSTRING_GET_DATA_END(x)                 (((duk_uint8_t *) ((x) + 1)) + ((x)->blen))
+#endif
+#define DUK_HSTRING_GET_DATA_END(x)                 (DUK_HSTRING_GET_DATA((x)) + ((x)->blen))
 
 /* marker value; in E5 2^32-1 is not a valid array index (2^32-2 is highest valid) */
 #define DUK_HSTRING_NO_ARRAY_INDEX  (0xffffffffUL)
@@ -93,7 +132,7 @@ struct duk_hstring {
 	 * shared heap header.  Good hashing needs more hash bits though.
 	 */
 
-	duk_uint32_t hash;         /* string hash */
+	duk_uint32_t hash;         /* string hash (index in heap->nonint_strs if non-interned) */
 	duk_uint32_t blen;         /* length in bytes (not counting NUL term) */
 	duk_uint32_t clen;         /* length in codepoints (must be E5 compatible) */
 
@@ -105,5 +144,18 @@ struct duk_hstring {
 	 */
 };
 
+#if defined(DUK_USE_STRING_SLICES)
+struct duk_hstring_slice {
+	duk_hstring str;
+
+	/* Points into the parent's data, or to a NUL terminated copy owned
+	 * by the slice if 'parent' is NULL (flattened slice).  The parent is
+	 * never a slice with a parent of its own.
+	 */
+	duk_uint8_t *data;
+	duk_hstring *parent;
+};
+#endif
+
 #endif  /* DUK_HSTRING_H_INCLUDED */
 
@@ -68,6 +68,7 @@ int duk_handle_safe_call(duk_hthread *thr,
 void duk_handle_ecma_call_setup(duk_hthread *thr,
                                 int num_stack_args,
                                 int call_flags);
+void duk_js_create_lazy_arguments(duk_hthread *thr);
 
 /* bytecode execution */
 void duk_js_execute_bytecode(duk_hthread *entry_thread);
@@ -121,7 +121,7 @@ typedef duk_uint32_t duk_instr;
 #define DUK_OP_BREAK                56
 #define DUK_OP_CONTINUE             57
 #define DUK_OP_TRYCATCH             58
-#define DUK_OP_UNUSED59             59
+#define DUK_OP_GETARG               59
 #define DUK_OP_UNUSED60             60
 #define DUK_OP_EXTRA                61
 #define DUK_OP_DEBUG                62
@@ -295,6 +295,95 @@ static void duk__handle_createargs_for_call(duk_hthread *thr,
 	/* [... arg1 ... argN envobj] */
 }
 
+/*
+ *  Lazy arguments object handling.
+ *
+ *  A LAZYARGS function only reads 'arguments[x]' and 'arguments.length'
+ *  (see DUK_OP_GETARG) so no arguments object is created on entry.  The
+ *  original call arguments are instead kept below the new valstack bottom:
+ *
+ *    [ ... arg1 ... argN argobj N this | regs ]
+ *
+ *  'argobj' is undefined until the object is created on demand, 'N' is the
+ *  actual argument count, and 'this' is a copy of the 'this' binding which
+ *  is always expected to be just beneath the valstack bottom.
+ */
+
+/* Set up the value stack for a LAZYARGS function; returns the new idx_args. */
+static int duk__handle_lazyargs_for_call(duk_hthread *thr,
+                                         int idx_args,
+                                         int num_stack_args,
+                                         int nargs,
+                                         int nregs) {
+	duk_context *ctx = (duk_context *) thr;
+	int i;
+
+	DUK_ASSERT(duk_get_top(ctx) == idx_args + num_stack_args);
+	DUK_ASSERT(nregs >= nargs);
+
+	duk_require_stack(ctx, 3 + nregs);
+
+	/* [... this arg1 ... argN] */
+
+	duk_push_undefined(ctx);
+	duk_push_int(ctx, num_stack_args);
+	duk_push_tval(ctx, thr->valstack_bottom + idx_args - 1);
+	idx_args += num_stack_args + 3;
+	for (i = 0; i < num_stack_args && i < nargs; i++) {
+		duk_dup(ctx, idx_args - num_stack_args - 3 + i);
+	}
+
+	/* [... this arg1 ... argN argobj N this | arg1 ... argM] */
+
+	return idx_args;
+}
+
+void duk_js_create_lazy_arguments(duk_hthread *thr) {
+	duk_context *ctx = (duk_context *) thr;
+	duk_activation *act;
+	duk_hobject *func;
+	duk_tval *tv;
+	duk_tval tv_tmp;
+	int entry_top;
+	int num_args;
+	int i;
+
+	DUK_ASSERT(thr->callstack_top >= 1);
+	act = thr->callstack + thr->callstack_top - 1;
+	func = act->func;
+	DUK_ASSERT(func != NULL);
+	DUK_ASSERT(DUK_HOBJECT_HAS_LAZYARGS(func));
+	DUK_ASSERT(DUK_TVAL_IS_UNDEFINED(thr->valstack_bottom - 3));
+	DUK_ASSERT(DUK_TVAL_IS_NUMBER(thr->valstack_bottom - 2));
+
+	DUK_DDDPRINT("creating lazy arguments object for func=%!iO", (duk_heaphdr *) func);
+
+	if (act->var_env == NULL) {
+		duk_js_init_activation_environment_records_delayed(thr, act);
+		act = thr->callstack + thr->callstack_top - 1;
+	}
+	DUK_ASSERT(act->var_env != NULL);
+
+	entry_top = duk_get_top(ctx);
+	num_args = (int) DUK_TVAL_GET_NUMBER(thr->valstack_bottom - 2);
+	duk_require_stack(ctx, num_args);
+	for (i = 0; i < num_args; i++) {
+		duk_push_tval(ctx, thr->valstack_bottom - 3 - num_args + i);
+	}
+
+	duk__create_arguments_object(thr, func, act->var_env, entry_top, num_args);
+
+	/* [ ... arg1 ... argN argobj ] */
+
+	tv = thr->valstack_bottom - 3;
+	DUK_TVAL_SET_TVAL(&tv_tmp, tv);
+	DUK_TVAL_SET_TVAL(tv, duk_get_tval(ctx, -1));
+	DUK_TVAL_INCREF(thr, tv);
+	DUK_TVAL_DECREF(thr, &tv_tmp);  /* side effects */
+
+	duk_set_top(ctx, entry_top);
+}
+
 /*
  *  Helper for handling a "bound function" chain when a call is being made.
  *
@@ -635,6 +724,7 @@ int duk_handle_call(duk_hthread *thr,
 	duk_jmpbuf * volatile old_jmpbuf_ptr = NULL;    /* ptr is volatile (not the target) */
 	int idx_func;         /* valstack index of 'func' and retval (relative to entry valstack_bottom) */
 	int idx_args;         /* valstack index of start of args (arg1) (relative to entry valstack_bottom) */
+	int idx_bottom;       /* valstack index of new valstack bottom, differs from idx_args for LAZYARGS */
 	int nargs;            /* # argument registers target function wants (< 0 => "as is") */
 	int nregs;            /* # total registers target function wants on entry (< 0 => "as is") */
 	unsigned int vs_min_size;  /* FIXME: type */
@@ -1103,9 +1193,17 @@ int duk_handle_call(duk_hthread *thr,
 
 	/* XXX: replace with a single operation */
 
+	idx_bottom = idx_args;
+	if (DUK_HOBJECT_HAS_LAZYARGS(func)) {
+		/* keep all args for DUK_OP_GETARG, see duk__handle_lazyargs_for_call() */
+		idx_bottom = duk__handle_lazyargs_for_call(thr, idx_args, num_stack_args, nargs, nregs);
+		act = thr->callstack + thr->callstack_top - 1;
+		act->idx_bottom = entry_valstack_bottom_index + idx_bottom;
+	}
+
 	if (nregs >= 0) {
-		duk_set_top(ctx, idx_args + nargs);  /* clamp anything above nargs */
-		duk_set_top(ctx, idx_args + nregs);  /* extend with undefined */
+		duk_set_top(ctx, idx_bottom + nargs);  /* clamp anything above nargs */
+		duk_set_top(ctx, idx_bottom + nregs);  /* extend with undefined */
 	} else {
 		/* 'func' wants stack "as is" */
 	}
@@ -1228,7 +1326,7 @@ int duk_handle_call(duk_hthread *thr,
 	 *  Shift to new valstack_bottom.
 	 */
 
-	thr->valstack_bottom = thr->valstack_bottom + idx_args;
+	thr->valstack_bottom = thr->valstack_bottom + idx_bottom;
 	/* keep current valstack_top */
 	DUK_ASSERT(thr->valstack_bottom >= thr->valstack);
 	DUK_ASSERT(thr->valstack_top >= thr->valstack_bottom);
@@ -1868,6 +1966,7 @@ void duk_handle_ecma_call_setup(duk_hthread *thr,
 	if (use_tailcall) {
 		duk_tval *tv1, *tv2;
 		duk_tval tv_tmp;
+		int lazy_crud;
 		int i;
 
 		/*
@@ -1889,10 +1988,29 @@ void duk_handle_ecma_call_setup(duk_hthread *thr,
 		DUK_ASSERT(DUK_HOBJECT_HAS_COMPILEDFUNCTION(func));
 		DUK_ASSERT((act->flags & DUK_ACT_FLAG_PREVENT_YIELD) == 0);
 
+		/* A LAZYARGS caller keeps its call arguments below its bottom
+		 * (see duk__handle_lazyargs_for_call()); reclaim them too.
+		 */
+		lazy_crud = 0;
+		if (DUK_HOBJECT_HAS_LAZYARGS(act->func)) {
+			DUK_ASSERT(DUK_TVAL_IS_NUMBER(thr->valstack_bottom - 2));
+			lazy_crud = (int) DUK_TVAL_GET_NUMBER(thr->valstack_bottom - 2) + 3;
+		}
+
 		/* There's no catchstack to unwind (a tailcall instruction is not emitted if there is) */
 		DUK_ASSERT(thr->callstack_top > 0);
 		duk_hthread_callstack_unwind(thr, thr->callstack_top - 1);
 
+		if (lazy_crud > 0) {
+			/* [ ... this_old arg1 ... argN argobj N this_old | (crud) func this_new ... ]
+			 * -> [ ... this_old | arg1 ... argN argobj N this_old (crud) func this_new ... ]
+			 */
+			thr->valstack_bottom -= lazy_crud;
+			entry_valstack_bottom_index -= lazy_crud;
+			idx_func += lazy_crud;
+			idx_args += lazy_crud;
+		}
+
 		/* Then reuse the unwound activation; callstack was not shrunk so there is always space */
 		thr->callstack_top++;
 		DUK_ASSERT(thr->callstack_top <= thr->callstack_size);
@@ -2102,6 +2220,16 @@ void duk_handle_ecma_call_setup(duk_hthread *thr,
 
 	/* XXX: replace with a single operation */
 
+	if (DUK_HOBJECT_HAS_LAZYARGS(func)) {
+		/* keep all args for DUK_OP_GETARG, see duk__handle_lazyargs_for_call();
+		 * for a tailcall this grows the valstack bottom, but the growth is
+		 * reclaimed if the function makes a tailcall in turn
+		 */
+		idx_args = duk__handle_lazyargs_for_call(thr, idx_args, num_stack_args, nargs, nregs);
+		act = thr->callstack + thr->callstack_top - 1;
+		act->idx_bottom = entry_valstack_bottom_index + idx_args;
+	}
+
 	DUK_ASSERT(nregs >= 0);
 	duk_set_top(ctx, idx_args + nargs);  /* clamp anything above nargs */
 	duk_set_top(ctx, idx_args + nregs);  /* extend with undefined */
@@ -147,7 +147,8 @@ static int duk__lookup_lhs(duk_compiler_ctx *ctx, int *out_reg_varbind, int *out
 /* label handling */
 static void duk__add_label(duk_compiler_ctx *comp_ctx, duk_hstring *h_label, int pc_label, int label_id);
 static void duk__update_label_flags(duk_compiler_ctx *comp_ctx, int label_id, int flags);
-static void duk__lookup_active_label(duk_compiler_ctx *comp_ctx, duk_hstring *h_label, int is_break, int *out_label_id, int *out_label_catch_depth, int *out_label_pc, int *out_is_closest);
+static void duk__set_label_need_catcher(duk_compiler_ctx *comp_ctx, int label_id);
+static void duk__lookup_active_label(duk_compiler_ctx *comp_ctx, duk_hstring *h_label, int is_break, int *out_label_id, int *out_label_catch_depth, int *out_label_pc);
 static void duk__reset_labels_to_length(duk_compiler_ctx *comp_ctx, int len);
 
 /* top-down expression parser */
@@ -656,6 +657,9 @@ static void duk__convert_to_func_template(duk_compiler_ctx *comp_ctx) {
 				DUK_DDDPRINT("function may access 'arguments' object directly or "
 				             "indirectly -> set CREATEARGS");
 				DUK_HOBJECT_SET_CREATEARGS((duk_hobject *) h_res);
+			} else if (func->lazy_arguments) {
+				DUK_DDDPRINT("function only reads 'arguments' with GETARG -> set LAZYARGS");
+				DUK_HOBJECT_SET_LAZYARGS((duk_hobject *) h_res);
 			}
 		}
 	} else if (func->is_eval && func->is_strict) {
@@ -768,6 +772,7 @@ static void duk__convert_to_func_template(duk_compiler_ctx *comp_ctx) {
 	 */
 	if (func->id_access_slow ||     /* directly uses slow accesses */
 	    func->may_direct_eval ||    /* may indirectly slow access through a direct eval */
+	    func->lazy_arguments ||     /* lazily created arguments object may map formals */
 	    funcs_count > 0) {          /* has inner functions which may slow access (XXX: this can be optimized by looking at the inner functions) */
 		int num_used;
 		duk_dup(ctx, func->varmap_idx);
@@ -1777,6 +1782,28 @@ static int duk__ispec_toregconst_raw(duk_compiler_ctx *comp_ctx,
 		}
 		}  /* end switch */
 	}
+	case DUK_ISPEC_ARGUMENTS: {
+		/* The 'arguments' object is needed as a value after all, e.g. for
+		 * 'arguments[0] = 1' or 'arguments.foo()'.  The lookup flags the
+		 * function as accessing 'arguments', so this never happens in a
+		 * LAZYARGS function (pass 1 sees the same code).
+		 */
+		int reg_varbind;
+		int reg_varname;
+		int dest;
+
+		DUK_ASSERT(!comp_ctx->curr_func.lazy_arguments);
+
+		duk_push_hstring_stridx(ctx, DUK_STRIDX_LC_ARGUMENTS);
+		if (duk__lookup_lhs(comp_ctx, &reg_varbind, &reg_varname)) {
+			x->t = DUK_ISPEC_REGCONST;
+			x->regconst = reg_varbind;
+			return duk__ispec_toregconst_raw(comp_ctx, x, forced_reg, flags);
+		}
+		dest = (forced_reg >= 0 ? forced_reg : DUK__ALLOCTEMP(comp_ctx));
+		duk__emit_a_bc(comp_ctx, DUK_OP_GETVAR, dest, reg_varname);
+		return dest;
+	}
 	case DUK_ISPEC_REGCONST: {
 		if ((x->regconst & DUK__CONST_MARKER) && !(flags & DUK__IVAL_FLAG_ALLOW_CONST)) {
 			int dest = (forced_reg >= 0 ? forced_reg : DUK__ALLOCTEMP(comp_ctx));
@@ -1919,6 +1946,28 @@ static void duk__ivalue_toplain_raw(duk_compiler_ctx *comp_ctx, duk_ivalue *x, i
 		int arg2;
 		int dest;
 
+		if (x->x1.t == DUK_ISPEC_ARGUMENTS) {
+			/* 'arguments[x]' or 'arguments.length' read, see
+			 * duk__ivalue_is_lazy_arguments()
+			 */
+			arg2 = duk__ispec_toregconst_raw(comp_ctx, &x->x2, -1, DUK__IVAL_FLAG_ALLOW_CONST | DUK__IVAL_FLAG_REQUIRE_SHORT /*flags*/);
+
+			if (forced_reg >= 0) {
+				dest = forced_reg;
+			} else if (DUK__ISTEMP(comp_ctx, arg2)) {
+				dest = arg2;
+			} else {
+				dest = DUK__ALLOCTEMP(comp_ctx);
+			}
+
+			duk__emit_a_b(comp_ctx, DUK_OP_GETARG, dest, arg2);
+
+			x->t = DUK_IVAL_PLAIN;
+			x->x1.t = DUK_ISPEC_REGCONST;
+			x->x1.regconst = dest;
+			return;
+		}
+
 		/* need a short reg/const, does not have to be a mutable temp */
 		arg1 = duk__ispec_toregconst_raw(comp_ctx, &x->x1, -1, DUK__IVAL_FLAG_ALLOW_CONST | DUK__IVAL_FLAG_REQUIRE_SHORT /*flags*/);
 		arg2 = duk__ispec_toregconst_raw(comp_ctx, &x->x2, -1, DUK__IVAL_FLAG_ALLOW_CONST | DUK__IVAL_FLAG_REQUIRE_SHORT /*flags*/);
@@ -2050,6 +2099,39 @@ static int duk__ivalue_toregconst(duk_compiler_ctx *comp_ctx, duk_ivalue *x) {
  * need to be coerced.
  */
 
+/* Check whether 'x' is an identifier reference to the function's own
+ * 'arguments' which is about to be read with 'arguments[x]' or
+ * 'arguments.length'.  Pass 1 just records such reads; pass 2 compiles
+ * them into DUK_OP_GETARG if the function has no other references to
+ * 'arguments' (any other use goes through duk__lookup_active_register_binding()
+ * and sets id_access_arguments) and no direct eval calls.  The arguments
+ * object is then only created if GETARG needs it.
+ */
+static int duk__ivalue_is_lazy_arguments(duk_compiler_ctx *comp_ctx, duk_ivalue *x) {
+	duk_hthread *thr = comp_ctx->thr;
+	duk_context *ctx = (duk_context *) thr;
+
+	if (x->t != DUK_IVAL_VAR ||
+	    !comp_ctx->curr_func.is_function ||
+	    comp_ctx->curr_func.with_depth > 0) {
+		return 0;
+	}
+	DUK_ASSERT(x->x1.t == DUK_ISPEC_VALUE);
+	if (duk_get_hstring(ctx, x->x1.valstack_idx) != DUK_HTHREAD_STRING_LC_ARGUMENTS(thr)) {
+		return 0;
+	}
+
+	if (comp_ctx->curr_func.in_scanning) {
+		/* a catch binding named 'arguments' shadows the arguments object */
+		if (duk_has_prop_stridx(ctx, comp_ctx->curr_func.varmap_idx, DUK_STRIDX_LC_ARGUMENTS)) {
+			return 0;
+		}
+		comp_ctx->curr_func.id_access_arguments_lazy = 1;
+		return 1;
+	}
+	return comp_ctx->curr_func.lazy_arguments;
+}
+
 /*
  *  Identifier handling
  */
@@ -2234,6 +2316,28 @@ static void duk__update_label_flags(duk_compiler_ctx *comp_ctx, int label_id, in
 	}
 }
 
+/* Mark all labels with matching label_id as needing a runtime LABEL catcher.
+ * Unlike duk__update_label_flags(), the label may be anywhere in the active
+ * label set.
+ */
+static void duk__set_label_need_catcher(duk_compiler_ctx *comp_ctx, int label_id) {
+	char *p;
+	duk_labelinfo *li_start, *li;
+
+	p = (char *) DUK_HBUFFER_DYNAMIC_GET_CURR_DATA_PTR(comp_ctx->curr_func.h_labelinfos);
+	li_start = (duk_labelinfo *) p;
+	li = (duk_labelinfo *) (p + DUK_HBUFFER_GET_SIZE(comp_ctx->curr_func.h_labelinfos));
+
+	while (li > li_start) {
+		li--;
+
+		if (li->label_id == label_id) {
+			DUK_DDDPRINT("label_id=%d needs a catcher, li=%p", label_id, (void *) li);
+			li->flags |= DUK_LABEL_FLAG_NEED_CATCHER;
+		}
+	}
+}
+
 /* Lookup active label information.  Break/continue distinction is necessary to handle switch
  * statement related labels correctly: a switch will only catch a 'break', not a 'continue'.
  *
@@ -2249,7 +2353,7 @@ static void duk__update_label_flags(duk_compiler_ctx *comp_ctx, int label_id, in
  */
 
 /* FIXME: awkward, especially the bunch of separate output values -> output struct? */
-static void duk__lookup_active_label(duk_compiler_ctx *comp_ctx, duk_hstring *h_label, int is_break, int *out_label_id, int *out_label_catch_depth, int *out_label_pc, int *out_is_closest) {
+static void duk__lookup_active_label(duk_compiler_ctx *comp_ctx, duk_hstring *h_label, int is_break, int *out_label_id, int *out_label_catch_depth, int *out_label_pc) {
 	duk_hthread *thr = comp_ctx->thr;
 	duk_context *ctx = (duk_context *) thr;
 	char *p;
@@ -2315,7 +2419,6 @@ static void duk__lookup_active_label(duk_compiler_ctx *comp_ctx, duk_hstring *h_
 	*out_label_id = li->label_id;
 	*out_label_catch_depth = li->catch_depth;
 	*out_label_pc = li->pc_label;
-	*out_is_closest = (li == li_end - 1);
 }
 
 static void duk__reset_labels_to_length(duk_compiler_ctx *comp_ctx, int len) {
@@ -3356,7 +3459,12 @@ static void duk__expr_led(duk_compiler_ctx *comp_ctx, duk_ivalue *left, duk_ival
 		 * causes an extra LDREG in call setup.  It's sufficient to coerce to a
 		 * unary ivalue?
 		 */
-		duk__ivalue_toplain(comp_ctx, left);
+		if (duk__ivalue_is_lazy_arguments(comp_ctx, left)) {
+			left->t = DUK_IVAL_PLAIN;
+			left->x1.t = DUK_ISPEC_ARGUMENTS;
+		} else {
+			duk__ivalue_toplain(comp_ctx, left);
+		}
 
 		/* NB: must accept reserved words as property name */
 		if (comp_ctx->curr_token.t_nores != DUK_TOK_IDENTIFIER) {
@@ -3381,7 +3489,12 @@ static void duk__expr_led(duk_compiler_ctx *comp_ctx, duk_ivalue *left, duk_ival
 		/* FIXME: optimize temp reg use */
 		/* FIXME: similar coercion issue as in DUK_TOK_PERIOD */
 
-		duk__ivalue_toplain(comp_ctx, left);
+		if (duk__ivalue_is_lazy_arguments(comp_ctx, left)) {
+			left->t = DUK_IVAL_PLAIN;
+			left->x1.t = DUK_ISPEC_ARGUMENTS;
+		} else {
+			duk__ivalue_toplain(comp_ctx, left);
+		}
 
 		duk__expr_toplain(comp_ctx, res, DUK__BP_FOR_EXPR /*rbp_flags*/);  /* Expression, ']' terminates */
 
@@ -5044,7 +5157,6 @@ static void duk__parse_break_or_continue_stmt(duk_compiler_ctx *comp_ctx, duk_iv
 	int label_id;
 	int label_catch_depth;
 	int label_pc;  /* points to LABEL; pc+1 = jump site for break; pc+2 = jump site for continue */
-	int label_is_closest;
 
 	DUK_UNREF(res);
 
@@ -5055,11 +5167,11 @@ static void duk__parse_break_or_continue_stmt(duk_compiler_ctx *comp_ctx, duk_iv
 	    comp_ctx->curr_token.allow_auto_semi) {         /* automatic semi will be inserted */
 		/* break/continue without label */
 
-		duk__lookup_active_label(comp_ctx, DUK_HTHREAD_STRING_EMPTY_STRING(thr), is_break, &label_id, &label_catch_depth, &label_pc, &label_is_closest);
+		duk__lookup_active_label(comp_ctx, DUK_HTHREAD_STRING_EMPTY_STRING(thr), is_break, &label_id, &label_catch_depth, &label_pc);
 	} else if (comp_ctx->curr_token.t == DUK_TOK_IDENTIFIER) {
 		/* break/continue with label (label cannot be a reserved word, production is 'Identifier' */
 		DUK_ASSERT(comp_ctx->curr_token.str1 != NULL);
-		duk__lookup_active_label(comp_ctx, comp_ctx->curr_token.str1, is_break, &label_id, &label_catch_depth, &label_pc, &label_is_closest);
+		duk__lookup_active_label(comp_ctx, comp_ctx->curr_token.str1, is_break, &label_id, &label_catch_depth, &label_pc);
 		duk__advance(comp_ctx);
 	} else {
 		DUK_ERROR(thr, DUK_ERR_SYNTAX_ERROR, "invalid break/continue label");
@@ -5069,24 +5181,31 @@ static void duk__parse_break_or_continue_stmt(duk_compiler_ctx *comp_ctx, duk_iv
 	 * just a jump to the LABEL break/continue jump slot, which then jumps
 	 * to an appropriate place (for break, going through ENDLABEL correctly).
 	 * The peephole optimizer will optimize the jump to a direct one.
+	 *
+	 * The fast variant is used whenever there is no try or 'with' statement
+	 * between the break/continue and the target label.  The jump may skip
+	 * over other label sites (e.g. 'continue' inside a 'switch', or a
+	 * labelled break out of nested loops); if such a site ends up needing
+	 * a LABEL catcher, the jump is converted to a slow one when the site
+	 * is finished, see duk__end_label_site().
 	 */
 
-	if (label_catch_depth == comp_ctx->curr_func.catch_depth &&
-	    label_is_closest) {
-		DUK_DDDPRINT("break/continue: is_break=%d, label_id=%d, label_is_closest=%d, "
+	if (label_catch_depth == comp_ctx->curr_func.catch_depth) {
+		DUK_DDDPRINT("break/continue: is_break=%d, label_id=%d, "
 		             "label_catch_depth=%d, catch_depth=%d "
 		             "-> use fast variant (direct jump)",
-		             is_break, label_id, label_is_closest, label_catch_depth,
+		             is_break, label_id, label_catch_depth,
 		             comp_ctx->curr_func.catch_depth);
 
 		duk__emit_jump(comp_ctx, label_pc + (is_break ? 1 : 2));
 	} else {
-		DUK_DDDPRINT("break/continue: is_break=%d, label_id=%d, label_is_closest=%d, "
+		DUK_DDDPRINT("break/continue: is_break=%d, label_id=%d, "
 		             "label_catch_depth=%d, catch_depth=%d "
 		             "-> use slow variant (longjmp)",
-		             is_break, label_id, label_is_closest, label_catch_depth,
+		             is_break, label_id, label_catch_depth,
 		             comp_ctx->curr_func.catch_depth);
 
+		duk__set_label_need_catcher(comp_ctx, label_id);
 		duk__emit_abc(comp_ctx,
 		              is_break ? DUK_OP_BREAK : DUK_OP_CONTINUE,
 		              label_id);
@@ -5432,7 +5551,12 @@ static void duk__parse_with_stmt(duk_compiler_ctx *comp_ctx, duk_ivalue *res) {
 	duk__emit_invalid(comp_ctx);  /* catch jump */
 	duk__emit_invalid(comp_ctx);  /* finished jump */
 
+	/* The 'with' catcher must be unwound by a break/continue out of the
+	 * statement, so it counts towards the catch depth like a try does.
+	 */
+	comp_ctx->curr_func.catch_depth++;
 	duk__parse_stmt(comp_ctx, res, 0 /*allow_source_elem*/);
+	comp_ctx->curr_func.catch_depth--;
 	duk__emit_extraop_only(comp_ctx, DUK_EXTRAOP_ENDTRY);
 
 	pc_finished = duk__get_current_pc(comp_ctx);
@@ -5456,6 +5580,82 @@ static int duk__stmt_label_site(duk_compiler_ctx *comp_ctx, int label_id) {
 	return label_id;
 }
 
+/* Finish a label site at the end of its statement.  The labels of the
+ * statement are the topmost ones in the active label set, starting from
+ * 'labels_len_at_entry'.
+ *
+ * If no slow break/continue targets the label site, LABEL is replaced with
+ * a jump over the jump slots and no ENDLABEL is emitted, so that no catcher
+ * is needed at runtime.  Otherwise any fast break/continue inside the
+ * statement which skips this site to reach an enclosing label site would
+ * leave the catcher behind, so such jumps are converted to slow ones (and
+ * the enclosing site then needs a catcher too).
+ */
+static void duk__end_label_site(duk_compiler_ctx *comp_ctx, int pc_label, int label_id, int labels_len_at_entry) {
+	duk_compiler_instr *instr;
+	char *p;
+	duk_labelinfo *li_start, *li_end, *li;
+	int need_catcher = 0;
+	int pc, n;
+
+	/* The break jump of a labelled non-iteration statement is not
+	 * patched by the statement parser: target is the end of statement.
+	 */
+	instr = duk__get_instr_ptr(comp_ctx, pc_label + 1);
+	DUK_ASSERT(instr != NULL);
+	if (DUK_DEC_OP(instr->ins) == DUK_OP_INVALID) {
+		duk__patch_jump_here(comp_ctx, pc_label + 1);
+	}
+
+	p = (char *) DUK_HBUFFER_DYNAMIC_GET_CURR_DATA_PTR(comp_ctx->curr_func.h_labelinfos);
+	li_start = (duk_labelinfo *) p;
+	li_end = (duk_labelinfo *) (p + DUK_HBUFFER_GET_SIZE(comp_ctx->curr_func.h_labelinfos));
+
+	for (li = li_start + labels_len_at_entry; li < li_end; li++) {
+		DUK_ASSERT(li->label_id == label_id);
+		DUK_ASSERT(li->pc_label == pc_label);
+		if (li->flags & DUK_LABEL_FLAG_NEED_CATCHER) {
+			need_catcher = 1;
+		}
+	}
+
+	if (!need_catcher) {
+		DUK_DDDPRINT("label site for label_id %d at pc %d needs no catcher -> replace LABEL with a jump",
+		             label_id, pc_label);
+		duk__patch_jump(comp_ctx, pc_label, pc_label + 3);
+		return;
+	}
+
+	n = duk__get_current_pc(comp_ctx);
+	for (pc = pc_label + 3; pc < n; pc++) {
+		int target_pc;
+
+		instr = duk__get_instr_ptr(comp_ctx, pc);
+		DUK_ASSERT(instr != NULL);
+		if (DUK_DEC_OP(instr->ins) != DUK_OP_JUMP) {
+			continue;
+		}
+		target_pc = pc + 1 + DUK_DEC_ABC(instr->ins) - DUK_BC_JUMP_BIAS;
+
+		/* only fast break/continue jumps target the jump slots of
+		 * an enclosing label site
+		 */
+		for (li = li_start; li < li_start + labels_len_at_entry; li++) {
+			if (target_pc == li->pc_label + 1 || target_pc == li->pc_label + 2) {
+				DUK_DDDPRINT("fast break/continue at pc %d skips label site for label_id %d "
+				             "-> convert to slow variant for label_id %d",
+				             pc, label_id, li->label_id);
+				instr->ins = DUK_ENC_OP_ABC((target_pc == li->pc_label + 1 ? DUK_OP_BREAK : DUK_OP_CONTINUE),
+				                            li->label_id);
+				duk__set_label_need_catcher(comp_ctx, li->label_id);
+				break;
+			}
+		}
+	}
+
+	duk__emit_abc(comp_ctx, DUK_OP_ENDLABEL, label_id);
+}
+
 /* Parse a single statement.
  *
  * Creates a label site (with an empty label) automatically for iteration
@@ -5914,7 +6114,7 @@ static void duk__parse_stmt(duk_compiler_ctx *comp_ctx, duk_ivalue *res, int all
 	 */
 
 	if (label_id >= 0) {
-		duk__emit_abc(comp_ctx, DUK_OP_ENDLABEL, label_id);
+		duk__end_label_site(comp_ctx, pc_at_entry, label_id, labels_len_at_entry);
 	}
 
 	DUK__SETTEMP(comp_ctx, temp_at_entry);
@@ -6447,6 +6647,16 @@ static void duk__parse_func_body(duk_compiler_ctx *comp_ctx, int expect_eof, int
 	func->stmt_next = 0;
 	func->label_next = 0;
 
+	/* 'arguments' only read with 'arguments[x]' and 'arguments.length'
+	 * in pass 1: compile the reads into GETARG in pass 2, see
+	 * duk__ivalue_is_lazy_arguments().
+	 */
+	func->lazy_arguments = (func->is_function &&
+	                        !func->is_arguments_shadowed &&
+	                        func->id_access_arguments_lazy &&
+	                        !func->id_access_arguments &&
+	                        !func->may_direct_eval);
+
 	/* FIXME: init or assert catch depth etc -- all values */
 	func->id_access_arguments = 0;
 	func->id_access_slow = 0;
@@ -6898,6 +7108,7 @@ static int duk__js_compile_raw(duk_context *ctx) {
 	comp_ctx->lex.thr = thr;
 	comp_ctx->lex.input = DUK_HSTRING_GET_DATA(h_sourcecode);
 	comp_ctx->lex.input_length = DUK_HSTRING_GET_BYTELEN(h_sourcecode);
+	comp_ctx->lex.input_ascii = DUK_HSTRING_HAS_ASCII(h_sourcecode) ? 1 : 0;
 	comp_ctx->lex.slot1_idx = comp_ctx->tok11_idx;
 	comp_ctx->lex.slot2_idx = comp_ctx->tok12_idx;
 	comp_ctx->lex.buf_idx = entry_top + 0;
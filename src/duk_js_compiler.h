@@ -36,6 +36,7 @@
 #define DUK_ISPEC_NONE         0   /* no value */
 #define DUK_ISPEC_VALUE        1   /* value resides in 'valstack_idx' */
 #define DUK_ISPEC_REGCONST     2   /* value resides in a register or constant */
+#define DUK_ISPEC_ARGUMENTS    3   /* the function's own 'arguments' object (lazy, see DUK_OP_GETARG) */
 
 /* bit mask which indicates that a regconst is a constant instead of a register */
 #define DUK_JS_CONST_MARKER    0x80000000
@@ -83,6 +84,7 @@ struct duk_compiler_instr {
 
 #define DUK_LABEL_FLAG_ALLOW_BREAK       (1 << 0)
 #define DUK_LABEL_FLAG_ALLOW_CONTINUE    (1 << 1)
+#define DUK_LABEL_FLAG_NEED_CATCHER      (1 << 2)  /* target of a slow break/continue, LABEL catcher needed */
 
 #define DUK_DECL_TYPE_VAR                0
 #define DUK_DECL_TYPE_FUNC               1
@@ -101,7 +103,8 @@ typedef struct {
 	/* Fast jumps (which avoid longjmp) jump directly to the jump sites
 	 * which are always known even while the iteration/switch statement
 	 * is still being parsed.  A final peephole pass "straightens out"
-	 * the jumps.
+	 * the jumps.  A label site only gets a runtime LABEL catcher if a
+	 * slow break/continue targets it.
 	 */
 } duk_labelinfo;
 
@@ -137,6 +140,8 @@ struct duk_compiler_func {
 	int in_scanning;                    /* parsing in "scanning" phase (first pass) */
 	int may_direct_eval;                /* function may call direct eval */
 	int id_access_arguments;            /* function refers to 'arguments' identifier */
+	int id_access_arguments_lazy;       /* function reads 'arguments[x]' or 'arguments.length' */
+	int lazy_arguments;                 /* pass 2: 'arguments' reads compiled to GETARG, no arguments object */
 	int id_access_slow;                 /* function makes one or more slow path accesses */
 	int is_arguments_shadowed;          /* argument/function declaration shadows 'arguments' */
 	int needs_shuffle;                  /* function needs shuffle registers */
@@ -2191,6 +2191,75 @@ void duk_js_execute_bytecode(duk_hthread *entry_thread) {
 			break;
 		}
 
+		case DUK_OP_GETARG: {
+			int a = DUK_DEC_A(ins);
+			int b = DUK_DEC_B(ins);
+			duk_tval *tv_key;
+			duk_tval *tv_src;
+			duk_tval *tv_dst;
+			duk_tval tv_tmp;
+			int num_args;
+			int rc;
+
+			/* A -> target reg
+			 * B -> key reg/const
+			 *
+			 * Read 'arguments[key]' in a LAZYARGS function.  Index and
+			 * 'length' reads are served directly from the call arguments
+			 * kept below valstack_bottom; anything else creates the
+			 * arguments object (once) and reads from it.  See
+			 * duk_js_create_lazy_arguments() for the valstack layout.
+			 */
+
+			DUK_ASSERT(DUK_HOBJECT_HAS_LAZYARGS(&fun->obj));
+
+			tv_key = DUK__REGCONSTP(b);
+			if (DUK_TVAL_IS_UNDEFINED(thr->valstack_bottom - 3)) {
+				DUK_ASSERT(DUK_TVAL_IS_NUMBER(thr->valstack_bottom - 2));
+				num_args = (int) DUK_TVAL_GET_NUMBER(thr->valstack_bottom - 2);
+
+				if (DUK_TVAL_IS_NUMBER(tv_key)) {
+					double d = DUK_TVAL_GET_NUMBER(tv_key);
+					int idx;
+
+					if (d >= 0.0 && d < (double) num_args) {
+						idx = (int) d;
+						if ((double) idx == d) {
+							/* Non-strict: an index mapped to a formal
+							 * reads the current formal value.
+							 */
+							if (idx < (int) fun->nargs && !DUK__STRICT()) {
+								tv_src = DUK__REGP(idx);
+							} else {
+								tv_src = thr->valstack_bottom - 3 - num_args + idx;
+							}
+							tv_dst = DUK__REGP(a);
+							DUK_TVAL_SET_TVAL(&tv_tmp, tv_dst);
+							DUK_TVAL_SET_TVAL(tv_dst, tv_src);
+							DUK_TVAL_INCREF(thr, tv_dst);
+							DUK_TVAL_DECREF(thr, &tv_tmp);  /* side effects */
+							break;
+						}
+					}
+				} else if (DUK_TVAL_IS_STRING(tv_key) &&
+				           DUK_TVAL_GET_STRING(tv_key) == DUK_HTHREAD_STRING_LENGTH(thr)) {
+					tv_dst = DUK__REGP(a);
+					DUK_TVAL_SET_TVAL(&tv_tmp, tv_dst);
+					DUK_TVAL_SET_NUMBER(tv_dst, (double) num_args);
+					DUK_TVAL_DECREF(thr, &tv_tmp);  /* side effects */
+					break;
+				}
+
+				duk_js_create_lazy_arguments(thr);  /* side effects */
+			}
+
+			DUK_ASSERT(DUK_TVAL_IS_OBJECT(thr->valstack_bottom - 3));
+			rc = duk_hobject_getprop(thr, thr->valstack_bottom - 3, DUK__REGCONSTP(b));  /* -> [val] */
+			DUK_UNREF(rc);  /* ignore */
+			duk_replace((duk_context *) thr, a);    /* val */
+			break;
+		}
+
 		case DUK_OP_PUTPROP: {
 			int a = DUK_DEC_A(ins);
 			int b = DUK_DEC_B(ins);
@@ -431,6 +431,31 @@ int duk_js_equals_number(double x, double y) {
 	return 0;
 }
 
+/* String equality for all equality variants.  Interned strings can be
+ * compared by pointer; if either string is non-interned, equal pointers
+ * still imply equality but contents must be compared otherwise.
+ */
+#if defined(DUK_USE_NONINTERNED_STRINGS)
+static int duk__hstring_equals(duk_hstring *h_x, duk_hstring *h_y) {
+	if (h_x == h_y) {
+		return 1;
+	}
+	if (!DUK_HSTRING_HAS_NONINTERNED(h_x) && !DUK_HSTRING_HAS_NONINTERNED(h_y)) {
+		return 0;
+	}
+	if (DUK_HSTRING_GET_BYTELEN(h_x) != DUK_HSTRING_GET_BYTELEN(h_y)) {
+		return 0;
+	}
+	return (DUK_MEMCMP((void *) DUK_HSTRING_GET_DATA(h_x),
+	                   (void *) DUK_HSTRING_GET_DATA(h_y),
+	                   DUK_HSTRING_GET_BYTELEN(h_x)) == 0) ? 1 : 0;
+}
+#define DUK__HSTRING_EQUALS(h_x,h_y)  duk__hstring_equals((h_x), (h_y))
+#else
+/* heap pointer comparison suffices */
+#define DUK__HSTRING_EQUALS(h_x,h_y)  ((h_x) == (h_y))
+#endif
+
 /* E5 Section 11.9.3. */
 int duk_js_equals(duk_hthread *thr, duk_tval *tv_x, duk_tval *tv_y) {
 	duk_context *ctx = (duk_context *) thr;
@@ -465,7 +490,9 @@ int duk_js_equals(duk_hthread *thr, duk_tval *tv_x, duk_tval *tv_y) {
 		case DUK_TAG_POINTER: {
 			return DUK_TVAL_GET_POINTER(tv_x) == DUK_TVAL_GET_POINTER(tv_y);
 		}
-		case DUK_TAG_STRING:
+		case DUK_TAG_STRING: {
+			return DUK__HSTRING_EQUALS(DUK_TVAL_GET_STRING(tv_x), DUK_TVAL_GET_STRING(tv_y));
+		}
 		case DUK_TAG_OBJECT: {
 			/* heap pointer comparison suffices */
 			return DUK_TVAL_GET_HEAPHDR(tv_x) == DUK_TVAL_GET_HEAPHDR(tv_y);
@@ -631,7 +658,9 @@ int duk_js_strict_equals(duk_tval *tv_x, duk_tval *tv_y) {
 		case DUK_TAG_POINTER: {
 			return DUK_TVAL_GET_POINTER(tv_x) == DUK_TVAL_GET_POINTER(tv_y);
 		}
-		case DUK_TAG_STRING:
+		case DUK_TAG_STRING: {
+			return DUK__HSTRING_EQUALS(DUK_TVAL_GET_STRING(tv_x), DUK_TVAL_GET_STRING(tv_y));
+		}
 		case DUK_TAG_OBJECT:
 		case DUK_TAG_BUFFER: {
 			/* heap pointer comparison suffices */
@@ -709,7 +738,9 @@ int duk_js_samevalue(duk_tval *tv_x, duk_tval *tv_y) {
 		case DUK_TAG_POINTER: {
 			return DUK_TVAL_GET_POINTER(tv_x) == DUK_TVAL_GET_POINTER(tv_y);
 		}
-		case DUK_TAG_STRING:
+		case DUK_TAG_STRING: {
+			return DUK__HSTRING_EQUALS(DUK_TVAL_GET_STRING(tv_x), DUK_TVAL_GET_STRING(tv_y));
+		}
 		case DUK_TAG_OBJECT:
 		case DUK_TAG_BUFFER: {
 			/* heap pointer comparison suffices */
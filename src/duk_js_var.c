@@ -189,6 +189,9 @@ void duk_js_push_closure(duk_hthread *thr,
 	if (DUK_HOBJECT_HAS_CREATEARGS(&fun_temp->obj)) {
 		DUK_HOBJECT_SET_CREATEARGS(&fun_clos->obj);
 	}
+	if (DUK_HOBJECT_HAS_LAZYARGS(&fun_temp->obj)) {
+		DUK_HOBJECT_SET_LAZYARGS(&fun_clos->obj);
+	}
 	DUK_ASSERT(!DUK_HOBJECT_HAS_SPECIAL_ARRAY(&fun_clos->obj));
 	DUK_ASSERT(!DUK_HOBJECT_HAS_SPECIAL_STRINGOBJ(&fun_clos->obj));
 	DUK_ASSERT(!DUK_HOBJECT_HAS_SPECIAL_ARGUMENTS(&fun_clos->obj));
@@ -351,22 +354,24 @@ void duk_js_push_closure(duk_hthread *thr,
 	 *  "prototype" is, by default, a fresh object with the "constructor"
 	 *  property.
 	 *
-	 *  Note that this creates a circular reference for every function
-	 *  instance (closure) which prevents refcount-based collection of
-	 *  function instances.
+	 *  Most functions are never used as constructors, so the default
+	 *  prototype is created on demand: the property slot is allocated
+	 *  here (so that property order and attributes are unaffected) but
+	 *  its value is left undefined and DUK_HOBJECT_FLAG_LAZYPROTO is set.
+	 *  The first own property lookup of "prototype" creates the object,
+	 *  see duk__get_own_property_desc_raw().
 	 *
-	 *  FIXME: Try to avoid creating the default prototype object, because
-	 *  many functions are not used as constructors and the default
-	 *  prototype is unnecessary.  Perhaps it could be created on-demand
-	 *  when it is first accessed?
+	 *  Note that the created object has a circular reference to the
+	 *  closure which prevents refcount-based collection of the function
+	 *  instance; this is now only paid for functions whose prototype is
+	 *  actually looked up.
 	 */
 
 	/* [ ... closure template ] */
 
-	duk_push_object(ctx);  /* -> [ ... closure template newobj ] */
-	duk_dup(ctx, -3);          /* -> [ ... closure template newobj closure ] */
-	duk_def_prop_stridx(ctx, -2, DUK_STRIDX_CONSTRUCTOR, DUK_PROPDESC_FLAGS_WC);  /* -> [ ... closure template newobj ] */
+	duk_push_undefined(ctx);
 	duk_def_prop_stridx(ctx, -3, DUK_STRIDX_PROTOTYPE, DUK_PROPDESC_FLAGS_W);     /* -> [ ... closure template ] */
+	DUK_HOBJECT_SET_LAZYPROTO(&fun_clos->obj);
 
 	/*
 	 *  "arguments" and "caller" must be mapped to throwers for
@@ -433,7 +438,7 @@ void duk_js_push_closure(duk_hthread *thr,
 	DUK_ASSERT(fun_clos->obj.prototype == thr->builtins[DUK_BIDX_FUNCTION_PROTOTYPE]);
 	DUK_ASSERT(DUK_HOBJECT_HAS_EXTENSIBLE(&fun_clos->obj));
 	DUK_ASSERT(duk_has_prop_stridx(ctx, -2, DUK_STRIDX_LENGTH) != 0);
-	DUK_ASSERT(duk_has_prop_stridx(ctx, -2, DUK_STRIDX_PROTOTYPE) != 0);
+	DUK_ASSERT(duk_hobject_find_existing_entry_tval_ptr(&fun_clos->obj, DUK_HTHREAD_STRING_PROTOTYPE(thr)) != NULL);  /* don't trigger creation */
 	DUK_ASSERT(duk_has_prop_stridx(ctx, -2, DUK_STRIDX_NAME) != 0);  /* non-standard */
 	DUK_ASSERT(!DUK_HOBJECT_HAS_STRICT(&fun_clos->obj) ||
 	           duk_has_prop_stridx(ctx, -2, DUK_STRIDX_CALLER) != 0);
@@ -26,6 +26,11 @@
 /* How much stack to require on entry to object/array decode */
 #define DUK_JSON_DEC_REQSTACK                 32
 
+/* Number of nesting levels for which the decoder remembers object/array
+ * sizes as presizing hints.
+ */
+#define DUK_JSON_DEC_SIZE_HINT_DEPTH          8
+
 /* Encoding state.  Heap object references are all borrowed. */
 typedef struct {
 	duk_hthread *thr;
@@ -52,6 +57,9 @@ typedef struct {
 	int stridx_custom_posinf;
 	int stridx_custom_function;
 #endif
+#if defined(DUK_USE_JSON_STRINGIFY_FASTPATH)
+	duk_hobject *h_fast_proto[2];  /* prototypes known to have no 'toJSON' (object, array) */
+#endif
 } duk_json_enc_ctx;
 
 typedef struct {
@@ -66,7 +74,30 @@ typedef struct {
 #endif
 	int recursion_depth;
 	int recursion_limit;
+	duk_uint32_t obj_size_hint[DUK_JSON_DEC_SIZE_HINT_DEPTH];  /* key count of last object at each depth */
+	duk_uint32_t arr_size_hint[DUK_JSON_DEC_SIZE_HINT_DEPTH];  /* length of last array at each depth */
 } duk_json_dec_ctx;
 
+/* Streaming decoder modes */
+#define DUK_JSON_STREAM_MODE_INITIAL      0  /* before top level value */
+#define DUK_JSON_STREAM_MODE_ARRAY        1  /* inside top level array, decoding elements one at a time */
+#define DUK_JSON_STREAM_MODE_VALUE        2  /* top level value is not an array, collecting input */
+#define DUK_JSON_STREAM_MODE_DONE         3  /* after top level array */
+
+/* Streaming decoder state, stored in a fixed buffer of the decoder object.
+ * The scanner state describes the pending input up to 'scan_off'.
+ */
+typedef struct {
+	duk_json_dec_ctx js_ctx;  /* shared by all element decodes (keeps size hints) */
+	duk_size_t scan_off;      /* offset of first unscanned byte in pending input */
+	duk_uint32_t count;       /* number of top level array elements decoded */
+	duk_uint32_t depth;       /* nesting depth inside the current element */
+	int mode;                 /* DUK_JSON_STREAM_MODE_xxx */
+	int in_string;            /* scanner is inside a string */
+	int escape;               /* scanner is after a backslash inside a string */
+	int seen_value;           /* current element has non-whitespace bytes */
+	int busy;                 /* feed or finish in progress, failed, or finished */
+} duk_json_dec_stream;
+
 #endif  /* DUK_JSON_H_INCLUDED */
 
@@ -297,6 +297,31 @@ static void duk__advance_chars(duk_lexer_ctx *lex_ctx, int count) {
 		lex_ctx->window[i] = lex_ctx->window[i + count];
 	}
 
+	if (lex_ctx->input_ascii) {
+		/* Pure ASCII input (flagged at intern time): every byte is
+		 * a valid codepoint so decoding and validation can be skipped.
+		 * Only LF and CR can bump the line number.
+		 */
+		for (; i < DUK_LEXER_WINDOW_SIZE; i++) {
+			int x;
+
+			lex_ctx->offsets[i] = lex_ctx->input_offset;
+			lex_ctx->lines[i] = lex_ctx->input_line;
+			if (lex_ctx->input_offset >= lex_ctx->input_length) {
+				lex_ctx->window[i] = -1;
+				continue;
+			}
+			x = (int) lex_ctx->input[lex_ctx->input_offset++];
+			if ((x == 0x000a) ||
+			    ((x == 0x000d) && (lex_ctx->input_offset >= lex_ctx->input_length ||
+			                       lex_ctx->input[lex_ctx->input_offset] != 0x000a))) {
+				lex_ctx->input_line++;
+			}
+			lex_ctx->window[i] = x;
+		}
+		return;
+	}
+
 	for (; i < DUK_LEXER_WINDOW_SIZE; i++) {
 		lex_ctx->offsets[i] = lex_ctx->input_offset;
 		lex_ctx->lines[i] = lex_ctx->input_line;
@@ -351,7 +376,7 @@ static void duk__internbuffer(duk_lexer_ctx *lex_ctx, int valstack_idx) {
 	DUK_ASSERT(valstack_idx == lex_ctx->slot1_idx || valstack_idx == lex_ctx->slot2_idx);
 
 	duk_dup(ctx, lex_ctx->buf_idx);
-	duk_to_string(ctx, -1);
+	(void) duk_to_property_key_hstring(ctx, -1);  /* identifiers and literals may be used as keys */
 	duk_replace(ctx, valstack_idx);
 }
 
@@ -386,6 +386,7 @@ struct duk_lexer_ctx {
 
 	duk_uint8_t *input;
 	int input_length;
+	int input_ascii;                        /* input is pure ASCII: no UTF-8 decoding needed */
 	int window[DUK_LEXER_WINDOW_SIZE];      /* window of unicode code points */
 	int offsets[DUK_LEXER_WINDOW_SIZE];     /* input byte offset for each char */
 	int lines[DUK_LEXER_WINDOW_SIZE];       /* input lines for each char */
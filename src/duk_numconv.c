@@ -2,10 +2,12 @@
  *  Number-to-string and string-to-number conversions.
  *
  *  Slow path number-to-string and string-to-number conversion is based on
- *  a Dragon4 variant, with fast paths for small integers.  Big integer
- *  arithmetic is needed for guaranteeing that the conversion is correct
- *  and uses a minimum number of digits.  The big number arithmetic has a
- *  fixed maximum size and does not require dynamic allocations.
+ *  a Dragon4 variant, with fast paths for small integers, a Grisu3 fast
+ *  path for shortest radix 10 number-to-string conversion, and an
+ *  Eisel-Lemire fast path for radix 10 string-to-number conversion.  Big
+ *  integer arithmetic is needed for guaranteeing that the conversion is
+ *  correct and uses a minimum number of digits.  The big number arithmetic
+ *  has a fixed maximum size and does not require dynamic allocations.
  *
  *  See: doc/number-conversion.txt.
  */
@@ -799,7 +801,7 @@ static void duk__dragon4_prepare(duk__numconv_stringify_ctx *nc_ctx) {
 		/* When doing string-to-number, lowest_mantissa is always 0 so
 		 * the exponent check, while incorrect, won't matter.
 		 */
-		if (nc_ctx->e > DUK__IEEE_DOUBLE_EXP_MIN /*not minimum exponent*/ &&
+		if (nc_ctx->e > DUK__IEEE_DOUBLE_EXP_MIN - 52 /*not minimum exponent*/ &&
 		    lowest_mantissa /* lowest mantissa for this exponent*/) {
 			/* r <- (* f b 2)                                [if b==2 -> (* f 4)]
 			 * s <- (* (expt b (- 1 e)) 2) == b^(1-e) * 2    [if b==2 -> b^(2-e)]
@@ -1013,7 +1015,7 @@ static void duk__dragon4_generate(duk__numconv_stringify_ctx *nc_ctx) {
 			tc1 = (duk__bi_compare(&nc_ctx->r, &nc_ctx->mm) <= (nc_ctx->low_ok ? 0 : -1));
 
 			duk__bi_add(&nc_ctx->t1, &nc_ctx->r, &nc_ctx->mp);  /* t1 <- (+ r m+) */
-			tc2 = (duk__bi_compare(&nc_ctx->t1, &nc_ctx->s) >= (&nc_ctx->high_ok ? 0 : 1));
+			tc2 = (duk__bi_compare(&nc_ctx->t1, &nc_ctx->s) >= (nc_ctx->high_ok ? 0 : 1));
 
 			DUK_DDDPRINT("tc1=%d, tc2=%d", (int) tc1, (int) tc2);
 		} else {
@@ -1029,14 +1031,19 @@ static void duk__dragon4_generate(duk__numconv_stringify_ctx *nc_ctx) {
 
 		if (tc1) {
 			if (tc2) {
-				/* tc1 = true, tc2 = true */
+				/* tc1 = true, tc2 = true; on a tie (2r == s) prefer
+				 * an even digit, like E5 Section 9.8.1, note 2.
+				 */
+				duk_small_int_t cmp;
+
 				duk__bi_mul_small(&nc_ctx->t1, &nc_ctx->r, 2);
-				if (duk__bi_compare(&nc_ctx->t1, &nc_ctx->s) < 0) {  /* (< (* r 2) s) */
-					DUK_DDDPRINT("tc1=true, tc2=true, 2r > s: output d --> %d (k=%d)",
+				cmp = duk__bi_compare(&nc_ctx->t1, &nc_ctx->s);
+				if (cmp < 0 || (cmp == 0 && (d & 1) == 0)) {  /* (< (* r 2) s) */
+					DUK_DDDPRINT("tc1=true, tc2=true, 2r < s: output d --> %d (k=%d)",
 					             (int) d, (int) nc_ctx->k);
 					DUK__DRAGON4_OUTPUT_PREINC(nc_ctx, count, d);
 				} else {
-					DUK_DDDPRINT("tc1=true, tc2=true, 2r <= s: output d+1 --> %d (k=%d)",
+					DUK_DDDPRINT("tc1=true, tc2=true, 2r >= s: output d+1 --> %d (k=%d)",
 					             (int) (d + 1), (int) nc_ctx->k);
 					DUK__DRAGON4_OUTPUT_PREINC(nc_ctx, count, d + 1);
 				}
@@ -1388,6 +1395,32 @@ static void duk__dragon4_double_to_ctx(duk__numconv_stringify_ctx *nc_ctx, duk_d
 	nc_ctx->e = exp;
 }
 
+/* Check whether binary digits (with the remainder 'r' left by fixed format
+ * generation) are exactly halfway at round_idx with an even digit before it,
+ * so that round-half-to-even must not round up.
+ */
+static duk_small_int_t duk__dragon4_is_even_tie(duk__numconv_stringify_ctx *nc_ctx, duk_small_int_t round_idx) {
+	duk_small_int_t i;
+
+	DUK_ASSERT(nc_ctx->B == 2);
+
+	if (round_idx < 0 || round_idx >= nc_ctx->count) {
+		return 0;
+	}
+	if (nc_ctx->digits[round_idx] != 1) {
+		return 0;
+	}
+	if (round_idx > 0 && nc_ctx->digits[round_idx - 1] != 0) {
+		return 0;
+	}
+	for (i = round_idx + 1; i < nc_ctx->count; i++) {
+		if (nc_ctx->digits[i] != 0) {
+			return 0;
+		}
+	}
+	return duk__bi_is_zero(&nc_ctx->r);
+}
+
 void duk__dragon4_ctx_to_double(duk__numconv_stringify_ctx *nc_ctx, duk_double_t *x) {
 	duk_double_union u;
 	duk_small_int_t exp;
@@ -1470,6 +1503,11 @@ void duk__dragon4_ctx_to_double(duk__numconv_stringify_ctx *nc_ctx, duk_double_t
 	DUK_DDDPRINT("ieee exp=%d, bitstart=%d, bitround=%d",
 	             (int) exp, (int) bitstart, (int) bitround);
 
+	if (!skip_round && duk__dragon4_is_even_tie(nc_ctx, bitround)) {
+		/* Exact halfway case, round to even by truncating. */
+		DUK_DDDPRINT("halfway case, last mantissa bit is even -> no rounding");
+		skip_round = 1;
+	}
 	if (!skip_round) {
 		if (duk__dragon4_fixed_format_round(nc_ctx, bitround)) {
 			/* Corner case: see test-numconv-parse-mant-carry.js.  We could
@@ -1526,6 +1564,538 @@ void duk__dragon4_ctx_to_double(duk__numconv_stringify_ctx *nc_ctx, duk_double_t
 	*x = DUK_DBLUNION_GET_DOUBLE(&u);
 }
 
+/*
+ *  Grisu3 fast path for shortest number-to-string conversion, based on:
+ *
+ *    Florian Loitsch: "Printing Floating-Point Numbers Quickly and
+ *    Accurately with Integers", PLDI 2010.
+ *
+ *  Handles free format radix 10 conversion of non-zero finite numbers with
+ *  64-bit integer arithmetic only.  The algorithm either produces the
+ *  shortest digit sequence which is closest to the input (the same result
+ *  as Dragon4), or detects that it cannot guarantee that (about 0.5% of
+ *  inputs), in which case the caller falls back to Dragon4.
+ */
+
+#if defined(DUK_USE_NUMCONV_GRISU3)
+
+/* "Do-it-yourself floating point": value is f * 2^e. */
+typedef struct {
+	duk_uint64_t f;
+	duk_small_int_t e;
+} duk__diyfp;
+
+typedef struct {
+	duk_uint32_t f_hi;
+	duk_uint32_t f_lo;
+	duk_int16_t e;   /* binary exponent */
+	duk_int16_t k;   /* decimal exponent */
+} duk__cached_power;
+
+/* 10^k for k = -348, -340, ..., 340, generated with src/gencachedpowers.py. */
+static const duk__cached_power duk__grisu_cached_powers[] = {
+	{ 0xfa8fd5a0UL, 0x081c0288UL, -1220, -348 }, { 0xbaaee17fUL, 0xa23ebf76UL, -1193, -340 },
+	{ 0x8b16fb20UL, 0x3055ac76UL, -1166, -332 }, { 0xcf42894aUL, 0x5dce35eaUL, -1140, -324 },
+	{ 0x9a6bb0aaUL, 0x55653b2dUL, -1113, -316 }, { 0xe61acf03UL, 0x3d1a45dfUL, -1087, -308 },
+	{ 0xab70fe17UL, 0xc79ac6caUL, -1060, -300 }, { 0xff77b1fcUL, 0xbebcdc4fUL, -1034, -292 },
+	{ 0xbe5691efUL, 0x416bd60cUL, -1007, -284 }, { 0x8dd01fadUL, 0x907ffc3cUL, -980, -276 },
+	{ 0xd3515c28UL, 0x31559a83UL, -954, -268 }, { 0x9d71ac8fUL, 0xada6c9b5UL, -927, -260 },
+	{ 0xea9c2277UL, 0x23ee8bcbUL, -901, -252 }, { 0xaecc4991UL, 0x4078536dUL, -874, -244 },
+	{ 0x823c1279UL, 0x5db6ce57UL, -847, -236 }, { 0xc2109436UL, 0x4dfb5637UL, -821, -228 },
+	{ 0x9096ea6fUL, 0x3848984fUL, -794, -220 }, { 0xd77485cbUL, 0x25823ac7UL, -768, -212 },
+	{ 0xa086cfcdUL, 0x97bf97f4UL, -741, -204 }, { 0xef340a98UL, 0x172aace5UL, -715, -196 },
+	{ 0xb23867fbUL, 0x2a35b28eUL, -688, -188 }, { 0x84c8d4dfUL, 0xd2c63f3bUL, -661, -180 },
+	{ 0xc5dd4427UL, 0x1ad3cdbaUL, -635, -172 }, { 0x936b9fceUL, 0xbb25c996UL, -608, -164 },
+	{ 0xdbac6c24UL, 0x7d62a584UL, -582, -156 }, { 0xa3ab6658UL, 0x0d5fdaf6UL, -555, -148 },
+	{ 0xf3e2f893UL, 0xdec3f126UL, -529, -140 }, { 0xb5b5ada8UL, 0xaaff80b8UL, -502, -132 },
+	{ 0x87625f05UL, 0x6c7c4a8bUL, -475, -124 }, { 0xc9bcff60UL, 0x34c13053UL, -449, -116 },
+	{ 0x964e858cUL, 0x91ba2655UL, -422, -108 }, { 0xdff97724UL, 0x70297ebdUL, -396, -100 },
+	{ 0xa6dfbd9fUL, 0xb8e5b88fUL, -369, -92 }, { 0xf8a95fcfUL, 0x88747d94UL, -343, -84 },
+	{ 0xb9447093UL, 0x8fa89bcfUL, -316, -76 }, { 0x8a08f0f8UL, 0xbf0f156bUL, -289, -68 },
+	{ 0xcdb02555UL, 0x653131b6UL, -263, -60 }, { 0x993fe2c6UL, 0xd07b7facUL, -236, -52 },
+	{ 0xe45c10c4UL, 0x2a2b3b06UL, -210, -44 }, { 0xaa242499UL, 0x697392d3UL, -183, -36 },
+	{ 0xfd87b5f2UL, 0x8300ca0eUL, -157, -28 }, { 0xbce50864UL, 0x92111aebUL, -130, -20 },
+	{ 0x8cbccc09UL, 0x6f5088ccUL, -103, -12 }, { 0xd1b71758UL, 0xe219652cUL, -77, -4 },
+	{ 0x9c400000UL, 0x00000000UL, -50, 4 }, { 0xe8d4a510UL, 0x00000000UL, -24, 12 },
+	{ 0xad78ebc5UL, 0xac620000UL, 3, 20 }, { 0x813f3978UL, 0xf8940984UL, 30, 28 },
+	{ 0xc097ce7bUL, 0xc90715b3UL, 56, 36 }, { 0x8f7e32ceUL, 0x7bea5c70UL, 83, 44 },
+	{ 0xd5d238a4UL, 0xabe98068UL, 109, 52 }, { 0x9f4f2726UL, 0x179a2245UL, 136, 60 },
+	{ 0xed63a231UL, 0xd4c4fb27UL, 162, 68 }, { 0xb0de6538UL, 0x8cc8ada8UL, 189, 76 },
+	{ 0x83c7088eUL, 0x1aab65dbUL, 216, 84 }, { 0xc45d1df9UL, 0x42711d9aUL, 242, 92 },
+	{ 0x924d692cUL, 0xa61be758UL, 269, 100 }, { 0xda01ee64UL, 0x1a708deaUL, 295, 108 },
+	{ 0xa26da399UL, 0x9aef774aUL, 322, 116 }, { 0xf209787bUL, 0xb47d6b85UL, 348, 124 },
+	{ 0xb454e4a1UL, 0x79dd1877UL, 375, 132 }, { 0x865b8692UL, 0x5b9bc5c2UL, 402, 140 },
+	{ 0xc83553c5UL, 0xc8965d3dUL, 428, 148 }, { 0x952ab45cUL, 0xfa97a0b3UL, 455, 156 },
+	{ 0xde469fbdUL, 0x99a05fe3UL, 481, 164 }, { 0xa59bc234UL, 0xdb398c25UL, 508, 172 },
+	{ 0xf6c69a72UL, 0xa3989f5cUL, 534, 180 }, { 0xb7dcbf53UL, 0x54e9beceUL, 561, 188 },
+	{ 0x88fcf317UL, 0xf22241e2UL, 588, 196 }, { 0xcc20ce9bUL, 0xd35c78a5UL, 614, 204 },
+	{ 0x98165af3UL, 0x7b2153dfUL, 641, 212 }, { 0xe2a0b5dcUL, 0x971f303aUL, 667, 220 },
+	{ 0xa8d9d153UL, 0x5ce3b396UL, 694, 228 }, { 0xfb9b7cd9UL, 0xa4a7443cUL, 720, 236 },
+	{ 0xbb764c4cUL, 0xa7a44410UL, 747, 244 }, { 0x8bab8eefUL, 0xb6409c1aUL, 774, 252 },
+	{ 0xd01fef10UL, 0xa657842cUL, 800, 260 }, { 0x9b10a4e5UL, 0xe9913129UL, 827, 268 },
+	{ 0xe7109bfbUL, 0xa19c0c9dUL, 853, 276 }, { 0xac2820d9UL, 0x623bf429UL, 880, 284 },
+	{ 0x80444b5eUL, 0x7aa7cf85UL, 907, 292 }, { 0xbf21e440UL, 0x03acdd2dUL, 933, 300 },
+	{ 0x8e679c2fUL, 0x5e44ff8fUL, 960, 308 }, { 0xd433179dUL, 0x9c8cb841UL, 986, 316 },
+	{ 0x9e19db92UL, 0xb4e31ba9UL, 1013, 324 }, { 0xeb96bf6eUL, 0xbadf77d9UL, 1039, 332 },
+	{ 0xaf87023bUL, 0x9bf0ee6bUL, 1066, 340 },
+};
+
+#define DUK__GRISU_NUM_CACHED_POWERS  ((duk_small_int_t) (sizeof(duk__grisu_cached_powers) / sizeof(duk__cached_power)))
+#define DUK__GRISU_MIN_TARGET_EXP     (-60)
+#define DUK__GRISU_MAX_TARGET_EXP     (-32)
+#define DUK__GRISU_HIDDEN_BIT         (((duk_uint64_t) 1) << 52)
+#define DUK__GRISU_TOP_BIT            (((duk_uint64_t) 1) << 63)
+
+/* x <- normalized x (top bit set), x != 0 */
+static void duk__diyfp_normalize(duk__diyfp *x) {
+	DUK_ASSERT(x->f != 0);
+	while ((x->f & DUK__GRISU_TOP_BIT) == 0) {
+		x->f <<= 1;
+		x->e--;
+	}
+}
+
+/* x <- y * z, keeping the upper 64 bits of the product rounded */
+static void duk__diyfp_mul(duk__diyfp *x, duk__diyfp *y, duk__diyfp *z) {
+	duk_uint64_t a, b, c, d;
+	duk_uint64_t ac, bc, ad, bd;
+	duk_uint64_t tmp;
+
+	a = y->f >> 32;
+	b = y->f & 0xffffffffUL;
+	c = z->f >> 32;
+	d = z->f & 0xffffffffUL;
+	ac = a * c;
+	bc = b * c;
+	ad = a * d;
+	bd = b * d;
+	tmp = (bd >> 32) + (ad & 0xffffffffUL) + (bc & 0xffffffffUL);
+	tmp += ((duk_uint64_t) 1) << 31;  /* round */
+	x->f = ac + (ad >> 32) + (bc >> 32) + (tmp >> 32);
+	x->e = y->e + z->e + 64;
+}
+
+/* Find a cached power c = 10^k such that the binary exponent of the product
+ * of a normalized diyfp with exponent 'e' and c is within the target range
+ * [DUK__GRISU_MIN_TARGET_EXP, DUK__GRISU_MAX_TARGET_EXP].
+ */
+static void duk__grisu_get_cached_power(duk_small_int_t e, duk__diyfp *out_c, duk_small_int_t *out_k) {
+	duk_small_int_t min_exp;
+	duk_small_int_t k;
+	duk_small_int_t idx;
+	const duk__cached_power *p;
+
+	/* Decimal exponent estimate for 2^(min_exp + 63), 78913 / 2^18 ~= log10(2).
+	 * The estimate may be off by one, which is corrected below.
+	 */
+	min_exp = DUK__GRISU_MIN_TARGET_EXP - (e + 64);
+	k = (duk_small_int_t) (((duk_int32_t) (min_exp + 63) * 78913L) / 262144L);
+	idx = (k - duk__grisu_cached_powers[0].k) / 8;
+	if (idx < 0) {
+		idx = 0;
+	} else if (idx >= DUK__GRISU_NUM_CACHED_POWERS) {
+		idx = DUK__GRISU_NUM_CACHED_POWERS - 1;
+	}
+	while (idx < DUK__GRISU_NUM_CACHED_POWERS - 1 &&
+	       e + duk__grisu_cached_powers[idx].e + 64 < DUK__GRISU_MIN_TARGET_EXP) {
+		idx++;
+	}
+	while (idx > 0 &&
+	       e + duk__grisu_cached_powers[idx].e + 64 > DUK__GRISU_MAX_TARGET_EXP) {
+		idx--;
+	}
+
+	p = duk__grisu_cached_powers + idx;
+	out_c->f = (((duk_uint64_t) p->f_hi) << 32) | ((duk_uint64_t) p->f_lo);
+	out_c->e = (duk_small_int_t) p->e;
+	*out_k = (duk_small_int_t) p->k;
+
+	DUK_ASSERT(e + out_c->e + 64 >= DUK__GRISU_MIN_TARGET_EXP);
+	DUK_ASSERT(e + out_c->e + 64 <= DUK__GRISU_MAX_TARGET_EXP);
+}
+
+/* Move the last generated digit towards 'w' as far as possible, and check
+ * whether the result is guaranteed to be the closest shortest one.  All
+ * values are relative to too_high and scaled by the same power of ten.
+ */
+static duk_small_int_t duk__grisu_round_weed(duk__numconv_stringify_ctx *nc_ctx,
+                                             duk_uint64_t dist_too_high_w,
+                                             duk_uint64_t unsafe_interval,
+                                             duk_uint64_t rest,
+                                             duk_uint64_t ten_kappa,
+                                             duk_uint64_t unit) {
+	duk_uint64_t small_dist = dist_too_high_w - unit;
+	duk_uint64_t big_dist = dist_too_high_w + unit;
+
+	while (rest < small_dist &&
+	       unsafe_interval - rest >= ten_kappa &&
+	       (rest + ten_kappa < small_dist ||
+	        small_dist - rest >= rest + ten_kappa - small_dist)) {
+		DUK_ASSERT(nc_ctx->digits[nc_ctx->count - 1] > 0);
+		nc_ctx->digits[nc_ctx->count - 1]--;
+		rest += ten_kappa;
+	}
+
+	/* If the digit could be moved once more when measuring from the other
+	 * end of the uncertainty region, the result is ambiguous.
+	 */
+	if (rest < big_dist &&
+	    unsafe_interval - rest >= ten_kappa &&
+	    (rest + ten_kappa < big_dist ||
+	     big_dist - rest > rest + ten_kappa - big_dist)) {
+		return 0;
+	}
+
+	/* The result must be safely inside the rounding interval. */
+	return (2 * unit <= rest) && (rest <= unsafe_interval - 4 * unit);
+}
+
+/* Generate the shortest digits for 'w' within (low, high), all scaled to
+ * the same exponent in the target range.
+ */
+static duk_small_int_t duk__grisu_digit_gen(duk__numconv_stringify_ctx *nc_ctx,
+                                            duk__diyfp *low,
+                                            duk__diyfp *w,
+                                            duk__diyfp *high,
+                                            duk_small_int_t *out_kappa) {
+	duk_uint64_t unit = 1;
+	duk_uint64_t too_low = low->f - unit;
+	duk_uint64_t too_high = high->f + unit;
+	duk_uint64_t unsafe_interval = too_high - too_low;
+	duk_small_int_t shift = -w->e;
+	duk_uint64_t one = ((duk_uint64_t) 1) << shift;
+	duk_uint32_t integrals;
+	duk_uint64_t fractionals;
+	duk_uint32_t divisor;
+	duk_small_int_t kappa;
+	duk_small_int_t count = 0;
+	duk_uint64_t rest;
+
+	DUK_ASSERT(low->e == w->e && w->e == high->e);
+	DUK_ASSERT(shift >= -DUK__GRISU_MAX_TARGET_EXP && shift <= -DUK__GRISU_MIN_TARGET_EXP);
+
+	integrals = (duk_uint32_t) (too_high >> shift);
+	fractionals = too_high & (one - 1);
+
+	/* Largest power of ten <= integrals; integrals >= 2^3 here. */
+	divisor = 1000000000UL;
+	kappa = 10;
+	while (divisor > integrals) {
+		divisor /= 10;
+		kappa--;
+	}
+
+	while (kappa > 0) {
+		nc_ctx->digits[count++] = (duk_uint8_t) (integrals / divisor);
+		integrals %= divisor;
+		kappa--;
+		rest = (((duk_uint64_t) integrals) << shift) + fractionals;
+		if (rest < unsafe_interval) {
+			nc_ctx->count = count;
+			*out_kappa = kappa;
+			return duk__grisu_round_weed(nc_ctx, too_high - w->f, unsafe_interval, rest,
+			                             ((duk_uint64_t) divisor) << shift, unit);
+		}
+		divisor /= 10;
+	}
+
+	for (;;) {
+		DUK_ASSERT(count < DUK__MAX_OUTPUT_DIGITS);
+		fractionals *= 10;
+		unit *= 10;
+		unsafe_interval *= 10;
+		nc_ctx->digits[count++] = (duk_uint8_t) (fractionals >> shift);
+		fractionals &= one - 1;
+		kappa--;
+		if (fractionals < unsafe_interval) {
+			nc_ctx->count = count;
+			*out_kappa = kappa;
+			return duk__grisu_round_weed(nc_ctx, (too_high - w->f) * unit, unsafe_interval,
+			                             fractionals, one, unit);
+		}
+	}
+}
+
+/* Convert a non-zero finite positive 'x' into shortest radix 10 digits in
+ * nc_ctx (digits, count, k).  Returns 0 if the result cannot be guaranteed,
+ * in which case nc_ctx digits are garbage and Dragon4 must be used.
+ */
+static duk_small_int_t duk__grisu3(duk__numconv_stringify_ctx *nc_ctx, duk_double_t x) {
+	duk_double_union u;
+	duk_uint64_t bits;
+	duk_uint64_t frac;
+	duk_small_int_t biased_exp;
+	duk__diyfp v, w, m_plus, m_minus, c;
+	duk__diyfp scaled_w, scaled_plus, scaled_minus;
+	duk_small_int_t mk;
+	duk_small_int_t kappa;
+
+	DUK_ASSERT(x > 0.0);
+
+	DUK_DBLUNION_SET_DOUBLE(&u, x);
+	bits = (((duk_uint64_t) DUK_DBLUNION_GET_HIGH32(&u)) << 32) |
+	       ((duk_uint64_t) DUK_DBLUNION_GET_LOW32(&u));
+	frac = bits & (DUK__GRISU_HIDDEN_BIT - 1);
+	biased_exp = (duk_small_int_t) ((bits >> 52) & 0x07ffUL);
+
+	if (biased_exp == 0) {
+		/* denormal */
+		v.f = frac;
+		v.e = DUK__IEEE_DOUBLE_EXP_MIN - 52;
+	} else {
+		v.f = frac | DUK__GRISU_HIDDEN_BIT;
+		v.e = biased_exp - DUK__IEEE_DOUBLE_EXP_BIAS - 52;
+	}
+
+	w = v;
+	duk__diyfp_normalize(&w);
+
+	/* Rounding interval boundaries (midpoints to the neighbors); the
+	 * lower gap is smaller when the significand is a power of two.
+	 */
+	m_plus.f = (v.f << 1) + 1;
+	m_plus.e = v.e - 1;
+	duk__diyfp_normalize(&m_plus);
+	if (frac == 0 && biased_exp > 1) {
+		m_minus.f = (v.f << 2) - 1;
+		m_minus.e = v.e - 2;
+	} else {
+		m_minus.f = (v.f << 1) - 1;
+		m_minus.e = v.e - 1;
+	}
+	m_minus.f <<= m_minus.e - m_plus.e;
+	m_minus.e = m_plus.e;
+	DUK_ASSERT(w.e == m_plus.e);
+
+	duk__grisu_get_cached_power(w.e, &c, &mk);
+	duk__diyfp_mul(&scaled_w, &w, &c);
+	duk__diyfp_mul(&scaled_plus, &m_plus, &c);
+	duk__diyfp_mul(&scaled_minus, &m_minus, &c);
+
+	if (!duk__grisu_digit_gen(nc_ctx, &scaled_minus, &scaled_w, &scaled_plus, &kappa)) {
+		DUK_DDDPRINT("grisu3 failed, fall back to dragon4");
+		return 0;
+	}
+
+	/* digits * 10^(kappa - mk) == 0.digits * 10^k */
+	nc_ctx->k = nc_ctx->count + kappa - mk;
+	return 1;
+}
+
+/* Format an integer in [0, 2^53] in radix 10; returns length. */
+static duk_size_t duk__format_uint64_dec(duk_uint8_t *buf, duk_uint64_t x) {
+	duk_uint8_t tmp[20];
+	duk_uint8_t *p = tmp + sizeof(tmp);
+	duk_size_t len;
+
+	do {
+		*(--p) = (duk_uint8_t) ('0' + (duk_small_int_t) (x % 10));
+		x /= 10;
+	} while (x != 0);
+
+	len = (duk_size_t) ((tmp + sizeof(tmp)) - p);
+	DUK_MEMCPY((void *) buf, (void *) p, len);
+	return len;
+}
+
+#endif  /* DUK_USE_NUMCONV_GRISU3 */
+
+/*
+ *  Eisel-Lemire fast path for radix 10 string-to-number conversion, based on:
+ *
+ *    Daniel Lemire: "Number Parsing at a Gigabyte per Second",
+ *    Software: Practice and Experience 51(8), 2021.
+ *
+ *  Handles decimal inputs whose significand fits into 64 bits (at most 19
+ *  significant digits) and whose net exponent is within a moderate range.
+ *  The significand is multiplied with a truncated 64-bit approximation of
+ *  10^q; the upper half of the 128-bit product determines the result unless
+ *  the truncation error could change the rounding, the input is a halfway
+ *  case, or the result is denormal or infinite.  In those (rare) cases the
+ *  caller falls back to Dragon4.
+ *
+ *  Clinger's floating point fast path (w * 10^q with w <= 2^53, |q| <= 22)
+ *  is not used because it is only exact when the FPU rounds intermediate
+ *  results to double precision, which is not the case e.g. on x87.  The
+ *  integer arithmetic here covers the same inputs.
+ */
+
+#if defined(DUK_USE_NUMCONV_FAST_PARSE)
+
+typedef struct {
+	duk_uint32_t f_hi;
+	duk_uint32_t f_lo;
+} duk__s2n_power;
+
+#define DUK__S2N_FAST_MIN_EXP10  (-64)
+#define DUK__S2N_FAST_MAX_EXP10  64
+
+/* 10^q for q = -64, ..., 64 as a normalized 64-bit significand, truncated,
+ * generated with src/gencachedpowers.py.
+ */
+static const duk__s2n_power duk__s2n_powers[] = {
+	{ 0xa87fea27UL, 0xa539e9a5UL }, { 0xd29fe4b1UL, 0x8e88640eUL }, { 0x83a3eeeeUL, 0xf9153e89UL },
+	{ 0xa48ceaaaUL, 0xb75a8e2bUL }, { 0xcdb02555UL, 0x653131b6UL }, { 0x808e1755UL, 0x5f3ebf11UL },
+	{ 0xa0b19d2aUL, 0xb70e6ed6UL }, { 0xc8de0475UL, 0x64d20a8bUL }, { 0xfb158592UL, 0xbe068d2eUL },
+	{ 0x9ced737bUL, 0xb6c4183dUL }, { 0xc428d05aUL, 0xa4751e4cUL }, { 0xf5330471UL, 0x4d9265dfUL },
+	{ 0x993fe2c6UL, 0xd07b7fabUL }, { 0xbf8fdb78UL, 0x849a5f96UL }, { 0xef73d256UL, 0xa5c0f77cUL },
+	{ 0x95a86376UL, 0x27989aadUL }, { 0xbb127c53UL, 0xb17ec159UL }, { 0xe9d71b68UL, 0x9dde71afUL },
+	{ 0x92267121UL, 0x62ab070dUL }, { 0xb6b00d69UL, 0xbb55c8d1UL }, { 0xe45c10c4UL, 0x2a2b3b05UL },
+	{ 0x8eb98a7aUL, 0x9a5b04e3UL }, { 0xb267ed19UL, 0x40f1c61cUL }, { 0xdf01e85fUL, 0x912e37a3UL },
+	{ 0x8b61313bUL, 0xbabce2c6UL }, { 0xae397d8aUL, 0xa96c1b77UL }, { 0xd9c7dcedUL, 0x53c72255UL },
+	{ 0x881cea14UL, 0x545c7575UL }, { 0xaa242499UL, 0x697392d2UL }, { 0xd4ad2dbfUL, 0xc3d07787UL },
+	{ 0x84ec3c97UL, 0xda624ab4UL }, { 0xa6274bbdUL, 0xd0fadd61UL }, { 0xcfb11eadUL, 0x453994baUL },
+	{ 0x81ceb32cUL, 0x4b43fcf4UL }, { 0xa2425ff7UL, 0x5e14fc31UL }, { 0xcad2f7f5UL, 0x359a3b3eUL },
+	{ 0xfd87b5f2UL, 0x8300ca0dUL }, { 0x9e74d1b7UL, 0x91e07e48UL }, { 0xc6120625UL, 0x76589ddaUL },
+	{ 0xf79687aeUL, 0xd3eec551UL }, { 0x9abe14cdUL, 0x44753b52UL }, { 0xc16d9a00UL, 0x95928a27UL },
+	{ 0xf1c90080UL, 0xbaf72cb1UL }, { 0x971da050UL, 0x74da7beeUL }, { 0xbce50864UL, 0x92111aeaUL },
+	{ 0xec1e4a7dUL, 0xb69561a5UL }, { 0x9392ee8eUL, 0x921d5d07UL }, { 0xb877aa32UL, 0x36a4b449UL },
+	{ 0xe69594beUL, 0xc44de15bUL }, { 0x901d7cf7UL, 0x3ab0acd9UL }, { 0xb424dc35UL, 0x095cd80fUL },
+	{ 0xe12e1342UL, 0x4bb40e13UL }, { 0x8cbccc09UL, 0x6f5088cbUL }, { 0xafebff0bUL, 0xcb24aafeUL },
+	{ 0xdbe6feceUL, 0xbdedd5beUL }, { 0x89705f41UL, 0x36b4a597UL }, { 0xabcc7711UL, 0x8461cefcUL },
+	{ 0xd6bf94d5UL, 0xe57a42bcUL }, { 0x8637bd05UL, 0xaf6c69b5UL }, { 0xa7c5ac47UL, 0x1b478423UL },
+	{ 0xd1b71758UL, 0xe219652bUL }, { 0x83126e97UL, 0x8d4fdf3bUL }, { 0xa3d70a3dUL, 0x70a3d70aUL },
+	{ 0xccccccccUL, 0xccccccccUL }, { 0x80000000UL, 0x00000000UL }, { 0xa0000000UL, 0x00000000UL },
+	{ 0xc8000000UL, 0x00000000UL }, { 0xfa000000UL, 0x00000000UL }, { 0x9c400000UL, 0x00000000UL },
+	{ 0xc3500000UL, 0x00000000UL }, { 0xf4240000UL, 0x00000000UL }, { 0x98968000UL, 0x00000000UL },
+	{ 0xbebc2000UL, 0x00000000UL }, { 0xee6b2800UL, 0x00000000UL }, { 0x9502f900UL, 0x00000000UL },
+	{ 0xba43b740UL, 0x00000000UL }, { 0xe8d4a510UL, 0x00000000UL }, { 0x9184e72aUL, 0x00000000UL },
+	{ 0xb5e620f4UL, 0x80000000UL }, { 0xe35fa931UL, 0xa0000000UL }, { 0x8e1bc9bfUL, 0x04000000UL },
+	{ 0xb1a2bc2eUL, 0xc5000000UL }, { 0xde0b6b3aUL, 0x76400000UL }, { 0x8ac72304UL, 0x89e80000UL },
+	{ 0xad78ebc5UL, 0xac620000UL }, { 0xd8d726b7UL, 0x177a8000UL }, { 0x87867832UL, 0x6eac9000UL },
+	{ 0xa968163fUL, 0x0a57b400UL }, { 0xd3c21bceUL, 0xcceda100UL }, { 0x84595161UL, 0x401484a0UL },
+	{ 0xa56fa5b9UL, 0x9019a5c8UL }, { 0xcecb8f27UL, 0xf4200f3aUL }, { 0x813f3978UL, 0xf8940984UL },
+	{ 0xa18f07d7UL, 0x36b90be5UL }, { 0xc9f2c9cdUL, 0x04674edeUL }, { 0xfc6f7c40UL, 0x45812296UL },
+	{ 0x9dc5ada8UL, 0x2b70b59dUL }, { 0xc5371912UL, 0x364ce305UL }, { 0xf684df56UL, 0xc3e01bc6UL },
+	{ 0x9a130b96UL, 0x3a6c115cUL }, { 0xc097ce7bUL, 0xc90715b3UL }, { 0xf0bdc21aUL, 0xbb48db20UL },
+	{ 0x96769950UL, 0xb50d88f4UL }, { 0xbc143fa4UL, 0xe250eb31UL }, { 0xeb194f8eUL, 0x1ae525fdUL },
+	{ 0x92efd1b8UL, 0xd0cf37beUL }, { 0xb7abc627UL, 0x050305adUL }, { 0xe596b7b0UL, 0xc643c719UL },
+	{ 0x8f7e32ceUL, 0x7bea5c6fUL }, { 0xb35dbf82UL, 0x1ae4f38bUL }, { 0xe0352f62UL, 0xa19e306eUL },
+	{ 0x8c213d9dUL, 0xa502de45UL }, { 0xaf298d05UL, 0x0e4395d6UL }, { 0xdaf3f046UL, 0x51d47b4cUL },
+	{ 0x88d8762bUL, 0xf324cd0fUL }, { 0xab0e93b6UL, 0xefee0053UL }, { 0xd5d238a4UL, 0xabe98068UL },
+	{ 0x85a36366UL, 0xeb71f041UL }, { 0xa70c3c40UL, 0xa64e6c51UL }, { 0xd0cf4b50UL, 0xcfe20765UL },
+	{ 0x82818f12UL, 0x81ed449fUL }, { 0xa321f2d7UL, 0x226895c7UL }, { 0xcbea6f8cUL, 0xeb02bb39UL },
+	{ 0xfee50b70UL, 0x25c36a08UL }, { 0x9f4f2726UL, 0x179a2245UL }, { 0xc722f0efUL, 0x9d80aad6UL },
+	{ 0xf8ebad2bUL, 0x84e0d58bUL }, { 0x9b934c3bUL, 0x330c8577UL }, { 0xc2781f49UL, 0xffcfa6d5UL },
+};
+
+/* x_hi:x_lo <- y * z (full 128-bit product) */
+static void duk__mul64_full(duk_uint64_t y, duk_uint64_t z, duk_uint64_t *x_hi, duk_uint64_t *x_lo) {
+	duk_uint64_t a, b, c, d;
+	duk_uint64_t ac, bc, ad, bd;
+	duk_uint64_t tmp;
+
+	a = y >> 32;
+	b = y & 0xffffffffUL;
+	c = z >> 32;
+	d = z & 0xffffffffUL;
+	ac = a * c;
+	bc = b * c;
+	ad = a * d;
+	bd = b * d;
+	tmp = (bd >> 32) + (ad & 0xffffffffUL) + (bc & 0xffffffffUL);
+	*x_lo = (tmp << 32) | (bd & 0xffffffffUL);
+	*x_hi = ac + (ad >> 32) + (bc >> 32) + (tmp >> 32);
+}
+
+/* Convert w * 10^q (w != 0) into a double.  Returns 0 if the result cannot
+ * be guaranteed to be correctly rounded, in which case Dragon4 must be used.
+ */
+static duk_small_int_t duk__s2n_eisel_lemire(duk_uint64_t w, duk_small_int_t q, duk_double_t *out) {
+	const duk__s2n_power *p;
+	duk_uint64_t t;
+	duk_uint64_t x_hi, x_lo;
+	duk_uint64_t mant;
+	duk_int32_t log2_q;
+	duk_int32_t biased_exp;
+	duk_small_int_t lz;
+	duk_small_int_t msb;
+	duk_double_union u;
+
+	DUK_ASSERT(w != 0);
+
+	if (q < DUK__S2N_FAST_MIN_EXP10 || q > DUK__S2N_FAST_MAX_EXP10) {
+		return 0;
+	}
+	p = &duk__s2n_powers[q - DUK__S2N_FAST_MIN_EXP10];
+	t = (((duk_uint64_t) p->f_hi) << 32) | ((duk_uint64_t) p->f_lo);
+
+	/* Normalize w so that its top bit is set. */
+	lz = 0;
+	if ((w >> 32) == 0) {
+		w <<= 32;
+		lz += 32;
+	}
+	if ((w >> 48) == 0) {
+		w <<= 16;
+		lz += 16;
+	}
+	if ((w >> 56) == 0) {
+		w <<= 8;
+		lz += 8;
+	}
+	if ((w >> 60) == 0) {
+		w <<= 4;
+		lz += 4;
+	}
+	if ((w >> 62) == 0) {
+		w <<= 2;
+		lz += 2;
+	}
+	if ((w >> 63) == 0) {
+		w <<= 1;
+		lz += 1;
+	}
+
+	duk__mul64_full(w, t, &x_hi, &x_lo);
+
+	/* The exact product is in [x, x + w) because 't' is truncated.  If
+	 * adding w may carry into the bits used below, give up.
+	 */
+	if ((x_hi & 0x1ffUL) == 0x1ffUL && x_lo + w < x_lo) {
+		DUK_DDDPRINT("eisel-lemire: inexact product, fall back to dragon4");
+		return 0;
+	}
+
+	/* Take 54 bits (53 bits and a rounding bit) of the product. */
+	msb = (duk_small_int_t) (x_hi >> 63);
+	mant = x_hi >> (msb + 9);
+
+	/* An exact halfway case needs round-to-even; let Dragon4 handle it. */
+	if (x_lo == 0 && (x_hi & 0x1ffUL) == 0 && (mant & 3) == 1) {
+		DUK_DDDPRINT("eisel-lemire: halfway case, fall back to dragon4");
+		return 0;
+	}
+
+	/* floor(log2(10^q)), 217706 / 2^16 ~= log2(10); exact for |q| <= 347. */
+	log2_q = (duk_int32_t) q * 217706L;
+	if (log2_q >= 0) {
+		log2_q = log2_q / 65536L;
+	} else {
+		log2_q = -((-log2_q + 65535L) / 65536L);
+	}
+	biased_exp = log2_q + DUK__IEEE_DOUBLE_EXP_BIAS + 63 - lz + msb;
+
+	mant += mant & 1;
+	mant >>= 1;
+	if ((mant >> 53) != 0) {
+		mant >>= 1;
+		biased_exp++;
+	}
+	if (biased_exp <= 0 || biased_exp >= 0x7ff) {
+		DUK_DDDPRINT("eisel-lemire: denormal or infinite result, fall back to dragon4");
+		return 0;
+	}
+
+	DUK_DBLUNION_SET_HIGH32(&u, (((duk_uint32_t) biased_exp) << 20) |
+	                            ((duk_uint32_t) (mant >> 32) & 0x000fffffUL));
+	DUK_DBLUNION_SET_LOW32(&u, (duk_uint32_t) (mant & 0xffffffffUL));
+	*out = DUK_DBLUNION_GET_DOUBLE(&u);
+	return 1;
+}
+
+#endif  /* DUK_USE_NUMCONV_FAST_PARSE */
+
 /*
  *  Exposed number-to-string API
  *
@@ -1606,6 +2176,43 @@ void duk_numconv_stringify(duk_context *ctx, duk_small_int_t radix, duk_small_in
 		return;
 	}
 
+#if defined(DUK_USE_NUMCONV_GRISU3)
+	/*
+	 *  Radix 10 free format fast paths: integers up to 2^53 are exact and
+	 *  printed as is, other values are converted with Grisu3 unless it
+	 *  can't guarantee a shortest result.  Zero was handled above.
+	 */
+
+	if (radix == 10 && flags == 0) {
+		DUK_ASSERT(c != DUK_FP_ZERO);
+
+		if (x <= 9007199254740992.0) {  /* 2^53 */
+			duk_uint64_t uval64 = (duk_uint64_t) x;
+			if (((duk_double_t) uval64) == x) {
+				duk_uint8_t *buf = (duk_uint8_t *) (&nc_ctx->f);
+				duk_uint8_t *p = buf;
+
+				DUK_ASSERT(DUK__NUMCONV_CTX_BIGINTS_SIZE >= 20 + 1);  /* max digits + sign */
+				if (neg) {
+					*p++ = (duk_uint8_t) '-';
+				}
+				p += duk__format_uint64_dec(p, uval64);
+				duk_push_lstring(ctx, (const char *) buf, (size_t) (p - buf));
+				return;
+			}
+		}
+
+		if (duk__grisu3(nc_ctx, x)) {
+			nc_ctx->is_fixed = 0;
+			nc_ctx->abs_pos = 0;
+			nc_ctx->req_digits = 0;
+			nc_ctx->B = 10;
+			duk__dragon4_convert_and_push(nc_ctx, ctx, radix, digits, flags, neg);
+			return;
+		}
+	}
+#endif  /* DUK_USE_NUMCONV_GRISU3 */
+
 	/*
 	 *  Dragon4 setup.
 	 *
@@ -1753,6 +2360,7 @@ void duk_numconv_parse(duk_context *ctx, duk_small_int_t radix, duk_small_uint_t
 	duk_small_int_t dig_frac;
 	duk_small_int_t dig_exp;
 	duk_small_int_t dig_prec;
+	duk_small_int_t dig_sticky;
 	const duk__exp_limits *explim;
 	const duk_uint8_t *p;
 	duk_small_int_t ch;
@@ -1807,6 +2415,7 @@ void duk_numconv_parse(duk_context *ctx, duk_small_int_t radix, duk_small_uint_t
 	}
 	h_str = duk_require_hstring(ctx, -1);
 	DUK_ASSERT(h_str != NULL);
+	DUK_HSTRING_FLATTEN(thr, h_str);  /* parsing relies on NUL termination */
 	p = (const duk_uint8_t *) DUK_HSTRING_GET_DATA(h_str);
 
 	neg = 0;
@@ -1921,6 +2530,7 @@ void duk_numconv_parse(duk_context *ctx, duk_small_int_t radix, duk_small_uint_t
 
 	duk__bi_set_small(&nc_ctx->f, 0);
 	dig_prec = 0;
+	dig_sticky = 0;
 	dig_lzero = 0;
 	dig_whole = 0;
 	dig_frac = -1;
@@ -2042,9 +2652,13 @@ void duk_numconv_parse(duk_context *ctx, duk_small_int_t radix, duk_small_uint_t
 				}
 			} else {
 				/* Ignore digits beyond a radix-specific limit, but note them
-				 * in exp_adj.
+				 * in exp_adj.  A non-zero ignored digit is remembered so that
+				 * the value isn't mistaken for an exact halfway case.
 				 */
 				exp_adj++;
+				if (dig != 0) {
+					dig_sticky = 1;
+				}
 			}
 	
 			if (dig_frac >= 0) {
@@ -2152,6 +2766,27 @@ void duk_numconv_parse(duk_context *ctx, duk_small_int_t radix, duk_small_uint_t
 		goto negcheck_and_ret;
 	}
 
+#if defined(DUK_USE_NUMCONV_FAST_PARSE)
+	/* Eisel-Lemire fast path for decimal input whose significand fits
+	 * into 64 bits.  With at most 19 significant digits no digits have
+	 * been ignored, so 'f' is exact.
+	 */
+
+	if (radix == 10 && dig_prec <= 19 && nc_ctx->f.n > 0) {
+		duk_uint64_t w;
+
+		DUK_ASSERT(nc_ctx->f.n <= 2);
+		w = (duk_uint64_t) nc_ctx->f.v[0];
+		if (nc_ctx->f.n == 2) {
+			w |= ((duk_uint64_t) nc_ctx->f.v[1]) << 32;
+		}
+		if (duk__s2n_eisel_lemire(w, exp, &res)) {
+			DUK_DDDPRINT("eisel-lemire fast path number parse");
+			goto negcheck_and_ret;
+		}
+	}
+#endif
+
 	/* Significand ('f') padding. */
 
 	while (dig_prec < duk__str2num_digits_for_radix[radix - 2]) {
@@ -2231,6 +2866,16 @@ void duk_numconv_parse(duk_context *ctx, duk_small_int_t radix, duk_small_uint_t
 
 	DUK_ASSERT(nc_ctx->count == 53 + 1);
 
+	if (dig_sticky) {
+		/* Ignored digits were not all zero, so the value is above the
+		 * generated digits even if the remainder is zero.  Make the
+		 * remainder non-zero so that the value is not mistaken for an
+		 * exact halfway case when rounding.
+		 */
+		DUK_DDDPRINT("non-zero digits were ignored, force non-zero remainder");
+		duk__bi_set_small(&nc_ctx->r, 1);
+	}
+
 	/*
 	 *  Convert binary digits into an IEEE double.  Need to handle
 	 *  denormals and rounding correctly.
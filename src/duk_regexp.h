@@ -17,11 +17,7 @@
 #define DUK_RE_COMPILE_TOKEN_LIMIT         100000000L   /* 1e8 */
 
 /* regexp execution limits */
-#if defined(DUK_USE_DEEP_C_STACK)
-#define DUK_RE_EXECUTE_RECURSION_LIMIT     1000
-#else
-#define DUK_RE_EXECUTE_RECURSION_LIMIT     100
-#endif
+#define DUK_RE_EXECUTE_BACKTRACK_LIMIT     (4L * 1024L * 1024L)  /* backtrack stack slots */
 #define DUK_RE_EXECUTE_STEPS_LIMIT         1000000000L  /* 1e9 */
 
 /* regexp opcodes */
@@ -45,10 +41,40 @@
 #define DUK_REOP_ASSERT_WORD_BOUNDARY      18
 #define DUK_REOP_ASSERT_NOT_WORD_BOUNDARY  19
 
+/* RANGES/INVRANGES operand layout: ASCII bitmap, then fixed size non-ASCII
+ * ranges (two big endian u32 codepoints each)
+ */
+#define DUK_RE_RANGE_BITMAP_SIZE           16   /* bytes, 128 bits */
+#define DUK_RE_RANGE_ENTRY_SIZE            8    /* bytes per non-ASCII range */
+
 /* flags */
 #define DUK_RE_FLAG_GLOBAL                 (1 << 0)
 #define DUK_RE_FLAG_IGNORE_CASE            (1 << 1)
 #define DUK_RE_FLAG_MULTILINE              (1 << 2)
+#define DUK_RE_FLAG_AUTOMATON              (1 << 3)  /* internal: use automaton matcher */
+
+/* prefilter flags (compiled regexp header) */
+#define DUK_RE_PREFILTER_ANCHORED          (1 << 0)  /* match can only start at input start */
+#define DUK_RE_PREFILTER_PREFIX            (1 << 1)  /* literal appears at match start */
+#define DUK_RE_PREFILTER_REQUIRED          (1 << 2)  /* literal appears at or after match start */
+#define DUK_RE_PREFILTER_FIRSTSET          (1 << 3)  /* bitmap of possible first input bytes */
+
+/* prefilter analysis limits */
+#define DUK_RE_PREFILTER_MAX_LITERAL       32   /* max literal length (chars) */
+#define DUK_RE_PREFILTER_MAX_PATHS         8    /* max pending alternatives in first set analysis */
+#define DUK_RE_PREFILTER_MAX_STEPS         64   /* max opcodes inspected in first set analysis */
+
+/* max thread list size for automaton matching, in pointer slots
+ * (threads * (nsaved + 1)); larger regexps use backtracking
+ */
+#define DUK_RE_AUTOMATON_MAX_SLOTS         4096
+
+/* one slot of the matcher backtrack stack */
+union duk_re_btslot {
+	duk_uint8_t *ptr;
+	duk_uint32_t val;
+	duk_size_t size;
+};
 
 struct duk_re_matcher_ctx {
 	duk_hthread *thr;
@@ -56,14 +82,37 @@ struct duk_re_matcher_ctx {
 	duk_uint32_t re_flags;
 	duk_uint8_t *input;
 	duk_uint8_t *input_end;
+	duk_small_int_t input_ascii;	/* input is pure ASCII: one byte per char */
 	duk_uint8_t *bytecode;
 	duk_uint8_t *bytecode_end;
 	duk_uint8_t **saved;		/* allocated from valstack (fixed buffer) */
 	duk_uint32_t nsaved;
-	duk_uint32_t recursion_depth;
-	duk_uint32_t recursion_limit;
+	duk_hbuffer_dynamic *bt_buf;	/* backtrack stack, allocated from valstack (dynamic buffer) */
+	duk_re_btslot *bt;		/* current data pointer of bt_buf */
+	duk_size_t bt_top;		/* number of slots in use */
+	duk_size_t bt_size;		/* number of slots allocated */
+	duk_size_t bt_limit;
+	duk_size_t sub_top;		/* bt_top just above innermost sub-match entry, 0 if none */
 	duk_uint32_t steps_count;
 	duk_uint32_t steps_limit;
+
+	duk_uint32_t pf_flags;		/* prefilter (DUK_RE_PREFILTER_*) */
+	duk_uint8_t *pf_lit;		/* prefilter literal, points to bytecode */
+	duk_size_t pf_lit_len;
+	duk_uint8_t *pf_req;		/* next occurrence of a required literal */
+	duk_uint32_t pf_firstset[8];
+
+	duk_uint32_t nthreads;		/* automaton: max threads per thread list */
+	duk_uint32_t *visited;		/* automaton: generation per bytecode offset */
+	duk_uint32_t visit_gen;
+};
+
+/* match bounds for callers which don't need the exec() result object */
+struct duk_re_match_bounds {
+	duk_uint32_t start_coff;	/* char offsets */
+	duk_uint32_t end_coff;
+	duk_size_t start_boff;		/* byte offsets into the (coerced) input */
+	duk_size_t end_boff;
 };
 
 struct duk_re_compiler_ctx {
@@ -78,6 +127,11 @@ struct duk_re_compiler_ctx {
 	duk_uint32_t recursion_depth;
 	duk_uint32_t recursion_limit;
 	duk_uint32_t nranges;	/* internal temporary value, used for char classes */
+	duk_small_int_t automaton;	/* compiling for the automaton matcher (no simple quantifiers) */
+	duk_small_int_t has_lookahead;
+	duk_small_int_t may_backtrack;	/* alternatives or quantifiers present */
+	duk_small_int_t nullable_loop;	/* unbounded quantifier over an atom which can match empty */
+	duk_small_int_t sq_too_large;	/* a simple quantifier can't be expanded for the automaton */
 };
 
 /*
@@ -88,6 +142,8 @@ void duk_regexp_compile(duk_hthread *thr);
 void duk_regexp_create_instance(duk_hthread *thr);
 void duk_regexp_match(duk_hthread *thr);
 void duk_regexp_match_force_global(duk_hthread *thr);  /* hacky helper for String.prototype.split() */
+duk_small_int_t duk_regexp_match_bounds(duk_hthread *thr, duk_small_int_t force_global, duk_re_match_bounds *out_bounds);
+duk_uint32_t duk_regexp_get_num_captures(duk_hthread *thr, duk_idx_t index);
 
 #endif  /* DUK_REGEXP_H_INCLUDED */
 
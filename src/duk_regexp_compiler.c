@@ -43,6 +43,7 @@ typedef struct {
 	duk_uint32_t start_captures;
 	duk_uint32_t end_captures;
 #endif
+	duk_small_int_t nullable;  /* can match the empty string */
 } duk__re_disjunction_info;
 
 /*
@@ -84,13 +85,29 @@ static duk_uint32_t duk__append_i32(duk_re_compiler_ctx *re_ctx, duk_int32_t x)
 }
 #endif
 
-/* special helper for emitting u16 lists (used for character ranges for built-in char classes) */
-static void duk__append_u16_list(duk_re_compiler_ctx *re_ctx, duk_uint16_t *values, duk_uint32_t count) {
-	/* Call sites don't need the result length so it's not accumulated. */
-	while (count > 0) {
-		(void) duk__append_u32(re_ctx, (duk_uint32_t) (*values++));
-		count--;
-	}
+/* Character class ranges are collected into the bytecode buffer as fixed
+ * size (r1, r2) pairs, and are converted into the final RANGES/INVRANGES
+ * format by duk__finish_ranges().
+ */
+static void duk__put_range_u32(duk_uint8_t *p, duk_uint32_t x) {
+	p[0] = (duk_uint8_t) (x >> 24);
+	p[1] = (duk_uint8_t) (x >> 16);
+	p[2] = (duk_uint8_t) (x >> 8);
+	p[3] = (duk_uint8_t) x;
+}
+
+static duk_uint32_t duk__get_range_u32(duk_uint8_t *p) {
+	return ((duk_uint32_t) p[0] << 24) | ((duk_uint32_t) p[1] << 16) |
+	       ((duk_uint32_t) p[2] << 8) | (duk_uint32_t) p[3];
+}
+
+static void duk__append_range(duk_re_compiler_ctx *re_ctx, duk_codepoint_t r1, duk_codepoint_t r2) {
+	duk_uint8_t buf[DUK_RE_RANGE_ENTRY_SIZE];
+
+	duk__put_range_u32(buf, (duk_uint32_t) r1);
+	duk__put_range_u32(buf + 4, (duk_uint32_t) r2);
+	duk_hbuffer_append_bytes(re_ctx->thr, re_ctx->buf, buf, DUK_RE_RANGE_ENTRY_SIZE);
+	re_ctx->nranges++;
 }
 
 static void duk__insert_slice(duk_re_compiler_ctx *re_ctx, duk_uint32_t offset, duk_uint32_t data_offset, duk_uint32_t data_length) {
@@ -141,8 +158,8 @@ static duk_uint32_t duk__append_jump_offset(duk_re_compiler_ctx *re_ctx, duk_int
  *  duk_re_range_callback for generating character class ranges.
  *
  *  When ignoreCase is false, the range is simply emitted as is.
- *  We don't, for instance, eliminate duplicates or overlapping
- *  ranges in a character class.
+ *  Duplicate and overlapping ranges are eliminated afterwards by
+ *  duk__finish_ranges().
  *
  *  When ignoreCase is true, the range needs to be normalized through
  *  canonicalization.  Unfortunately a canonicalized version of a
@@ -188,23 +205,122 @@ static void duk__generate_ranges(void *userdata, duk_codepoint_t r1, duk_codepoi
 				r_end = t;
 			} else {
 				DUK_DDPRINT("canonicalized, emit range: [%d,%d]", (int) r_start, (int) r_end);
-				duk__append_u32(re_ctx, (duk_uint32_t) r_start);
-				duk__append_u32(re_ctx, (duk_uint32_t) r_end);
-				re_ctx->nranges++;
+				duk__append_range(re_ctx, r_start, r_end);
 				r_start = t;
 				r_end = t;
 			}
 		}
 		DUK_DDPRINT("canonicalized, emit range: [%d,%d]", r_start, r_end);
-		duk__append_u32(re_ctx, (duk_uint32_t) r_start);
-		duk__append_u32(re_ctx, (duk_uint32_t) r_end);
-		re_ctx->nranges++;
+		duk__append_range(re_ctx, r_start, r_end);
 	} else {
 		DUK_DDPRINT("direct, emit range: [%d,%d]", r1, r2);
-		duk__append_u32(re_ctx, (duk_uint32_t) r1);
-		duk__append_u32(re_ctx, (duk_uint32_t) r2);
-		re_ctx->nranges++;
+		duk__append_range(re_ctx, r1, r2);
+	}
+}
+
+/*
+ *  Convert the ranges collected at 'offset' (re_ctx->nranges fixed size
+ *  entries at the end of the buffer) into the final format:
+ *
+ *    - a 128-bit bitmap of the ASCII input characters matching the ranges,
+ *      indexed with the input character as is: canonicalization is applied
+ *      here so that the executor doesn't need to canonicalize ASCII input
+ *
+ *    - the number of non-ASCII ranges, followed by the ranges sorted and
+ *      merged so that the executor can binary search them; non-ASCII input
+ *      is canonicalized by the executor as before
+ *
+ *  Non-ASCII characters never canonicalize into ASCII (E5 Section 15.10.2.8),
+ *  and ASCII characters always canonicalize into ASCII, so the two parts
+ *  can be handled separately.  Sorting is an insertion sort: ranges mostly
+ *  arrive in ascending order.
+ */
+
+static void duk__finish_ranges(duk_re_compiler_ctx *re_ctx, duk_uint32_t offset) {
+	duk_uint8_t bitmap[DUK_RE_RANGE_BITMAP_SIZE];
+	duk_uint8_t canon_bitmap[DUK_RE_RANGE_BITMAP_SIZE];
+	duk_uint8_t tmp[DUK_RE_RANGE_ENTRY_SIZE];
+	duk_uint8_t *p;
+	duk_uint32_t n, i, j, m;
+	duk_uint32_t r1, r2, c;
+
+	n = re_ctx->nranges;
+	DUK_ASSERT(DUK__BUFLEN(re_ctx) == offset + n * DUK_RE_RANGE_ENTRY_SIZE);
+	p = (duk_uint8_t *) DUK_HBUFFER_DYNAMIC_GET_CURR_DATA_PTR(re_ctx->buf) + offset;
+
+	for (i = 1; i < n; i++) {
+		r1 = duk__get_range_u32(p + i * DUK_RE_RANGE_ENTRY_SIZE);
+		for (j = i; j > 0 && duk__get_range_u32(p + (j - 1) * DUK_RE_RANGE_ENTRY_SIZE) > r1; j--) {
+			;
+		}
+		if (j != i) {
+			DUK_MEMCPY((void *) tmp, (void *) (p + i * DUK_RE_RANGE_ENTRY_SIZE), DUK_RE_RANGE_ENTRY_SIZE);
+			DUK_MEMMOVE((void *) (p + (j + 1) * DUK_RE_RANGE_ENTRY_SIZE),
+			            (void *) (p + j * DUK_RE_RANGE_ENTRY_SIZE),
+			            (size_t) ((i - j) * DUK_RE_RANGE_ENTRY_SIZE));
+			DUK_MEMCPY((void *) (p + j * DUK_RE_RANGE_ENTRY_SIZE), (void *) tmp, DUK_RE_RANGE_ENTRY_SIZE);
+		}
+	}
+
+	/* ASCII part into the bitmap, non-ASCII part merged in place */
+	DUK_MEMZERO(canon_bitmap, sizeof(canon_bitmap));
+	m = 0;
+	for (i = 0; i < n; i++) {
+		r1 = duk__get_range_u32(p + i * DUK_RE_RANGE_ENTRY_SIZE);
+		r2 = duk__get_range_u32(p + i * DUK_RE_RANGE_ENTRY_SIZE + 4);
+		for (c = r1; c <= r2 && c < 0x80; c++) {
+			canon_bitmap[c >> 3] |= (duk_uint8_t) (1 << (c & 0x07));
+		}
+		if (r2 < 0x80) {
+			continue;
+		}
+		if (r1 < 0x80) {
+			r1 = 0x80;
+		}
+		if (m > 0 && r1 - 1 <= duk__get_range_u32(p + (m - 1) * DUK_RE_RANGE_ENTRY_SIZE + 4)) {
+			/* overlaps or is adjacent to the previous range */
+			if (r2 > duk__get_range_u32(p + (m - 1) * DUK_RE_RANGE_ENTRY_SIZE + 4)) {
+				duk__put_range_u32(p + (m - 1) * DUK_RE_RANGE_ENTRY_SIZE + 4, r2);
+			}
+		} else {
+			duk__put_range_u32(p + m * DUK_RE_RANGE_ENTRY_SIZE, r1);
+			duk__put_range_u32(p + m * DUK_RE_RANGE_ENTRY_SIZE + 4, r2);
+			m++;
+		}
+	}
+
+	if (re_ctx->re_flags & DUK_RE_FLAG_IGNORE_CASE) {
+		DUK_MEMZERO(bitmap, sizeof(bitmap));
+		for (c = 0; c < 0x80; c++) {
+			r1 = (duk_uint32_t) duk_unicode_re_canonicalize_char(re_ctx->thr, (duk_codepoint_t) c);
+			DUK_ASSERT(r1 < 0x80);
+			if (canon_bitmap[r1 >> 3] & (1 << (r1 & 0x07))) {
+				bitmap[c >> 3] |= (duk_uint8_t) (1 << (c & 0x07));
+			}
+		}
+	} else {
+		DUK_MEMCPY((void *) bitmap, (void *) canon_bitmap, sizeof(bitmap));
 	}
+
+	DUK_DDPRINT("character class: %d ranges, %d non-ASCII ranges after merging", (int) n, (int) m);
+
+	/* insertion order inverted on purpose */
+	duk__remove_slice(re_ctx, offset + m * DUK_RE_RANGE_ENTRY_SIZE, (n - m) * DUK_RE_RANGE_ENTRY_SIZE);
+	(void) duk__insert_u32(re_ctx, offset, m);
+	duk_hbuffer_insert_bytes(re_ctx->thr, re_ctx->buf, offset, bitmap, DUK_RE_RANGE_BITMAP_SIZE);
+}
+
+/* special helper for emitting u16 lists (used for character ranges for built-in char classes) */
+static void duk__append_u16_ranges(duk_re_compiler_ctx *re_ctx, duk_uint16_t *values, duk_uint32_t count) {
+	duk_uint32_t offset = DUK__BUFLEN(re_ctx);
+
+	re_ctx->nranges = 0;
+	while (count > 0) {
+		duk__append_range(re_ctx, (duk_codepoint_t) values[0], (duk_codepoint_t) values[1]);
+		values += 2;
+		count -= 2;
+	}
+	duk__finish_ranges(re_ctx, offset);
 }
 
 /*
@@ -261,6 +377,9 @@ static void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, int expect_eof,
 	duk_int32_t atom_start_offset = -1;                   /* negative -> no atom matched on previous round */
 	duk_int32_t atom_char_length = 0;                     /* negative -> complex atom */
 	duk_uint32_t atom_start_captures = re_ctx->captures;  /* value of re_ctx->captures at start of atom */
+	duk_small_int_t atom_nullable = 0;                    /* atom can match the empty string */
+	duk_uint32_t alt_consuming = 0;                       /* atoms in current alternative which always consume input */
+	duk_small_int_t res_nullable = 0;                     /* some finished alternative can match the empty string */
 	duk_int32_t unpatched_disjunction_split = -1;
 	duk_int32_t unpatched_disjunction_jump = -1;
 	duk_uint32_t entry_offset = DUK__BUFLEN(re_ctx);
@@ -291,6 +410,7 @@ static void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, int expect_eof,
 		                                     * (allows quantifiers to copy the atom bytecode)
 		                                     */
 		duk_uint32_t new_atom_start_captures;  /* re_ctx->captures at the start of the atom parsed in this loop */
+		duk_small_int_t new_atom_nullable;     /* atom parsed in this loop can match the empty string */
 
 		duk_lexer_parse_re_token(&re_ctx->lex, &re_ctx->curr_token);
 
@@ -304,6 +424,7 @@ static void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, int expect_eof,
 		new_atom_start_offset = -1;
 		new_atom_char_length = -1;
 		new_atom_start_captures = re_ctx->captures;
+		new_atom_nullable = 0;
 
 		switch (re_ctx->curr_token.t) {
 		case DUK_RETOK_DISJUNCTION: {
@@ -340,6 +461,12 @@ static void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, int expect_eof,
 
 			/* 'taint' result as complex */
 			res_charlen = -1;
+			re_ctx->may_backtrack = 1;
+
+			if (alt_consuming == 0) {
+				res_nullable = 1;
+			}
+			alt_consuming = 0;
 			break;
 		}
 		case DUK_RETOK_QUANTIFIER: {
@@ -351,7 +478,19 @@ static void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, int expect_eof,
 				DUK_ERROR(re_ctx->thr, DUK_ERR_SYNTAX_ERROR,
 				          "quantifier values invalid (qmin > qmax)");
 			}
-			if (atom_char_length >= 0) {
+			re_ctx->may_backtrack = 1;
+			if (!atom_nullable && re_ctx->curr_token.qmin == 0) {
+				/* atom no longer consumes input for sure */
+				DUK_ASSERT(alt_consuming > 0);
+				alt_consuming--;
+			}
+			if (atom_nullable && re_ctx->curr_token.qmax == DUK_RE_QUANTIFIER_INFINITE) {
+				/* an empty iteration needs the empty check (E5 Section
+				 * 15.10.2.5) which the automaton doesn't support
+				 */
+				re_ctx->nullable_loop = 1;
+			}
+			if (atom_char_length >= 0 && !re_ctx->automaton) {
 				/*
 				 *  Simple atom
 				 *
@@ -363,6 +502,9 @@ static void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, int expect_eof,
 				 *
 				 *  With a simple atom there can be no capture groups, so no captures need
 				 *  to be reset.
+				 *
+				 *  When compiling for the automaton matcher, simple atoms are expanded like
+				 *  complex ones; note here if that would exceed the atom copy limit.
 				 */
 				duk_int32_t atom_code_length;
 				duk_uint32_t offset;
@@ -370,6 +512,9 @@ static void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, int expect_eof,
 
 				qmin = re_ctx->curr_token.qmin;
 				qmax = re_ctx->curr_token.qmax;
+				if (((qmax == DUK_RE_QUANTIFIER_INFINITE) ? qmin : qmax) > DUK_RE_MAX_ATOM_COPIES) {
+					re_ctx->sq_too_large = 1;
+				}
 				if (atom_char_length == 0) {
 					/* qmin and qmax will be 0 or 1 */
 					if (qmin > 1) {
@@ -534,6 +679,7 @@ static void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, int expect_eof,
 			duk_uint32_t opcode = (re_ctx->curr_token.t == DUK_RETOK_ASSERT_START_POS_LOOKAHEAD) ?
 			                      DUK_REOP_LOOKPOS : DUK_REOP_LOOKNEG;
 
+			re_ctx->has_lookahead = 1;
 			offset = DUK__BUFLEN(re_ctx);
 			duk__parse_disjunction(re_ctx, 0, &tmp_disj);
 			duk__append_u32(re_ctx, DUK_REOP_MATCH);
@@ -579,8 +725,7 @@ static void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, int expect_eof,
 			duk__append_u32(re_ctx,
 			                (re_ctx->curr_token.t == DUK_RETOK_ATOM_DIGIT) ?
 			                DUK_REOP_RANGES : DUK_REOP_INVRANGES);
-			duk__append_u32(re_ctx, sizeof(duk_unicode_re_ranges_digit) / (2 * sizeof(duk_uint16_t)));
-			duk__append_u16_list(re_ctx, duk_unicode_re_ranges_digit, sizeof(duk_unicode_re_ranges_digit) / sizeof(duk_uint16_t));
+			duk__append_u16_ranges(re_ctx, duk_unicode_re_ranges_digit, sizeof(duk_unicode_re_ranges_digit) / sizeof(duk_uint16_t));
 			break;
 		}
 		case DUK_RETOK_ATOM_WHITE:
@@ -590,8 +735,7 @@ static void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, int expect_eof,
 			duk__append_u32(re_ctx,
 			                (re_ctx->curr_token.t == DUK_RETOK_ATOM_WHITE) ?
 			                DUK_REOP_RANGES : DUK_REOP_INVRANGES);
-			duk__append_u32(re_ctx, sizeof(duk_unicode_re_ranges_white) / (2 * sizeof(duk_uint16_t)));
-			duk__append_u16_list(re_ctx, duk_unicode_re_ranges_white, sizeof(duk_unicode_re_ranges_white) / sizeof(duk_uint16_t));
+			duk__append_u16_ranges(re_ctx, duk_unicode_re_ranges_white, sizeof(duk_unicode_re_ranges_white) / sizeof(duk_uint16_t));
 			break;
 		}
 		case DUK_RETOK_ATOM_WORD_CHAR:
@@ -601,8 +745,7 @@ static void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, int expect_eof,
 			duk__append_u32(re_ctx,
 			                (re_ctx->curr_token.t == DUK_RETOK_ATOM_WORD_CHAR) ?
 			                DUK_REOP_RANGES : DUK_REOP_INVRANGES);
-			duk__append_u32(re_ctx, sizeof(duk_unicode_re_ranges_wordchar) / (2 * sizeof(duk_uint16_t)));
-			duk__append_u16_list(re_ctx, duk_unicode_re_ranges_wordchar, sizeof(duk_unicode_re_ranges_wordchar) / sizeof(duk_uint16_t));
+			duk__append_u16_ranges(re_ctx, duk_unicode_re_ranges_wordchar, sizeof(duk_unicode_re_ranges_wordchar) / sizeof(duk_uint16_t));
 			break;
 		}
 		case DUK_RETOK_ATOM_BACKREFERENCE: {
@@ -612,6 +755,7 @@ static void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, int expect_eof,
 			}
 			new_atom_char_length = -1;   /* mark as complex */
 			new_atom_start_offset = DUK__BUFLEN(re_ctx);
+			new_atom_nullable = 1;
 			duk__append_u32(re_ctx, DUK_REOP_BACKREFERENCE);
 			duk__append_u32(re_ctx, backref);
 			break;
@@ -625,6 +769,7 @@ static void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, int expect_eof,
 			duk__append_u32(re_ctx, DUK_REOP_SAVE);
 			duk__append_u32(re_ctx, cap * 2);
 			duk__parse_disjunction(re_ctx, 0, &tmp_disj);  /* retval (sub-atom char length) unused, tainted as complex above */
+			new_atom_nullable = tmp_disj.nullable;
 			duk__append_u32(re_ctx, DUK_REOP_SAVE);
 			duk__append_u32(re_ctx, cap * 2 + 1);
 			break;
@@ -633,6 +778,7 @@ static void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, int expect_eof,
 			new_atom_start_offset = DUK__BUFLEN(re_ctx);
 			duk__parse_disjunction(re_ctx, 0, &tmp_disj);
 			new_atom_char_length = tmp_disj.charlen;
+			new_atom_nullable = tmp_disj.nullable;
 			break;
 		}
 		case DUK_RETOK_ATOM_START_CHARCLASS:
@@ -658,7 +804,7 @@ static void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, int expect_eof,
 			 *    [0-9A-FA-FX-Z{-{]
 			 *
 			 *  where [x-{] is split as a result of canonicalization.  The duplicate
-			 *  ranges are not a semantics issue: they work correctly.
+			 *  ranges are merged by duk__finish_ranges().
 			 */
 
 			duk_uint32_t offset;
@@ -671,14 +817,14 @@ static void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, int expect_eof,
 			duk__append_u32(re_ctx,
 			                (re_ctx->curr_token.t == DUK_RETOK_ATOM_START_CHARCLASS) ?
 			                DUK_REOP_RANGES : DUK_REOP_INVRANGES);
-			offset = DUK__BUFLEN(re_ctx);    /* patch in range count later */
+			offset = DUK__BUFLEN(re_ctx);    /* ranges converted into final format later */
 
 			/* parse ranges until character class ends */
 			re_ctx->nranges = 0;    /* note: ctx-wide temporary */
 			duk_lexer_parse_re_ranges(&re_ctx->lex, duk__generate_ranges, (void *) re_ctx);
 
-			/* insert range count */
-			duk__insert_u32(re_ctx, offset, re_ctx->nranges);
+			/* convert into bitmap and sorted range list */
+			duk__finish_ranges(re_ctx, offset);
 			break;
 		}
 		case DUK_RETOK_ATOM_END_GROUP: {
@@ -709,12 +855,16 @@ static void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, int expect_eof,
 				/* only advance if not tainted */
 				res_charlen += new_atom_char_length;
 			}
+			if (!new_atom_nullable) {
+				alt_consuming++;
+			}
 		}
 
 		/* record previous atom info in case next token is a quantifier */
 		atom_start_offset = new_atom_start_offset;
 		atom_char_length = new_atom_char_length;
 		atom_start_captures = new_atom_start_captures;
+		atom_nullable = new_atom_nullable;
 	}
 
  done:
@@ -738,8 +888,9 @@ static void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, int expect_eof,
 	out_atom_info->end_captures = re_ctx->captures;
 #endif
 	out_atom_info->charlen = res_charlen;
-	DUK_DDDPRINT("parse disjunction finished: charlen=%d",
-	             (int) out_atom_info->charlen);
+	out_atom_info->nullable = (res_nullable || alt_consuming == 0);
+	DUK_DDDPRINT("parse disjunction finished: charlen=%d, nullable=%d",
+	             (int) out_atom_info->charlen, (int) out_atom_info->nullable);
 
 	re_ctx->recursion_depth--;
 }
@@ -857,13 +1008,538 @@ static void duk__create_escaped_source(duk_hthread *thr, int idx_pattern) {
 	duk_to_string(ctx, -1);  /* -> [ ... escaped_source ] */
 }
 
+/*
+ *  Prefilter analysis (see doc/regexp.txt).
+ *
+ *  Inspects the compiled bytecode (without header) and determines:
+ *
+ *    - whether the regexp is anchored, i.e. can only match at input start
+ *
+ *    - a literal prefix which must appear at the match start, or if there
+ *      is none, a literal which must appear somewhere in the match
+ *
+ *    - the set of possible first bytes of a match
+ *
+ *  The executor uses these to skip candidate match positions without
+ *  running the matcher.  All of these are conservative: an analysis may
+ *  always give up, which just disables the corresponding prefilter.
+ */
+
+typedef struct {
+	duk_uint32_t flags;
+	duk_uint32_t lit_len;
+	duk_codepoint_t lit[DUK_RE_PREFILTER_MAX_LITERAL];
+	duk_uint32_t firstset[8];  /* 256-bit bitmap */
+} duk__re_prefilter_info;
+
+static duk_uint32_t duk__bc_read_u32(duk_re_compiler_ctx *re_ctx, duk_uint8_t **p, duk_uint8_t *p_start, duk_uint8_t *p_end) {
+	return (duk_uint32_t) duk_unicode_decode_xutf8_checked(re_ctx->thr, p, p_start, p_end);
+}
+
+static duk_int32_t duk__bc_read_i32(duk_re_compiler_ctx *re_ctx, duk_uint8_t **p, duk_uint8_t *p_start, duk_uint8_t *p_end) {
+	duk_uint32_t t;
+
+	t = duk__bc_read_u32(re_ctx, p, p_start, p_end);
+	if (t & 1) {
+		return -((duk_int32_t) (t >> 1));
+	} else {
+		return (duk_int32_t) (t >> 1);
+	}
+}
+
+/* Skip the operands of a RANGES or INVRANGES instruction, returning a
+ * pointer to the ASCII bitmap and the number of non-ASCII ranges.
+ */
+static duk_uint8_t *duk__bc_skip_ranges(duk_re_compiler_ctx *re_ctx, duk_uint8_t **p, duk_uint8_t *p_start, duk_uint8_t *p_end, duk_uint32_t *out_n) {
+	duk_uint8_t *bitmap;
+	duk_uint32_t n;
+
+	bitmap = *p;
+	if (p_end - bitmap < DUK_RE_RANGE_BITMAP_SIZE) {
+		DUK_ERROR(re_ctx->thr, DUK_ERR_INTERNAL_ERROR, "regexp bytecode invalid");
+	}
+	*p += DUK_RE_RANGE_BITMAP_SIZE;
+	n = duk__bc_read_u32(re_ctx, p, p_start, p_end);
+	if ((duk_size_t) (p_end - *p) / DUK_RE_RANGE_ENTRY_SIZE < n) {
+		DUK_ERROR(re_ctx->thr, DUK_ERR_INTERNAL_ERROR, "regexp bytecode invalid");
+	}
+	*p += n * DUK_RE_RANGE_ENTRY_SIZE;
+	if (out_n) {
+		*out_n = n;
+	}
+	return bitmap;
+}
+
+#define DUK__FIRSTSET_ADD(info,b)  do { \
+		(info)->firstset[(b) >> 5] |= (duk_uint32_t) 1 << ((b) & 0x1f); \
+	} while (0)
+
+/* Add all non-ASCII leading bytes; continuation bytes never start a character. */
+static void duk__prefilter_add_nonascii(duk__re_prefilter_info *info) {
+	duk_small_int_t b;
+
+	for (b = 0xc0; b <= 0xff; b++) {
+		DUK__FIRSTSET_ADD(info, b);
+	}
+}
+
+static void duk__prefilter_add_char(duk_re_compiler_ctx *re_ctx, duk__re_prefilter_info *info, duk_codepoint_t c) {
+	duk_uint8_t buf[DUK_UNICODE_MAX_XUTF8_LENGTH];
+
+	if (c < 0x80) {
+		DUK__FIRSTSET_ADD(info, c);
+		if ((re_ctx->re_flags & DUK_RE_FLAG_IGNORE_CASE) && c >= 'A' && c <= 'Z') {
+			/* canonicalized (uppercase) in bytecode */
+			DUK__FIRSTSET_ADD(info, c + ('a' - 'A'));
+		}
+	} else if (re_ctx->re_flags & DUK_RE_FLAG_IGNORE_CASE) {
+		/* non-ASCII characters never canonicalize to ASCII, but there may
+		 * be several non-ASCII characters with the same canonical form
+		 */
+		duk__prefilter_add_nonascii(info);
+	} else {
+		(void) duk_unicode_encode_xutf8((duk_ucodepoint_t) c, buf);
+		DUK__FIRSTSET_ADD(info, buf[0]);
+	}
+}
+
+static void duk__prefilter_add_ranges(duk_re_compiler_ctx *re_ctx, duk__re_prefilter_info *info, duk_small_int_t op, duk_uint8_t **p, duk_uint8_t *p_start, duk_uint8_t *p_end) {
+	duk_uint8_t *bitmap;
+	duk_uint32_t n;
+	duk_small_int_t b;
+	duk_small_int_t match;
+
+	/* the bitmap is indexed with the uncanonicalized input byte */
+	bitmap = duk__bc_skip_ranges(re_ctx, p, p_start, p_end, &n);
+	for (b = 0; b < 0x80; b++) {
+		match = (bitmap[b >> 3] >> (b & 0x07)) & 0x01;
+		if (match != (op == DUK_REOP_INVRANGES)) {
+			DUK__FIRSTSET_ADD(info, b);
+		}
+	}
+	if (n > 0 || op == DUK_REOP_INVRANGES) {
+		duk__prefilter_add_nonascii(info);
+	}
+}
+
+/* Determine the anchoring and the literal by scanning the top level
+ * sequence of the regexp.  The scan ends at the first jump or split, so
+ * that only code which every match executes is considered.  Zero-width
+ * opcodes don't break literal runs.
+ */
+static void duk__prefilter_literal(duk_re_compiler_ctx *re_ctx, duk__re_prefilter_info *info, duk_uint8_t *p_start, duk_uint8_t *p_end) {
+	duk_uint8_t *p = p_start;
+	duk_codepoint_t run[DUK_RE_PREFILTER_MAX_LITERAL];
+	duk_uint32_t run_len = 0;
+	duk_small_int_t at_start = 1;    /* no consuming opcodes so far */
+	duk_small_int_t first_op = 1;    /* no opcodes other than SAVE so far */
+	duk_small_int_t done = 0;
+	duk_small_int_t op;
+
+	while (!done) {
+		op = (duk_small_int_t) duk__bc_read_u32(re_ctx, &p, p_start, p_end);
+
+		switch (op) {
+		case DUK_REOP_CHAR: {
+			duk_codepoint_t c = (duk_codepoint_t) duk__bc_read_u32(re_ctx, &p, p_start, p_end);
+			if (run_len < DUK_RE_PREFILTER_MAX_LITERAL) {
+				/* a truncated literal is still required */
+				run[run_len++] = c;
+			}
+			first_op = 0;
+			continue;
+		}
+		case DUK_REOP_SAVE: {
+			(void) duk__bc_read_u32(re_ctx, &p, p_start, p_end);
+			continue;
+		}
+		case DUK_REOP_WIPERANGE: {
+			(void) duk__bc_read_u32(re_ctx, &p, p_start, p_end);
+			(void) duk__bc_read_u32(re_ctx, &p, p_start, p_end);
+			first_op = 0;
+			continue;
+		}
+		case DUK_REOP_ASSERT_START: {
+			if (first_op && !(re_ctx->re_flags & DUK_RE_FLAG_MULTILINE)) {
+				info->flags |= DUK_RE_PREFILTER_ANCHORED;
+			}
+			first_op = 0;
+			continue;
+		}
+		case DUK_REOP_ASSERT_END:
+		case DUK_REOP_ASSERT_WORD_BOUNDARY:
+		case DUK_REOP_ASSERT_NOT_WORD_BOUNDARY: {
+			first_op = 0;
+			continue;
+		}
+		case DUK_REOP_LOOKPOS:
+		case DUK_REOP_LOOKNEG: {
+			duk_int32_t skip = duk__bc_read_i32(re_ctx, &p, p_start, p_end);
+			p += skip;
+			first_op = 0;
+			continue;
+		}
+		case DUK_REOP_PERIOD: {
+			break;
+		}
+		case DUK_REOP_RANGES:
+		case DUK_REOP_INVRANGES: {
+			(void) duk__bc_skip_ranges(re_ctx, &p, p_start, p_end, NULL);
+			break;
+		}
+		case DUK_REOP_SQGREEDY:
+		case DUK_REOP_SQMINIMAL: {
+			duk_int32_t skip;
+			(void) duk__bc_read_u32(re_ctx, &p, p_start, p_end);  /* qmin */
+			(void) duk__bc_read_u32(re_ctx, &p, p_start, p_end);  /* qmax */
+			if (op == DUK_REOP_SQGREEDY) {
+				(void) duk__bc_read_u32(re_ctx, &p, p_start, p_end);  /* atomlen */
+			}
+			skip = duk__bc_read_i32(re_ctx, &p, p_start, p_end);
+			p += skip;
+			break;
+		}
+		case DUK_REOP_BACKREFERENCE: {
+			(void) duk__bc_read_u32(re_ctx, &p, p_start, p_end);
+			break;
+		}
+		default: {
+			/* DUK_REOP_MATCH, jumps, and splits */
+			done = 1;
+			break;
+		}
+		}
+
+		/* end of a literal run */
+		if (run_len > 0) {
+			if (at_start) {
+				info->flags |= DUK_RE_PREFILTER_PREFIX;
+				info->lit_len = run_len;
+				DUK_MEMCPY((void *) info->lit, (void *) run, sizeof(duk_codepoint_t) * run_len);
+				break;
+			} else if (run_len > info->lit_len) {
+				info->flags |= DUK_RE_PREFILTER_REQUIRED;
+				info->lit_len = run_len;
+				DUK_MEMCPY((void *) info->lit, (void *) run, sizeof(duk_codepoint_t) * run_len);
+			}
+		}
+		run_len = 0;
+		at_start = 0;
+		first_op = 0;
+	}
+}
+
+/* Determine the set of possible first bytes by following all paths from
+ * the regexp start to their first consuming opcode.  Gives up if some
+ * path may match an empty string or consume an arbitrary character.
+ */
+static void duk__prefilter_firstset(duk_re_compiler_ctx *re_ctx, duk__re_prefilter_info *info, duk_uint8_t *p_start, duk_uint8_t *p_end) {
+	duk_uint8_t *paths[DUK_RE_PREFILTER_MAX_PATHS];
+	duk_small_int_t npaths;
+	duk_small_int_t steps = 0;
+	duk_uint8_t *p;
+	duk_small_int_t op;
+
+	paths[0] = p_start;
+	npaths = 1;
+
+	while (npaths > 0) {
+		p = paths[--npaths];
+
+		for (;;) {
+			if (++steps > DUK_RE_PREFILTER_MAX_STEPS) {
+				goto fail;
+			}
+
+			op = (duk_small_int_t) duk__bc_read_u32(re_ctx, &p, p_start, p_end);
+			if (op == DUK_REOP_CHAR) {
+				duk__prefilter_add_char(re_ctx, info, (duk_codepoint_t) duk__bc_read_u32(re_ctx, &p, p_start, p_end));
+				break;
+			} else if (op == DUK_REOP_RANGES || op == DUK_REOP_INVRANGES) {
+				duk__prefilter_add_ranges(re_ctx, info, op, &p, p_start, p_end);
+				break;
+			} else if (op == DUK_REOP_SAVE) {
+				(void) duk__bc_read_u32(re_ctx, &p, p_start, p_end);
+			} else if (op == DUK_REOP_WIPERANGE) {
+				(void) duk__bc_read_u32(re_ctx, &p, p_start, p_end);
+				(void) duk__bc_read_u32(re_ctx, &p, p_start, p_end);
+			} else if (op == DUK_REOP_ASSERT_START || op == DUK_REOP_ASSERT_END ||
+			           op == DUK_REOP_ASSERT_WORD_BOUNDARY || op == DUK_REOP_ASSERT_NOT_WORD_BOUNDARY) {
+				;
+			} else if (op == DUK_REOP_LOOKPOS || op == DUK_REOP_LOOKNEG || op == DUK_REOP_JUMP) {
+				duk_int32_t skip = duk__bc_read_i32(re_ctx, &p, p_start, p_end);
+				p += skip;
+			} else if (op == DUK_REOP_SPLIT1 || op == DUK_REOP_SPLIT2) {
+				duk_int32_t skip = duk__bc_read_i32(re_ctx, &p, p_start, p_end);
+				if (npaths >= DUK_RE_PREFILTER_MAX_PATHS) {
+					goto fail;
+				}
+				paths[npaths++] = p + skip;
+			} else if (op == DUK_REOP_SQGREEDY || op == DUK_REOP_SQMINIMAL) {
+				duk_uint32_t qmin;
+				duk_int32_t skip;
+
+				qmin = duk__bc_read_u32(re_ctx, &p, p_start, p_end);
+				(void) duk__bc_read_u32(re_ctx, &p, p_start, p_end);  /* qmax */
+				if (op == DUK_REOP_SQGREEDY) {
+					(void) duk__bc_read_u32(re_ctx, &p, p_start, p_end);  /* atomlen */
+				}
+				skip = duk__bc_read_i32(re_ctx, &p, p_start, p_end);
+				if (qmin == 0) {
+					/* atom may be skipped */
+					if (npaths >= DUK_RE_PREFILTER_MAX_PATHS) {
+						goto fail;
+					}
+					paths[npaths++] = p + skip;
+				}
+				/* continue into atom */
+			} else {
+				/* DUK_REOP_MATCH, DUK_REOP_PERIOD, DUK_REOP_BACKREFERENCE */
+				goto fail;
+			}
+
+			if (p < p_start || p >= p_end) {
+				goto fail;
+			}
+		}
+	}
+
+	info->flags |= DUK_RE_PREFILTER_FIRSTSET;
+	return;
+
+ fail:
+	DUK_DDPRINT("no first set for regexp");
+	return;
+}
+
+/* Analyze the compiled bytecode in re_ctx->buf and insert the prefilter
+ * part of the header at offset 0.
+ */
+static void duk__insert_prefilter(duk_re_compiler_ctx *re_ctx) {
+	duk__re_prefilter_info info;
+	duk_uint8_t *p_start;
+	duk_uint8_t *p_end;
+	duk_small_int_t i;
+
+	DUK_MEMZERO(&info, sizeof(info));
+
+	p_start = (duk_uint8_t *) DUK_HBUFFER_DYNAMIC_GET_CURR_DATA_PTR(re_ctx->buf);
+	p_end = p_start + DUK__BUFLEN(re_ctx);
+
+	if (!(re_ctx->re_flags & DUK_RE_FLAG_IGNORE_CASE)) {
+		/* case insensitive literals would need case folding when searching */
+		duk__prefilter_literal(re_ctx, &info, p_start, p_end);
+	}
+	if (!(info.flags & (DUK_RE_PREFILTER_ANCHORED | DUK_RE_PREFILTER_PREFIX))) {
+		/* not useful for anchored regexps, implied by a prefix */
+		duk__prefilter_firstset(re_ctx, &info, p_start, p_end);
+	}
+
+	DUK_DDPRINT("regexp prefilter: flags=0x%02x, lit_len=%d",
+	            (unsigned int) info.flags, (int) info.lit_len);
+
+	/* insertion order inverted on purpose */
+	if (info.flags & DUK_RE_PREFILTER_FIRSTSET) {
+		for (i = 7; i >= 0; i--) {
+			(void) duk__insert_u32(re_ctx, 0, info.firstset[i]);
+		}
+	}
+	if (info.flags & (DUK_RE_PREFILTER_PREFIX | DUK_RE_PREFILTER_REQUIRED)) {
+		for (i = (duk_small_int_t) info.lit_len - 1; i >= 0; i--) {
+			(void) duk__insert_u32(re_ctx, 0, (duk_uint32_t) info.lit[i]);
+		}
+		(void) duk__insert_u32(re_ctx, 0, info.lit_len);
+	}
+	(void) duk__insert_u32(re_ctx, 0, info.flags);
+}
+
+#if defined(DUK_USE_REGEXP_AUTOMATON)
+/*
+ *  Automaton program analysis.
+ *
+ *  A thread list of the automaton matcher holds at most one thread for each
+ *  character matching instruction, so the number of such instructions bounds
+ *  the list size.  Simple quantifiers, lookaheads and backreferences never
+ *  appear in an automaton program.
+ */
+
+static duk_uint32_t duk__count_automaton_threads(duk_re_compiler_ctx *re_ctx) {
+	duk_uint8_t *p_start;
+	duk_uint8_t *p_end;
+	duk_uint8_t *p;
+	duk_uint32_t count = 0;
+
+	p_start = (duk_uint8_t *) DUK_HBUFFER_DYNAMIC_GET_CURR_DATA_PTR(re_ctx->buf);
+	p_end = p_start + DUK__BUFLEN(re_ctx);
+	p = p_start;
+
+	while (p < p_end) {
+		switch (duk__bc_read_u32(re_ctx, &p, p_start, p_end)) {
+		case DUK_REOP_CHAR:
+			(void) duk__bc_read_u32(re_ctx, &p, p_start, p_end);
+			count++;
+			break;
+		case DUK_REOP_PERIOD:
+			count++;
+			break;
+		case DUK_REOP_RANGES:
+		case DUK_REOP_INVRANGES:
+			(void) duk__bc_skip_ranges(re_ctx, &p, p_start, p_end, NULL);
+			count++;
+			break;
+		case DUK_REOP_JUMP:
+		case DUK_REOP_SPLIT1:
+		case DUK_REOP_SPLIT2:
+			(void) duk__bc_read_i32(re_ctx, &p, p_start, p_end);
+			break;
+		case DUK_REOP_SAVE:
+			(void) duk__bc_read_u32(re_ctx, &p, p_start, p_end);
+			break;
+		case DUK_REOP_WIPERANGE:
+			(void) duk__bc_read_u32(re_ctx, &p, p_start, p_end);
+			(void) duk__bc_read_u32(re_ctx, &p, p_start, p_end);
+			break;
+		case DUK_REOP_MATCH:
+		case DUK_REOP_ASSERT_START:
+		case DUK_REOP_ASSERT_END:
+		case DUK_REOP_ASSERT_WORD_BOUNDARY:
+		case DUK_REOP_ASSERT_NOT_WORD_BOUNDARY:
+			break;
+		default:
+			DUK_ERROR(re_ctx->thr, DUK_ERR_INTERNAL_ERROR, "unexpected opcode in automaton program");
+		}
+	}
+
+	return count;
+}
+#endif  /* DUK_USE_REGEXP_AUTOMATON */
+
+#if defined(DUK_USE_REGEXP_CACHE)
+/*
+ *  Compiled regexp cache.
+ *
+ *  A small per-heap LRU cache maps (pattern, flags) to the compilation
+ *  result (escaped source, bytecode).  Only interned pattern strings are
+ *  cached, so keys can be compared by pointer.  The entries are reachability
+ *  roots for mark-and-sweep (see duk_heap_markandsweep.c) and hold a
+ *  reference count.  Compilation has no side effects other than creating
+ *  the result strings, so a cached result is indistinguishable from a
+ *  fresh one.
+ */
+
+/* Look up a cached result; on a hit, replace [ ... pattern flags ] with
+ * [ ... escaped_source bytecode ] and return 1.
+ */
+static int duk__recache_lookup(duk_hthread *thr, duk_hstring *h_pattern, duk_hstring *h_flags) {
+	duk_context *ctx = (duk_context *) thr;
+	duk_heap *heap = thr->heap;
+	duk_recache_entry *e;
+	int i;
+
+	for (i = 0; i < DUK_HEAP_RECACHE_SIZE; i++) {
+		e = heap->recache + i;
+		if (e->pattern == h_pattern && e->flags == h_flags) {
+			DUK_DDPRINT("regexp cache hit: %!O /%!O", (duk_heaphdr *) h_pattern, (duk_heaphdr *) h_flags);
+			e->lru = ++heap->recache_clock;
+			heap->recache_hits++;
+			duk_pop_2(ctx);
+			duk_push_hstring(ctx, e->source);
+			duk_push_hstring(ctx, e->bytecode);
+			return 1;
+		}
+	}
+	heap->recache_misses++;
+	return 0;
+}
+
+/* Insert a compilation result, evicting the least recently used entry. */
+static void duk__recache_insert(duk_hthread *thr, duk_hstring *h_pattern, duk_hstring *h_flags, duk_hstring *h_source, duk_hstring *h_bytecode) {
+	duk_heap *heap = thr->heap;
+	duk_recache_entry *e;
+	duk_recache_entry *victim;
+	int i;
+
+#if defined(DUK_USE_NONINTERNED_STRINGS)
+	if (DUK_HSTRING_HAS_NONINTERNED(h_pattern)) {
+		/* long pattern or a slice: can't be compared by pointer */
+		return;
+	}
+#endif
+	if (DUK_HSTRING_GET_BYTELEN(h_bytecode) > DUK_HEAP_RECACHE_MAX_BYTECODE) {
+		return;
+	}
+
+	victim = heap->recache;
+	for (i = 0; i < DUK_HEAP_RECACHE_SIZE; i++) {
+		e = heap->recache + i;
+		if (!e->pattern) {
+			victim = e;
+			break;
+		}
+		if (e->lru < victim->lru) {
+			victim = e;
+		}
+	}
+
+	/* incref new values before decref'ing old ones: the decrefs may have
+	 * side effects (refzero processing frees strings)
+	 */
+	DUK_HSTRING_INCREF(thr, h_pattern);
+	DUK_HSTRING_INCREF(thr, h_flags);
+	DUK_HSTRING_INCREF(thr, h_source);
+	DUK_HSTRING_INCREF(thr, h_bytecode);
+	if (victim->pattern) {
+		duk_hstring *old_pattern = victim->pattern;
+		duk_hstring *old_flags = victim->flags;
+		duk_hstring *old_source = victim->source;
+		duk_hstring *old_bytecode = victim->bytecode;
+
+		DUK_DDPRINT("regexp cache evict: %!O", (duk_heaphdr *) old_pattern);
+		victim->pattern = NULL;
+		DUK_HSTRING_DECREF(thr, old_pattern);
+		DUK_HSTRING_DECREF(thr, old_flags);
+		DUK_HSTRING_DECREF(thr, old_source);
+		DUK_HSTRING_DECREF(thr, old_bytecode);
+	}
+	victim->pattern = h_pattern;
+	victim->flags = h_flags;
+	victim->source = h_source;
+	victim->bytecode = h_bytecode;
+	victim->lru = ++heap->recache_clock;
+}
+#endif  /* DUK_USE_REGEXP_CACHE */
+
+/*
+ *  Parse the pattern from the beginning and emit the regexp body, including
+ *  the "boilerplate" capture of the matching substring (save 0 and 1).
+ */
+
+static void duk__compile_body(duk_re_compiler_ctx *re_ctx) {
+	duk_lexer_point lex_point;
+	duk__re_disjunction_info ign_disj;
+
+	lex_point.offset = 0;		/* expensive init, just want to fill window */
+	lex_point.line = 1;
+	DUK_LEXER_SETPOINT(&re_ctx->lex, &lex_point);
+
+	re_ctx->captures = 0;
+	re_ctx->highest_backref = 0;
+
+	duk__append_u32(re_ctx, DUK_REOP_SAVE);
+	duk__append_u32(re_ctx, 0);
+	duk__parse_disjunction(re_ctx, 1 /*expect_eof*/, &ign_disj);
+	duk__append_u32(re_ctx, DUK_REOP_SAVE);
+	duk__append_u32(re_ctx, 1);
+	duk__append_u32(re_ctx, DUK_REOP_MATCH);
+}
+
 /*
  *  Exposed regexp compilation primitive.
  *
- *  Sets up a regexp compilation context, and calls duk__parse_disjunction() to do the
- *  actual parsing.  Handles generation of the compiled regexp header and the
- *  "boilerplate" capture of the matching substring (save 0 and 1).  Also does some
- *  global level regexp checks after recursive compilation has finished.
+ *  Sets up a regexp compilation context, and calls duk__compile_body() to do the
+ *  actual parsing, twice if the regexp can use the automaton matcher.  Handles
+ *  generation of the compiled regexp header.  Also does some global level regexp
+ *  checks after recursive compilation has finished.
  *
  *  An escaped version of the regexp source, suitable for use as a RegExp instance
  *  'source' property (see E5 Section 15.10.3), is also left on the stack.
@@ -875,11 +1551,12 @@ static void duk__create_escaped_source(duk_hthread *thr, int idx_pattern) {
 void duk_regexp_compile(duk_hthread *thr) {
 	duk_context *ctx = (duk_context *) thr;
 	duk_re_compiler_ctx re_ctx;
-	duk_lexer_point lex_point;
 	duk_hstring *h_pattern;
 	duk_hstring *h_flags;
 	duk_hbuffer_dynamic *h_buffer;
-	duk__re_disjunction_info ign_disj;
+#if defined(DUK_USE_REGEXP_AUTOMATON)
+	duk_uint32_t nthreads = 0;
+#endif
 
 	DUK_ASSERT(thr != NULL);
 	DUK_ASSERT(ctx != NULL);
@@ -892,6 +1569,13 @@ void duk_regexp_compile(duk_hthread *thr) {
 	h_pattern = duk_require_hstring(ctx, -2);
 	h_flags = duk_require_hstring(ctx, -1);
 
+#if defined(DUK_USE_REGEXP_CACHE)
+	if (duk__recache_lookup(thr, h_pattern, h_flags)) {
+		/* [ ... escaped_source bytecode ] */
+		return;
+	}
+#endif
+
 	/*
 	 *  Create normalized 'source' property (E5 Section 15.10.3).
 	 */
@@ -918,6 +1602,7 @@ void duk_regexp_compile(duk_hthread *thr) {
 	re_ctx.lex.thr = thr;
 	re_ctx.lex.input = DUK_HSTRING_GET_DATA(h_pattern);
 	re_ctx.lex.input_length = DUK_HSTRING_GET_BYTELEN(h_pattern);
+	re_ctx.lex.input_ascii = DUK_HSTRING_HAS_ASCII(h_pattern) ? 1 : 0;
 	re_ctx.lex.token_limit = DUK_RE_COMPILE_TOKEN_LIMIT;
 	re_ctx.buf = h_buffer;
 	re_ctx.recursion_limit = DUK_RE_COMPILE_RECURSION_LIMIT;
@@ -926,26 +1611,13 @@ void duk_regexp_compile(duk_hthread *thr) {
 	DUK_DDPRINT("regexp compiler ctx initialized, flags=0x%08x, recursion_limit=%d",
 	            (unsigned int) re_ctx.re_flags, (int) re_ctx.recursion_limit);
 
-	/*
-	 *  Init lexer
-	 */
-
-	lex_point.offset = 0;		/* expensive init, just want to fill window */
-	lex_point.line = 1;
-	DUK_LEXER_SETPOINT(&re_ctx.lex, &lex_point);
-
 	/*
 	 *  Compilation
 	 */
 
 	DUK_DPRINT("starting regexp compilation");
 
-	duk__append_u32(&re_ctx, DUK_REOP_SAVE);
-	duk__append_u32(&re_ctx, 0);
-	duk__parse_disjunction(&re_ctx, 1 /*expect_eof*/, &ign_disj);
-	duk__append_u32(&re_ctx, DUK_REOP_SAVE);
-	duk__append_u32(&re_ctx, 1);
-	duk__append_u32(&re_ctx, DUK_REOP_MATCH);
+	duk__compile_body(&re_ctx);
 
 	DUK_DPRINT("regexp bytecode size (before header) is %d bytes",
 	           (int) DUK_HBUFFER_GET_SIZE(re_ctx.buf));
@@ -963,11 +1635,58 @@ void duk_regexp_compile(duk_hthread *thr) {
 		DUK_ERROR(thr, DUK_ERR_SYNTAX_ERROR, "invalid backreference(s)");
 	}
 
+#if defined(DUK_USE_REGEXP_AUTOMATON)
 	/*
-	 *  Emit compiled regexp header: flags, ncaptures
-	 *  (insertion order inverted on purpose)
+	 *  Recompile for the automaton matcher when possible.
+	 *
+	 *  Without lookaheads and backreferences the matcher can follow all
+	 *  backtracking alternatives in parallel, in time linear to the input
+	 *  length (see doc/regexp.txt).  The automaton doesn't support simple
+	 *  quantifiers, so the second pass expands them like complex ones.
+	 *  Regexps without alternatives or quantifiers never backtrack and
+	 *  are left as is, and so are regexps with an unbounded quantifier
+	 *  over an atom which can match the empty string, and regexps whose
+	 *  thread lists would be too large.
 	 */
 
+	if (re_ctx.may_backtrack && !re_ctx.has_lookahead && !re_ctx.nullable_loop &&
+	    re_ctx.highest_backref == 0 && !re_ctx.sq_too_large) {
+		DUK_DDPRINT("recompiling regexp for automaton matcher");
+
+		duk_push_dynamic_buffer(ctx, 0);
+		re_ctx.buf = (duk_hbuffer_dynamic *) duk_require_hbuffer(ctx, -1);
+		re_ctx.automaton = 1;
+		duk__compile_body(&re_ctx);
+
+		/* [ ... pattern flags escaped_source buffer automaton_buffer ] */
+
+		nthreads = duk__count_automaton_threads(&re_ctx);
+		if ((re_ctx.captures + 1) * 2 + 1 <= DUK_RE_AUTOMATON_MAX_SLOTS / (nthreads + 1)) {
+			re_ctx.re_flags |= DUK_RE_FLAG_AUTOMATON;
+			duk_remove(ctx, -2);
+		} else {
+			DUK_DDPRINT("automaton thread lists too large (%d threads), use backtracking",
+			            (int) nthreads);
+			duk_pop(ctx);
+			re_ctx.buf = h_buffer;
+			re_ctx.automaton = 0;
+		}
+
+		/* [ ... pattern flags escaped_source buffer ] */
+	}
+#endif
+
+	/*
+	 *  Emit compiled regexp header: flags, ncaptures, automaton thread
+	 *  count, prefilter (insertion order inverted on purpose)
+	 */
+
+	duk__insert_prefilter(&re_ctx);
+#if defined(DUK_USE_REGEXP_AUTOMATON)
+	if (re_ctx.re_flags & DUK_RE_FLAG_AUTOMATON) {
+		duk__insert_u32(&re_ctx, 0, nthreads);
+	}
+#endif
 	duk__insert_u32(&re_ctx, 0, (re_ctx.captures + 1) * 2);
 	duk__insert_u32(&re_ctx, 0, re_ctx.re_flags);
 
@@ -981,6 +1700,10 @@ void duk_regexp_compile(duk_hthread *thr) {
 
 	/* [ ... pattern flags escaped_source bytecode ] */
 
+#if defined(DUK_USE_REGEXP_CACHE)
+	duk__recache_insert(thr, h_pattern, h_flags, duk_get_hstring(ctx, -2), duk_get_hstring(ctx, -1));
+#endif
+
 	/*
 	 *  Finalize stack
 	 */
@@ -106,12 +106,26 @@ static duk_uint8_t *duk__utf8_advance(duk_hthread *thr, duk_uint8_t **ptr, duk_u
  *  Helpers for dealing with the input string
  */
 
+/* Get an input character from current sp without canonicalization. */
+static duk_codepoint_t duk__inp_get_raw_cp(duk_re_matcher_ctx *re_ctx, duk_uint8_t **sp) {
+	if (re_ctx->input_ascii) {
+		/* pure ASCII input: no UTF-8 decoding needed */
+		if (*sp < re_ctx->input || *sp >= re_ctx->input_end) {
+			DUK_ERROR(re_ctx->thr, DUK_ERR_INTERNAL_ERROR, "regexp input decode failed");
+		}
+		return (duk_codepoint_t) *(*sp)++;
+	}
+	return (duk_codepoint_t) duk_unicode_decode_xutf8_checked(re_ctx->thr, sp, re_ctx->input, re_ctx->input_end);
+}
+
 /* Get a (possibly canonicalized) input character from current sp.  The input
  * itself is never modified, and captures always record non-canonicalized
  * characters even in case-insensitive matching.
  */
 static duk_codepoint_t duk__inp_get_cp(duk_re_matcher_ctx *re_ctx, duk_uint8_t **sp) {
-	duk_codepoint_t res = (duk_codepoint_t) duk_unicode_decode_xutf8_checked(re_ctx->thr, sp, re_ctx->input, re_ctx->input_end);
+	duk_codepoint_t res;
+
+	res = duk__inp_get_raw_cp(re_ctx, sp);
 	if (re_ctx->re_flags & DUK_RE_FLAG_IGNORE_CASE) {
 		res = duk_unicode_re_canonicalize_char(re_ctx->thr, res);
 	}
@@ -119,32 +133,264 @@ static duk_codepoint_t duk__inp_get_cp(duk_re_matcher_ctx *re_ctx, duk_uint8_t *
 }
 
 static duk_uint8_t *duk__inp_backtrack(duk_re_matcher_ctx *re_ctx, duk_uint8_t **sp, duk_uint_fast32_t count) {
+	if (re_ctx->input_ascii) {
+		/* pure ASCII input: one byte per char */
+		if (*sp > re_ctx->input_end || (duk_size_t) (*sp - re_ctx->input) < (duk_size_t) count) {
+			DUK_ERROR(re_ctx->thr, DUK_ERR_INTERNAL_ERROR, "regexp backtrack failed");
+		}
+		*sp -= count;
+		return *sp;
+	}
 	return duk__utf8_backtrack(re_ctx->thr, sp, re_ctx->input, re_ctx->input_end, count);
 }
 
+/* Number of characters in the input between 'p' and 'q'. */
+static duk_uint32_t duk__count_chars(duk_re_matcher_ctx *re_ctx, duk_uint8_t *p, duk_uint8_t *q) {
+	duk_small_int_t ign_ascii;
+
+	DUK_ASSERT(p <= q);
+	if (re_ctx->input_ascii) {
+		return (duk_uint32_t) (q - p);
+	}
+	return (duk_uint32_t) duk_unicode_unvalidated_utf8_length(p, (duk_size_t) (q - p), &ign_ascii);
+}
+
 /* Backtrack utf-8 input and return a (possibly canonicalized) input character. */
 static duk_codepoint_t duk__inp_get_prev_cp(duk_re_matcher_ctx *re_ctx, duk_uint8_t *sp) {
 	/* note: caller 'sp' is intentionally not updated here */
 	(void) duk__inp_backtrack(re_ctx, &sp, (duk_uint_fast32_t) 1);
 	return duk__inp_get_cp(re_ctx, &sp);
 }
+
+/* Match a character against a RANGES or INVRANGES instruction, 'pc' pointing
+ * to the ASCII bitmap.  The character 'c' must not be canonicalized: the
+ * bitmap already accounts for case insensitivity, and non-ASCII characters
+ * are canonicalized here only when needed.  Returns 1 if the character is
+ * inside some range (regardless of the opcode).
+ */
+static duk_small_int_t duk__match_ranges(duk_re_matcher_ctx *re_ctx, duk_uint8_t **pc, duk_codepoint_t c) {
+	duk_uint8_t *p;
+	duk_uint8_t *q;
+	duk_uint32_t n, lo, hi, mid;
+	duk_uint32_t r1, r2;
+
+	p = *pc;
+	if (p < re_ctx->bytecode || re_ctx->bytecode_end - p < DUK_RE_RANGE_BITMAP_SIZE) {
+		goto internal_error;
+	}
+	*pc = p + DUK_RE_RANGE_BITMAP_SIZE;
+	n = duk__bc_get_u32(re_ctx, pc);
+	q = *pc;
+	if ((duk_size_t) (re_ctx->bytecode_end - q) / DUK_RE_RANGE_ENTRY_SIZE < n) {
+		goto internal_error;
+	}
+	*pc = q + n * DUK_RE_RANGE_ENTRY_SIZE;
+
+	if (c < 0x80) {
+		DUK_DDDPRINT("matching ranges/invranges, ascii bitmap, c=%d", (int) c);
+		return (p[c >> 3] >> (c & 0x07)) & 0x01;
+	}
+
+	if (re_ctx->re_flags & DUK_RE_FLAG_IGNORE_CASE) {
+		c = duk_unicode_re_canonicalize_char(re_ctx->thr, c);
+	}
+
+	/* ranges are sorted and don't overlap */
+	lo = 0;
+	hi = n;
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		p = q + mid * DUK_RE_RANGE_ENTRY_SIZE;
+		r1 = ((duk_uint32_t) p[0] << 24) | ((duk_uint32_t) p[1] << 16) |
+		     ((duk_uint32_t) p[2] << 8) | (duk_uint32_t) p[3];
+		r2 = ((duk_uint32_t) p[4] << 24) | ((duk_uint32_t) p[5] << 16) |
+		     ((duk_uint32_t) p[6] << 8) | (duk_uint32_t) p[7];
+		DUK_DDDPRINT("matching ranges/invranges, n=%d, r1=%d, r2=%d, c=%d",
+		             (int) n, (int) r1, (int) r2, (int) c);
+		if ((duk_uint32_t) c < r1) {
+			hi = mid;
+		} else if ((duk_uint32_t) c > r2) {
+			lo = mid + 1;
+		} else {
+			return 1;
+		}
+	}
+	return 0;
+
+ internal_error:
+	DUK_ERROR(re_ctx->thr, DUK_ERR_INTERNAL_ERROR, "regexp bytecode invalid");
+	return 0;  /* never here */
+}
+
+/* Check an assertion (DUK_REOP_ASSERT_xxx) at 'sp', returns 1 if it holds. */
+static duk_small_int_t duk__check_assertion(duk_re_matcher_ctx *re_ctx, duk_small_int_t op, duk_uint8_t *sp) {
+	duk_codepoint_t c;
+
+	switch (op) {
+	case DUK_REOP_ASSERT_START: {
+		if (sp <= re_ctx->input) {
+			return 1;
+		}
+		if (!(re_ctx->re_flags & DUK_RE_FLAG_MULTILINE)) {
+			return 0;
+		}
+		c = duk__inp_get_prev_cp(re_ctx, sp);
+		/* E5 Sections 15.10.2.8, 7.3 */
+		return duk_unicode_is_line_terminator(c) ? 1 : 0;
+	}
+	case DUK_REOP_ASSERT_END: {
+		if (sp >= re_ctx->input_end) {
+			return 1;
+		}
+		if (!(re_ctx->re_flags & DUK_RE_FLAG_MULTILINE)) {
+			return 0;
+		}
+		c = duk__inp_get_cp(re_ctx, &sp);  /* caller 'sp' is not updated */
+		/* E5 Sections 15.10.2.8, 7.3 */
+		return duk_unicode_is_line_terminator(c) ? 1 : 0;
+	}
+	default: {
+		/*
+		 *  E5 Section 15.10.2.6.  The previous and current character
+		 *  should -not- be canonicalized as they are now.  However,
+		 *  canonicalization does not affect the result of IsWordChar()
+		 *  (which depends on Unicode characters never canonicalizing
+		 *  into ASCII characters) so this does not matter.
+		 */
+		duk_small_int_t w1, w2;
+
+		DUK_ASSERT(op == DUK_REOP_ASSERT_WORD_BOUNDARY ||
+		           op == DUK_REOP_ASSERT_NOT_WORD_BOUNDARY);
+
+		if (sp <= re_ctx->input) {
+			w1 = 0;  /* not a wordchar */
+		} else {
+			c = duk__inp_get_prev_cp(re_ctx, sp);
+			w1 = duk_unicode_re_is_wordchar(c);
+		}
+		if (sp >= re_ctx->input_end) {
+			w2 = 0;  /* not a wordchar */
+		} else {
+			c = duk__inp_get_cp(re_ctx, &sp);  /* caller 'sp' is not updated */
+			w2 = duk_unicode_re_is_wordchar(c);
+		}
+
+		if (op == DUK_REOP_ASSERT_WORD_BOUNDARY) {
+			return (w1 != w2) ? 1 : 0;
+		} else {
+			return (w1 == w2) ? 1 : 0;
+		}
+	}
+	}
+}
 	
 /*
- *  Regexp recursive matching function.
+ *  Explicit backtrack stack.
  *
- *  Returns 'sp' on successful match (points to character after last matched one),
- *  NULL otherwise.
+ *  Backtrack points and the information needed to undo capture updates are
+ *  kept in a heap allocated stack of slots (a dynamic buffer kept in the
+ *  value stack) instead of the C stack, so that C stack usage doesn't depend
+ *  on the regexp or the input.  An entry consists of one or more slots with
+ *  a type tag in the topmost slot; entries are popped when matching fails.
+ *
+ *  Simple quantifier atoms and lookahead bodies are matched as "sub-matches"
+ *  which end in a DUK_REOP_MATCH.  A sub-match entry marks the start of a
+ *  sub-match; when the sub-match succeeds all backtrack entries above it are
+ *  discarded (there is no backtracking into a completed sub-match), and when
+ *  it fails the entry is reached by ordinary backtracking.  Entry layouts,
+ *  bottom to top:
  *
- *  The C recursion depth limit check is only performed in this function, this
- *  suffices because the function is present in all true recursion required by
- *  regexp execution.
+ *    SPLIT          pc, sp
+ *    SAVE           old value, idx
+ *    WIPE           old values [count], idx_start, count
+ *    RESTORE_ALL    old values [nsaved]
+ *    GREEDY         pc_cont, sp, q, qmin, atomlen
+ *    MINIMAL        pc_atom, pc_cont, sp, q, qmin, qmax
+ *    SUB_GREEDY     pc_atom, pc_cont, sp, q, qmin, qmax, atomlen, prev_sub_top
+ *    SUB_MINIMAL    pc_atom, pc_cont, sp, q, qmin, qmax, prev_sub_top
+ *    SUB_LOOK       old values [nsaved], pc_cont, sp, op, prev_sub_top
  */
 
-static duk_uint8_t *duk__match_regexp(duk_re_matcher_ctx *re_ctx, duk_uint8_t *pc, duk_uint8_t *sp) {
-	if (re_ctx->recursion_depth >= re_ctx->recursion_limit) {
-		DUK_ERROR(re_ctx->thr, DUK_ERR_RANGE_ERROR, "regexp executor recursion limit");
+#define DUK__BT_SPLIT        1
+#define DUK__BT_SAVE         2
+#define DUK__BT_WIPE         3
+#define DUK__BT_RESTORE_ALL  4
+#define DUK__BT_GREEDY       5
+#define DUK__BT_MINIMAL      6
+#define DUK__BT_SUB_GREEDY   7
+#define DUK__BT_SUB_MINIMAL  8
+#define DUK__BT_SUB_LOOK     9
+
+#define DUK__BT_INITIAL_SLOTS  64
+
+#define DUK__BT_PUSH_PTR(re_ctx,x)   do { (re_ctx)->bt[(re_ctx)->bt_top++].ptr = (x); } while (0)
+#define DUK__BT_PUSH_VAL(re_ctx,x)   do { (re_ctx)->bt[(re_ctx)->bt_top++].val = (duk_uint32_t) (x); } while (0)
+#define DUK__BT_PUSH_SIZE(re_ctx,x)  do { (re_ctx)->bt[(re_ctx)->bt_top++].size = (x); } while (0)
+#define DUK__BT_POP_PTR(re_ctx)      ((re_ctx)->bt[--(re_ctx)->bt_top].ptr)
+#define DUK__BT_POP_VAL(re_ctx)      ((re_ctx)->bt[--(re_ctx)->bt_top].val)
+#define DUK__BT_POP_SIZE(re_ctx)     ((re_ctx)->bt[--(re_ctx)->bt_top].size)
+
+/* Ensure there is space for 'count' more slots. */
+static void duk__bt_require(duk_re_matcher_ctx *re_ctx, duk_size_t count) {
+	duk_size_t new_size;
+
+	if (re_ctx->bt_top + count <= re_ctx->bt_size) {
+		return;
+	}
+
+	new_size = re_ctx->bt_size * 2 + count;
+	if (new_size > re_ctx->bt_limit) {
+		new_size = re_ctx->bt_limit;
+		if (re_ctx->bt_top + count > new_size) {
+			DUK_ERROR(re_ctx->thr, DUK_ERR_RANGE_ERROR, "regexp backtrack limit");
+		}
+	}
+
+	DUK_DDDPRINT("resize regexp backtrack stack: %d -> %d slots", (int) re_ctx->bt_size, (int) new_size);
+	duk_hbuffer_resize(re_ctx->thr, re_ctx->bt_buf, new_size * sizeof(duk_re_btslot), new_size * sizeof(duk_re_btslot));
+	re_ctx->bt = (duk_re_btslot *) DUK_HBUFFER_DYNAMIC_GET_CURR_DATA_PTR(re_ctx->bt_buf);
+	re_ctx->bt_size = new_size;
+}
+
+/* Push a copy of the entire saved[] array, to be followed by a tag. */
+static void duk__bt_push_saved_copy(duk_re_matcher_ctx *re_ctx) {
+	duk_uint32_t i;
+
+	for (i = 0; i < re_ctx->nsaved; i++) {
+		DUK__BT_PUSH_PTR(re_ctx, re_ctx->saved[i]);
 	}
-	re_ctx->recursion_depth++;
+}
+
+/* Restore the entire saved[] array from a copy at the stack top, without
+ * popping it.
+ */
+static void duk__bt_restore_saved_copy(duk_re_matcher_ctx *re_ctx) {
+	duk_re_btslot *p;
+	duk_uint32_t i;
+
+	DUK_ASSERT(re_ctx->bt_top >= re_ctx->nsaved);
+	p = re_ctx->bt + (re_ctx->bt_top - re_ctx->nsaved);
+	for (i = 0; i < re_ctx->nsaved; i++) {
+		re_ctx->saved[i] = p[i].ptr;
+	}
+}
+
+/*
+ *  Regexp matching function.
+ *
+ *  Returns 'sp' on successful match (points to character after last matched one),
+ *  NULL otherwise.  The backtrack stack is empty on entry and is left in an
+ *  undefined state.
+ */
+
+static duk_uint8_t *duk__match_regexp(duk_re_matcher_ctx *re_ctx, duk_uint8_t *pc, duk_uint8_t *sp) {
+	/* Quantifier state, used when starting and resuming quantifier loops. */
+	duk_uint8_t *q_pc_atom;
+	duk_uint8_t *q_pc_cont;
+	duk_uint32_t q, qmin, qmax, atomlen;
+
+	DUK_ASSERT(re_ctx->bt_top == 0);
+	DUK_ASSERT(re_ctx->sub_top == 0);
 
 	for (;;) {
 		duk_small_int_t op;
@@ -156,8 +402,8 @@ static duk_uint8_t *duk__match_regexp(duk_re_matcher_ctx *re_ctx, duk_uint8_t *p
 
 		op = (duk_small_int_t) duk__bc_get_u32(re_ctx, &pc);
 
-		DUK_DDDPRINT("match: rec=%d, steps=%d, pc (after op)=%d, sp=%d, op=%d",
-		             (int) re_ctx->recursion_depth,
+		DUK_DDDPRINT("match: bt_top=%d, steps=%d, pc (after op)=%d, sp=%d, op=%d",
+		             (int) re_ctx->bt_top,
 		             (int) re_ctx->steps_count,
 		             (int) (pc - re_ctx->bytecode),
 		             (int) (sp - re_ctx->input),
@@ -211,32 +457,14 @@ static duk_uint8_t *duk__match_regexp(duk_re_matcher_ctx *re_ctx, duk_uint8_t *p
 		}
 		case DUK_REOP_RANGES:
 		case DUK_REOP_INVRANGES: {
-			duk_uint32_t n;
 			duk_codepoint_t c;
 			duk_small_int_t match;
-	
-			n = duk__bc_get_u32(re_ctx, &pc);
+
 			if (sp >= re_ctx->input_end) {
 				goto fail;
 			}
-			c = duk__inp_get_cp(re_ctx, &sp);
-
-			match = 0;
-			while (n) {
-				duk_codepoint_t r1, r2;
-				r1 = (duk_codepoint_t) duk__bc_get_u32(re_ctx, &pc);
-				r2 = (duk_codepoint_t) duk__bc_get_u32(re_ctx, &pc);
-				DUK_DDDPRINT("matching ranges/invranges, n=%d, r1=%d, r2=%d, c=%d",
-				             (int) n, (int) r1, (int) r2, (int) c);
-				if (c >= r1 && c <= r2) {
-					/* Note: don't bail out early, we must read all the ranges from
-					 * bytecode.  Another option is to skip them efficiently after
-					 * breaking out of here.  Prefer smallest code.
-					 */
-					match = 1;
-				}
-				n--;
-			}
+			c = duk__inp_get_raw_cp(re_ctx, &sp);  /* canonicalized by duk__match_ranges() if necessary */
+			match = duk__match_ranges(re_ctx, &pc, c);
 
 			if (op == DUK_REOP_RANGES) {
 				if (!match) {
@@ -250,76 +478,12 @@ static duk_uint8_t *duk__match_regexp(duk_re_matcher_ctx *re_ctx, duk_uint8_t *p
 			}
 			break;
 		}
-		case DUK_REOP_ASSERT_START: {
-			duk_codepoint_t c;
-
-			if (sp <= re_ctx->input) {
-				break;
-			}
-			if (!(re_ctx->re_flags & DUK_RE_FLAG_MULTILINE)) {
-				goto fail;
-			}
-			c = duk__inp_get_prev_cp(re_ctx, sp);
-			if (duk_unicode_is_line_terminator(c)) {
-				/* E5 Sections 15.10.2.8, 7.3 */
-				break;
-			}
-			goto fail;
-		}
-		case DUK_REOP_ASSERT_END: {
-			duk_codepoint_t c;
-			duk_uint8_t *temp_sp;
-
-			if (sp >= re_ctx->input_end) {
-				break;
-			}
-			if (!(re_ctx->re_flags & DUK_RE_FLAG_MULTILINE)) {
-				goto fail;
-			}
-			temp_sp = sp;
-			c = duk__inp_get_cp(re_ctx, &temp_sp);
-			if (duk_unicode_is_line_terminator(c)) {
-				/* E5 Sections 15.10.2.8, 7.3 */
-				break;
-			}
-			goto fail;
-		}
+		case DUK_REOP_ASSERT_START:
+		case DUK_REOP_ASSERT_END:
 		case DUK_REOP_ASSERT_WORD_BOUNDARY:
 		case DUK_REOP_ASSERT_NOT_WORD_BOUNDARY: {
-			/*
-			 *  E5 Section 15.10.2.6.  The previous and current character
-			 *  should -not- be canonicalized as they are now.  However,
-			 *  canonicalization does not affect the result of IsWordChar()
-			 *  (which depends on Unicode characters never canonicalizing
-			 *  into ASCII characters) so this does not matter.
-			 */
-			duk_small_int_t w1, w2;
-
-			if (sp <= re_ctx->input) {
-				w1 = 0;  /* not a wordchar */
-			} else {
-				duk_codepoint_t c;
-				c = duk__inp_get_prev_cp(re_ctx, sp);
-				w1 = duk_unicode_re_is_wordchar(c);
-			}
-			if (sp >= re_ctx->input_end) {
-				w2 = 0;  /* not a wordchar */
-			} else {
-				duk_uint8_t *tmp_sp = sp;  /* dummy so sp won't get updated */
-				duk_codepoint_t c;
-				c = duk__inp_get_cp(re_ctx, &tmp_sp);
-				w2 = duk_unicode_re_is_wordchar(c);
-			}
-
-			if (op == DUK_REOP_ASSERT_WORD_BOUNDARY) {
-				if (w1 == w2) {
-					goto fail;
-				}
-			} else {
-				DUK_ASSERT(op == DUK_REOP_ASSERT_NOT_WORD_BOUNDARY);
-				if (w1 != w2) {
-					goto fail;
-				}
+			if (!duk__check_assertion(re_ctx, op, sp)) {
+				goto fail;
 			}
 			break;
 		}
@@ -332,35 +496,29 @@ static duk_uint8_t *duk__match_regexp(duk_re_matcher_ctx *re_ctx, duk_uint8_t *p
 		}
 		case DUK_REOP_SPLIT1: {
 			/* split1: prefer direct execution (no jump) */
-			duk_uint8_t *sub_sp;
 			duk_int32_t skip;
 
 			skip = duk__bc_get_i32(re_ctx, &pc);
-			sub_sp = duk__match_regexp(re_ctx, pc, sp);
-			if (sub_sp) {
-				sp = sub_sp;
-				goto match;
-			}
-			pc += skip;
+			duk__bt_require(re_ctx, 3);
+			DUK__BT_PUSH_PTR(re_ctx, pc + skip);
+			DUK__BT_PUSH_PTR(re_ctx, sp);
+			DUK__BT_PUSH_VAL(re_ctx, DUK__BT_SPLIT);
 			break;
 		}
 		case DUK_REOP_SPLIT2: {
 			/* split2: prefer jump execution (not direct) */
-			duk_uint8_t *sub_sp;
 			duk_int32_t skip;
 
 			skip = duk__bc_get_i32(re_ctx, &pc);
-			sub_sp = duk__match_regexp(re_ctx, pc + skip, sp);
-			if (sub_sp) {
-				sp = sub_sp;
-				goto match;
-			}
+			duk__bt_require(re_ctx, 3);
+			DUK__BT_PUSH_PTR(re_ctx, pc);
+			DUK__BT_PUSH_PTR(re_ctx, sp);
+			DUK__BT_PUSH_VAL(re_ctx, DUK__BT_SPLIT);
+			pc += skip;
 			break;
 		}
 		case DUK_REOP_SQMINIMAL: {
-			duk_uint32_t q, qmin, qmax;
 			duk_int32_t skip;
-			duk_uint8_t *sub_sp;
 
 			qmin = duk__bc_get_u32(re_ctx, &pc);
 			qmax = duk__bc_get_u32(re_ctx, &pc);
@@ -368,28 +526,13 @@ static duk_uint8_t *duk__match_regexp(duk_re_matcher_ctx *re_ctx, duk_uint8_t *p
 			DUK_DDDPRINT("minimal quantifier, qmin=%u, qmax=%u, skip=%d",
 			             (unsigned int) qmin, (unsigned int) qmax, (int) skip);
 
+			q_pc_atom = pc;
+			q_pc_cont = pc + skip;
 			q = 0;
-			while (q <= qmax) {
-				if (q >= qmin) {
-					sub_sp = duk__match_regexp(re_ctx, pc + skip, sp);
-					if (sub_sp) {
-						sp = sub_sp;
-						goto match;
-					}
-				}
-				sub_sp = duk__match_regexp(re_ctx, pc, sp);
-				if (!sub_sp) {
-					break;
-				}
-				sp = sub_sp;
-				q++;
-			}
-			goto fail;
+			goto minimal_step;
 		}
 		case DUK_REOP_SQGREEDY: {
-			duk_uint32_t q, qmin, qmax, atomlen;
 			duk_int32_t skip;
-			duk_uint8_t *sub_sp;
 
 			qmin = duk__bc_get_u32(re_ctx, &pc);
 			qmax = duk__bc_get_u32(re_ctx, &pc);
@@ -398,41 +541,13 @@ static duk_uint8_t *duk__match_regexp(duk_re_matcher_ctx *re_ctx, duk_uint8_t *p
 			DUK_DDDPRINT("greedy quantifier, qmin=%u, qmax=%u, atomlen=%u, skip=%d",
 			             (unsigned int) qmin, (unsigned int) qmax, (unsigned int) atomlen, (int) skip);
 
+			q_pc_atom = pc;
+			q_pc_cont = pc + skip;
 			q = 0;
-			while (q < qmax) {
-				sub_sp = duk__match_regexp(re_ctx, pc, sp);
-				if (!sub_sp) {
-					break;
-				}
-				sp = sub_sp;
-				q++;
-			}
-			while (q >= qmin) {
-				sub_sp = duk__match_regexp(re_ctx, pc + skip, sp);
-				if (sub_sp) {
-					sp = sub_sp;
-					goto match;
-				}
-				if (q == qmin) {
-					break;
-				}
-
-				/* Note: if atom were to contain e.g. captures, we would need to
-				 * re-match the atom to get correct captures.  Simply quantifiers
-				 * do not allow captures in their atom now, so this is not an issue.
-				 */
-
-				DUK_DDDPRINT("greedy quantifier, backtrack %d characters (atomlen)",
-				             atomlen);
-				sp = duk__inp_backtrack(re_ctx, &sp, (duk_uint_fast32_t) atomlen);
-				q--;
-			}
-			goto fail;
+			goto greedy_atom;
 		}
 		case DUK_REOP_SAVE: {
 			duk_uint32_t idx;
-			duk_uint8_t *old;
-			duk_uint8_t *sub_sp;
 
 			idx = duk__bc_get_u32(re_ctx, &pc);
 			if (idx >= re_ctx->nsaved) {
@@ -440,31 +555,17 @@ static duk_uint8_t *duk__match_regexp(duk_re_matcher_ctx *re_ctx, duk_uint8_t *p
 				DUK_DPRINT("internal error, regexp save index insane: idx=%d", (int) idx);
 				goto internal_error;
 			}
-			old = re_ctx->saved[idx];
+			duk__bt_require(re_ctx, 3);
+			DUK__BT_PUSH_PTR(re_ctx, re_ctx->saved[idx]);
+			DUK__BT_PUSH_VAL(re_ctx, idx);
+			DUK__BT_PUSH_VAL(re_ctx, DUK__BT_SAVE);
 			re_ctx->saved[idx] = sp;
-			sub_sp = duk__match_regexp(re_ctx, pc, sp);
-			if (sub_sp) {
-				sp = sub_sp;
-				goto match;
-			}
-			re_ctx->saved[idx] = old;
-			goto fail;
+			break;
 		}
 		case DUK_REOP_WIPERANGE: {
-			/* Wipe capture range and save old values for backtracking.
-			 *
-			 * XXX: this typically happens with a relatively small idx_count.
-			 * It might be useful to handle cases where the count is small
-			 * (say <= 8) by saving the values in stack instead.  This would
-			 * reduce memory churn and improve performance, at the cost of a
-			 * slightly higher code footprint.
-			 */
+			/* Wipe capture range and save old values for backtracking. */
 			duk_uint32_t idx_start, idx_count;
-#ifdef DUK_USE_EXPLICIT_NULL_INIT
 			duk_uint32_t idx_end, idx;
-#endif
-			duk_uint8_t **range_save;
-			duk_uint8_t *sub_sp;
 
 			idx_start = duk__bc_get_u32(re_ctx, &pc);
 			idx_count = duk__bc_get_u32(re_ctx, &pc);
@@ -480,38 +581,16 @@ static duk_uint8_t *duk__match_regexp(duk_re_matcher_ctx *re_ctx, duk_uint8_t *p
 			}
 			DUK_ASSERT(idx_count > 0);
 
-			duk_require_stack((duk_context *) re_ctx->thr, 1);
-			range_save = (duk_uint8_t **) duk_push_fixed_buffer((duk_context *) re_ctx->thr,
-			                                                    sizeof(duk_uint8_t *) * idx_count);
-			DUK_ASSERT(range_save != NULL);
-			DUK_MEMCPY(range_save, re_ctx->saved + idx_start, sizeof(duk_uint8_t *) * idx_count);
-#ifdef DUK_USE_EXPLICIT_NULL_INIT
+			duk__bt_require(re_ctx, (duk_size_t) idx_count + 3);
 			idx_end = idx_start + idx_count;
 			for (idx = idx_start; idx < idx_end; idx++) {
+				DUK__BT_PUSH_PTR(re_ctx, re_ctx->saved[idx]);
 				re_ctx->saved[idx] = NULL;
 			}
-#else
-			DUK_MEMZERO(re_ctx->saved + idx_start, sizeof(duk_uint8_t *) * idx_count);
-#endif
-
-			sub_sp = duk__match_regexp(re_ctx, pc, sp);
-			if (sub_sp) {
-				/* match: keep wiped/resaved values */
-				DUK_DDDPRINT("match: keep wiped/resaved values [%d,%d] (captures [%d,%d])",
-				             (int) idx_start, (int) (idx_start + idx_count - 1),
-			                     idx_start / 2, (idx_start + idx_count - 1) / 2);
-				duk_pop((duk_context *) re_ctx->thr);
-				sp = sub_sp;
-				goto match;
-			}
-
-			/* fail: restore saves */
-			DUK_DDDPRINT("fail: restore wiped/resaved values [%d,%d] (captures [%d,%d])",
-			             (int) idx_start, (int) (idx_start + idx_count - 1),
-			             idx_start / 2, (idx_start + idx_count - 1) / 2);
-			DUK_MEMCPY(re_ctx->saved + idx_start, range_save, sizeof(duk_uint8_t *) * idx_count);
-			duk_pop((duk_context *) re_ctx->thr);
-			goto fail;
+			DUK__BT_PUSH_VAL(re_ctx, idx_start);
+			DUK__BT_PUSH_VAL(re_ctx, idx_count);
+			DUK__BT_PUSH_VAL(re_ctx, DUK__BT_WIPE);
+			break;
 		}
 		case DUK_REOP_LOOKPOS:
 		case DUK_REOP_LOOKNEG: {
@@ -522,51 +601,24 @@ static duk_uint8_t *duk__match_regexp(duk_re_matcher_ctx *re_ctx, duk_uint8_t *p
 			 *  a bit expensive.  Note that the saved array is not needed for just
 			 *  the lookahead sub-match, but for the matching of the entire sequel.
 			 *
-			 *  The temporary save buffer is pushed on to the valstack to handle
-			 *  errors correctly.  Each lookahead causes a C recursion and pushes
-			 *  more stuff on the value stack.  If the C recursion limit is less
-			 *  than the value stack spare, there is no need to check the stack.
-			 *  We do so regardless, just in case.
+			 *  The lookahead body is matched as a sub-match; the copy of the
+			 *  saved array stays in the backtrack stack while the sequel is
+			 *  matched.
 			 */
-
 			duk_int32_t skip;
-			duk_uint8_t **full_save;
-			duk_uint8_t *sub_sp;
 
 			DUK_ASSERT(re_ctx->nsaved > 0);
 
-			duk_require_stack((duk_context *) re_ctx->thr, 1);
-			full_save = (duk_uint8_t **) duk_push_fixed_buffer((duk_context *) re_ctx->thr,
-			                                                   sizeof(duk_uint8_t *) * re_ctx->nsaved);
-			DUK_ASSERT(full_save != NULL);
-			DUK_MEMCPY(full_save, re_ctx->saved, sizeof(duk_uint8_t *) * re_ctx->nsaved);
-
 			skip = duk__bc_get_i32(re_ctx, &pc);
-			sub_sp = duk__match_regexp(re_ctx, pc, sp);
-			if (op == DUK_REOP_LOOKPOS) {
-				if (!sub_sp) {
-					goto lookahead_fail;
-				}
-			} else {
-				if (sub_sp) {
-					goto lookahead_fail;
-				}
-			}
-			sub_sp = duk__match_regexp(re_ctx, pc + skip, sp);
-			if (sub_sp) {
-				/* match: keep saves */
-				duk_pop((duk_context *) re_ctx->thr);
-				sp = sub_sp;
-				goto match;
-			}
-
-			/* fall through */
-
-		 lookahead_fail:
-			/* fail: restore saves */
-			DUK_MEMCPY(re_ctx->saved, full_save, sizeof(duk_uint8_t *) * re_ctx->nsaved);
-			duk_pop((duk_context *) re_ctx->thr);
-			goto fail;
+			duk__bt_require(re_ctx, (duk_size_t) re_ctx->nsaved + 5);
+			duk__bt_push_saved_copy(re_ctx);
+			DUK__BT_PUSH_PTR(re_ctx, pc + skip);
+			DUK__BT_PUSH_PTR(re_ctx, sp);
+			DUK__BT_PUSH_VAL(re_ctx, op);
+			DUK__BT_PUSH_SIZE(re_ctx, re_ctx->sub_top);
+			DUK__BT_PUSH_VAL(re_ctx, DUK__BT_SUB_LOOK);
+			re_ctx->sub_top = re_ctx->bt_top;
+			break;
 		}
 		case DUK_REOP_BACKREFERENCE: {
 			/*
@@ -626,34 +678,699 @@ static duk_uint8_t *duk__match_regexp(duk_re_matcher_ctx *re_ctx, duk_uint8_t *p
 			goto internal_error;
 		}
 		}
+		continue;
+
+		/*
+		 *  Quantifier loops.  The state is in q_pc_atom, q_pc_cont, q, qmin,
+		 *  qmax, and atomlen (greedy only).
+		 */
+
+	 greedy_atom:
+		/* Match the atom greedily as many times as possible (E5 Section
+		 * 15.10.2.5, RepeatMatcher); each atom is a sub-match.
+		 */
+		if (q < qmax) {
+			duk__bt_require(re_ctx, 9);
+			DUK__BT_PUSH_PTR(re_ctx, q_pc_atom);
+			DUK__BT_PUSH_PTR(re_ctx, q_pc_cont);
+			DUK__BT_PUSH_PTR(re_ctx, sp);
+			DUK__BT_PUSH_VAL(re_ctx, q);
+			DUK__BT_PUSH_VAL(re_ctx, qmin);
+			DUK__BT_PUSH_VAL(re_ctx, qmax);
+			DUK__BT_PUSH_VAL(re_ctx, atomlen);
+			DUK__BT_PUSH_SIZE(re_ctx, re_ctx->sub_top);
+			DUK__BT_PUSH_VAL(re_ctx, DUK__BT_SUB_GREEDY);
+			re_ctx->sub_top = re_ctx->bt_top;
+			pc = q_pc_atom;
+			continue;
+		}
+		/* fall through */
+
+	 greedy_sequel:
+		/* Try the sequel with q atoms matched; on failure, backtrack one
+		 * atom (by its fixed character length) and retry.
+		 *
+		 * Note: if atom were to contain e.g. captures, we would need to
+		 * re-match the atom to get correct captures.  Simple quantifiers
+		 * do not allow captures in their atom now, so this is not an issue.
+		 */
+		if (q < qmin) {
+			goto fail;
+		}
+		duk__bt_require(re_ctx, 6);
+		DUK__BT_PUSH_PTR(re_ctx, q_pc_cont);
+		DUK__BT_PUSH_PTR(re_ctx, sp);
+		DUK__BT_PUSH_VAL(re_ctx, q);
+		DUK__BT_PUSH_VAL(re_ctx, qmin);
+		DUK__BT_PUSH_VAL(re_ctx, atomlen);
+		DUK__BT_PUSH_VAL(re_ctx, DUK__BT_GREEDY);
+		pc = q_pc_cont;
+		continue;
+
+	 minimal_step:
+		/* Try the sequel first if q >= qmin, then one more atom. */
+		if (q > qmax) {
+			goto fail;
+		}
+		if (q >= qmin) {
+			duk__bt_require(re_ctx, 7);
+			DUK__BT_PUSH_PTR(re_ctx, q_pc_atom);
+			DUK__BT_PUSH_PTR(re_ctx, q_pc_cont);
+			DUK__BT_PUSH_PTR(re_ctx, sp);
+			DUK__BT_PUSH_VAL(re_ctx, q);
+			DUK__BT_PUSH_VAL(re_ctx, qmin);
+			DUK__BT_PUSH_VAL(re_ctx, qmax);
+			DUK__BT_PUSH_VAL(re_ctx, DUK__BT_MINIMAL);
+			pc = q_pc_cont;
+			continue;
+		}
+		/* fall through */
+
+	 minimal_atom:
+		duk__bt_require(re_ctx, 8);
+		DUK__BT_PUSH_PTR(re_ctx, q_pc_atom);
+		DUK__BT_PUSH_PTR(re_ctx, q_pc_cont);
+		DUK__BT_PUSH_PTR(re_ctx, sp);
+		DUK__BT_PUSH_VAL(re_ctx, q);
+		DUK__BT_PUSH_VAL(re_ctx, qmin);
+		DUK__BT_PUSH_VAL(re_ctx, qmax);
+		DUK__BT_PUSH_SIZE(re_ctx, re_ctx->sub_top);
+		DUK__BT_PUSH_VAL(re_ctx, DUK__BT_SUB_MINIMAL);
+		re_ctx->sub_top = re_ctx->bt_top;
+		pc = q_pc_atom;
+		continue;
+
+		/*
+		 *  Match: either the entire regexp or a sub-match has matched.
+		 */
+
+	 match:
+		if (re_ctx->sub_top == 0) {
+			return sp;
+		}
+
+		/* Discard backtrack entries of the sub-match. */
+		re_ctx->bt_top = re_ctx->sub_top;
+		switch ((duk_small_int_t) DUK__BT_POP_VAL(re_ctx)) {
+		case DUK__BT_SUB_GREEDY: {
+			re_ctx->sub_top = DUK__BT_POP_SIZE(re_ctx);
+			atomlen = DUK__BT_POP_VAL(re_ctx);
+			qmax = DUK__BT_POP_VAL(re_ctx);
+			qmin = DUK__BT_POP_VAL(re_ctx);
+			q = DUK__BT_POP_VAL(re_ctx);
+			(void) DUK__BT_POP_PTR(re_ctx);  /* sp before atom */
+			q_pc_cont = DUK__BT_POP_PTR(re_ctx);
+			q_pc_atom = DUK__BT_POP_PTR(re_ctx);
+			q++;
+			goto greedy_atom;
+		}
+		case DUK__BT_SUB_MINIMAL: {
+			re_ctx->sub_top = DUK__BT_POP_SIZE(re_ctx);
+			qmax = DUK__BT_POP_VAL(re_ctx);
+			qmin = DUK__BT_POP_VAL(re_ctx);
+			q = DUK__BT_POP_VAL(re_ctx);
+			(void) DUK__BT_POP_PTR(re_ctx);  /* sp before atom */
+			q_pc_cont = DUK__BT_POP_PTR(re_ctx);
+			q_pc_atom = DUK__BT_POP_PTR(re_ctx);
+			q++;
+			goto minimal_step;
+		}
+		case DUK__BT_SUB_LOOK: {
+			re_ctx->sub_top = DUK__BT_POP_SIZE(re_ctx);
+			op = (duk_small_int_t) DUK__BT_POP_VAL(re_ctx);
+			sp = DUK__BT_POP_PTR(re_ctx);  /* lookahead doesn't consume input */
+			pc = DUK__BT_POP_PTR(re_ctx);
+			if (op == DUK_REOP_LOOKNEG) {
+				duk__bt_restore_saved_copy(re_ctx);
+				re_ctx->bt_top -= re_ctx->nsaved;
+				goto fail;
+			}
+			/* Positive lookahead: keep captures but restore them if
+			 * the sequel fails.
+			 */
+			DUK__BT_PUSH_VAL(re_ctx, DUK__BT_RESTORE_ALL);
+			continue;
+		}
+		default: {
+			DUK_DPRINT("internal error, regexp sub-match entry insane");
+			goto internal_error;
+		}
+		}
+
+		/*
+		 *  Fail: backtrack until a resumable entry is found.
+		 */
+
+	 fail:
+		for (;;) {
+			if (re_ctx->bt_top == 0) {
+				return NULL;
+			}
+
+			switch ((duk_small_int_t) DUK__BT_POP_VAL(re_ctx)) {
+			case DUK__BT_SPLIT: {
+				sp = DUK__BT_POP_PTR(re_ctx);
+				pc = DUK__BT_POP_PTR(re_ctx);
+				goto resume;
+			}
+			case DUK__BT_SAVE: {
+				duk_uint32_t idx;
+
+				idx = DUK__BT_POP_VAL(re_ctx);
+				DUK_ASSERT(idx < re_ctx->nsaved);
+				re_ctx->saved[idx] = DUK__BT_POP_PTR(re_ctx);
+				break;
+			}
+			case DUK__BT_WIPE: {
+				duk_uint32_t idx_start, idx_count;
+
+				idx_count = DUK__BT_POP_VAL(re_ctx);
+				idx_start = DUK__BT_POP_VAL(re_ctx);
+				DUK_ASSERT(idx_start + idx_count <= re_ctx->nsaved);
+				DUK_ASSERT(re_ctx->bt_top >= idx_count);
+				re_ctx->bt_top -= idx_count;
+				DUK_MEMCPY((void *) (re_ctx->saved + idx_start),
+				           (void *) (re_ctx->bt + re_ctx->bt_top),
+				           sizeof(duk_uint8_t *) * idx_count);
+				break;
+			}
+			case DUK__BT_RESTORE_ALL: {
+				duk__bt_restore_saved_copy(re_ctx);
+				re_ctx->bt_top -= re_ctx->nsaved;
+				break;
+			}
+			case DUK__BT_GREEDY: {
+				atomlen = DUK__BT_POP_VAL(re_ctx);
+				qmin = DUK__BT_POP_VAL(re_ctx);
+				q = DUK__BT_POP_VAL(re_ctx);
+				sp = DUK__BT_POP_PTR(re_ctx);
+				q_pc_cont = DUK__BT_POP_PTR(re_ctx);
+				if (q == qmin) {
+					break;
+				}
+				DUK_DDDPRINT("greedy quantifier, backtrack %d characters (atomlen)",
+				             atomlen);
+				sp = duk__inp_backtrack(re_ctx, &sp, (duk_uint_fast32_t) atomlen);
+				q--;
+				goto greedy_sequel;
+			}
+			case DUK__BT_MINIMAL: {
+				qmax = DUK__BT_POP_VAL(re_ctx);
+				qmin = DUK__BT_POP_VAL(re_ctx);
+				q = DUK__BT_POP_VAL(re_ctx);
+				sp = DUK__BT_POP_PTR(re_ctx);
+				q_pc_cont = DUK__BT_POP_PTR(re_ctx);
+				q_pc_atom = DUK__BT_POP_PTR(re_ctx);
+				goto minimal_atom;
+			}
+			case DUK__BT_SUB_GREEDY: {
+				/* atom failed: match the sequel with the atoms so far */
+				re_ctx->sub_top = DUK__BT_POP_SIZE(re_ctx);
+				atomlen = DUK__BT_POP_VAL(re_ctx);
+				qmax = DUK__BT_POP_VAL(re_ctx);
+				qmin = DUK__BT_POP_VAL(re_ctx);
+				q = DUK__BT_POP_VAL(re_ctx);
+				sp = DUK__BT_POP_PTR(re_ctx);
+				q_pc_cont = DUK__BT_POP_PTR(re_ctx);
+				q_pc_atom = DUK__BT_POP_PTR(re_ctx);
+				goto greedy_sequel;
+			}
+			case DUK__BT_SUB_MINIMAL: {
+				/* atom failed: the whole quantifier fails */
+				re_ctx->sub_top = DUK__BT_POP_SIZE(re_ctx);
+				re_ctx->bt_top -= 6;
+				break;
+			}
+			case DUK__BT_SUB_LOOK: {
+				re_ctx->sub_top = DUK__BT_POP_SIZE(re_ctx);
+				op = (duk_small_int_t) DUK__BT_POP_VAL(re_ctx);
+				sp = DUK__BT_POP_PTR(re_ctx);
+				pc = DUK__BT_POP_PTR(re_ctx);
+				duk__bt_restore_saved_copy(re_ctx);
+				if (op == DUK_REOP_LOOKNEG) {
+					/* Negative lookahead: match the sequel, restoring
+					 * captures if it fails.
+					 */
+					DUK__BT_PUSH_VAL(re_ctx, DUK__BT_RESTORE_ALL);
+					goto resume;
+				}
+				re_ctx->bt_top -= re_ctx->nsaved;
+				break;
+			}
+			default: {
+				DUK_DPRINT("internal error, regexp backtrack entry insane");
+				goto internal_error;
+			}
+			}
+		}
+
+	 resume:
+		;
 	}
 
- match:
-	re_ctx->recursion_depth--;
+ internal_error:
+	DUK_ERROR(re_ctx->thr, DUK_ERR_INTERNAL_ERROR, "regexp internal error");
+	return NULL;  /* never here */
+}
+
+/*
+ *  Prefilter (see doc/regexp.txt).
+ *
+ *  Returns the first position at or after 'sp' where a match may start,
+ *  NULL if there is none.
+ */
+
+static duk_uint8_t *duk__prefilter_skip(duk_re_matcher_ctx *re_ctx, duk_uint8_t *sp) {
+	duk_uint32_t pf_flags = re_ctx->pf_flags;
+
+	if (pf_flags & DUK_RE_PREFILTER_ANCHORED) {
+		if (sp != re_ctx->input) {
+			DUK_DDDPRINT("anchored regexp, no match after input start");
+			return NULL;
+		}
+	} else if (pf_flags & DUK_RE_PREFILTER_PREFIX) {
+		sp = duk_util_memsearch(sp, (duk_size_t) (re_ctx->input_end - sp), re_ctx->pf_lit, re_ctx->pf_lit_len);
+		if (sp == NULL) {
+			DUK_DDDPRINT("prefix not found");
+			return NULL;
+		}
+	} else if (pf_flags & DUK_RE_PREFILTER_FIRSTSET) {
+		duk_uint8_t *p_end;
+		duk_uint8_t t;
+
+		/* 0x80-0xbf are never in the set, so that a matching
+		 * byte always starts a character.
+		 */
+		p_end = re_ctx->input_end;
+		while (sp < p_end) {
+			t = *sp;
+			if (re_ctx->pf_firstset[t >> 5] & ((duk_uint32_t) 1 << (t & 0x1f))) {
+				break;
+			}
+			sp++;
+		}
+		if (sp >= p_end) {
+			DUK_DDDPRINT("no first character found");
+			return NULL;
+		}
+	}
+	if (pf_flags & DUK_RE_PREFILTER_REQUIRED) {
+		if (re_ctx->pf_req == NULL || re_ctx->pf_req < sp) {
+			re_ctx->pf_req = duk_util_memsearch(sp, (duk_size_t) (re_ctx->input_end - sp), re_ctx->pf_lit, re_ctx->pf_lit_len);
+			if (re_ctx->pf_req == NULL) {
+				DUK_DDDPRINT("required literal not found");
+				return NULL;
+			}
+		}
+	}
 	return sp;
+}
 
- fail:
-	re_ctx->recursion_depth--;
-	return NULL;
+#if defined(DUK_USE_REGEXP_AUTOMATON)
+/*
+ *  Automaton matcher (see doc/regexp.txt).
+ *
+ *  Used for regexps compiled with DUK_RE_FLAG_AUTOMATON, which have no
+ *  backreferences, lookaheads or simple quantifiers.  Instead of trying
+ *  alternatives one at a time, all of them are followed in parallel (a
+ *  "Pike VM"): a thread list contains a thread for each character matching
+ *  instruction waiting for the current input character, together with the
+ *  captures of that thread, in the order in which backtracking would try
+ *  them.  Because the future of a thread depends only on its pc and the
+ *  input position, only the first (highest priority) thread reaching each
+ *  pc at a certain position is kept.  The result is the same as with
+ *  backtracking, but each input character is examined at most once per
+ *  instruction.
+ *
+ *  A thread for a new match attempt is started at each candidate position,
+ *  with the lowest priority, until some thread matches.  When a thread
+ *  matches, lower priority threads are dropped, and matching continues
+ *  until the higher priority threads have failed or matched.
+ *
+ *  Non-character instructions are followed when threads are added, using
+ *  the backtrack stack for pending alternatives (SPLIT entries) and for
+ *  undoing capture updates (SAVE and WIPE entries).
+ */
+
+typedef struct {
+	duk_uint8_t **threads;  /* per thread: pc, saved[nsaved] */
+	duk_uint32_t count;
+} duk__re_threadlist;
+
+/* Add threads reachable from 'pc' at input position 'sp' to 'list', with
+ * re_ctx->saved[] as the initial captures.  Returns 1 if a match was
+ * reached, with its captures copied to 'match_saved'.  The backtrack stack
+ * and saved[] are left in an undefined state.
+ */
+static duk_small_int_t duk__pike_add_thread(duk_re_matcher_ctx *re_ctx, duk__re_threadlist *list, duk_uint8_t *pc, duk_uint8_t *sp, duk_uint8_t **match_saved) {
+	duk_uint32_t tag;
+
+	DUK_ASSERT(re_ctx->bt_top == 0);
+
+	for (;;) {
+		for (;;) {
+			duk_uint8_t *op_pc;
+			duk_small_int_t op;
+			duk_size_t off;
+
+			if (pc < re_ctx->bytecode || pc >= re_ctx->bytecode_end) {
+				DUK_DPRINT("internal error, regexp pc out of bounds");
+				goto internal_error;
+			}
+			off = (duk_size_t) (pc - re_ctx->bytecode);
+			if (re_ctx->visited[off] == re_ctx->visit_gen) {
+				/* reached already by a higher priority thread */
+				goto next;
+			}
+			re_ctx->visited[off] = re_ctx->visit_gen;
+
+			if (re_ctx->steps_count >= re_ctx->steps_limit) {
+				DUK_ERROR(re_ctx->thr, DUK_ERR_RANGE_ERROR, "regexp step limit");
+			}
+			re_ctx->steps_count++;
+
+			op_pc = pc;
+			op = (duk_small_int_t) duk__bc_get_u32(re_ctx, &pc);
+
+			switch (op) {
+			case DUK_REOP_MATCH: {
+				DUK_MEMCPY((void *) match_saved, (void *) re_ctx->saved,
+				           sizeof(duk_uint8_t *) * re_ctx->nsaved);
+				return 1;
+			}
+			case DUK_REOP_CHAR:
+			case DUK_REOP_PERIOD:
+			case DUK_REOP_RANGES:
+			case DUK_REOP_INVRANGES: {
+				duk_uint8_t **t;
+
+				if (list->count >= re_ctx->nthreads) {
+					DUK_DPRINT("internal error, regexp thread list full");
+					goto internal_error;
+				}
+				t = list->threads + (duk_size_t) list->count * (re_ctx->nsaved + 1);
+				t[0] = op_pc;
+				DUK_MEMCPY((void *) (t + 1), (void *) re_ctx->saved,
+				           sizeof(duk_uint8_t *) * re_ctx->nsaved);
+				list->count++;
+				goto next;
+			}
+			case DUK_REOP_ASSERT_START:
+			case DUK_REOP_ASSERT_END:
+			case DUK_REOP_ASSERT_WORD_BOUNDARY:
+			case DUK_REOP_ASSERT_NOT_WORD_BOUNDARY: {
+				if (!duk__check_assertion(re_ctx, op, sp)) {
+					goto next;
+				}
+				break;
+			}
+			case DUK_REOP_JUMP: {
+				duk_int32_t skip;
+
+				skip = duk__bc_get_i32(re_ctx, &pc);
+				pc += skip;
+				break;
+			}
+			case DUK_REOP_SPLIT1: {
+				/* split1: prefer direct execution (no jump) */
+				duk_int32_t skip;
+
+				skip = duk__bc_get_i32(re_ctx, &pc);
+				duk__bt_require(re_ctx, 3);
+				DUK__BT_PUSH_PTR(re_ctx, pc + skip);
+				DUK__BT_PUSH_PTR(re_ctx, sp);
+				DUK__BT_PUSH_VAL(re_ctx, DUK__BT_SPLIT);
+				break;
+			}
+			case DUK_REOP_SPLIT2: {
+				/* split2: prefer jump execution (not direct) */
+				duk_int32_t skip;
+
+				skip = duk__bc_get_i32(re_ctx, &pc);
+				duk__bt_require(re_ctx, 3);
+				DUK__BT_PUSH_PTR(re_ctx, pc);
+				DUK__BT_PUSH_PTR(re_ctx, sp);
+				DUK__BT_PUSH_VAL(re_ctx, DUK__BT_SPLIT);
+				pc += skip;
+				break;
+			}
+			case DUK_REOP_SAVE: {
+				duk_uint32_t idx;
+
+				idx = duk__bc_get_u32(re_ctx, &pc);
+				if (idx >= re_ctx->nsaved) {
+					DUK_DPRINT("internal error, regexp save index insane: idx=%d", (int) idx);
+					goto internal_error;
+				}
+				duk__bt_require(re_ctx, 3);
+				DUK__BT_PUSH_PTR(re_ctx, re_ctx->saved[idx]);
+				DUK__BT_PUSH_VAL(re_ctx, idx);
+				DUK__BT_PUSH_VAL(re_ctx, DUK__BT_SAVE);
+				re_ctx->saved[idx] = sp;
+				break;
+			}
+			case DUK_REOP_WIPERANGE: {
+				duk_uint32_t idx_start, idx_count;
+				duk_uint32_t idx_end, idx;
+
+				idx_start = duk__bc_get_u32(re_ctx, &pc);
+				idx_count = duk__bc_get_u32(re_ctx, &pc);
+				if (idx_start + idx_count > re_ctx->nsaved || idx_count == 0) {
+					DUK_DPRINT("internal error, regexp wipe indices insane: idx_start=%d, idx_count=%d",
+					           (int) idx_start, (int) idx_count);
+					goto internal_error;
+				}
+
+				duk__bt_require(re_ctx, (duk_size_t) idx_count + 3);
+				idx_end = idx_start + idx_count;
+				for (idx = idx_start; idx < idx_end; idx++) {
+					DUK__BT_PUSH_PTR(re_ctx, re_ctx->saved[idx]);
+					re_ctx->saved[idx] = NULL;
+				}
+				DUK__BT_PUSH_VAL(re_ctx, idx_start);
+				DUK__BT_PUSH_VAL(re_ctx, idx_count);
+				DUK__BT_PUSH_VAL(re_ctx, DUK__BT_WIPE);
+				break;
+			}
+			default: {
+				DUK_DPRINT("internal error, regexp opcode not allowed in automaton: %d", (int) op);
+				goto internal_error;
+			}
+			}
+		}
+
+	 next:
+		/* Continue with the next pending alternative, undoing capture
+		 * updates made after it was pushed.
+		 */
+		for (;;) {
+			if (re_ctx->bt_top == 0) {
+				return 0;
+			}
+			tag = DUK__BT_POP_VAL(re_ctx);
+			if (tag == DUK__BT_SPLIT) {
+				(void) DUK__BT_POP_PTR(re_ctx);  /* sp, same for all alternatives */
+				pc = DUK__BT_POP_PTR(re_ctx);
+				break;
+			} else if (tag == DUK__BT_SAVE) {
+				duk_uint32_t idx;
+
+				idx = DUK__BT_POP_VAL(re_ctx);
+				DUK_ASSERT(idx < re_ctx->nsaved);
+				re_ctx->saved[idx] = DUK__BT_POP_PTR(re_ctx);
+			} else {
+				duk_uint32_t idx_start, idx_count;
+
+				DUK_ASSERT(tag == DUK__BT_WIPE);
+				idx_count = DUK__BT_POP_VAL(re_ctx);
+				idx_start = DUK__BT_POP_VAL(re_ctx);
+				DUK_ASSERT(idx_start + idx_count <= re_ctx->nsaved);
+				DUK_ASSERT(re_ctx->bt_top >= idx_count);
+				re_ctx->bt_top -= idx_count;
+				DUK_MEMCPY((void *) (re_ctx->saved + idx_start),
+				           (void *) (re_ctx->bt + re_ctx->bt_top),
+				           sizeof(duk_uint8_t *) * idx_count);
+			}
+		}
+	}
 
  internal_error:
 	DUK_ERROR(re_ctx->thr, DUK_ERR_INTERNAL_ERROR, "regexp internal error");
-	return NULL;  /* never here */
+	return 0;  /* never here */
 }
 
+/* Match starting from 'sp' (unanchored).  Returns 1 on match, with the
+ * captures of the match in re_ctx->saved[], 0 otherwise.  The backtrack
+ * stack must exist (it may be resized).
+ */
+static duk_small_int_t duk__match_automaton(duk_re_matcher_ctx *re_ctx, duk_uint8_t *sp) {
+	duk_context *ctx = (duk_context *) re_ctx->thr;
+	duk__re_threadlist list1, list2;
+	duk__re_threadlist *clist, *nlist, *tmp_list;
+	duk_uint8_t **match_saved;
+	duk_uint8_t *cand;
+	duk_uint8_t *next_sp;
+	duk_size_t entry_size;
+	duk_size_t bc_len;
+	duk_size_t alloc_size;
+	duk_uint32_t i;
+	duk_small_int_t matched = 0;
+
+	/*
+	 *  Allocate thread lists, match captures, and visited generations
+	 *  from a single fixed buffer (automatically zeroed).
+	 */
+
+	entry_size = (duk_size_t) re_ctx->nsaved + 1;
+	if (re_ctx->nthreads > DUK_RE_AUTOMATON_MAX_SLOTS / entry_size) {
+		DUK_DPRINT("internal error, regexp automaton thread count insane: %d", (int) re_ctx->nthreads);
+		DUK_ERROR(re_ctx->thr, DUK_ERR_INTERNAL_ERROR, "regexp internal error");
+	}
+	bc_len = (duk_size_t) (re_ctx->bytecode_end - re_ctx->bytecode);
+	alloc_size = sizeof(duk_uint8_t *) * (2 * entry_size * re_ctx->nthreads + re_ctx->nsaved) +
+	             sizeof(duk_uint32_t) * bc_len;
+	duk_push_fixed_buffer(ctx, alloc_size);
+	list1.threads = (duk_uint8_t **) duk_get_buffer(ctx, -1, NULL);
+	DUK_ASSERT(list1.threads != NULL);
+	list1.count = 0;
+	list2.threads = list1.threads + entry_size * re_ctx->nthreads;
+	list2.count = 0;
+	match_saved = list2.threads + entry_size * re_ctx->nthreads;
+	re_ctx->visited = (duk_uint32_t *) (match_saved + re_ctx->nsaved);
+	re_ctx->visit_gen = 1;
+	clist = &list1;
+	nlist = &list2;
+
+	DUK_DDDPRINT("automaton match: nthreads=%d, nsaved=%d, alloc_size=%d",
+	             (int) re_ctx->nthreads, (int) re_ctx->nsaved, (int) alloc_size);
+
+	/*
+	 *  Match loop, one input character per round.  'clist' contains the
+	 *  threads at position 'sp', 'cand' is the next position at or after
+	 *  'sp' where a match attempt can start (NULL if none).
+	 */
+
+	cand = duk__prefilter_skip(re_ctx, sp);
+
+	for (;;) {
+		duk_codepoint_t c;
+		duk_codepoint_t c_raw;  /* for RANGES/INVRANGES */
+
+		if (!matched && cand == sp) {
+			/* start a new match attempt with the lowest priority */
+			DUK_MEMZERO((void *) re_ctx->saved, sizeof(duk_uint8_t *) * re_ctx->nsaved);
+			re_ctx->bt_top = 0;
+			if (duk__pike_add_thread(re_ctx, clist, re_ctx->bytecode, sp, match_saved)) {
+				matched = 1;
+			}
+		}
+
+		if (clist->count == 0) {
+			if (matched || cand == NULL) {
+				break;
+			}
+			if (cand > sp) {
+				/* no threads alive: skip directly to the next candidate */
+				sp = cand;
+				re_ctx->visit_gen++;
+				continue;
+			}
+		}
+
+		if (sp >= re_ctx->input_end) {
+			break;
+		}
+
+		next_sp = sp;
+		c = c_raw = duk__inp_get_raw_cp(re_ctx, &next_sp);
+		if (re_ctx->re_flags & DUK_RE_FLAG_IGNORE_CASE) {
+			c = duk_unicode_re_canonicalize_char(re_ctx->thr, c);
+		}
+		re_ctx->visit_gen++;
+		nlist->count = 0;
+
+		for (i = 0; i < clist->count; i++) {
+			duk_uint8_t **t;
+			duk_uint8_t *pc;
+			duk_small_int_t op;
+			duk_small_int_t ok;
+
+			if (re_ctx->steps_count >= re_ctx->steps_limit) {
+				DUK_ERROR(re_ctx->thr, DUK_ERR_RANGE_ERROR, "regexp step limit");
+			}
+			re_ctx->steps_count++;
+
+			t = clist->threads + (duk_size_t) i * entry_size;
+			pc = t[0];
+			op = (duk_small_int_t) duk__bc_get_u32(re_ctx, &pc);
+			switch (op) {
+			case DUK_REOP_CHAR:
+				/* both canonicalized if case insensitive */
+				ok = ((duk_codepoint_t) duk__bc_get_u32(re_ctx, &pc) == c);
+				break;
+			case DUK_REOP_PERIOD:
+				/* E5 Sections 15.10.2.8, 7.3 */
+				ok = !duk_unicode_is_line_terminator(c);
+				break;
+			case DUK_REOP_RANGES:
+				ok = duk__match_ranges(re_ctx, &pc, c_raw);
+				break;
+			default:
+				DUK_ASSERT(op == DUK_REOP_INVRANGES);
+				ok = !duk__match_ranges(re_ctx, &pc, c_raw);
+				break;
+			}
+			if (!ok) {
+				continue;
+			}
+
+			DUK_MEMCPY((void *) re_ctx->saved, (void *) (t + 1),
+			           sizeof(duk_uint8_t *) * re_ctx->nsaved);
+			re_ctx->bt_top = 0;
+			if (duk__pike_add_thread(re_ctx, nlist, pc, next_sp, match_saved)) {
+				/* drop lower priority threads */
+				matched = 1;
+				break;
+			}
+		}
+
+		tmp_list = clist;
+		clist = nlist;
+		nlist = tmp_list;
+		sp = next_sp;
+
+		if (!matched && cand != NULL && cand < sp) {
+			cand = duk__prefilter_skip(re_ctx, sp);
+		}
+	}
+
+	if (matched) {
+		DUK_MEMCPY((void *) re_ctx->saved, (void *) match_saved,
+		           sizeof(duk_uint8_t *) * re_ctx->nsaved);
+	}
+	re_ctx->visited = NULL;
+	duk_pop(ctx);
+	return matched;
+}
+#endif  /* DUK_USE_REGEXP_AUTOMATON */
+
 /*
  *  Exposed matcher function which provides the semantics of RegExp.prototype.exec().
  *
  *  RegExp.prototype.test() has the same semantics as exec() but does not return the
- *  result object (which contains the matching string and capture groups).  Currently
- *  there is no separate test() helper, so a temporary result object is created and
- *  discarded if test() is needed.  This is intentional, to save code space.
+ *  result object (which contains the matching string and capture groups).  When
+ *  'out_bounds' is non-NULL, the result object is not created: only the match
+ *  bounds are written to 'out_bounds' and the match status is returned.  This is
+ *  used by test(), search(), and split() (when the regexp has no captures), and
+ *  avoids interning the match and capture substrings.  lastIndex is updated in
+ *  the same way in both cases.
  *
  *  Input stack:  [ ... re_obj input ]
- *  Output stack: [ ... result ]
+ *  Output stack: [ ... result ]  (out_bounds == NULL)
+ *                [ ... ]         (out_bounds != NULL)
  */
 
-static void duk__regexp_match_helper(duk_hthread *thr, duk_small_int_t force_global) {
+static duk_small_int_t duk__regexp_match_helper(duk_hthread *thr, duk_small_int_t force_global, duk_re_match_bounds *out_bounds) {
 	duk_context *ctx = (duk_context *) thr;
 	duk_re_matcher_ctx re_ctx;
 	duk_hobject *h_regexp;
@@ -688,6 +1405,12 @@ static void duk__regexp_match_helper(duk_hthread *thr, duk_small_int_t force_glo
 	h_input = duk_get_hstring(ctx, -1);
 	DUK_ASSERT(h_input != NULL);
 
+	/* A slice input may be flattened by mark-and-sweep when the backtrack
+	 * stack is resized, which would invalidate 'sp' and saved[].  Flatten
+	 * it here so that the input data pointer stays stable.
+	 */
+	DUK_HSTRING_FLATTEN(thr, h_input);
+
 	duk_get_prop_stridx(ctx, -2, DUK_STRIDX_INT_BYTECODE);  /* [ ... re_obj input ] -> [ ... re_obj input bc ] */
 	h_bytecode = duk_require_hstring(ctx, -1);  /* no regexp instance should exist without a non-configurable bytecode property */
 	DUK_ASSERT(h_bytecode != NULL);
@@ -700,6 +1423,14 @@ static void duk__regexp_match_helper(duk_hthread *thr, duk_small_int_t force_glo
 	 *
 	 *    uint   flags
 	 *    uint   nsaved (even, 2n+2 where n = num captures)
+	 *    uint   max threads per thread list (if AUTOMATON flag)
+	 *    uint   prefilter flags
+	 *    uint   literal length n (if PREFIX or REQUIRED)
+	 *    uint   literal characters [n] (if PREFIX or REQUIRED)
+	 *    uint   first byte bitmap [8] (if FIRSTSET)
+	 *
+	 *  Because the literal characters are encoded like input characters,
+	 *  the literal can be searched for directly from the bytecode.
 	 */
 
 	/* [ ... re_obj input bc ] */
@@ -709,16 +1440,35 @@ static void duk__regexp_match_helper(duk_hthread *thr, duk_small_int_t force_glo
 	re_ctx.thr = thr;
 	re_ctx.input = (duk_uint8_t *) DUK_HSTRING_GET_DATA(h_input);
 	re_ctx.input_end = re_ctx.input + DUK_HSTRING_GET_BYTELEN(h_input);
+	re_ctx.input_ascii = DUK_HSTRING_HAS_ASCII(h_input) ? 1 : 0;
 	re_ctx.bytecode = (duk_uint8_t *) DUK_HSTRING_GET_DATA(h_bytecode);
 	re_ctx.bytecode_end = re_ctx.bytecode + DUK_HSTRING_GET_BYTELEN(h_bytecode);
 	re_ctx.saved = NULL;
-	re_ctx.recursion_limit = DUK_RE_EXECUTE_RECURSION_LIMIT;
+	re_ctx.bt_limit = DUK_RE_EXECUTE_BACKTRACK_LIMIT;
 	re_ctx.steps_limit = DUK_RE_EXECUTE_STEPS_LIMIT;
 
 	/* read header */
 	pc = re_ctx.bytecode;
 	re_ctx.re_flags = duk__bc_get_u32(&re_ctx, &pc);
 	re_ctx.nsaved = duk__bc_get_u32(&re_ctx, &pc);
+	if (re_ctx.re_flags & DUK_RE_FLAG_AUTOMATON) {
+		re_ctx.nthreads = duk__bc_get_u32(&re_ctx, &pc);
+	}
+	re_ctx.pf_flags = duk__bc_get_u32(&re_ctx, &pc);
+	if (re_ctx.pf_flags & (DUK_RE_PREFILTER_PREFIX | DUK_RE_PREFILTER_REQUIRED)) {
+		i = (duk_uint_fast32_t) duk__bc_get_u32(&re_ctx, &pc);
+		re_ctx.pf_lit = pc;
+		while (i > 0) {
+			(void) duk__bc_get_u32(&re_ctx, &pc);
+			i--;
+		}
+		re_ctx.pf_lit_len = (duk_size_t) (pc - re_ctx.pf_lit);
+	}
+	if (re_ctx.pf_flags & DUK_RE_PREFILTER_FIRSTSET) {
+		for (i = 0; i < 8; i++) {
+			re_ctx.pf_firstset[i] = duk__bc_get_u32(&re_ctx, &pc);
+		}
+	}
 	re_ctx.bytecode = pc;
 
 	DUK_ASSERT(DUK_RE_FLAG_GLOBAL < 0x10000UL);  /* must fit into duk_small_int_t */
@@ -740,8 +1490,8 @@ static void duk__regexp_match_helper(duk_hthread *thr, duk_small_int_t force_glo
 	}
 #endif
 
-	DUK_DDDPRINT("regexp ctx initialized, flags=0x%08x, nsaved=%d, recursion_limit=%d, steps_limit=%d",
-	             (unsigned int) re_ctx.re_flags, (int) re_ctx.nsaved, (int) re_ctx.recursion_limit,
+	DUK_DDDPRINT("regexp ctx initialized, flags=0x%08x, nsaved=%d, bt_limit=%d, steps_limit=%d",
+	             (unsigned int) re_ctx.re_flags, (int) re_ctx.nsaved, (int) re_ctx.bt_limit,
 	             (int) re_ctx.steps_limit);
 
 	/*
@@ -795,15 +1545,54 @@ static void duk__regexp_match_helper(duk_hthread *thr, duk_small_int_t force_glo
 
 	/* [ ... re_obj input bc saved_buf ] */
 
+	(void) duk_push_dynamic_buffer(ctx, sizeof(duk_re_btslot) * DUK__BT_INITIAL_SLOTS);
+	re_ctx.bt_buf = (duk_hbuffer_dynamic *) duk_get_hbuffer(ctx, -1);
+	DUK_ASSERT(re_ctx.bt_buf != NULL);
+	re_ctx.bt = (duk_re_btslot *) DUK_HBUFFER_DYNAMIC_GET_CURR_DATA_PTR(re_ctx.bt_buf);
+	re_ctx.bt_size = DUK__BT_INITIAL_SLOTS;
+
+	/* [ ... re_obj input bc saved_buf bt_buf ] */
+
 	DUK_ASSERT(match == 0);
 
+#if defined(DUK_USE_REGEXP_AUTOMATON)
+	if (re_ctx.re_flags & DUK_RE_FLAG_AUTOMATON) {
+		/* all match positions are handled in one pass */
+		if (duk__match_automaton(&re_ctx, sp)) {
+			DUK_ASSERT(re_ctx.saved[0] >= sp);
+			char_offset += duk__count_chars(&re_ctx, sp, re_ctx.saved[0]);
+			DUK_DDDPRINT("automaton match at offset %d", (int) char_offset);
+			match = 1;
+		}
+		goto matcher_done;
+	}
+#endif
+
 	for (;;) {
+		duk_uint8_t *p;
+
 		/* char offset in [0, h_input->clen] (both ends inclusive), checked before entry */
 		DUK_ASSERT_DISABLE(char_offset >= 0);
 		DUK_ASSERT(char_offset <= DUK_HSTRING_GET_CHARLEN(h_input));
 
 		/* Note: ctx.steps is intentionally not reset, it applies to the entire unanchored match */
-		DUK_ASSERT(re_ctx.recursion_depth == 0);
+		re_ctx.bt_top = 0;
+		re_ctx.sub_top = 0;
+
+		/*
+		 *  Prefilter: skip positions where a match cannot start.  Matching
+		 *  can be abandoned entirely if no position qualifies.
+		 */
+
+		p = duk__prefilter_skip(&re_ctx, sp);
+		if (p == NULL) {
+			DUK_DDDPRINT("prefilter: no candidates after offset %d", (int) char_offset);
+			break;
+		}
+		if (p != sp) {
+			char_offset += duk__count_chars(&re_ctx, sp, p);
+			sp = p;
+		}
 
 		DUK_DDDPRINT("attempt match at char offset %d; %p [%p,%p]",
 		             (int) char_offset, (void *) sp, (void *) re_ctx.input,
@@ -817,15 +1606,11 @@ static void duk__regexp_match_helper(duk_hthread *thr, duk_small_int_t force_glo
 		 *
 		 *    - Clearing saved[] is not necessary because backtracking does it
 		 *
-		 *    - Backtracking also rewinds ctx.recursion back to zero, unless an
-		 *      internal/limit error occurs (which causes a longjmp())
+		 *    - The backtrack stack is reset for each attempt; it is empty after
+		 *      a failed attempt anyway
 		 *
-		 *    - If we supported anchored matches, we would break out here
-		 *      unconditionally; however, Ecmascript regexps don't have anchored
-		 *      matches.  It might make sense to implement a fast bail-out if
-		 *      the regexp begins with '^' and sp is not 0: currently we'll just
-		 *      run through the entire input string, trivially failing the match
-		 *      at every non-zero offset.
+		 *    - Regexps beginning with '^' (without the multiline flag) are
+		 *      only attempted at offset 0, see prefilter above
 		 */
 
 		if (duk__match_regexp(&re_ctx, re_ctx.bytecode, sp) != NULL) {
@@ -851,9 +1636,19 @@ static void duk__regexp_match_helper(duk_hthread *thr, duk_small_int_t force_glo
 		}
 
 		/* avoid calling at end of input, will DUK_ERROR (above check suffices to avoid this) */
-		(void) duk__utf8_advance(thr, &sp, re_ctx.input, re_ctx.input_end, (duk_uint_fast32_t) 1);
+		if (re_ctx.input_ascii) {
+			DUK_ASSERT(sp < re_ctx.input_end);
+			sp++;
+		} else {
+			(void) duk__utf8_advance(thr, &sp, re_ctx.input, re_ctx.input_end, (duk_uint_fast32_t) 1);
+		}
 	}
 
+#if defined(DUK_USE_REGEXP_AUTOMATON)
+ matcher_done:
+#endif
+	duk_pop(ctx);  /* bt_buf */
+
  match_over:
 
 	/*
@@ -872,6 +1667,35 @@ static void duk__regexp_match_helper(duk_hthread *thr, duk_small_int_t force_glo
 
 	/* [ ... re_obj input bc saved_buf ] */
 
+	if (out_bounds != NULL) {
+		if (match) {
+			DUK_ASSERT(re_ctx.saved[0] != NULL && re_ctx.saved[1] != NULL);
+			DUK_ASSERT(re_ctx.saved[1] >= re_ctx.saved[0]);
+
+			out_bounds->start_coff = char_offset;
+			out_bounds->end_coff = char_offset + duk__count_chars(&re_ctx, re_ctx.saved[0], re_ctx.saved[1]);
+			out_bounds->start_boff = (duk_size_t) (re_ctx.saved[0] - re_ctx.input);
+			out_bounds->end_boff = (duk_size_t) (re_ctx.saved[1] - re_ctx.input);
+
+			DUK_DDDPRINT("regexp matches at char_offset %d (bounds only)", (int) char_offset);
+
+			if (global) {
+				duk_push_number(ctx, (double) out_bounds->end_coff);
+				duk_put_prop_stridx(ctx, -5, DUK_STRIDX_LAST_INDEX);
+			}
+		} else {
+			/* same as below */
+			duk_push_int(ctx, 0);
+			duk_put_prop_stridx(ctx, -5, DUK_STRIDX_LAST_INDEX);
+		}
+
+		duk_pop_n(ctx, 4);
+
+		/* [ ... ] */
+
+		return match;
+	}
+
 	if (match) {
 #ifdef DUK_USE_ASSERTIONS
 		duk_hobject *h_res;
@@ -977,17 +1801,58 @@ static void duk__regexp_match_helper(duk_hthread *thr, duk_small_int_t force_glo
 	/* XXX: these last tricks are unnecessary if the function is made
 	 * a genuine native function.
 	 */
+
+	return match;
 }
 
 void duk_regexp_match(duk_hthread *thr) {
-	duk__regexp_match_helper(thr, 0 /*force_global*/);
+	(void) duk__regexp_match_helper(thr, 0 /*force_global*/, NULL);
 }
 
 /* This variant is needed by String.prototype.split(); it needs to perform
  * global-style matching on a cloned RegExp which is potentially non-global.
  */
 void duk_regexp_match_force_global(duk_hthread *thr) {
-	duk__regexp_match_helper(thr, 1 /*force_global*/);
+	(void) duk__regexp_match_helper(thr, 1 /*force_global*/, NULL);
+}
+
+/* Match without creating a result object: [ ... re_obj input ] -> [ ... ].
+ * Returns 1 and fills 'out_bounds' on a match, returns 0 otherwise.
+ */
+duk_small_int_t duk_regexp_match_bounds(duk_hthread *thr, duk_small_int_t force_global, duk_re_match_bounds *out_bounds) {
+	DUK_ASSERT(out_bounds != NULL);
+	return duk__regexp_match_helper(thr, force_global, out_bounds);
+}
+
+/* Number of capture groups of the RegExp instance at 'index', read from
+ * the bytecode header (nsaved = 2n + 2).  Callers use this to decide
+ * whether capture substrings need to be materialized at all.
+ */
+duk_uint32_t duk_regexp_get_num_captures(duk_hthread *thr, duk_idx_t index) {
+	duk_context *ctx = (duk_context *) thr;
+	duk_re_matcher_ctx re_ctx;
+	duk_hstring *h_bytecode;
+	duk_uint8_t *pc;
+	duk_uint32_t nsaved;
+
+	index = duk_require_normalize_index(ctx, index);
+	(void) duk_require_hobject_with_class(ctx, index, DUK_HOBJECT_CLASS_REGEXP);
+
+	duk_get_prop_stridx(ctx, index, DUK_STRIDX_INT_BYTECODE);
+	h_bytecode = duk_require_hstring(ctx, -1);
+	DUK_ASSERT(h_bytecode != NULL);
+
+	DUK_MEMZERO(&re_ctx, sizeof(re_ctx));
+	re_ctx.thr = thr;
+	re_ctx.bytecode = (duk_uint8_t *) DUK_HSTRING_GET_DATA(h_bytecode);
+	re_ctx.bytecode_end = re_ctx.bytecode + DUK_HSTRING_GET_BYTELEN(h_bytecode);
+
+	pc = re_ctx.bytecode;
+	(void) duk__bc_get_u32(&re_ctx, &pc);  /* flags */
+	nsaved = duk__bc_get_u32(&re_ctx, &pc);
+	duk_pop(ctx);
+
+	return (nsaved >= 2 ? (nsaved - 2) / 2 : 0);
 }
 
 #else  /* DUK_USE_REGEXP_SUPPORT */
@@ -187,6 +187,16 @@
 
 #include "duk_unicode_caseconv.h"
 
+#if defined(DUK_USE_CASECONV_LOOKUP)
+#include "duk_unicode_caseconv_lookup.h"
+#endif
+
+#if defined(DUK_USE_IDCHAR_LOOKUP)
+#include "duk_unicode_ids_noabmp_lookup.h"
+#include "duk_unicode_ids_m_let_noabmp_lookup.h"
+#include "duk_unicode_idp_m_ids_noabmp_lookup.h"
+#endif
+
 /*
  *  Extern
  */
@@ -209,7 +219,7 @@ duk_small_int_t duk_unicode_encode_xutf8(duk_ucodepoint_t cp, duk_uint8_t *out);
 duk_small_int_t duk_unicode_encode_cesu8(duk_ucodepoint_t cp, duk_uint8_t *out);
 duk_small_int_t duk_unicode_decode_xutf8(duk_hthread *thr, duk_uint8_t **ptr, duk_uint8_t *ptr_start, duk_uint8_t *ptr_end, duk_ucodepoint_t *out_cp);
 duk_ucodepoint_t duk_unicode_decode_xutf8_checked(duk_hthread *thr, duk_uint8_t **ptr, duk_uint8_t *ptr_start, duk_uint8_t *ptr_end);
-duk_size_t duk_unicode_unvalidated_utf8_length(duk_uint8_t *data, duk_size_t blen);
+duk_size_t duk_unicode_unvalidated_utf8_length(duk_uint8_t *data, duk_size_t blen, duk_small_int_t *out_ascii);
 duk_small_int_t duk_unicode_is_whitespace(duk_codepoint_t cp);
 duk_small_int_t duk_unicode_is_line_terminator(duk_codepoint_t cp);
 duk_small_int_t duk_unicode_is_identifier_start(duk_codepoint_t cp);
@@ -233,24 +233,72 @@ duk_ucodepoint_t duk_unicode_decode_xutf8_checked(duk_hthread *thr, duk_uint8_t
 }
 
 /* (extended) utf-8 length without codepoint encoding validation, used
- * for string interning (should probably be inlined).
+ * for string interning.  Also indicates whether the data is pure ASCII
+ * (all bytes 0x00...0x7f) so that both are computed in a single pass.
+ *
+ * The length is 'blen' minus the number of continuation bytes (10xxxxxx,
+ * 0x80...0xbf); bytes above and below that are initial bytes.  The bulk of
+ * the data is processed a word at a time: for each byte lane, bit 7 of
+ * (w & ~(w << 1)) is set exactly for continuation bytes, and the set lanes
+ * are summed with a multiply.  Words without any high bits set (the
+ * common ASCII case) skip the counting altogether.
  */
-duk_size_t duk_unicode_unvalidated_utf8_length(duk_uint8_t *data, duk_size_t blen) {
+#if defined(DUK_USE_64BIT_OPS)
+typedef duk_uint64_t duk__utf8_word_t;
+#define DUK__UTF8_WORD_HIBITS  ((((duk__utf8_word_t) 0x80808080UL) << 32) | ((duk__utf8_word_t) 0x80808080UL))
+#define DUK__UTF8_WORD_LOBITS  ((((duk__utf8_word_t) 0x01010101UL) << 32) | ((duk__utf8_word_t) 0x01010101UL))
+#else
+typedef duk_uint32_t duk__utf8_word_t;
+#define DUK__UTF8_WORD_HIBITS  ((duk__utf8_word_t) 0x80808080UL)
+#define DUK__UTF8_WORD_LOBITS  ((duk__utf8_word_t) 0x01010101UL)
+#endif
+#define DUK__UTF8_WORD_SUMSHIFT  ((sizeof(duk__utf8_word_t) - 1) * 8)
+
+duk_size_t duk_unicode_unvalidated_utf8_length(duk_uint8_t *data, duk_size_t blen, duk_small_int_t *out_ascii) {
 	duk_uint8_t *p = data;
 	duk_uint8_t *p_end = data + blen;
-	duk_size_t clen = 0;
+	duk_size_t ncont = 0;
+	duk_uint_fast32_t hibits = 0;
+	duk__utf8_word_t hiword = 0;
+
+	DUK_ASSERT(out_ascii != NULL);
+
+	/* Leading bytes until word aligned. */
+	while (p < p_end && (((duk_uintptr_t) p) & (sizeof(duk__utf8_word_t) - 1)) != 0) {
+		duk_uint8_t x = *p++;
+		hibits |= x;
+		if ((x & 0xc0) == 0x80) {
+			ncont++;
+		}
+	}
 
+	/* Aligned words. */
+	while ((duk_size_t) (p_end - p) >= sizeof(duk__utf8_word_t)) {
+		duk__utf8_word_t w = *((duk__utf8_word_t *) p);
+		p += sizeof(duk__utf8_word_t);
+
+		if (w & DUK__UTF8_WORD_HIBITS) {
+			duk__utf8_word_t c;
+
+			hiword |= w;
+			c = (w & ~(w << 1)) & DUK__UTF8_WORD_HIBITS;
+			c = ((c >> 7) * DUK__UTF8_WORD_LOBITS) >> DUK__UTF8_WORD_SUMSHIFT;
+			ncont += (duk_size_t) c;
+		}
+	}
+
+	/* Trailing bytes. */
 	while (p < p_end) {
 		duk_uint8_t x = *p++;
-		if (x < 0x80 || x >= 0xc0) {
-			/* 10xxxxxx = continuation chars (0x80...0xbf), above
-			 * and below that initial bytes.
-			 */
-			clen++;
+		hibits |= x;
+		if ((x & 0xc0) == 0x80) {
+			ncont++;
 		}
 	}
 
-	return clen;
+	*out_ascii = ((hibits & 0x80) == 0 && (hiword & DUK__UTF8_WORD_HIBITS) == 0);
+	DUK_ASSERT(ncont <= blen);
+	return blen - ncont;
 }
 
 /*
@@ -313,6 +361,21 @@ static duk_small_int_t duk__uni_range_match(const duk_uint8_t *unitab, duk_size_
 	return 0;
 }
 
+#if defined(DUK_USE_IDCHAR_LOOKUP)
+/* Match a BMP codepoint against a two-level bitmap generated by
+ * src/extract_chars.py: 'idx' maps the high byte of the codepoint to
+ * a 32-byte bitmap block in 'bits'.
+ */
+static duk_small_int_t duk__uni_lookup_match(const duk_uint8_t *idx, const duk_uint8_t *bits, duk_codepoint_t cp) {
+	duk_uint_fast32_t off;
+
+	DUK_ASSERT(cp >= 0 && cp <= 0xffffL);
+
+	off = ((duk_uint_fast32_t) idx[cp >> 8] << 5) + (duk_uint_fast32_t) ((cp & 0xffL) >> 3);
+	return (duk_small_int_t) ((bits[off] >> (cp & 0x07L)) & 0x01);
+}
+#endif
+
 /*
  *  "WhiteSpace" production check.
  */
@@ -462,6 +525,15 @@ duk_small_int_t duk_unicode_is_identifier_start(duk_codepoint_t cp) {
 		return 0;
 	}
 
+#if defined(DUK_USE_IDCHAR_LOOKUP)
+	/* Non-ASCII BMP fast path (bitmap lookup) */
+	if (cp < 0x10000L) {
+		return duk__uni_lookup_match(duk_unicode_ids_noabmp_lookup_idx,
+		                             duk_unicode_ids_noabmp_lookup_bits,
+		                             cp);
+	}
+#endif
+
 	/* Non-ASCII slow path (range-by-range linear comparison), very slow */
 
 #ifdef DUK_USE_SOURCE_NONBMP
@@ -548,6 +620,18 @@ duk_small_int_t duk_unicode_is_identifier_part(duk_codepoint_t cp) {
 		return 0;
 	}
 
+#if defined(DUK_USE_IDCHAR_LOOKUP)
+	/* Non-ASCII BMP fast path (bitmap lookup) */
+	if (cp < 0x10000L) {
+		return duk__uni_lookup_match(duk_unicode_ids_noabmp_lookup_idx,
+		                             duk_unicode_ids_noabmp_lookup_bits,
+		                             cp) ||
+		       duk__uni_lookup_match(duk_unicode_idp_m_ids_noabmp_lookup_idx,
+		                             duk_unicode_idp_m_ids_noabmp_lookup_bits,
+		                             cp);
+	}
+#endif
+
 	/* Non-ASCII slow path (range-by-range linear comparison), very slow */
 
 #ifdef DUK_USE_SOURCE_NONBMP
@@ -607,6 +691,18 @@ duk_small_int_t duk_unicode_is_letter(duk_codepoint_t cp) {
 		return 0;
 	}
 
+#if defined(DUK_USE_IDCHAR_LOOKUP)
+	/* Non-ASCII BMP fast path (bitmap lookup) */
+	if (cp < 0x10000L) {
+		return duk__uni_lookup_match(duk_unicode_ids_noabmp_lookup_idx,
+		                             duk_unicode_ids_noabmp_lookup_bits,
+		                             cp) &&
+		       !duk__uni_lookup_match(duk_unicode_ids_m_let_noabmp_lookup_idx,
+		                              duk_unicode_ids_m_let_noabmp_lookup_bits,
+		                              cp);
+	}
+#endif
+
 	/* Non-ASCII slow path (range-by-range linear comparison), very slow */
 
 #ifdef DUK_USE_SOURCE_NONBMP
@@ -644,7 +740,8 @@ duk_small_int_t duk_unicode_is_letter(duk_codepoint_t cp) {
  *  control stream generated by unicode/extract_caseconv.py.  The conversion
  *  is very slow because it runs through the conversion data in a linear
  *  fashion to save space (which is why ASCII characters have a special
- *  fast path before arriving here).
+ *  fast path before arriving here).  With DUK_USE_CASECONV_LOOKUP only
+ *  1:n conversions are handled here.
  * 
  *  The particular bit counts etc have been determined experimentally to
  *  be small but still sufficient, and must match the Python script
@@ -825,6 +922,25 @@ static duk_codepoint_t duk__case_transform_helper(duk_hthread *thr,
 	}
 
 	/* 1:1 or special conversions, but not locale/context specific: script generated rules */
+#if defined(DUK_USE_CASECONV_LOOKUP)
+	/* The lookup tables cover the whole BMP and there are no rules for
+	 * non-BMP codepoints, so only 1:n mappings need the bitstream.
+	 */
+	if (cp >= 0x10000L) {
+		goto singlechar;
+	} else {
+		const duk_uint8_t *idx;
+		duk_uint16_t delta;
+
+		idx = (uppercase ? duk_unicode_caseconv_lookup_uc_idx : duk_unicode_caseconv_lookup_lc_idx);
+		delta = duk_unicode_caseconv_lookup_delta[((duk_uint_fast32_t) idx[cp >> DUK_UNICODE_CASECONV_LOOKUP_SHIFT] << DUK_UNICODE_CASECONV_LOOKUP_SHIFT) +
+		                                          (duk_uint_fast32_t) (cp & DUK_UNICODE_CASECONV_LOOKUP_MASK)];
+		if (delta != DUK_UNICODE_CASECONV_LOOKUP_COMPLEX) {
+			cp = (cp + (duk_codepoint_t) delta) & 0xffffL;
+			goto singlechar;
+		}
+	}
+#endif
 	DUK_MEMZERO(&bd_ctx, sizeof(bd_ctx));
 	if (uppercase) {
 		bd_ctx.data = (duk_uint8_t *) duk_unicode_caseconv_uc;
@@ -848,6 +964,63 @@ static duk_codepoint_t duk__case_transform_helper(duk_hthread *thr,
 #endif
 }
 
+/*
+ *  Case conversion of a pure ASCII string.  There are no context specific
+ *  rules for ASCII and the result has the same byte length, so the bytes
+ *  can be converted in bulk.  If nothing changes, the input string is
+ *  kept as is.
+ */
+
+static void duk__case_convert_ascii_string(duk_hthread *thr, duk_hstring *h_input, duk_small_int_t uppercase) {
+	duk_context *ctx = (duk_context *) thr;
+	duk_uint8_t *p_start, *p_end, *p;
+	duk_uint8_t *q;
+	duk_uint8_t lo, hi;  /* range of bytes to convert: [lo,hi] */
+	duk_uint8_t t;
+	duk_size_t blen;
+
+	if (uppercase) {
+		lo = (duk_uint8_t) 'a';
+		hi = (duk_uint8_t) 'z';
+	} else {
+		lo = (duk_uint8_t) 'A';
+		hi = (duk_uint8_t) 'Z';
+	}
+
+	blen = (duk_size_t) DUK_HSTRING_GET_BYTELEN(h_input);
+	p_start = (duk_uint8_t *) DUK_HSTRING_GET_DATA(h_input);
+	p_end = p_start + blen;
+
+	/* Unsigned wraparound turns the range check into one comparison. */
+	for (p = p_start; p < p_end; p++) {
+		if ((duk_uint8_t) (*p - lo) <= (duk_uint8_t) (hi - lo)) {
+			break;
+		}
+	}
+	if (p == p_end) {
+		return;
+	}
+
+	/* Pushing the buffer may trigger a GC but the input is reachable
+	 * from the value stack; re-lookup the data pointer anyway because
+	 * a slice may be flattened.
+	 */
+	q = (duk_uint8_t *) duk_push_fixed_buffer(ctx, blen);
+	p_start = (duk_uint8_t *) DUK_HSTRING_GET_DATA(h_input);
+	p_end = p_start + blen;
+	p = p_start;
+	while (p < p_end) {
+		t = *p++;
+		if ((duk_uint8_t) (t - lo) <= (duk_uint8_t) (hi - lo)) {
+			t ^= 0x20;
+		}
+		*q++ = t;
+	}
+
+	duk_to_string(ctx, -1);
+	duk_remove(ctx, -2);
+}
+
 /*
  *  Replace valstack top with case converted version.
  */
@@ -862,6 +1035,11 @@ void duk_unicode_case_convert_string(duk_hthread *thr, duk_small_int_t uppercase
 	h_input = duk_require_hstring(ctx, -1);
 	DUK_ASSERT(h_input != NULL);
 
+	if (DUK_HSTRING_HAS_ASCII(h_input)) {
+		duk__case_convert_ascii_string(thr, h_input, uppercase);
+		return;
+	}
+
 	/* FIXME: should init with a spare of at least h_input->blen? */
 	duk_push_dynamic_buffer(ctx, 0);
 	h_buf = (duk_hbuffer_dynamic *) duk_get_hbuffer(ctx, -1);
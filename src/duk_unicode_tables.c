@@ -46,6 +46,23 @@
 #include "duk_unicode_idp_m_ids_noabmp.c"
 #endif
 
+/*
+ *  Two-level bitmap tables for the same BMP sets, used for constant time
+ *  matching of non-ASCII BMP codepoints.  The format is described in
+ *  src/extract_chars.py.
+ */
+
+#if defined(DUK_USE_IDCHAR_LOOKUP)
+/* duk_unicode_ids_noabmp_lookup_idx[], duk_unicode_ids_noabmp_lookup_bits[] */
+#include "duk_unicode_ids_noabmp_lookup.c"
+
+/* duk_unicode_ids_m_let_noabmp_lookup_idx[], duk_unicode_ids_m_let_noabmp_lookup_bits[] */
+#include "duk_unicode_ids_m_let_noabmp_lookup.c"
+
+/* duk_unicode_idp_m_ids_noabmp_lookup_idx[], duk_unicode_idp_m_ids_noabmp_lookup_bits[] */
+#include "duk_unicode_idp_m_ids_noabmp_lookup.c"
+#endif
+
 /*
  *  Case conversion tables generated using src/extract_caseconv.py.
  */
@@ -55,3 +72,11 @@
 
 #include "duk_unicode_caseconv.c"
 
+#if defined(DUK_USE_CASECONV_LOOKUP)
+/* duk_unicode_caseconv_lookup_uc_idx[] */
+/* duk_unicode_caseconv_lookup_lc_idx[] */
+/* duk_unicode_caseconv_lookup_delta[] */
+
+#include "duk_unicode_caseconv_lookup.c"
+#endif
+
@@ -48,6 +48,9 @@ duk_uint32_t duk_util_hashbytes(duk_uint8_t *data, duk_size_t len, duk_uint32_t
 
 duk_uint32_t duk_util_get_hash_prime(duk_uint32_t size);
 
+duk_uint8_t *duk_util_memsearch(duk_uint8_t *hay, duk_size_t hay_len, duk_uint8_t *needle, duk_size_t needle_len);
+duk_uint8_t *duk_util_memsearch_last(duk_uint8_t *hay, duk_size_t hay_len, duk_uint8_t *needle, duk_size_t needle_len);
+
 duk_int32_t duk_bd_decode(duk_bitdecoder_ctx *ctx, duk_small_int_t bits);
 duk_small_int_t duk_bd_decode_flag(duk_bitdecoder_ctx *ctx);
 duk_int32_t duk_bd_decode_flagged(duk_bitdecoder_ctx *ctx, duk_small_int_t bits, duk_int32_t def_value);
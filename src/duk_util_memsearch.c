@@ -0,0 +1,149 @@
+/*
+ *  Byte string search, duk_util_memsearch() and duk_util_memsearch_last().
+ *
+ *  Strings are searched as raw bytes.  A match of a valid (extended) UTF-8
+ *  needle in a valid haystack always begins at a codepoint boundary, so
+ *  callers only need to convert the resulting byte offset into a character
+ *  offset.
+ *
+ *  Short needles are searched by scanning for the first byte (with memchr()
+ *  which is typically vectorized by the C library) and verifying each
+ *  candidate with memcmp().  Long needles use Boyer-Moore-Horspool with a
+ *  byte-sized skip table: the skip table is cheap to build for each search
+ *  and the average skip grows with the needle length.
+ */
+
+#include "duk_internal.h"
+
+/* Minimum needle length for Boyer-Moore-Horspool. */
+#define DUK__MEMSEARCH_HORSPOOL_MIN  8
+
+/* Skips are stored as bytes; a shorter skip is always safe. */
+#define DUK__MEMSEARCH_MAX_SKIP      255
+
+static void duk__memsearch_init_skip(duk_uint8_t *skip, duk_size_t needle_len) {
+	DUK_MEMSET((void *) skip,
+	           (int) (needle_len > DUK__MEMSEARCH_MAX_SKIP ? DUK__MEMSEARCH_MAX_SKIP : needle_len),
+	           256);
+}
+
+static duk_uint8_t *duk__memsearch_horspool(duk_uint8_t *hay, duk_size_t hay_len, duk_uint8_t *needle, duk_size_t needle_len) {
+	duk_uint8_t skip[256];
+	duk_uint8_t *p, *p_end;
+	duk_size_t i, last, d;
+	duk_uint8_t lastbyte, t;
+
+	DUK_ASSERT(needle_len >= 2 && needle_len <= hay_len);
+
+	last = needle_len - 1;
+	duk__memsearch_init_skip(skip, needle_len);
+	for (i = 0; i < last; i++) {
+		d = last - i;
+		skip[needle[i]] = (duk_uint8_t) (d > DUK__MEMSEARCH_MAX_SKIP ? DUK__MEMSEARCH_MAX_SKIP : d);
+	}
+	lastbyte = needle[last];
+
+	p = hay;
+	p_end = hay + (hay_len - needle_len);  /* last possible match start */
+	while (p <= p_end) {
+		t = p[last];
+		if (t == lastbyte && DUK_MEMCMP((void *) p, (void *) needle, (size_t) last) == 0) {
+			return p;
+		}
+		p += skip[t];
+	}
+	return NULL;
+}
+
+static duk_uint8_t *duk__memsearch_horspool_last(duk_uint8_t *hay, duk_size_t hay_len, duk_uint8_t *needle, duk_size_t needle_len) {
+	duk_uint8_t skip[256];
+	duk_uint8_t *p;
+	duk_size_t i;
+	duk_uint8_t firstbyte, t;
+
+	DUK_ASSERT(needle_len >= 2 && needle_len <= hay_len);
+
+	/* Mirror image of the forward search: windows move backwards and
+	 * the skip is determined by the window's first byte.
+	 */
+	duk__memsearch_init_skip(skip, needle_len);
+	for (i = needle_len - 1; i > 0; i--) {
+		skip[needle[i]] = (duk_uint8_t) (i > DUK__MEMSEARCH_MAX_SKIP ? DUK__MEMSEARCH_MAX_SKIP : i);
+	}
+	firstbyte = needle[0];
+
+	p = hay + (hay_len - needle_len);  /* last possible match start */
+	for (;;) {
+		t = p[0];
+		if (t == firstbyte && DUK_MEMCMP((void *) (p + 1), (void *) (needle + 1), (size_t) (needle_len - 1)) == 0) {
+			return p;
+		}
+		if ((duk_size_t) (p - hay) < (duk_size_t) skip[t]) {
+			break;
+		}
+		p -= skip[t];
+	}
+	return NULL;
+}
+
+/* Find the first occurrence of 'needle' in 'hay', return NULL if none. */
+duk_uint8_t *duk_util_memsearch(duk_uint8_t *hay, duk_size_t hay_len, duk_uint8_t *needle, duk_size_t needle_len) {
+	duk_uint8_t *p, *p_end;
+	duk_uint8_t firstbyte;
+
+	if (needle_len == 0) {
+		return hay;
+	}
+	if (needle_len > hay_len) {
+		return NULL;
+	}
+	if (needle_len >= DUK__MEMSEARCH_HORSPOOL_MIN) {
+		return duk__memsearch_horspool(hay, hay_len, needle, needle_len);
+	}
+
+	firstbyte = needle[0];
+	p = hay;
+	p_end = hay + (hay_len - needle_len);  /* last possible match start */
+	while (p <= p_end) {
+		p = (duk_uint8_t *) DUK_MEMCHR((void *) p, (int) firstbyte, (size_t) (p_end - p + 1));
+		if (p == NULL) {
+			break;
+		}
+		if (DUK_MEMCMP((void *) (p + 1), (void *) (needle + 1), (size_t) (needle_len - 1)) == 0) {
+			return p;
+		}
+		p++;
+	}
+	return NULL;
+}
+
+/* Find the last occurrence of 'needle' in 'hay', return NULL if none. */
+duk_uint8_t *duk_util_memsearch_last(duk_uint8_t *hay, duk_size_t hay_len, duk_uint8_t *needle, duk_size_t needle_len) {
+	duk_uint8_t *p;
+	duk_uint8_t firstbyte;
+
+	if (needle_len == 0) {
+		return hay + hay_len;
+	}
+	if (needle_len > hay_len) {
+		return NULL;
+	}
+	if (needle_len >= DUK__MEMSEARCH_HORSPOOL_MIN) {
+		return duk__memsearch_horspool_last(hay, hay_len, needle, needle_len);
+	}
+
+	/* No portable memrchr(), so scan the first byte manually. */
+	firstbyte = needle[0];
+	p = hay + (hay_len - needle_len);  /* last possible match start */
+	for (;;) {
+		if (*p == firstbyte &&
+		    DUK_MEMCMP((void *) (p + 1), (void *) (needle + 1), (size_t) (needle_len - 1)) == 0) {
+			return p;
+		}
+		if (p == hay) {
+			break;
+		}
+		p--;
+	}
+	return NULL;
+}
@@ -88,9 +88,11 @@ typedef int duk_bool_t;
 typedef size_t duk_size_t;
 
 struct duk_memory_functions;
+struct duk_regexp_cache_stats;
 
 typedef void duk_context;
 typedef struct duk_memory_functions duk_memory_functions;
+typedef struct duk_regexp_cache_stats duk_regexp_cache_stats;
 
 typedef duk_ret_t (*duk_c_function)(duk_context *ctx);
 typedef void *(*duk_alloc_function) (void *udata, duk_size_t size);
@@ -108,6 +110,12 @@ struct duk_memory_functions {
 	void *udata;
 };
 
+struct duk_regexp_cache_stats {
+	duk_size_t hits;      /* regexp compilations served from the cache */
+	duk_size_t misses;    /* regexp compilations not found in the cache */
+	duk_size_t entries;   /* regexps currently cached */
+};
+
 /*
  *  Constants
  */
@@ -262,6 +270,7 @@ void duk_free(duk_context *ctx, void *ptr);
 void *duk_realloc(duk_context *ctx, void *ptr, duk_size_t size);
 void duk_get_memory_functions(duk_context *ctx, duk_memory_functions *out_funcs);
 void duk_gc(duk_context *ctx, int flags);
+void duk_get_regexp_cache_stats(duk_context *ctx, duk_regexp_cache_stats *out_stats);
 
 /*
  *  Error handling
@@ -496,6 +505,11 @@ const char *duk_hex_encode(duk_context *ctx, int index);
 void duk_hex_decode(duk_context *ctx, int index);
 const char *duk_json_encode(duk_context *ctx, int index);
 void duk_json_decode(duk_context *ctx, int index);
+void duk_push_json_decoder(duk_context *ctx, int callback_index);
+void duk_json_decoder_feed(duk_context *ctx, int index, const void *data, duk_size_t len);
+void duk_json_decoder_finish(duk_context *ctx, int index);
+void duk_cbor_encode(duk_context *ctx, int index);
+void duk_cbor_decode(duk_context *ctx, int index);
 
 /*
  *  Buffer
@@ -5,6 +5,10 @@
 #  bitstream encoded rules are used for the slow path at run time, so
 #  compactness is favored over speed.
 #
+#  Optionally, multi-level lookup tables are also generated for BMP
+#  codepoints.  They are much larger than the bitstream but allow a
+#  constant time lookup for 1:1 mappings, see generate_lookup_tables().
+#
 #  There is no support for context or locale sensitive rules, as they
 #  are handled directly in C code before consulting tables generated
 #  here.  Ecmascript requires case conversion both with and without
@@ -341,6 +345,61 @@ def generate_tables(convmap):
 
 	return be.getBytes(), be.getNumBits()
 
+def generate_lookup_tables(uc, lc, shift):
+	"Generate multi-level lookup tables for BMP case conversion."
+
+	# The BMP is split into blocks of (1 << shift) codepoints.  For each
+	# conversion direction there is a first level byte table mapping the
+	# block number to an index into a shared second level table.  The
+	# second level table contains, for each codepoint in a block, the
+	# 16-bit difference (modulo 0x10000) between the converted codepoint
+	# and the input codepoint, so that a zero entry means no change.
+	# Identical blocks (most of the BMP) are shared.
+	#
+	# A 1:n mapping is marked with a special value; the caller then falls
+	# back to the bitstream.  ASCII entries are left as zero because ASCII
+	# is handled by the C fast path.
+
+	blocksize = 1 << shift
+	blocks = []
+	block_map = {}
+	res_idx = []
+
+	complex_marker = 0x8000
+
+	for convmap in [ uc, lc ]:
+		idx = []
+		for start in xrange(0, 0x10000, blocksize):
+			block = []
+			for cp in xrange(start, start + blocksize):
+				if cp < 0x80 or not convmap.has_key(cp):
+					block.append(0)
+				elif len(convmap[cp]) > 1:
+					block.append(complex_marker)
+				else:
+					diff = (ord(convmap[cp]) - cp) & 0xffff
+					if diff == complex_marker or ord(convmap[cp]) >= 0x10000:
+						raise Exception('cannot represent mapping %d -> %d' % (cp, ord(convmap[cp])))
+					block.append(diff)
+			block = tuple(block)
+			if not block_map.has_key(block):
+				block_map[block] = len(blocks)
+				blocks.append(block)
+			idx.append(block_map[block])
+		res_idx.append(idx)
+
+	if len(blocks) > 256:
+		raise Exception('too many unique blocks for a byte index: %d' % len(blocks))
+
+	data = []
+	for block in blocks:
+		data.extend(list(block))
+
+	print 'lookup tables: shift %d, %d unique blocks, %d bytes' % \
+		(shift, len(blocks), len(res_idx[0]) + len(res_idx[1]) + 2 * len(data))
+
+	return res_idx[0], res_idx[1], data, complex_marker
+
 def clonedict(x):
 	"Shallow clone of input dict."
 	res = {}
@@ -356,6 +415,10 @@ def main():
 	parser.add_option('--out-header', dest='out_header')
 	parser.add_option('--table-name-lc', dest='table_name_lc', default='caseconv_lc')
 	parser.add_option('--table-name-uc', dest='table_name_uc', default='caseconv_uc')
+	parser.add_option('--out-lookup-source', dest='out_lookup_source')
+	parser.add_option('--out-lookup-header', dest='out_lookup_header')
+	parser.add_option('--table-name-lookup', dest='table_name_lookup', default='caseconv_lookup')
+	parser.add_option('--lookup-shift', dest='lookup_shift', type='int', default=5)
 	(opts, args) = parser.parse_args()
 
 	unicode_data = UnicodeData(opts.unicode_data)
@@ -366,6 +429,12 @@ def main():
 
 	# XXX: ASCII and non-BMP filtering could be an option but is now hardcoded
 
+	# lookup tables are generated from unmodified maps, ascii is skipped
+	# in generate_lookup_tables()
+	if opts.out_lookup_source is not None:
+		uc_idx, lc_idx, delta, complex_marker = \
+			generate_lookup_tables(uc, lc, opts.lookup_shift)
+
 	# ascii is handled with 'fast path' so not needed here
 	t = clonedict(uc)
 	remove_ascii_part(t)
@@ -392,6 +461,36 @@ def main():
 	f.write(genc.getString())
 	f.close()
 
+	if opts.out_lookup_source is None:
+		return
+
+	name_uc = opts.table_name_lookup + '_uc_idx'
+	name_lc = opts.table_name_lookup + '_lc_idx'
+	name_delta = opts.table_name_lookup + '_delta'
+
+	genc = dukutil.GenerateC()
+	genc.emitHeader('extract_caseconv.py')
+	genc.emitArray(uc_idx, name_uc, bytesize=len(uc_idx), typename='duk_uint8_t', intvalues=True, const=True)
+	genc.emitArray(lc_idx, name_lc, bytesize=len(lc_idx), typename='duk_uint8_t', intvalues=True, const=True)
+	genc.emitArray(delta, name_delta, bytesize=len(delta), typename='duk_uint16_t', intvalues=True, const=True)
+	f = open(opts.out_lookup_source, 'wb')
+	f.write(genc.getString())
+	f.close()
+
+	prefix = opts.table_name_lookup.upper()
+	genc = dukutil.GenerateC()
+	genc.emitHeader('extract_caseconv.py')
+	genc.emitDefine(prefix + '_SHIFT', '%d' % opts.lookup_shift)
+	genc.emitDefine(prefix + '_MASK', '0x%xL' % ((1 << opts.lookup_shift) - 1))
+	genc.emitDefine(prefix + '_COMPLEX', '0x%04xU' % complex_marker, 'delta value for a 1:n mapping')
+	genc.emitLine('')
+	genc.emitLine('extern const duk_uint8_t %s[%d];' % (name_uc, len(uc_idx)))
+	genc.emitLine('extern const duk_uint8_t %s[%d];' % (name_lc, len(lc_idx)))
+	genc.emitLine('extern const duk_uint16_t %s[%d];' % (name_delta, len(delta)))
+	f = open(opts.out_lookup_header, 'wb')
+	f.write(genc.getString())
+	f.close()
+
 if __name__ == '__main__':
 	main()
 
@@ -14,6 +14,10 @@
 #  above U+FFFF which is useful because such codepoints don't need to be
 #  supported in standard Ecmascript.
 #
+#  Optionally, a two-level bitmap lookup table is also written for sets
+#  which contain only BMP codepoints.  This allows constant time matching
+#  at the cost of a larger table, see generate_lookup_table().
+#
 
 import os, sys, math
 import optparse
@@ -253,6 +257,41 @@ def generate_match_table3(ranges):
 	data, nbits = be.getBytes(), be.getNumBits()
 	return data, freq
 
+def generate_lookup_table(ranges):
+	"Two-level bitmap lookup table for a set of BMP codepoints."
+
+	# The BMP is split into 256 blocks of 256 codepoints.  The first level
+	# table maps the high byte of a codepoint to a block number, and the
+	# second level table contains a 32-byte bitmap for each unique block
+	# (bit (cp & 7) of byte (cp & 0xff) >> 3 is set for matching codepoints).
+	# Most blocks are either empty or full so they are shared.
+
+	bitmap = [0] * (0x10000 / 8)
+	for rs, re in ranges:
+		if re >= 0x10000:
+			raise Exception('lookup table only supports BMP codepoints')
+		for cp in xrange(rs, re + 1):
+			bitmap[cp >> 3] |= (1 << (cp & 0x07))
+
+	blocks = []
+	block_map = {}
+	idx = []
+	for i in xrange(256):
+		block = tuple(bitmap[i * 32:(i + 1) * 32])
+		if not block_map.has_key(block):
+			block_map[block] = len(blocks)
+			blocks.append(block)
+		idx.append(block_map[block])
+
+	if len(blocks) > 256:
+		raise Exception('too many unique blocks for a byte index: %d' % len(blocks))
+
+	bits = []
+	for block in blocks:
+		bits.extend(list(block))
+
+	return idx, bits
+
 def main():
 	parser = optparse.OptionParser()
 	parser.add_option('--unicode-data', dest='unicode_data')      # UnicodeData.txt
@@ -263,6 +302,9 @@ def main():
 	parser.add_option('--out-header', dest='out_header')
 	parser.add_option('--out-png', dest='out_png')
 	parser.add_option('--table-name', dest='table_name', default='match_table')
+	parser.add_option('--out-lookup-source', dest='out_lookup_source')
+	parser.add_option('--out-lookup-header', dest='out_lookup_header')
+	parser.add_option('--table-name-lookup', dest='table_name_lookup', default='match_lookup')
 	(opts, args) = parser.parse_args()
 
 	unidata = opts.unicode_data
@@ -345,6 +387,33 @@ def main():
 		f.write(genc.getString())
 		f.close()
 
+	# Bitmap lookup table (optional)
+	if opts.out_lookup_source is not None:
+		lookup_idx, lookup_bits = generate_lookup_table(ranges)
+		print('')
+		print('LOOKUP TABLE: %d unique blocks, %d bytes' % \
+		      (len(lookup_bits) / 32, len(lookup_idx) + len(lookup_bits)))
+
+		name_idx = opts.table_name_lookup + '_idx'
+		name_bits = opts.table_name_lookup + '_bits'
+
+		genc = dukutil.GenerateC()
+		genc.emitHeader('extract_chars.py')
+		genc.emitArray(lookup_idx, name_idx, bytesize=len(lookup_idx), typename='duk_uint8_t', intvalues=True, const=True)
+		genc.emitArray(lookup_bits, name_bits, bytesize=len(lookup_bits), typename='duk_uint8_t', intvalues=True, const=True)
+		f = open(opts.out_lookup_source, 'wb')
+		f.write(genc.getString())
+		f.close()
+
+		genc = dukutil.GenerateC()
+		genc.emitHeader('extract_chars.py')
+		genc.emitLine('extern const duk_uint8_t %s[%d];' % (name_idx, len(lookup_idx)))
+		genc.emitLine('extern const duk_uint8_t %s[%d];' % (name_bits, len(lookup_bits)))
+		if opts.out_lookup_header is not None:
+			f = open(opts.out_lookup_header, 'wb')
+			f.write(genc.getString())
+			f.close()
+
 	# Image (for illustrative purposes only)
 	if opts.out_png is not None:
 		generate_png(res, opts.out_png)
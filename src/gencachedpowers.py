@@ -0,0 +1,62 @@
+#!/usr/bin/python
+#
+#  Generate the tables of cached powers of ten used by the number conversion
+#  fast paths in duk_numconv.c:
+#
+#    gencachedpowers.py          Grisu3 number-to-string table
+#    gencachedpowers.py parse    Eisel-Lemire string-to-number table
+#
+#  Each Grisu3 entry is 10^k (k = -348, -340, ..., 340) as a normalized
+#  64-bit significand f (2^63 <= f < 2^64) and a binary exponent e so that
+#  f * 2^e is 10^k rounded to nearest.  The string-to-number table has an
+#  entry for each k = -64, ..., 64, with the significand truncated (rounded
+#  down) instead, and without the binary exponent which is computed at
+#  runtime.  Significands are split into two 32-bit halves so that the
+#  tables don't need 64-bit constants.
+
+import sys
+
+def power_of_ten(k):
+	# exact rational 10^k as (numerator, denominator)
+	if k >= 0:
+		return 10 ** k, 1
+	else:
+		return 1, 10 ** (-k)
+
+def normalize(num, den, truncate):
+	e = num.bit_length() - den.bit_length() - 64
+	while True:
+		if e >= 0:
+			n, d = num, den << e
+		else:
+			n, d = num << (-e), den
+		if n < d * (1 << 63):
+			e -= 1
+		elif n >= d * (1 << 64):
+			e += 1
+		else:
+			break
+	f = n // d
+	if not truncate and (n - f * d) * 2 >= d:
+		f += 1
+	if f == (1 << 64):
+		f >>= 1
+		e += 1
+	return f, e
+
+entries = []
+if len(sys.argv) > 1 and sys.argv[1] == 'parse':
+	for k in xrange(-64, 64 + 1):
+		num, den = power_of_ten(k)
+		f, e = normalize(num, den, True)
+		entries.append('{ 0x%08xUL, 0x%08xUL }' % (f >> 32, f & 0xffffffff))
+	per_line = 3
+else:
+	for k in xrange(-348, 340 + 1, 8):
+		num, den = power_of_ten(k)
+		f, e = normalize(num, den, False)
+		entries.append('{ 0x%08xUL, 0x%08xUL, %d, %d }' % (f >> 32, f & 0xffffffff, e, k))
+	per_line = 2
+
+for i in xrange(0, len(entries), per_line):
+	print '\t' + ', '.join(entries[i:i+per_line]) + ','
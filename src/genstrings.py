@@ -547,6 +547,12 @@ duk_string_list = [
 	mkstr("target", internal=True, custom=True),	# target object
 	mkstr("this", internal=True, custom=True),	# implicit this binding value
 
+	# internal properties for JSON streaming decoder objects
+	mkstr("state", internal=True, custom=True),	# decoder state (fixed buffer)
+	mkstr("input", internal=True, custom=True),	# pending input (dynamic buffer)
+	mkstr("callback", internal=True, custom=True),	# element callback
+	mkstr("value", internal=True, custom=True),	# result array
+
 	# fake filename for compiled functions
 	mkstr("compile", custom=True),                  # used as a filename for functions created with Function constructor
 	mkstr("input", custom=True),                    # used as a filename for eval temp function
@@ -566,6 +572,7 @@ duk_string_list = [
 	mkstr("base64", custom=True),   # enc/dec alg
 	mkstr("jsonx", custom=True),    # enc/dec alg
 	mkstr("jsonc", custom=True),    # enc/dec alg
+	mkstr("cbor", custom=True),     # enc/dec alg
 	mkstr("compact", custom=True),
 
 	# Buffer constructor
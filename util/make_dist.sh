@@ -62,6 +62,7 @@ for i in	\
 	duk_api_buffer.c	\
 	duk_api.c		\
 	duk_api_call.c		\
+	duk_api_cbor.c		\
 	duk_api_codec.c		\
 	duk_api_compile.c	\
 	duk_api_internal.h	\
@@ -162,6 +163,7 @@ for i in	\
 	duk_util.h		\
 	duk_util_hashbytes.c	\
 	duk_util_hashprime.c	\
+	duk_util_memsearch.c	\
 	duk_util_misc.c		\
 	duk_util_tinyrandom.c	\
 	duk_selftest.c		\
@@ -370,7 +372,15 @@ IDPART_MINUS_IDSTART_NOA_EXCL='Lu,Ll,Lt,Lm,Lo,Nl,0024,005F,ASCII'
 IDPART_MINUS_IDSTART_NOABMP_INCL=$IDPART_MINUS_IDSTART_NOA_INCL
 IDPART_MINUS_IDSTART_NOABMP_EXCL='Lu,Ll,Lt,Lm,Lo,Nl,0024,005F,ASCII,NONBMP'
 
+# Optional 4th argument 'lookup' also generates a bitmap lookup table
+# (BMP only).
 extract_chars() {
+	LOOKUP_OPTS=""
+	if [ "$4" = "lookup" ]; then
+		LOOKUP_OPTS="--out-lookup-source=$DISTSRCSEP/duk_unicode_$3_lookup.c.tmp \
+		             --out-lookup-header=$DISTSRCSEP/duk_unicode_$3_lookup.h.tmp \
+		             --table-name-lookup=duk_unicode_$3_lookup"
+	fi
 	python src/extract_chars.py \
 		--unicode-data=src/UnicodeData.txt \
 		--include-categories="$1" \
@@ -378,6 +388,7 @@ extract_chars() {
 		--out-source=$DISTSRCSEP/duk_unicode_$3.c.tmp \
 		--out-header=$DISTSRCSEP/duk_unicode_$3.h.tmp \
 		--table-name=duk_unicode_$3 \
+		$LOOKUP_OPTS \
 		> $DISTSRCSEP/$3.txt
 }
 
@@ -389,6 +400,9 @@ extract_caseconv() {
 		--out-header=$DISTSRCSEP/duk_unicode_caseconv.h.tmp \
 		--table-name-lc=duk_unicode_caseconv_lc \
 		--table-name-uc=duk_unicode_caseconv_uc \
+		--out-lookup-source=$DISTSRCSEP/duk_unicode_caseconv_lookup.c.tmp \
+		--out-lookup-header=$DISTSRCSEP/duk_unicode_caseconv_lookup.h.tmp \
+		--table-name-lookup=duk_unicode_caseconv_lookup \
 		> $DISTSRCSEP/caseconv.txt
 }
 
@@ -398,13 +412,13 @@ extract_chars $LETTER_NOA_INCL $LETTER_NOA_EXCL let_noa
 extract_chars $LETTER_NOABMP_INCL $LETTER_NOABMP_EXCL let_noabmp
 extract_chars $IDSTART_INCL $IDSTART_EXCL ids
 extract_chars $IDSTART_NOA_INCL $IDSTART_NOA_EXCL ids_noa
-extract_chars $IDSTART_NOABMP_INCL $IDSTART_NOABMP_EXCL ids_noabmp
+extract_chars $IDSTART_NOABMP_INCL $IDSTART_NOABMP_EXCL ids_noabmp lookup
 extract_chars $IDSTART_MINUS_LETTER_INCL $IDSTART_MINUS_LETTER_EXCL ids_m_let
 extract_chars $IDSTART_MINUS_LETTER_NOA_INCL $IDSTART_MINUS_LETTER_NOA_EXCL ids_m_let_noa
-extract_chars $IDSTART_MINUS_LETTER_NOABMP_INCL $IDSTART_MINUS_LETTER_NOABMP_EXCL ids_m_let_noabmp
+extract_chars $IDSTART_MINUS_LETTER_NOABMP_INCL $IDSTART_MINUS_LETTER_NOABMP_EXCL ids_m_let_noabmp lookup
 extract_chars $IDPART_MINUS_IDSTART_INCL $IDPART_MINUS_IDSTART_EXCL idp_m_ids
 extract_chars $IDPART_MINUS_IDSTART_NOA_INCL $IDPART_MINUS_IDSTART_NOA_EXCL idp_m_ids_noa
-extract_chars $IDPART_MINUS_IDSTART_NOABMP_INCL $IDPART_MINUS_IDSTART_NOABMP_EXCL idp_m_ids_noabmp
+extract_chars $IDPART_MINUS_IDSTART_NOABMP_INCL $IDPART_MINUS_IDSTART_NOABMP_EXCL idp_m_ids_noabmp lookup
 extract_caseconv
 
 # Inject autogenerated files into source and header files so that they are
@@ -442,6 +456,22 @@ cat > $DISTSRCSEP/sed.tmp <<EOF
 	r $DISTSRCSEP/duk_unicode_caseconv.h.tmp
 	d
 }
+/#include "duk_unicode_caseconv_lookup.h"/ {
+	r $DISTSRCSEP/duk_unicode_caseconv_lookup.h.tmp
+	d
+}
+/#include "duk_unicode_ids_noabmp_lookup.h"/ {
+	r $DISTSRCSEP/duk_unicode_ids_noabmp_lookup.h.tmp
+	d
+}
+/#include "duk_unicode_ids_m_let_noabmp_lookup.h"/ {
+	r $DISTSRCSEP/duk_unicode_ids_m_let_noabmp_lookup.h.tmp
+	d
+}
+/#include "duk_unicode_idp_m_ids_noabmp_lookup.h"/ {
+	r $DISTSRCSEP/duk_unicode_idp_m_ids_noabmp_lookup.h.tmp
+	d
+}
 EOF
 
 mv $DISTSRCSEP/duk_unicode.h $DISTSRCSEP/duk_unicode.h.tmp
@@ -478,6 +508,22 @@ cat > $DISTSRCSEP/sed.tmp <<EOF
 	r $DISTSRCSEP/duk_unicode_caseconv.c.tmp
 	d
 }
+/#include "duk_unicode_caseconv_lookup.c"/ {
+	r $DISTSRCSEP/duk_unicode_caseconv_lookup.c.tmp
+	d
+}
+/#include "duk_unicode_ids_noabmp_lookup.c"/ {
+	r $DISTSRCSEP/duk_unicode_ids_noabmp_lookup.c.tmp
+	d
+}
+/#include "duk_unicode_ids_m_let_noabmp_lookup.c"/ {
+	r $DISTSRCSEP/duk_unicode_ids_m_let_noabmp_lookup.c.tmp
+	d
+}
+/#include "duk_unicode_idp_m_ids_noabmp_lookup.c"/ {
+	r $DISTSRCSEP/duk_unicode_idp_m_ids_noabmp_lookup.c.tmp
+	d
+}
 EOF
 
 mv $DISTSRCSEP/duk_unicode_tables.c $DISTSRCSEP/duk_unicode_tables.c.tmp